@@ -21,6 +21,8 @@
 
 #include <stdio.h>
 
+#include "SWGChannelPerf.h"
+
 #include "device/deviceapi.h"
 #include "audio/audiooutput.h"
 #include "dsp/dspcommands.h"
@@ -40,10 +42,19 @@ ChannelAnalyzer::ChannelAnalyzer(DeviceAPI *deviceAPI) :
     qDebug("ChannelAnalyzer::ChannelAnalyzer");
     setObjectName(m_channelId);
 
-    m_thread = new QThread(this);
     m_basebandSink = new ChannelAnalyzerBaseband();
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
     m_basebandSink->setSampleSink(&m_spectrumVis);
-    m_basebandSink->moveToThread(m_thread);
+
+    if (m_basebandSink->getTask()) // processed by the baseband scheduler
+    {
+        m_thread = nullptr;
+    }
+    else
+    {
+        m_thread = new QThread(this);
+        m_basebandSink->moveToThread(m_thread);
+    }
 
 	applySettings(m_settings, true);
 
@@ -75,14 +86,27 @@ void ChannelAnalyzer::start()
     }
 
     m_basebandSink->reset();
-    m_thread->start();
+
+    if (m_thread) {
+        m_thread->start();
+    } else {
+        m_basebandSink->getTask()->start(m_deviceAPI->getDeviceSetIndex());
+    }
 }
 
 void ChannelAnalyzer::stop()
 {
     qDebug() << "ChannelAnalyzer::stop";
-	m_thread->exit();
-	m_thread->wait();
+
+    if (m_thread)
+    {
+        m_thread->exit();
+        m_thread->wait();
+    }
+    else
+    {
+        m_basebandSink->getTask()->stop();
+    }
 }
 
 bool ChannelAnalyzer::handleMessage(const Message& cmd)
@@ -139,3 +163,12 @@ void ChannelAnalyzer::applySettings(const ChannelAnalyzerSettings& settings, boo
 
     m_settings = settings;
 }
+
+int ChannelAnalyzer::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
@@ -18,6 +18,7 @@
 #include <QDebug>
 
 #include "dsp/dspengine.h"
+#include "dsp/basebandscheduler.h"
 #include "dsp/dspcommands.h"
 #include "dsp/downchannelizer.h"
 
@@ -30,21 +31,33 @@ ChannelAnalyzerBaseband::ChannelAnalyzerBaseband() :
 {
     qDebug("ChannelAnalyzerBaseband::ChannelAnalyzerBaseband");
     m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(48000));
+    m_sampleFifo.setLockFree(true);
     m_channelizer = new DownChannelizer(&m_sink);
 
-    QObject::connect(
-        &m_sampleFifo,
-        &SampleSinkFifo::dataReady,
-        this,
-        &ChannelAnalyzerBaseband::handleData,
-        Qt::QueuedConnection
-    );
+    BasebandScheduler *basebandScheduler = DSPEngine::instance()->getBasebandScheduler();
+
+    if (basebandScheduler) // data processed by the shared workers
+    {
+        m_task = new BasebandTask(basebandScheduler, &m_sampleFifo, [this]() { handleData(); });
+    }
+    else
+    {
+        m_task = nullptr;
+        QObject::connect(
+            &m_sampleFifo,
+            &SampleSinkFifo::dataReady,
+            this,
+            &ChannelAnalyzerBaseband::handleData,
+            Qt::QueuedConnection
+        );
+    }
 
     connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
 }
 
 ChannelAnalyzerBaseband::~ChannelAnalyzerBaseband()
 {
+    delete m_task;
     delete m_channelizer;
 }
 
@@ -28,6 +28,7 @@
 #include "chanalyzersink.h"
 
 class DownChannelizer;
+class BasebandTask;
 
 class ChannelAnalyzerBaseband : public QObject
 {
@@ -59,8 +60,11 @@ public:
     ChannelAnalyzerBaseband();
     ~ChannelAnalyzerBaseband();
     void reset();
+    void attachSharedFifo(SampleSinkSharedFifo *sharedFifo) { m_sampleFifo.attachSharedFifo(sharedFifo); } //!< Read baseband from device engine shared FIFO
     void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
+    BasebandTask *getTask() { return m_task; } //!< nullptr if the baseband runs in its own thread
+    SampleSinkFifo& getSampleFifo() { return m_sampleFifo; }
     int getChannelSampleRate() const;
     double getMagSq() { return m_sink.getMagSq(); }
     double getMagSqAvg() const { return (double) m_sink.getMagSqAvg(); }
@@ -76,6 +80,7 @@ private:
     DownChannelizer *m_channelizer;
     ChannelAnalyzerSink m_sink;
 	MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
+	BasebandTask *m_task;
     ChannelAnalyzerSettings m_settings;
     QMutex m_mutex;
 
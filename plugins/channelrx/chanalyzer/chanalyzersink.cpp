@@ -56,24 +56,25 @@ ChannelAnalyzerSink::~ChannelAnalyzerSink()
 void ChannelAnalyzerSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
 	fftfilt::cmplx *sideband = 0;
-	Complex ci;
 
-	for (SampleVector::const_iterator it = begin; it < end; ++it)
+	if (m_settings.m_rationalDownSample)
 	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		m_mixedSamples.resize(end - begin);
+		m_nco.mix(begin, end, m_mixedSamples.data());
 
-		if (m_settings.m_rationalDownSample)
-		{
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci, sideband);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
+		m_interpolator.decimate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_mixedSamples.data(), m_mixedSamples.size(), m_resampledSamples);
+
+		for (std::vector<Complex>::iterator it = m_resampledSamples.begin(); it != m_resampledSamples.end(); ++it) {
+			processOneSample(*it, sideband);
 		}
-		else
+	}
+	else
+	{
+		for (SampleVector::const_iterator it = begin; it < end; ++it)
 		{
-	        processOneSample(c, sideband);
+			Complex c(it->real(), it->imag());
+			c *= m_nco.nextIQ();
+			processOneSample(c, sideband);
 		}
 	}
 
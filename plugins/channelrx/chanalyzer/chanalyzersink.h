@@ -68,6 +68,8 @@ private:
     Interpolator m_interpolator;
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
+    std::vector<Complex> m_mixedSamples;     //!< channel samples shifted by the NCO
+    std::vector<Complex> m_resampledSamples; //!< output of the interpolator
 
 	fftfilt* SSBFilter;
 	fftfilt* DSBFilter;
@@ -31,6 +31,7 @@
 #include "SWGAMDemodSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGAMDemodReport.h"
+#include "SWGChannelPerf.h"
 
 #include "dsp/dspengine.h"
 #include "dsp/dspcommands.h"
@@ -50,9 +51,18 @@ AMDemod::AMDemod(DeviceAPI *deviceAPI) :
 {
     setObjectName(m_channelId);
 
-    m_thread = new QThread(this);
     m_basebandSink = new AMDemodBaseband();
-    m_basebandSink->moveToThread(m_thread);
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
+
+    if (m_basebandSink->getTask()) // processed by the baseband scheduler
+    {
+        m_thread = nullptr;
+    }
+    else
+    {
+        m_thread = new QThread(this);
+        m_basebandSink->moveToThread(m_thread);
+    }
 
 	applySettings(m_settings, true);
 
@@ -93,14 +103,27 @@ void AMDemod::start()
     }
 
     m_basebandSink->reset();
-    m_thread->start();
+
+    if (m_thread) {
+        m_thread->start();
+    } else {
+        m_basebandSink->getTask()->start(m_deviceAPI->getDeviceSetIndex());
+    }
 }
 
 void AMDemod::stop()
 {
     qDebug("AMDemod::stop");
-	m_thread->exit();
-	m_thread->wait();
+
+    if (m_thread)
+    {
+        m_thread->exit();
+        m_thread->wait();
+    }
+    else
+    {
+        m_basebandSink->getTask()->stop();
+    }
 }
 
 bool AMDemod::handleMessage(const Message& cmd)
@@ -351,6 +374,15 @@ int AMDemod::webapiReportGet(
     return 200;
 }
 
+int AMDemod::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
+
 void AMDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const AMDemodSettings& settings)
 {
     response.getAmDemodSettings()->setAudioMute(settings.m_audioMute ? 1 : 0);
@@ -100,6 +100,10 @@ public:
             SWGSDRangel::SWGChannelReport& response,
             QString& errorMessage);
 
+    virtual int webapiPerfGet(
+            SWGSDRangel::SWGChannelPerf& response,
+            QString& errorMessage);
+
     static void webapiFormatChannelSettings(
             SWGSDRangel::SWGChannelSettings& response,
             const AMDemodSettings& settings);
@@ -18,6 +18,7 @@
 #include <QDebug>
 
 #include "dsp/dspengine.h"
+#include "dsp/basebandscheduler.h"
 #include "dsp/dspcommands.h"
 #include "dsp/downchannelizer.h"
 
@@ -31,15 +32,26 @@ AMDemodBaseband::AMDemodBaseband() :
     qDebug("AMDemodBaseband::AMDemodBaseband");
 
     m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(48000));
+    m_sampleFifo.setLockFree(true);
     m_channelizer = new DownChannelizer(&m_sink);
 
-    QObject::connect(
-        &m_sampleFifo,
-        &SampleSinkFifo::dataReady,
-        this,
-        &AMDemodBaseband::handleData,
-        Qt::QueuedConnection
-    );
+    BasebandScheduler *basebandScheduler = DSPEngine::instance()->getBasebandScheduler();
+
+    if (basebandScheduler) // data processed by the shared workers
+    {
+        m_task = new BasebandTask(basebandScheduler, &m_sampleFifo, [this]() { handleData(); });
+    }
+    else
+    {
+        m_task = nullptr;
+        QObject::connect(
+            &m_sampleFifo,
+            &SampleSinkFifo::dataReady,
+            this,
+            &AMDemodBaseband::handleData,
+            Qt::QueuedConnection
+        );
+    }
 
     DSPEngine::instance()->getAudioDeviceManager()->addAudioSink(m_sink.getAudioFifo(), getInputMessageQueue());
     m_sink.applyAudioSampleRate(DSPEngine::instance()->getAudioDeviceManager()->getOutputSampleRate());
@@ -49,6 +61,7 @@ AMDemodBaseband::AMDemodBaseband() :
 
 AMDemodBaseband::~AMDemodBaseband()
 {
+    delete m_task;
     DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(m_sink.getAudioFifo());
     delete m_channelizer;
 }
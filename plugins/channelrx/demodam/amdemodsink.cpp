@@ -65,29 +65,17 @@ AMDemodSink::~AMDemodSink()
 
 void AMDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-	Complex ci;
+	m_mixedSamples.resize(end - begin);
+	m_nco.mix(begin, end, m_mixedSamples.data());
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
-	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+	if (m_interpolatorDistance < 1.0f) { // interpolate
+		m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_mixedSamples.data(), m_mixedSamples.size(), m_resampledSamples);
+	} else { // decimate
+		m_interpolator.decimate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_mixedSamples.data(), m_mixedSamples.size(), m_resampledSamples);
+	}
 
-		if (m_interpolatorDistance < 1.0f) // interpolate
-		{
-		    while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
-		}
-		else // decimate
-		{
-	        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-	        {
-	            processOneSample(ci);
-	            m_interpolatorDistanceRemain += m_interpolatorDistance;
-	        }
-		}
+	for (std::vector<Complex>::iterator it = m_resampledSamples.begin(); it != m_resampledSamples.end(); ++it) {
+		processOneSample(*it);
 	}
 
 	if (m_audioBufferFill > 0)
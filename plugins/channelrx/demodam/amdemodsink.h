@@ -94,6 +94,8 @@ private:
 	Interpolator m_interpolator;
 	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
+	std::vector<Complex> m_mixedSamples;     //!< channel samples shifted by the NCO
+	std::vector<Complex> m_resampledSamples; //!< output of the interpolator
 
 	Real m_squelchLevel;
 	uint32_t m_squelchCount;
@@ -23,6 +23,8 @@
 #include <stdio.h>
 #include <complex.h>
 
+#include "SWGChannelPerf.h"
+
 #include "dsp/dspengine.h"
 #include "device/deviceapi.h"
 
@@ -43,6 +45,7 @@ ATVDemod::ATVDemod(DeviceAPI *deviceAPI) :
 
     m_thread = new QThread(this);
     m_basebandSink = new ATVDemodBaseband();
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
     m_basebandSink->moveToThread(m_thread);
 
     applySettings(m_settings, true);
@@ -152,3 +155,12 @@ void ATVDemod::applySettings(const ATVDemodSettings& settings, bool force)
 
     m_settings = settings;
 }
+
+int ATVDemod::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
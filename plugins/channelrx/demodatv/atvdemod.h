@@ -76,6 +76,10 @@ public:
     virtual QByteArray serialize() const { return QByteArray(); }
     virtual bool deserialize(const QByteArray& data) { (void) data; return false; }
 
+    virtual int webapiPerfGet(
+            SWGSDRangel::SWGChannelPerf& response,
+            QString& errorMessage);
+
     virtual int getNbSinkStreams() const { return 1; }
     virtual int getNbSourceStreams() const { return 0; }
 
@@ -81,8 +81,10 @@ public:
     ATVDemodBaseband();
     ~ATVDemodBaseband();
     void reset();
+    void attachSharedFifo(SampleSinkSharedFifo *sharedFifo) { m_sampleFifo.attachSharedFifo(sharedFifo); } //!< Read baseband from device engine shared FIFO
     void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
+    SampleSinkFifo& getSampleFifo() { return m_sampleFifo; }
     int getChannelSampleRate() const;
     double getMagSq() const { return m_sink.getMagSq(); }
     void setScopeSink(BasebandSampleSink* scopeSink) { m_sink.setScopeSink(scopeSink); }
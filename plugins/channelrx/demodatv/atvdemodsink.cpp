@@ -92,34 +92,37 @@ void ATVDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
 {
     float fltI;
     float fltQ;
-    Complex ci;
 
     //********** Let's rock and roll buddy ! **********
 
     //********** Accessing ATV Screen context **********
 
-    for (SampleVector::const_iterator it = begin; it != end; ++it /* ++it **/)
-    {
+    m_mixedSamples.resize(end - begin);
+    std::vector<Complex>::iterator mit = m_mixedSamples.begin();
 
+    for (SampleVector::const_iterator it = begin; it != end; ++it, ++mit)
+    {
         fltI = it->real();
         fltQ = it->imag();
-        Complex c(fltI, fltQ);
+        *mit = Complex(fltI, fltQ);
 
         if (m_settings.m_inputFrequencyOffset != 0) {
-            c *= m_nco.nextIQ();
+            *mit *= m_nco.nextIQ();
         }
+    }
 
-        if ((m_tvSampleRate == m_channelSampleRate) && (!m_settings.m_forceDecimator)) // no decimation
-        {
-            demod(c);
+    if ((m_tvSampleRate == m_channelSampleRate) && (!m_settings.m_forceDecimator)) // no decimation
+    {
+        for (std::vector<Complex>::iterator it = m_mixedSamples.begin(); it != m_mixedSamples.end(); ++it) {
+            demod(*it);
         }
-        else
-        {
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                demod(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
+    }
+    else
+    {
+        m_interpolator.decimate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_mixedSamples.data(), m_mixedSamples.size(), m_resampledSamples);
+
+        for (std::vector<Complex>::iterator it = m_resampledSamples.begin(); it != m_resampledSamples.end(); ++it) {
+            demod(*it);
         }
     }
 
@@ -168,6 +168,8 @@ private:
     Interpolator m_interpolator;
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
+    std::vector<Complex> m_mixedSamples;     //!< channel samples shifted by the NCO
+    std::vector<Complex> m_resampledSamples; //!< output of the interpolator at the TV sample rate
 
     // Used for vestigial SSB with asymmetrical filtering (needs double sideband scheme)
     fftfilt* m_DSBFilter;
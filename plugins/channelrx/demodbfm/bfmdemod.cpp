@@ -30,6 +30,7 @@
 #include "SWGChannelReport.h"
 #include "SWGBFMDemodReport.h"
 #include "SWGRDSReport.h"
+#include "SWGChannelPerf.h"
 
 #include "dsp/dspengine.h"
 #include "dsp/dspcommands.h"
@@ -53,10 +54,19 @@ BFMDemod::BFMDemod(DeviceAPI *deviceAPI) :
 {
 	setObjectName(m_channelId);
 
-    m_thread = new QThread(this);
     m_basebandSink = new BFMDemodBaseband();
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
     m_basebandSink->setSpectrumSink(&m_spectrumVis);
-    m_basebandSink->moveToThread(m_thread);
+
+    if (m_basebandSink->getTask()) // processed by the baseband scheduler
+    {
+        m_thread = nullptr;
+    }
+    else
+    {
+        m_thread = new QThread(this);
+        m_basebandSink->moveToThread(m_thread);
+    }
 
 	applySettings(m_settings, true);
 
@@ -98,14 +108,27 @@ void BFMDemod::start()
     }
 
     m_basebandSink->reset();
-    m_thread->start();
+
+    if (m_thread) {
+        m_thread->start();
+    } else {
+        m_basebandSink->getTask()->start(m_deviceAPI->getDeviceSetIndex());
+    }
 }
 
 void BFMDemod::stop()
 {
     qDebug() << "BFMDemod::stop";
-	m_thread->exit();
-	m_thread->wait();
+
+    if (m_thread)
+    {
+        m_thread->exit();
+        m_thread->wait();
+    }
+    else
+    {
+        m_basebandSink->getTask()->stop();
+    }
 }
 
 bool BFMDemod::handleMessage(const Message& cmd)
@@ -345,6 +368,15 @@ int BFMDemod::webapiReportGet(
     return 200;
 }
 
+int BFMDemod::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
+
 void BFMDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const BFMDemodSettings& settings)
 {
     response.getBfmDemodSettings()->setInputFrequencyOffset(settings.m_inputFrequencyOffset);
@@ -86,13 +86,15 @@ BFMDemodSink::~BFMDemodSink()
 
 void BFMDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-	Complex ci, cs, cr;
 	fftfilt::cmplx *rf;
 	int rf_out;
 	double msq;
 	Real demod;
 
 	m_sampleBuffer.clear();
+	m_demodSamples.clear();
+	m_stereoSamples.clear();
+	m_rdsSamples.clear();
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
@@ -138,25 +140,9 @@ void BFMDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
 			if (m_settings.m_rdsActive)
 			{
 				//Complex r(demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]), 0.0);
-				Complex r(demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]), 0.0);
-
-				if (m_interpolatorRDS.decimate(&m_interpolatorRDSDistanceRemain, r, &cr))
-				{
-					bool bit;
-
-					if (m_rdsDemod.process(cr.real(), bit))
-					{
-						if (m_rdsDecoder.frameSync(bit)) {
-						    m_rdsParser.parseGroup(m_rdsDecoder.getGroup());
-						}
-					}
-
-					m_interpolatorRDSDistanceRemain += m_interpolatorRDSDistance;
-				}
+				m_rdsSamples.push_back(Complex(demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]), 0.0));
 			}
 
-			Real sampleStereo = 0.0f;
-
 			// Process stereo if stereo mode is selected
 
 			if (m_settings.m_audioStereo)
@@ -167,65 +153,82 @@ void BFMDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
 					m_sampleBuffer.push_back(Sample(m_pilotPLLSamples[1] * SDR_RX_SCALEF, 0.0)); // debug 38 kHz pilot
 				}
 
-				if (m_settings.m_lsbStereo)
-				{
+				if (m_settings.m_lsbStereo) {
 					// 1.17 * 0.7 = 0.819
-					Complex s(demod * m_pilotPLLSamples[1], demod * m_pilotPLLSamples[2]);
-
-					if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
-					{
-						sampleStereo = cs.real() + cs.imag();
-						m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
-					}
-				}
-				else
-				{
-					Complex s(demod * 1.17 * m_pilotPLLSamples[1], 0);
-
-					if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
-					{
-						sampleStereo = cs.real();
-						m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
-					}
+					m_stereoSamples.push_back(Complex(demod * m_pilotPLLSamples[1], demod * m_pilotPLLSamples[2]));
+				} else {
+					m_stereoSamples.push_back(Complex(demod * 1.17 * m_pilotPLLSamples[1], 0));
 				}
 			}
 
-			Complex e(demod, 0);
+			m_demodSamples.push_back(Complex(demod, 0));
+		}
+	}
+
+	// the twin interpolators have the same rates and are fed the same number of samples: their outputs are aligned
+	m_interpolator.decimate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_demodSamples.data(), m_demodSamples.size(), m_audioSamples);
+
+	if (m_settings.m_audioStereo) {
+		m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, m_interpolatorStereoDistance, m_stereoSamples.data(), m_stereoSamples.size(), m_stereoAudioSamples);
+	} else {
+		m_stereoAudioSamples.clear();
+	}
+
+	if (m_settings.m_rdsActive)
+	{
+		m_interpolatorRDS.decimate(&m_interpolatorRDSDistanceRemain, m_interpolatorRDSDistance, m_rdsSamples.data(), m_rdsSamples.size(), m_rdsResampledSamples);
+
+		for (std::vector<Complex>::const_iterator cr = m_rdsResampledSamples.begin(); cr != m_rdsResampledSamples.end(); ++cr)
+		{
+			bool bit;
 
-			if (m_interpolator.decimate(&m_interpolatorDistanceRemain, e, &ci))
+			if (m_rdsDemod.process(cr->real(), bit))
 			{
-				if (m_settings.m_audioStereo)
-				{
-					Real deemph_l, deemph_r; // Pre-emphasis is applied on each channel before multiplexing
-					m_deemphasisFilterX.process(ci.real() + sampleStereo, deemph_l);
-					m_deemphasisFilterY.process(ci.real() - sampleStereo, deemph_r);
-                    m_audioBuffer[m_audioBufferFill].l = (qint16)(deemph_l * (1<<12) * m_settings.m_volume);
-                    m_audioBuffer[m_audioBufferFill].r = (qint16)(deemph_r * (1<<12) * m_settings.m_volume);
-				}
-				else
-				{
-					Real deemph;
-					m_deemphasisFilterX.process(ci.real(), deemph);
-					quint16 sample = (qint16)(deemph * (1<<12) * m_settings.m_volume);
-					m_audioBuffer[m_audioBufferFill].l = sample;
-					m_audioBuffer[m_audioBufferFill].r = sample;
+				if (m_rdsDecoder.frameSync(bit)) {
+					m_rdsParser.parseGroup(m_rdsDecoder.getGroup());
 				}
+			}
+		}
+	}
+
+	for (unsigned int i = 0; i < m_audioSamples.size(); i++)
+	{
+		const Complex& ci = m_audioSamples[i];
+
+		if (m_settings.m_audioStereo)
+		{
+			Real sampleStereo = 0.0f;
 
-				++m_audioBufferFill;
+			if (i < m_stereoAudioSamples.size()) {
+				sampleStereo = m_settings.m_lsbStereo ? m_stereoAudioSamples[i].real() + m_stereoAudioSamples[i].imag() : m_stereoAudioSamples[i].real();
+			}
 
-				if (m_audioBufferFill >= m_audioBuffer.size())
-				{
-					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+			Real deemph_l, deemph_r; // Pre-emphasis is applied on each channel before multiplexing
+			m_deemphasisFilterX.process(ci.real() + sampleStereo, deemph_l);
+			m_deemphasisFilterY.process(ci.real() - sampleStereo, deemph_r);
+            m_audioBuffer[m_audioBufferFill].l = (qint16)(deemph_l * (1<<12) * m_settings.m_volume);
+            m_audioBuffer[m_audioBufferFill].r = (qint16)(deemph_r * (1<<12) * m_settings.m_volume);
+		}
+		else
+		{
+			Real deemph;
+			m_deemphasisFilterX.process(ci.real(), deemph);
+			quint16 sample = (qint16)(deemph * (1<<12) * m_settings.m_volume);
+			m_audioBuffer[m_audioBufferFill].l = sample;
+			m_audioBuffer[m_audioBufferFill].r = sample;
+		}
 
-					if(res != m_audioBufferFill) {
-						qDebug("BFMDemodSink::feed: %u/%u audio samples written", res, m_audioBufferFill);
-					}
+		++m_audioBufferFill;
 
-					m_audioBufferFill = 0;
-				}
+		if (m_audioBufferFill >= m_audioBuffer.size())
+		{
+			uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
-				m_interpolatorDistanceRemain += m_interpolatorDistance;
+			if(res != m_audioBufferFill) {
+				qDebug("BFMDemodSink::feed: %u/%u audio samples written", res, m_audioBufferFill);
 			}
+
+			m_audioBufferFill = 0;
 		}
 	}
 
@@ -124,6 +124,12 @@ private:
 	Interpolator m_interpolatorRDS; //!< Twin Interpolator for stereo subcarrier
 	Real m_interpolatorRDSDistance;
 	Real m_interpolatorRDSDistanceRemain;
+	std::vector<Complex> m_demodSamples;        //!< demodulated samples of a feed call
+	std::vector<Complex> m_stereoSamples;       //!< stereo subcarrier mixed down
+	std::vector<Complex> m_rdsSamples;          //!< RDS subcarrier mixed down
+	std::vector<Complex> m_audioSamples;        //!< output of m_interpolator
+	std::vector<Complex> m_stereoAudioSamples;  //!< output of m_interpolatorStereo
+	std::vector<Complex> m_rdsResampledSamples; //!< output of m_interpolatorRDS
 
 	Lowpass<Real> m_lowpass;
 	fftfilt* m_rfFilter;
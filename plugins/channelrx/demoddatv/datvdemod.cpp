@@ -19,6 +19,8 @@
 
 #include <QDebug>
 
+#include "SWGChannelPerf.h"
+
 #include "device/deviceapi.h"
 
 #include "datvdemod.h"
@@ -37,6 +39,7 @@ DATVDemod::DATVDemod(DeviceAPI *deviceAPI) :
     setObjectName("DATVDemod");
     m_thread = new QThread(this);
     m_basebandSink = new DATVDemodBaseband();
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
     m_basebandSink->moveToThread(m_thread);
 
     applySettings(m_settings, true);
@@ -118,3 +121,12 @@ void DATVDemod::applySettings(const DATVDemodSettings& settings, bool force)
 
     m_settings = settings;
 }
+
+int DATVDemod::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
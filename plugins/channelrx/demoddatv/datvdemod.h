@@ -53,6 +53,10 @@ public:
 	virtual void stop();
 	virtual bool handleMessage(const Message& cmd);
 
+    virtual int webapiPerfGet(
+            SWGSDRangel::SWGChannelPerf& response,
+            QString& errorMessage);
+
     virtual int getNbSinkStreams() const { return 1; }
     virtual int getNbSourceStreams() const { return 0; }
 
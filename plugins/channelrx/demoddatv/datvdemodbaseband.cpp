@@ -31,6 +31,7 @@ DATVDemodBaseband::DATVDemodBaseband() :
 {
     qDebug("DATVDemodBaseband::DATVDemodBaseband");
     m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(48000));
+    m_sampleFifo.setLockFree(true);
     m_channelizer = new DownChannelizer(&m_sink);
 
     QObject::connect(
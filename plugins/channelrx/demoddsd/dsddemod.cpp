@@ -33,6 +33,7 @@
 #include "SWGChannelReport.h"
 #include "SWGDSDDemodReport.h"
 #include "SWGRDSReport.h"
+#include "SWGChannelPerf.h"
 
 #include "dsp/dspengine.h"
 #include "dsp/dspcommands.h"
@@ -55,9 +56,18 @@ DSDDemod::DSDDemod(DeviceAPI *deviceAPI) :
     qDebug("DSDDemod::DSDDemod");
 	setObjectName(m_channelId);
 
-    m_thread = new QThread(this);
     m_basebandSink = new DSDDemodBaseband();
-    m_basebandSink->moveToThread(m_thread);
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
+
+    if (m_basebandSink->getTask()) // processed by the baseband scheduler
+    {
+        m_thread = nullptr;
+    }
+    else
+    {
+        m_thread = new QThread(this);
+        m_basebandSink->moveToThread(m_thread);
+    }
 
     applySettings(m_settings, true);
 
@@ -98,14 +108,27 @@ void DSDDemod::start()
     }
 
     m_basebandSink->reset();
-    m_thread->start();
+
+    if (m_thread) {
+        m_thread->start();
+    } else {
+        m_basebandSink->getTask()->start(m_deviceAPI->getDeviceSetIndex());
+    }
 }
 
 void DSDDemod::stop()
 {
     qDebug() << "DSDDemod::stop";
-	m_thread->exit();
-	m_thread->wait();
+
+    if (m_thread)
+    {
+        m_thread->exit();
+        m_thread->wait();
+    }
+    else
+    {
+        m_basebandSink->getTask()->stop();
+    }
 }
 
 bool DSDDemod::handleMessage(const Message& cmd)
@@ -413,6 +436,15 @@ int DSDDemod::webapiReportGet(
     return 200;
 }
 
+int DSDDemod::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
+
 void DSDDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const DSDDemodSettings& settings)
 {
     response.getDsdDemodSettings()->setInputFrequencyOffset(settings.m_inputFrequencyOffset);
@@ -18,6 +18,7 @@
 #include <QDebug>
 
 #include "dsp/dspengine.h"
+#include "dsp/basebandscheduler.h"
 #include "dsp/dspcommands.h"
 #include "dsp/downchannelizer.h"
 
@@ -30,15 +31,26 @@ DSDDemodBaseband::DSDDemodBaseband() :
 {
     qDebug("DSDDemodBaseband::DSDDemodBaseband");
     m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(48000));
+    m_sampleFifo.setLockFree(true);
     m_channelizer = new DownChannelizer(&m_sink);
 
-    QObject::connect(
-        &m_sampleFifo,
-        &SampleSinkFifo::dataReady,
-        this,
-        &DSDDemodBaseband::handleData,
-        Qt::QueuedConnection
-    );
+    BasebandScheduler *basebandScheduler = DSPEngine::instance()->getBasebandScheduler();
+
+    if (basebandScheduler) // data processed by the shared workers
+    {
+        m_task = new BasebandTask(basebandScheduler, &m_sampleFifo, [this]() { handleData(); });
+    }
+    else
+    {
+        m_task = nullptr;
+        QObject::connect(
+            &m_sampleFifo,
+            &SampleSinkFifo::dataReady,
+            this,
+            &DSDDemodBaseband::handleData,
+            Qt::QueuedConnection
+        );
+    }
 
     DSPEngine::instance()->getAudioDeviceManager()->addAudioSink(m_sink.getAudioFifo1(), getInputMessageQueue());
     m_sink.applyAudioSampleRate(DSPEngine::instance()->getAudioDeviceManager()->getOutputSampleRate());
@@ -50,6 +62,7 @@ DSDDemodBaseband::DSDDemodBaseband() :
 
 DSDDemodBaseband::~DSDDemodBaseband()
 {
+    delete m_task;
     DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(m_sink.getAudioFifo1());
     DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(m_sink.getAudioFifo2());
     delete m_channelizer;
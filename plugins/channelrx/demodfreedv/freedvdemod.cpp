@@ -25,6 +25,7 @@
 #include "SWGFreeDVDemodSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGFreeDVDemodReport.h"
+#include "SWGChannelPerf.h"
 
 #include "dsp/dspengine.h"
 #include "dsp/dspcommands.h"
@@ -47,10 +48,19 @@ FreeDVDemod::FreeDVDemod(DeviceAPI *deviceAPI) :
 {
 	setObjectName(m_channelId);
 
-    m_thread = new QThread(this);
     m_basebandSink = new FreeDVDemodBaseband();
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
     m_basebandSink->setSpectrumSink(&m_spectrumVis);
-    m_basebandSink->moveToThread(m_thread);
+
+    if (m_basebandSink->getTask()) // processed by the baseband scheduler
+    {
+        m_thread = nullptr;
+    }
+    else
+    {
+        m_thread = new QThread(this);
+        m_basebandSink->moveToThread(m_thread);
+    }
 
     applySettings(m_settings, true);
 
@@ -91,14 +101,27 @@ void FreeDVDemod::start()
     }
 
     m_basebandSink->reset();
-    m_thread->start();
+
+    if (m_thread) {
+        m_thread->start();
+    } else {
+        m_basebandSink->getTask()->start(m_deviceAPI->getDeviceSetIndex());
+    }
 }
 
 void FreeDVDemod::stop()
 {
     qDebug() << "FreeDVDemod::stop";
-	m_thread->exit();
-	m_thread->wait();
+
+    if (m_thread)
+    {
+        m_thread->exit();
+        m_thread->wait();
+    }
+    else
+    {
+        m_basebandSink->getTask()->stop();
+    }
 }
 
 bool FreeDVDemod::handleMessage(const Message& cmd)
@@ -333,6 +356,15 @@ int FreeDVDemod::webapiReportGet(
     return 200;
 }
 
+int FreeDVDemod::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
+
 void FreeDVDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const FreeDVDemodSettings& settings)
 {
     response.getFreeDvDemodSettings()->setAudioMute(settings.m_audioMute ? 1 : 0);
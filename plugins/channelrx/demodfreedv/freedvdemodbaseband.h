@@ -28,6 +28,7 @@
 #include "freedvdemodsink.h"
 
 class DownChannelizer;
+class BasebandTask;
 
 class FreeDVDemodBaseband : public QObject
 {
@@ -72,8 +73,11 @@ public:
     FreeDVDemodBaseband();
     ~FreeDVDemodBaseband();
     void reset();
+    void attachSharedFifo(SampleSinkSharedFifo *sharedFifo) { m_sampleFifo.attachSharedFifo(sharedFifo); } //!< Read baseband from device engine shared FIFO
     void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
+    BasebandTask *getTask() { return m_task; } //!< nullptr if the baseband runs in its own thread
+    SampleSinkFifo& getSampleFifo() { return m_sampleFifo; }
     int getChannelSampleRate() const;
     unsigned int getAudioSampleRate() const { return m_sink.getAudioSampleRate(); }
     double getMagSq() { return m_sink.getMagSq(); }
@@ -104,6 +108,7 @@ private:
     DownChannelizer *m_channelizer;
     FreeDVDemodSink m_sink;
 	MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
+	BasebandTask *m_task;
     FreeDVDemodSettings m_settings;
     QMutex m_mutex;
     MessageQueue *m_messageQueueToGUI;
@@ -15,6 +15,8 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <cmath>
+
 #include <QDebug>
 
 #include "codec2/freedv_api.h"
@@ -288,8 +290,6 @@ void FreeDVDemodSink::processOneSample(Complex &ci)
 
 void FreeDVDemodSink::pushSampleToDV(int16_t sample)
 {
-    qint16 audioSample;
-
     calculateLevel(sample);
 
     if (m_iModem == m_nin)
@@ -298,22 +298,17 @@ void FreeDVDemodSink::pushSampleToDV(int16_t sample)
         m_freeDVStats.collect(m_freeDV);
         m_freeDVSNR.accumulate(m_freeDVStats.m_snrEst);
 
-        if (m_settings.m_audioMute)
+        for (int i = 0; i < nout; i++) // low cut at 8 kS/s: the resampler only filters the high end
         {
-            for (uint32_t i = 0; i < nout * m_audioResampler.getDecimation(); i++) {
-                pushSampleToAudio(0);
-            }
+            float s = m_speechHighPass.runHP(m_speechOut[i] / 32768.0f) * 32768.0f;
+            m_speechOut[i] = s < -32768.0f ? -32768 : s > 32767.0f ? 32767 : (int16_t) lrintf(s);
         }
-        else
-        {
-            for (int i = 0; i < nout; i++)
-            {
-                while (!m_audioResampler.upSample(m_speechOut[i], audioSample)) {
-                    pushSampleToAudio(audioSample);
-                }
 
-                pushSampleToAudio(audioSample);
-            }
+        // speech at its natural 8 kS/s rate converted to the audio rate in one block
+        unsigned int nbAudio = m_audioResampler.resample(m_speechOut, nout, m_speechResampled);
+
+        for (unsigned int i = 0; i < nbAudio; i++) {
+            pushSampleToAudio(m_settings.m_audioMute ? 0 : m_speechResampled[i]);
         }
 
         m_iModem = 0;
@@ -381,8 +376,8 @@ void FreeDVDemodSink::applyAudioSampleRate(int sampleRate)
     qDebug("FreeDVDemodSink::applyAudioSampleRate: %d", sampleRate);
 
     m_audioFifo.setSize(sampleRate);
-    m_audioResampler.setDecimation(sampleRate / m_speechSampleRate);
-    m_audioResampler.setAudioFilters(sampleRate, sampleRate, 250, 3300, 4.0f);
+    m_audioResampler.setRates(m_speechSampleRate, sampleRate, false, 3300.0f);
+    m_speechHighPass.setDecimFilters(m_speechSampleRate, m_speechSampleRate, 3300.0f, 250.0f);
     m_audioSampleRate = sampleRate;
 }
 
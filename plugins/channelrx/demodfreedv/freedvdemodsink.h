@@ -192,6 +192,8 @@ private:
     int16_t *m_speechOut;
     int16_t *m_modIn;
     AudioResampler m_audioResampler;
+    std::vector<qint16> m_speechResampled;
+    AudioFilter m_speechHighPass; //!< 250 Hz speech high pass before resampling
 	FreeDVStats m_freeDVStats;
 	FreeDVSNR m_freeDVSNR;
 	LevelRMS m_levelIn;
@@ -23,6 +23,8 @@
 #include <QDebug>
 #include <QThread>
 
+#include "SWGChannelPerf.h"
+
 #include "dsp/dspcommands.h"
 #include "device/deviceapi.h"
 
@@ -40,10 +42,19 @@ LoRaDemod::LoRaDemod(DeviceAPI* deviceAPI) :
 {
 	setObjectName(m_channelId);
 
-    m_thread = new QThread(this);
     m_basebandSink = new LoRaDemodBaseband();
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
     m_basebandSink->setSpectrumSink(&m_spectrumVis);
-    m_basebandSink->moveToThread(m_thread);
+
+    if (m_basebandSink->getTask()) // processed by the baseband scheduler
+    {
+        m_thread = nullptr;
+    }
+    else
+    {
+        m_thread = new QThread(this);
+        m_basebandSink->moveToThread(m_thread);
+    }
 
 	applySettings(m_settings, true);
 
@@ -75,14 +86,27 @@ void LoRaDemod::start()
     }
 
     m_basebandSink->reset();
-    m_thread->start();
+
+    if (m_thread) {
+        m_thread->start();
+    } else {
+        m_basebandSink->getTask()->start(m_deviceAPI->getDeviceSetIndex());
+    }
 }
 
 void LoRaDemod::stop()
 {
     qDebug() << "LoRaDemod::stop";
-	m_thread->exit();
-	m_thread->wait();
+
+    if (m_thread)
+    {
+        m_thread->exit();
+        m_thread->wait();
+    }
+    else
+    {
+        m_basebandSink->getTask()->stop();
+    }
 }
 
 bool LoRaDemod::handleMessage(const Message& cmd)
@@ -149,4 +173,13 @@ void LoRaDemod::applySettings(const LoRaDemodSettings& settings, bool force)
     m_basebandSink->getInputMessageQueue()->push(msg);
 
     m_settings = settings;
-}
\ No newline at end of file
+}
+
+int LoRaDemod::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
@@ -98,7 +98,10 @@ void LoRaDemodGUI::on_BW_valueChanged(int value)
 
 void LoRaDemodGUI::on_Spread_valueChanged(int value)
 {
-    (void) value;
+    m_settings.m_spread = value;
+    ui->SpreadText->setText(QString("6:4 2^%1").arg(m_settings.getSpreadFactor()));
+
+    applySettings();
 }
 
 void LoRaDemodGUI::onWidgetRolled(QWidget* widget, bool rollDown)
@@ -182,5 +185,7 @@ void LoRaDemodGUI::displaySettings()
     blockApplySettings(true);
     ui->BWText->setText(QString("%1 Hz").arg(thisBW));
     ui->BW->setValue(m_settings.m_bandwidthIndex);
+    ui->SpreadText->setText(QString("6:4 2^%1").arg(m_settings.getSpreadFactor()));
+    ui->Spread->setValue(m_settings.m_spread);
     blockApplySettings(false);
 }
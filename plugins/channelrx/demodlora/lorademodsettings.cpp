@@ -9,6 +9,8 @@
 
 const int LoRaDemodSettings::bandwidths[] = {7813,15625,20833,31250,62500};
 const int LoRaDemodSettings::nb_bandwidths = 5;
+const int LoRaDemodSettings::baseSpreadFactor = 8;
+const int LoRaDemodSettings::nbSpreadFactors = 5;
 
 LoRaDemodSettings::LoRaDemodSettings() :
     m_centerFrequency(0),
@@ -63,6 +65,7 @@ bool LoRaDemodSettings::deserialize(const QByteArray& data)
         d.readS32(1, &m_centerFrequency, 0);
         d.readS32(2, &m_bandwidthIndex, 0);
         d.readS32(3, &m_spread, 0);
+        m_spread = m_spread < 0 ? 0 : m_spread >= nbSpreadFactors ? nbSpreadFactors - 1 : m_spread;
 
         if (m_spectrumGUI) {
             d.readBlob(4, &bytetmp);
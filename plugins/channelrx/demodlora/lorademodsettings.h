@@ -13,7 +13,7 @@ struct LoRaDemodSettings
 {
     int m_centerFrequency;
     int m_bandwidthIndex;
-    int m_spread;
+    int m_spread; //!< spread factor index from baseSpreadFactor
     uint32_t m_rgbColor;
     QString m_title;
 
@@ -22,11 +22,14 @@ struct LoRaDemodSettings
 
     static const int bandwidths[];
     static const int nb_bandwidths;
+    static const int baseSpreadFactor;
+    static const int nbSpreadFactors;
 
     LoRaDemodSettings();
     void resetToDefaults();
     void setChannelMarker(Serializable *channelMarker) { m_channelMarker = channelMarker; }
     void setSpectrumGUI(Serializable *spectrumGUI) { m_spectrumGUI = spectrumGUI; }
+    unsigned int getSpreadFactor() const { return baseSpreadFactor + m_spread; }
     QByteArray serialize() const;
     bool deserialize(const QByteArray& data);
 };
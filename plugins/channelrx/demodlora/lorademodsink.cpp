@@ -18,19 +18,30 @@
 #include <QTime>
 #include <QDebug>
 #include <stdio.h>
+#include <algorithm>
 
 #include "dsp/dsptypes.h"
 #include "dsp/basebandsamplesink.h"
+#include "dsp/dspengine.h"
+#include "dsp/fftfactory.h"
+#include "dsp/fftengine.h"
+#include "dsp/spectrumkernels.h"
 
 #include "lorademodsink.h"
 
 const int LoRaDemodSink::DATA_BITS = 6;
-const int LoRaDemodSink::SAMPLEBITS = LoRaDemodSink::DATA_BITS + 2;
-const int LoRaDemodSink::SPREADFACTOR = (1 << LoRaDemodSink::SAMPLEBITS);
-const int LoRaDemodSink::LORA_SFFT_LEN = (LoRaDemodSink::SPREADFACTOR / 2);
 const int LoRaDemodSink::LORA_SQUELCH = 3;
+const int LoRaDemodSink::LORA_PREAMBLE_MATCH = 3;
 
 LoRaDemodSink::LoRaDemodSink() :
+        m_spreadFactor(0),
+        m_nbSymbolBins(0),
+        m_symbolIndex(0),
+        m_fftFactory(nullptr),
+        m_fft(nullptr),
+        m_fftSequence(0),
+        m_nbSymbols(0),
+        m_lastSymbol(-1),
         m_spectrumSink(nullptr)
 {
 	m_Bandwidth = LoRaDemodSettings::bandwidths[0];
@@ -40,37 +51,80 @@ LoRaDemodSink::LoRaDemodSink() :
 	m_interpolator.create(16, m_channelSampleRate, m_Bandwidth/1.9);
 	m_sampleDistanceRemain = (Real) m_channelSampleRate / m_Bandwidth;
 
-	m_chirp = 0;
-	m_angle = 0;
-	m_bin = 0;
-	m_result = 0;
-	m_count = 0;
-	m_header = 0;
 	m_time = 0;
 	m_tune = 0;
 
-	loraFilter = new sfft(LORA_SFFT_LEN);
-	negaFilter = new sfft(LORA_SFFT_LEN);
-	mov = new float[4*LORA_SFFT_LEN];
 	history = new short[1024];
-	finetune = new short[16];
+	setSpreadFactor(m_settings.getSpreadFactor());
 }
 
 LoRaDemodSink::~LoRaDemodSink()
 {
-    delete loraFilter;
-	delete negaFilter;
-	delete [] mov;
+	releaseFFT();
 	delete [] history;
-	delete [] finetune;
+}
+
+void LoRaDemodSink::releaseFFT()
+{
+	if (m_fft)
+	{
+		if (m_fftFactory) {
+			m_fftFactory->releaseEngine(m_nbSymbolBins, false, m_fftSequence);
+		} else {
+			delete m_fft;
+		}
+
+		m_fft = nullptr;
+	}
+}
+
+void LoRaDemodSink::setSpreadFactor(unsigned int spreadFactor)
+{
+	releaseFFT();
+
+	m_spreadFactor = spreadFactor;
+	m_nbSymbolBins = 1 << spreadFactor;
+	m_fftFactory = DSPEngine::instance()->getFFTFactory();
+
+	if (m_fftFactory)
+	{
+		m_fftSequence = m_fftFactory->getEngine(m_nbSymbolBins, false, &m_fft);
+	}
+	else // no factory: own engine
+	{
+		m_fft = FFTEngine::create(QString(""));
+
+		if (m_fft) {
+			m_fft->configure(m_nbSymbolBins, false);
+		}
+	}
+
+	m_downChirps.resize(m_nbSymbolBins);
+	m_symbolBuffer.resize(m_nbSymbolBins);
+	m_magSq.resize(m_nbSymbolBins);
+	m_symbolIndex = 0;
+	m_time = 0;
+	m_tune = 0;
+
+	// base chirp phase 2*pi*angle/N sweeps the whole bandwidth once per symbol
+	unsigned int angle = 0;
+
+	for (unsigned int n = 0; n < m_nbSymbolBins; n++)
+	{
+		angle = (angle + n) & (m_nbSymbolBins - 1);
+		m_downChirps[n] = Complex(cos(M_PI*2*angle/m_nbSymbolBins), -sin(M_PI*2*angle/m_nbSymbolBins));
+	}
+
+	qDebug("LoRaDemodSink::setSpreadFactor: SF: %u FFT size: %u", m_spreadFactor, m_nbSymbolBins);
 }
 
 void LoRaDemodSink::dumpRaw()
 {
 	short bin, j, max;
 	char text[256];
+	int shift = m_spreadFactor - DATA_BITS;
 
-	max = m_time / 4 - 3;
+	max = m_time - 3;
 
 	if (max > 140) {
 		max = 140; // about 2 symbols to each char
@@ -78,8 +132,9 @@ void LoRaDemodSink::dumpRaw()
 
 	for ( j=0; j < max; j++)
 	{
-		bin = (history[(j + 1)  * 4] + m_tune ) & (LORA_SFFT_LEN - 1);
-		text[j] = toGray(bin >> 1);
+		// keep the DATA_BITS most significant bits rounded to the nearest value
+		bin = ((history[j + 1] + m_tune + (1 << (shift - 1))) & (m_nbSymbolBins - 1)) >> shift;
+		text[j] = toGray(bin);
 	}
 
 	prng6(text, max);
@@ -108,11 +163,11 @@ void LoRaDemodSink::dumpRaw()
 
 short LoRaDemodSink::synch(short bin)
 {
-	short i, j;
+	short i;
 
 	if (bin < 0)
 	{
-		if (m_time > 70) {
+		if (m_time > 17) {
 			dumpRaw();
 		}
 
@@ -122,124 +177,114 @@ short LoRaDemodSink::synch(short bin)
 
 	history[m_time] = bin;
 
-	if (m_time > 12)
+	if (m_time >= LORA_PREAMBLE_MATCH - 1)
 	{
-		if (bin == history[m_time - 6])
-		{
-			if (bin == history[m_time - 12])
-			{
-				m_tune = LORA_SFFT_LEN - bin;
-				j = 0;
+		bool preamble = true;
 
-				for (i=0; i<12; i++) {
-					j += finetune[15 & (m_time - i)];
-				}
+		// preamble: same bin within one bin over consecutive up chirps
+		for (i = 1; i < LORA_PREAMBLE_MATCH; i++)
+		{
+			short delta = (bin - history[m_time - i]) & (m_nbSymbolBins - 1);
+			preamble = preamble && ((delta <= 1) || (delta == (short) m_nbSymbolBins - 1));
+		}
 
-				if (j < 0) {
-					m_tune += 1;
-				}
+		if (preamble)
+		{
+			short offset = bin < (short) (m_nbSymbolBins / 2) ? bin : bin - (short) m_nbSymbolBins;
 
-				m_tune &= (LORA_SFFT_LEN - 1);
-				m_time = 0;
-				return -1;
+			if (std::abs(offset) > (1 << (m_spreadFactor - DATA_BITS - 1)))
+			{
+				// the window starts bin samples after the chirp: move next window start back by that much
+				std::copy(m_symbolBuffer.end() - bin, m_symbolBuffer.end(), m_symbolBuffer.begin());
+				m_symbolIndex = bin;
+				m_tune = 0;
 			}
+			else
+			{
+				// residual is mostly frequency offset
+				m_tune = (m_nbSymbolBins - bin) & (m_nbSymbolBins - 1);
+			}
+
+			m_time = 0;
+			return -1;
 		}
 	}
 
 	m_time++;
 	m_time &= 1023;
 
-	if (m_time & 3) {
-		return -1;
-	}
-
-	return (bin + m_tune) & (LORA_SFFT_LEN - 1);
+	return (bin + m_tune) & (m_nbSymbolBins - 1);
 }
 
-int LoRaDemodSink::detect(Complex c, Complex a)
+void LoRaDemodSink::processSymbol()
 {
-	int p, q;
-	short i, result, negresult, movpoint;
-	float peak, negpeak, tfloat;
-	float mag[LORA_SFFT_LEN];
-	float rev[LORA_SFFT_LEN];
-
-	loraFilter->run(c * a);
-	negaFilter->run(c * conj(a));
-
-	// process spectrum twice in FFTLEN
-	if (++m_count & ((1 << DATA_BITS) - 1)) {
-		return m_result;
+	if (!m_fft) {
+		return;
 	}
 
-	movpoint = 3 & (m_count >> DATA_BITS);
+	Complex *in = m_fft->in();
 
-	loraFilter->fetch(mag);
-	negaFilter->fetch(rev);
-	peak = negpeak = 0.0f;
-	result = negresult = 0;
+	// dechirp the whole symbol then one FFT: the symbol value is the peak bin
+	for (unsigned int n = 0; n < m_nbSymbolBins; n++) {
+		in[n] = m_symbolBuffer[n] * m_downChirps[n];
+	}
 
-	for (i = 0; i < LORA_SFFT_LEN; i++)
+	if (m_spectrumSink)
 	{
-		if (rev[i] > negpeak)
-		{
-			negpeak = rev[i];
-			negresult = i;
+		for (unsigned int n = 0; n < m_nbSymbolBins; n++) {
+			m_sampleBuffer.push_back(Sample(in[n].real() * SDR_RX_SCALEF, in[n].imag() * SDR_RX_SCALEF));
 		}
+	}
+
+	m_fft->transform();
+	SpectrumKernels::magSq(m_fft->out(), m_magSq.data(), m_nbSymbolBins);
+
+	short result = 0;
+	float peak = 0.0f;
+	float total = 0.0f;
 
-		tfloat = mov[i] + mov[LORA_SFFT_LEN + i] +mov[2 * LORA_SFFT_LEN + i]
-				+ mov[3 * LORA_SFFT_LEN + i] + mag[i];
+	for (unsigned int k = 0; k < m_nbSymbolBins; k++)
+	{
+		total += m_magSq[k];
 
-		if (tfloat > peak)
+		if (m_magSq[k] > peak)
 		{
-			peak = tfloat;
-			result = i;
+			peak = m_magSq[k];
+			result = k;
 		}
-
-		mov[movpoint * LORA_SFFT_LEN + i] = mag[i];
 	}
 
-	p = (result - 1 + LORA_SFFT_LEN) & (LORA_SFFT_LEN -1);
-	q = (result + 1) & (LORA_SFFT_LEN -1);
-	finetune[15 & m_time] = (mag[p] > mag[q]) ? -1 : 1;
+	m_symbolIndex = 0;
+	m_nbSymbols++;
 
-	if (peak < negpeak * LORA_SQUELCH)
-	{
+	// peak to mean power of noise is about ln(N) = 0.69 * SF
+	if (peak * m_nbSymbolBins <= LORA_SQUELCH * m_spreadFactor * total) {
 		result = -1;
 	}
 
-	result = synch(result);
-
-	if (result >= 0) {
-		m_result = result;
-	}
-
-	return m_result;
+	m_lastSymbol = synch(result);
 }
 
 void LoRaDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-	int newangle;
-	Complex ci;
-
 	m_sampleBuffer.clear();
+	m_mixedSamples.resize(end - begin);
+	std::vector<Complex>::iterator mit = m_mixedSamples.begin();
 
-	for (SampleVector::const_iterator it = begin; it < end; ++it)
+	for (SampleVector::const_iterator it = begin; it < end; ++it, ++mit)
 	{
 		Complex c(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
-		c *= m_nco.nextIQ();
+		*mit = c * m_nco.nextIQ();
+	}
 
-		if (m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
-		{
-			m_chirp = (m_chirp + 1) & (SPREADFACTOR - 1);
-                        m_angle = (m_angle + m_chirp) & (SPREADFACTOR - 1);
-			Complex cangle(cos(M_PI*2*m_angle/SPREADFACTOR),-sin(M_PI*2*m_angle/SPREADFACTOR));
-			newangle = detect(ci, cangle);
-
-			m_bin = (m_bin + newangle) & (LORA_SFFT_LEN - 1);
-			Complex nangle(cos(M_PI*2*m_bin/LORA_SFFT_LEN),sin(M_PI*2*m_bin/LORA_SFFT_LEN));
-			m_sampleBuffer.push_back(Sample(nangle.real() * 100, nangle.imag() * 100));
-			m_sampleDistanceRemain += (Real) m_channelSampleRate / m_Bandwidth;
+	m_interpolator.decimate(&m_sampleDistanceRemain, (Real) m_channelSampleRate / m_Bandwidth, m_mixedSamples.data(), m_mixedSamples.size(), m_resampledSamples);
+
+	for (std::vector<Complex>::const_iterator ci = m_resampledSamples.begin(); ci != m_resampledSamples.end(); ++ci)
+	{
+		m_symbolBuffer[m_symbolIndex++] = *ci;
+
+		if (m_symbolIndex == m_nbSymbolBins) {
+			processSymbol();
 		}
 	}
 
@@ -260,7 +305,7 @@ void LoRaDemodSink::applyChannelSettings(int channelSampleRate, int bandwidth, i
         m_nco.setFreq(-channelFrequencyOffset, channelSampleRate);
     }
 
-    if ((channelSampleRate != m_channelSampleRate) || force)
+    if ((channelSampleRate != m_channelSampleRate) || (bandwidth != m_Bandwidth) || force)
     {
         qDebug() << "LoRaDemodSink::applyChannelSettings: m_interpolator.create";
         m_interpolator.create(16, channelSampleRate, bandwidth / 1.9f);
@@ -282,5 +327,9 @@ void LoRaDemodSink::applySettings(const LoRaDemodSettings& settings, bool force)
             << " m_title: " << settings.m_title
             << " force: " << force;
 
+    if ((settings.m_spread != m_settings.m_spread) || force) {
+        setSpreadFactor(settings.getSpreadFactor());
+    }
+
     m_settings = settings;
 }
@@ -24,11 +24,12 @@
 #include "dsp/nco.h"
 #include "dsp/interpolator.h"
 #include "util/message.h"
-#include "dsp/fftfilt.h"
 
 #include "lorademodsettings.h"
 
 class BasebandSampleSink;
+class FFTEngine;
+class FFTFactory;
 
 class LoRaDemodSink : public ChannelSampleSink {
 public:
@@ -40,41 +41,46 @@ public:
 	void setSpectrumSink(BasebandSampleSink* spectrumSink) { m_spectrumSink = spectrumSink; }
     void applyChannelSettings(int channelSampleRate, int bandwidth, int channelFrequencyOffset, bool force = false);
     void applySettings(const LoRaDemodSettings& settings, bool force = false);
+    unsigned int getNbSymbols() const { return m_nbSymbols; } //!< symbols demodulated so far
+    short getLastSymbol() const { return m_lastSymbol; }        //!< value of the last symbol or -1 if squelched or synchronizing
 
 private:
     LoRaDemodSettings m_settings;
 	Real m_Bandwidth;
     int m_channelSampleRate;
     int m_channelFrequencyOffset;
-	int m_chirp;
-	int m_angle;
-	int m_bin;
-	int m_result;
-	int m_count;
-	int m_header;
 	int m_time;
 	short m_tune;
-
-	sfft* loraFilter;
-	sfft* negaFilter;
-	float* mov;
 	short* history;
-	short* finetune;
+
+	unsigned int m_spreadFactor;
+	unsigned int m_nbSymbolBins;           //!< 2^SF samples per symbol and FFT size
+	std::vector<Complex> m_downChirps;     //!< conjugate of the base chirp over one symbol
+	std::vector<Complex> m_symbolBuffer;   //!< one symbol of samples at the bandwidth rate
+	unsigned int m_symbolIndex;            //!< fill of the symbol buffer
+	std::vector<float> m_magSq;
+	FFTFactory *m_fftFactory;              //!< factory the engine comes from. Null if the engine is owned
+	FFTEngine *m_fft;
+	unsigned int m_fftSequence;
+	unsigned int m_nbSymbols;
+	short m_lastSymbol;
 
 	NCO m_nco;
 	Interpolator m_interpolator;
 	Real m_sampleDistanceRemain;
+	std::vector<Complex> m_mixedSamples;     //!< channel samples shifted by the NCO
+	std::vector<Complex> m_resampledSamples; //!< output of the interpolator at the bandwidth rate
 
 	BasebandSampleSink* m_spectrumSink;
 	SampleVector m_sampleBuffer;
 
     static const int DATA_BITS;
-    static const int SAMPLEBITS;
-    static const int SPREADFACTOR;
-    static const int LORA_SFFT_LEN;
     static const int LORA_SQUELCH;
+    static const int LORA_PREAMBLE_MATCH;
 
-	int  detect(Complex sample, Complex angle);
+	void setSpreadFactor(unsigned int spreadFactor);
+	void releaseFFT();
+	void processSymbol();
 	void dumpRaw(void);
 	short synch (short bin);
 
@@ -30,6 +30,7 @@
 #include "SWGNFMDemodSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGNFMDemodReport.h"
+#include "SWGChannelPerf.h"
 
 #include "dsp/dspengine.h"
 #include "dsp/dspcommands.h"
@@ -54,9 +55,19 @@ NFMDemod::NFMDemod(DeviceAPI *devieAPI) :
     qDebug("NFMDemod::NFMDemod");
 	setObjectName(m_channelId);
 
-    m_thread = new QThread(this);
     m_basebandSink = new NFMDemodBaseband();
-    m_basebandSink->moveToThread(m_thread);
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
+    m_basebandSink->setFilterBankChannelizer(m_deviceAPI->getFilterBankChannelizer());
+
+    if (m_basebandSink->getTask()) // processed by the baseband scheduler
+    {
+        m_thread = nullptr;
+    }
+    else
+    {
+        m_thread = new QThread(this);
+        m_basebandSink->moveToThread(m_thread);
+    }
 
 	applySettings(m_settings, true);
 
@@ -97,14 +108,27 @@ void NFMDemod::start()
     }
 
     m_basebandSink->reset();
-    m_thread->start();
+
+    if (m_thread) {
+        m_thread->start();
+    } else {
+        m_basebandSink->getTask()->start(m_deviceAPI->getDeviceSetIndex());
+    }
 }
 
 void NFMDemod::stop()
 {
     qDebug() << "NFMDemod::stop";
-	m_thread->exit();
-	m_thread->wait();
+
+    if (m_thread)
+    {
+        m_thread->exit();
+        m_thread->wait();
+    }
+    else
+    {
+        m_basebandSink->getTask()->stop();
+    }
 }
 
 bool NFMDemod::handleMessage(const Message& cmd)
@@ -373,6 +397,15 @@ int NFMDemod::webapiReportGet(
     return 200;
 }
 
+int NFMDemod::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
+
 void NFMDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const NFMDemodSettings& settings)
 {
     response.getNfmDemodSettings()->setAfBandwidth(settings.m_afBandwidth);
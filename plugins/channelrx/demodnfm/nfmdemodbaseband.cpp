@@ -18,27 +18,47 @@
 #include <QDebug>
 
 #include "dsp/dspengine.h"
+#include "dsp/basebandscheduler.h"
 #include "dsp/dspcommands.h"
 #include "dsp/downchannelizer.h"
+#include "dsp/filterbankchannelizer.h"
 
 #include "nfmdemodbaseband.h"
 
 MESSAGE_CLASS_DEFINITION(NFMDemodBaseband::MsgConfigureNFMDemodBaseband, Message)
 
 NFMDemodBaseband::NFMDemodBaseband() :
+    m_basebandFifo(nullptr),
+    m_filterBankChannelizer(nullptr),
+    m_subbandFifo(nullptr),
+    m_subband(-1),
+    m_subbandSampleRate(0),
+    m_subbandBasebandSampleRate(0),
+    m_basebandSampleRate(0),
     m_mutex(QMutex::Recursive)
 {
     m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(48000));
+    m_sampleFifo.setLockFree(true);
     m_channelizer = new DownChannelizer(&m_sink);
 
     qDebug("NFMDemodBaseband::NFMDemodBaseband");
-    QObject::connect(
-        &m_sampleFifo,
-        &SampleSinkFifo::dataReady,
-        this,
-        &NFMDemodBaseband::handleData,
-        Qt::QueuedConnection
-    );
+    BasebandScheduler *basebandScheduler = DSPEngine::instance()->getBasebandScheduler();
+
+    if (basebandScheduler) // data processed by the shared workers
+    {
+        m_task = new BasebandTask(basebandScheduler, &m_sampleFifo, [this]() { handleData(); });
+    }
+    else
+    {
+        m_task = nullptr;
+        QObject::connect(
+            &m_sampleFifo,
+            &SampleSinkFifo::dataReady,
+            this,
+            &NFMDemodBaseband::handleData,
+            Qt::QueuedConnection
+        );
+    }
 
     DSPEngine::instance()->getAudioDeviceManager()->addAudioSink(m_sink.getAudioFifo(), getInputMessageQueue());
     m_sink.applyAudioSampleRate(DSPEngine::instance()->getAudioDeviceManager()->getOutputSampleRate());
@@ -48,10 +68,27 @@ NFMDemodBaseband::NFMDemodBaseband() :
 
 NFMDemodBaseband::~NFMDemodBaseband()
 {
+    delete m_task;
     DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(m_sink.getAudioFifo());
+    m_sampleFifo.detachSharedFifo();
+
+    if (m_subbandFifo) {
+        m_filterBankChannelizer->unsubscribe(m_subbandFifo);
+    }
+
     delete m_channelizer;
 }
 
+void NFMDemodBaseband::attachSharedFifo(SampleSinkSharedFifo *sharedFifo)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_basebandFifo = sharedFifo;
+
+    if (!m_subbandFifo) {
+        m_sampleFifo.attachSharedFifo(sharedFifo);
+    }
+}
+
 void NFMDemodBaseband::reset()
 {
     QMutexLocker mutexLocker(&m_mutex);
@@ -120,8 +157,8 @@ bool NFMDemodBaseband::handleMessage(const Message& cmd)
         DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
         qDebug() << "NFMDemodBaseband::handleMessage: DSPSignalNotification: basebandSampleRate: " << notif.getSampleRate();
         m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(notif.getSampleRate()));
-        m_channelizer->setBasebandSampleRate(notif.getSampleRate());
-        m_sink.applyChannelSettings(m_channelizer->getChannelSampleRate(), m_channelizer->getChannelFrequencyOffset());
+        m_basebandSampleRate = notif.getSampleRate();
+        applyChannelization(); // sub-band layout may have changed
 
 		return true;
     }
@@ -133,11 +170,8 @@ bool NFMDemodBaseband::handleMessage(const Message& cmd)
 
 void NFMDemodBaseband::applySettings(const NFMDemodSettings& settings, bool force)
 {
-    if ((settings.m_inputFrequencyOffset != m_settings.m_inputFrequencyOffset) || force)
-    {
-        m_channelizer->setChannelization(m_sink.getAudioSampleRate(), settings.m_inputFrequencyOffset);
-        m_sink.applyChannelSettings(m_channelizer->getChannelSampleRate(), m_channelizer->getChannelFrequencyOffset());
-    }
+    bool channelizationChanged = (settings.m_inputFrequencyOffset != m_settings.m_inputFrequencyOffset)
+        || (settings.m_rfBandwidth != m_settings.m_rfBandwidth) || force; // bandwidth decides if the channel fits in a sub-band
 
     if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
     {
@@ -150,14 +184,88 @@ void NFMDemodBaseband::applySettings(const NFMDemodSettings& settings, bool forc
         if (m_sink.getAudioSampleRate() != audioSampleRate)
         {
             m_sink.applyAudioSampleRate(audioSampleRate);
-            m_channelizer->setChannelization(audioSampleRate, settings.m_inputFrequencyOffset);
-            m_sink.applyChannelSettings(m_channelizer->getChannelSampleRate(), m_channelizer->getChannelFrequencyOffset());
+            channelizationChanged = true;
         }
     }
 
     m_sink.applySettings(settings, force);
 
     m_settings = settings;
+
+    if (channelizationChanged) {
+        applyChannelization();
+    }
+}
+
+void NFMDemodBaseband::applyChannelization()
+{
+    int sampleRate = m_basebandSampleRate;
+    qint64 frequencyOffset = m_settings.m_inputFrequencyOffset;
+    SampleSinkSharedFifo *subbandFifo = nullptr;
+    int subband = -1;
+    int subbandSampleRate = 0;
+    qint64 subbandFrequencyOffset = 0;
+
+    // channelize from the sub-band containing the channel if the device filter bank has one
+    if (m_filterBankChannelizer && m_basebandFifo && (m_basebandSampleRate != 0))
+    {
+        subband = m_filterBankChannelizer->getSubband(
+            m_settings.m_inputFrequencyOffset,
+            (int) m_settings.m_rfBandwidth,
+            subbandSampleRate,
+            subbandFrequencyOffset
+        );
+    }
+
+    // same sample rates and index: same sub-band. Only the residual offset may have changed.
+    bool sameSubband = (subband >= 0) && m_subbandFifo && (subband == m_subband)
+        && (subbandSampleRate == m_subbandSampleRate) && (m_basebandSampleRate == m_subbandBasebandSampleRate);
+
+    if (sameSubband)
+    {
+        subbandFifo = m_subbandFifo;
+    }
+    else
+    {
+        if (subband >= 0)
+        {
+            subbandFifo = m_filterBankChannelizer->subscribe(
+                m_settings.m_inputFrequencyOffset,
+                (int) m_settings.m_rfBandwidth,
+                subbandSampleRate,
+                subbandFrequencyOffset
+            );
+        }
+
+        // subscribe before unsubscribing so that the bank keeps running when moving between sub-bands
+        if (m_subbandFifo) {
+            m_filterBankChannelizer->unsubscribe(m_subbandFifo);
+        }
+
+        m_subbandFifo = subbandFifo;
+        m_subband = subbandFifo ? subband : -1;
+        m_subbandSampleRate = subbandSampleRate;
+        m_subbandBasebandSampleRate = m_basebandSampleRate;
+    }
+
+    if (subbandFifo)
+    {
+        sampleRate = subbandSampleRate;
+        frequencyOffset = subbandFrequencyOffset;
+    }
+
+    SampleSinkSharedFifo *fifo = subbandFifo ? subbandFifo : m_basebandFifo;
+
+    if (m_sampleFifo.getSharedFifo() != fifo) {
+        m_sampleFifo.attachSharedFifo(fifo);
+    }
+
+    if (sampleRate != 0) {
+        m_channelizer->setBasebandSampleRate(sampleRate);
+    }
+
+    m_channelizer->setChannelization(m_sink.getAudioSampleRate(), frequencyOffset);
+    m_sink.applyChannelSettings(m_channelizer->getChannelSampleRate(), m_channelizer->getChannelFrequencyOffset());
 }
 
 int NFMDemodBaseband::getChannelSampleRate() const
@@ -168,6 +276,7 @@ int NFMDemodBaseband::getChannelSampleRate() const
 
 void NFMDemodBaseband::setBasebandSampleRate(int sampleRate)
 {
-    m_channelizer->setBasebandSampleRate(sampleRate);
-    m_sink.applyChannelSettings(m_channelizer->getChannelSampleRate(), m_channelizer->getChannelFrequencyOffset());
+    QMutexLocker mutexLocker(&m_mutex);
+    m_basebandSampleRate = sampleRate;
+    applyChannelization();
 }
\ No newline at end of file
@@ -28,6 +28,9 @@
 #include "nfmdemodsink.h"
 
 class DownChannelizer;
+class BasebandTask;
+class SampleSinkSharedFifo;
+class FilterBankChannelizer;
 
 class NFMDemodBaseband : public QObject
 {
@@ -59,8 +62,12 @@ public:
     NFMDemodBaseband();
     ~NFMDemodBaseband();
     void reset();
+    void attachSharedFifo(SampleSinkSharedFifo *sharedFifo); //!< Read baseband from device engine shared FIFO
+    void setFilterBankChannelizer(FilterBankChannelizer *filterBankChannelizer) { m_filterBankChannelizer = filterBankChannelizer; } //!< Read a sub-band when possible
     void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
+    BasebandTask *getTask() { return m_task; } //!< nullptr if the baseband runs in its own thread
+    SampleSinkFifo& getSampleFifo() { return m_sampleFifo; }
     int getChannelSampleRate() const;
     void getMagSqLevels(double& avg, double& peak, int& nbSamples) { m_sink.getMagSqLevels(avg, peak, nbSamples); }
     void setSelectedCtcssIndex(int selectedCtcssIndex) { m_sink.setSelectedCtcssIndex(selectedCtcssIndex); }
@@ -72,14 +79,23 @@ public:
 
 private:
     SampleSinkFifo m_sampleFifo;
+    SampleSinkSharedFifo *m_basebandFifo;           //!< device engine shared FIFO
+    FilterBankChannelizer *m_filterBankChannelizer; //!< device engine filter bank
+    SampleSinkSharedFifo *m_subbandFifo;            //!< sub-band subscribed to if any
+    int m_subband;                                  //!< index of the sub-band subscribed to or -1
+    int m_subbandSampleRate;
+    int m_subbandBasebandSampleRate;                //!< baseband sample rate at subscription
+    int m_basebandSampleRate;
     DownChannelizer *m_channelizer;
     NFMDemodSink m_sink;
 	MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
+	BasebandTask *m_task;
     NFMDemodSettings m_settings;
     QMutex m_mutex;
 
     bool handleMessage(const Message& cmd);
     void applySettings(const NFMDemodSettings& settings, bool force = false);
+    void applyChannelization();
 
 private slots:
     void handleInputMessages();
@@ -22,6 +22,7 @@
 
 #include "dsp/dsptypes.h"
 #include "util/message.h"
+#include "util/messagepool.h"
 
 class NFMDemodReport : public QObject
 {
@@ -29,6 +30,7 @@ class NFMDemodReport : public QObject
 public:
     class MsgReportCTCSSFreq : public Message {
         MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOL_DECLARATION
 
     public:
         Real getFrequency() const { return m_freq; }
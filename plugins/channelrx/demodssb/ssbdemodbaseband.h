@@ -28,6 +28,7 @@
 #include "ssbdemodsink.h"
 
 class DownChannelizer;
+class BasebandTask;
 
 class SSBDemodBaseband : public QObject
 {
@@ -59,8 +60,11 @@ public:
     SSBDemodBaseband();
     ~SSBDemodBaseband();
     void reset();
+    void attachSharedFifo(SampleSinkSharedFifo *sharedFifo) { m_sampleFifo.attachSharedFifo(sharedFifo); } //!< Read baseband from device engine shared FIFO
     void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
+    BasebandTask *getTask() { return m_task; } //!< nullptr if the baseband runs in its own thread
+    SampleSinkFifo& getSampleFifo() { return m_sampleFifo; }
     int getChannelSampleRate() const;
 	void setSpectrumSink(BasebandSampleSink* spectrumSink) { m_sink.setSpectrumSink(spectrumSink); }
     double getMagSq() const { return m_sink.getMagSq(); }
@@ -75,6 +79,7 @@ private:
     DownChannelizer *m_channelizer;
     SSBDemodSink m_sink;
 	MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
+	BasebandTask *m_task;
     SSBDemodSettings m_settings;
     unsigned int m_audioSampleRate;
     MessageQueue *m_messageQueueToGUI;
@@ -31,6 +31,7 @@
 #include "SWGWFMDemodSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGWFMDemodReport.h"
+#include "SWGChannelPerf.h"
 
 #include "device/deviceapi.h"
 #include "audio/audiooutput.h"
@@ -55,9 +56,18 @@ WFMDemod::WFMDemod(DeviceAPI* deviceAPI) :
 {
 	setObjectName(m_channelId);
 
-    m_thread = new QThread(this);
     m_basebandSink = new WFMDemodBaseband();
-    m_basebandSink->moveToThread(m_thread);
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
+
+    if (m_basebandSink->getTask()) // processed by the baseband scheduler
+    {
+        m_thread = nullptr;
+    }
+    else
+    {
+        m_thread = new QThread(this);
+        m_basebandSink->moveToThread(m_thread);
+    }
 
 	applySettings(m_settings, true);
 
@@ -99,14 +109,27 @@ void WFMDemod::start()
     }
 
     m_basebandSink->reset();
-    m_thread->start();
+
+    if (m_thread) {
+        m_thread->start();
+    } else {
+        m_basebandSink->getTask()->start(m_deviceAPI->getDeviceSetIndex());
+    }
 }
 
 void WFMDemod::stop()
 {
     qDebug() << "WFMDemod::stop";
-	m_thread->exit();
-	m_thread->wait();
+
+    if (m_thread)
+    {
+        m_thread->exit();
+        m_thread->wait();
+    }
+    else
+    {
+        m_basebandSink->getTask()->stop();
+    }
 }
 
 bool WFMDemod::handleMessage(const Message& cmd)
@@ -335,6 +358,15 @@ int WFMDemod::webapiReportGet(
     return 200;
 }
 
+int WFMDemod::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
+
 void WFMDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const WFMDemodSettings& settings)
 {
     response.getWfmDemodSettings()->setInputFrequencyOffset(settings.m_inputFrequencyOffset);
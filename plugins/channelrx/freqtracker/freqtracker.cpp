@@ -32,6 +32,7 @@
 #include "SWGFreqTrackerSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGFreqTrackerReport.h"
+#include "SWGChannelPerf.h"
 
 #include "audio/audiooutput.h"
 #include "dsp/dspengine.h"
@@ -59,6 +60,7 @@ FreqTracker::FreqTracker(DeviceAPI *deviceAPI) :
 
     m_thread = new QThread(this);
     m_basebandSink = new FreqTrackerBaseband();
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
     propagateMessageQueue(getInputMessageQueue());
     m_basebandSink->moveToThread(m_thread);
 
@@ -398,6 +400,15 @@ int FreqTracker::webapiReportGet(
     return 200;
 }
 
+int FreqTracker::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
+
 void FreqTracker::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const FreqTrackerSettings& settings)
 {
     response.getFreqTrackerSettings()->setInputFrequencyOffset(settings.m_inputFrequencyOffset);
@@ -30,6 +30,7 @@ FreqTrackerBaseband::FreqTrackerBaseband() :
     m_mutex(QMutex::Recursive)
 {
     m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(48000));
+    m_sampleFifo.setLockFree(true);
     m_channelizer = new DownChannelizer(&m_sink);
 
     qDebug("FreqTrackerBaseband::FreqTrackerBaseband");
@@ -19,6 +19,7 @@
 
 MESSAGE_CLASS_DEFINITION(FreqTrackerReport::MsgConfigureChannelizer, Message)
 MESSAGE_CLASS_DEFINITION(FreqTrackerReport::MsgSinkFrequencyOffsetNotification, Message)
+MESSAGE_CLASS_POOL_DEFINITION(FreqTrackerReport::MsgSinkFrequencyOffsetNotification)
 
 FreqTrackerReport::FreqTrackerReport()
 {}
@@ -19,6 +19,7 @@
 #define INCLUDE_FREQTRACKERREPORT_H
 
 #include "util/message.h"
+#include "util/messagepool.h"
 
 class FreqTrackerReport
 {
@@ -48,6 +49,7 @@ public:
 
     class MsgSinkFrequencyOffsetNotification : public Message {
         MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOL_DECLARATION
 
     public:
         static MsgSinkFrequencyOffsetNotification* create(int frequencyOffset) {
@@ -24,6 +24,7 @@
 #include <QBuffer>
 
 #include "SWGChannelSettings.h"
+#include "SWGChannelPerf.h"
 
 #include "util/simpleserializer.h"
 #include "dsp/dspcommands.h"
@@ -54,6 +55,7 @@ LocalSink::LocalSink(DeviceAPI *deviceAPI) :
 
     m_thread = new QThread(this);
     m_basebandSink = new LocalSinkBaseband();
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
     m_basebandSink->moveToThread(m_thread);
 
     applySettings(m_settings, true);
@@ -358,6 +360,15 @@ int LocalSink::webapiSettingsPutPatch(
     return 200;
 }
 
+int LocalSink::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
+
 void LocalSink::webapiUpdateChannelSettings(
         LocalSinkSettings& settings,
         const QStringList& channelSettingsKeys,
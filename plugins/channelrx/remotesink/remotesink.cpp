@@ -29,6 +29,7 @@
 #include <QThread>
 
 #include "SWGChannelSettings.h"
+#include "SWGChannelPerf.h"
 
 #include "util/simpleserializer.h"
 #include "dsp/dspcommands.h"
@@ -54,6 +55,7 @@ RemoteSink::RemoteSink(DeviceAPI *deviceAPI) :
 
     m_thread = new QThread(this);
     m_basebandSink = new RemoteSinkBaseband();
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
     m_basebandSink->moveToThread(m_thread);
 
     applySettings(m_settings, true);
@@ -171,6 +173,7 @@ void RemoteSink::applySettings(const RemoteSinkSettings& settings, bool force)
     qDebug() << "RemoteSink::applySettings:"
             << " m_nbFECBlocks: " << settings.m_nbFECBlocks
             << " m_txDelay: " << settings.m_txDelay
+            << " m_blockSize: " << settings.m_blockSize
             << " m_dataAddress: " << settings.m_dataAddress
             << " m_dataPort: " << settings.m_dataPort
             << " m_streamIndex: " << settings.m_streamIndex
@@ -185,6 +188,9 @@ void RemoteSink::applySettings(const RemoteSinkSettings& settings, bool force)
     if ((m_settings.m_txDelay != settings.m_txDelay) || force) {
         reverseAPIKeys.append("txDelay");
     }
+    if ((m_settings.m_blockSize != settings.m_blockSize) || force) {
+        reverseAPIKeys.append("blockSize");
+    }
     if ((m_settings.m_dataAddress != settings.m_dataAddress) || force) {
         reverseAPIKeys.append("dataAddress");
     }
@@ -297,6 +303,15 @@ int RemoteSink::webapiSettingsPutPatch(
     return 200;
 }
 
+int RemoteSink::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
+
 void RemoteSink::webapiUpdateChannelSettings(
         RemoteSinkSettings& settings,
         const QStringList& channelSettingsKeys,
@@ -324,6 +339,17 @@ void RemoteSink::webapiUpdateChannelSettings(
         }
     }
 
+    if (channelSettingsKeys.contains("blockSize"))
+    {
+        int blockSize = response.getRemoteSinkSettings()->getBlockSize();
+
+        if (isRemoteBlockSizeValid(blockSize)) {
+            settings.m_blockSize = blockSize;
+        } else {
+            settings.m_blockSize = RemoteUdpSize;
+        }
+    }
+
     if (channelSettingsKeys.contains("dataAddress")) {
         settings.m_dataAddress = *response.getRemoteSinkSettings()->getDataAddress();
     }
@@ -380,6 +406,7 @@ void RemoteSink::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& re
 {
     response.getRemoteSinkSettings()->setNbFecBlocks(settings.m_nbFECBlocks);
     response.getRemoteSinkSettings()->setTxDelay(settings.m_txDelay);
+    response.getRemoteSinkSettings()->setBlockSize(settings.m_blockSize);
 
     if (response.getRemoteSinkSettings()->getDataAddress()) {
         *response.getRemoteSinkSettings()->getDataAddress() = settings.m_dataAddress;
@@ -431,6 +458,9 @@ void RemoteSink::webapiReverseSendSettings(QList<QString>& channelSettingsKeys,
     {
         swgRemoteSinkSettings->setTxDelay(settings.m_txDelay);
     }
+    if (channelSettingsKeys.contains("blockSize") || force) {
+        swgRemoteSinkSettings->setBlockSize(settings.m_blockSize);
+    }
     if (channelSettingsKeys.contains("dataAddress") || force) {
         swgRemoteSinkSettings->setDataAddress(new QString(settings.m_dataAddress));
     }
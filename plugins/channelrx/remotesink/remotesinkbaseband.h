@@ -61,11 +61,13 @@ public:
     ~RemoteSinkBaseband();
 
     void reset();
+    void attachSharedFifo(SampleSinkSharedFifo *sharedFifo) { m_sampleFifo.attachSharedFifo(sharedFifo); } //!< Read baseband from device engine shared FIFO
 	void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
     void startSender() { m_sink.startSender(); }
     void stopSender() { m_sink.stopSender(); }
 
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
+    SampleSinkFifo& getSampleFifo() { return m_sampleFifo; }
     int getChannelSampleRate() const;
     void setBasebandSampleRate(int sampleRate);
 
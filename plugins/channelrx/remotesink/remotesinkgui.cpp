@@ -192,12 +192,27 @@ void RemoteSinkGUI::displaySettings()
     ui->nominalNbBlocksText->setText(tr("%1/%2").arg(s).arg(s1));
     ui->txDelayText->setText(tr("%1%").arg(m_settings.m_txDelay));
     ui->txDelay->setValue(m_settings.m_txDelay);
+    displayBlockSize();
     updateTxDelayTime();
     applyDecimation();
     displayStreamIndex();
     blockApplySettings(false);
 }
 
+void RemoteSinkGUI::displayBlockSize()
+{
+    QString blockSizeStr = QString::number(m_settings.m_blockSize);
+    int index = ui->blockSize->findText(blockSizeStr);
+
+    if (index < 0) // size set through the API
+    {
+        ui->blockSize->addItem(blockSizeStr);
+        index = ui->blockSize->count() - 1;
+    }
+
+    ui->blockSize->setCurrentIndex(index);
+}
+
 void RemoteSinkGUI::displayStreamIndex()
 {
     if (m_deviceUISet->m_deviceMIMOEngine) {
@@ -364,10 +379,17 @@ void RemoteSinkGUI::on_nbFECBlocks_valueChanged(int value)
     applySettings();
 }
 
+void RemoteSinkGUI::on_blockSize_currentIndexChanged(int index)
+{
+    m_settings.m_blockSize = ui->blockSize->itemText(index).toUInt();
+    updateTxDelayTime();
+    applySettings();
+}
+
 void RemoteSinkGUI::updateTxDelayTime()
 {
     double txDelayRatio = m_settings.m_txDelay / 100.0;
-    int samplesPerBlock = RemoteNbBytesPerBlock / sizeof(Sample);
+    int samplesPerBlock = (m_settings.m_blockSize - sizeof(RemoteHeader)) / sizeof(Sample);
     int channelSampleRate = m_basebandSampleRate / (1<<m_settings.m_log2Decim);
     double delay = channelSampleRate == 0 ? 0.0 : (127*samplesPerBlock*txDelayRatio) / channelSampleRate;
     delay /= 128 + m_settings.m_nbFECBlocks;
@@ -78,6 +78,7 @@ private:
     void applySettings(bool force = false);
     void displaySettings();
     void displayStreamIndex();
+    void displayBlockSize();
     void displayRateAndShift();
     void updateTxDelayTime();
 
@@ -96,6 +97,7 @@ private slots:
     void on_dataApplyButton_clicked(bool checked);
     void on_nbFECBlocks_valueChanged(int value);
     void on_txDelay_valueChanged(int value);
+    void on_blockSize_currentIndexChanged(int index);
     void onWidgetRolled(QWidget* widget, bool rollDown);
     void onMenuDialogCalled(const QPoint& p);
     void tick();
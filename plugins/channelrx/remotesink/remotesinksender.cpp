@@ -24,22 +24,38 @@
 
 #include <thread>
 #include <chrono>
+#include <algorithm>
 
 #include <QUdpSocket>
 
 #include "cm256cc/cm256.h"
 
 #include "channel/remotedatablock.h"
+#include "util/udpbatch.h"
 #include "remotesinksender.h"
 
 RemoteSinkSender::RemoteSinkSender() :
     m_fifo(20, this),
     m_address(QHostAddress::LocalHost),
-    m_socket(nullptr)
+    m_socket(nullptr),
+    m_sendErrors(0),
+    m_statsStartNs(0),
+    m_statsFrames(0),
+    m_statsFECFrames(0),
+    m_statsFECLatencyNs(0)
 {
-    qDebug("RemoteSinkSender::RemoteSinkSender");
+    qDebug("RemoteSinkSender::RemoteSinkSender: %d FEC encoding workers", m_encoderPool.getNbWorkers());
     m_cm256p = m_cm256.isInitialized() ? &m_cm256 : nullptr;
+    m_workerCM256 = new CM256[m_encoderPool.getNbWorkers()];
+    m_workerFECBlocks = new std::vector<uint8_t>[m_encoderPool.getNbWorkers()];
     m_socket = new QUdpSocket(this);
+    m_clock.start();
+
+    for (unsigned int i = 0; i < m_maxPendingFrames; i++)
+    {
+        m_frameBlocks.push_back(new RemoteDataBlock());
+        m_freeFrameBlocks.push_back(m_frameBlocks.back());
+    }
 
     QObject::connect(
         &m_fifo,
@@ -53,6 +69,14 @@ RemoteSinkSender::RemoteSinkSender() :
 RemoteSinkSender::~RemoteSinkSender()
 {
     qDebug("RemoteSinkSender::~RemoteSinkSender");
+    m_encoderPool.waitAll(); // jobs use the pending frames and the worker encoders
+
+    for (std::vector<RemoteDataBlock*>::iterator it = m_frameBlocks.begin(); it != m_frameBlocks.end(); ++it) {
+        delete *it;
+    }
+
+    delete[] m_workerFECBlocks;
+    delete[] m_workerCM256;
     delete m_socket;
 }
 
@@ -64,88 +88,185 @@ RemoteDataBlock *RemoteSinkSender::getDataBlock()
 void RemoteSinkSender::handleData()
 {
     RemoteDataBlock *dataBlock;
-    unsigned int remainder = m_fifo.getRemainder();
 
-    while (remainder != 0)
+    while (true)
     {
-        remainder = m_fifo.readDataBlock(&dataBlock);
+        // frames available are copied out of the FIFO and encoded in parallel while the oldest is sent
+        while (!m_freeFrameBlocks.empty() && (m_fifo.getRemainder() != 0))
+        {
+            m_fifo.readDataBlock(&dataBlock);
+
+            if (dataBlock) {
+                queueDataBlock(dataBlock);
+            }
+        }
 
-        if (dataBlock) {
-            sendDataBlock(dataBlock);
+        if (m_pendingFrames.empty()) {
+            break;
         }
+
+        PendingFrame& frame = m_pendingFrames.front();
+
+        if (frame.m_fec) {
+            m_encoderPool.wait(frame.m_job);
+        }
+
+        sendDataBlock(frame);
+        m_freeFrameBlocks.push_back(frame.m_dataBlock);
+        m_pendingFrames.pop_front();
     }
 }
 
-void RemoteSinkSender::sendDataBlock(RemoteDataBlock *dataBlock)
+void RemoteSinkSender::queueDataBlock(RemoteDataBlock *fifoDataBlock)
+{
+    // the producer overwrites FIFO blocks without waiting: encode and send a copy. FEC blocks are
+    // computed in the copy so only the original blocks are copied.
+    RemoteDataBlock *dataBlock = m_freeFrameBlocks.back();
+    m_freeFrameBlocks.pop_back();
+    dataBlock->setBlockSize(fifoDataBlock->getBlockSize());
+    dataBlock->m_txControlBlock = fifoDataBlock->m_txControlBlock;
+    std::copy(
+        (const uint8_t*) fifoDataBlock->getSuperBlock(0),
+        (const uint8_t*) fifoDataBlock->getSuperBlock(RemoteNbOrginalBlocks),
+        (uint8_t*) dataBlock->getSuperBlock(0)
+    );
+
+    m_pendingFrames.push_back(PendingFrame());
+    PendingFrame *frame = &m_pendingFrames.back(); // deque elements do not move when adding or removing at ends
+    frame->m_dataBlock = dataBlock;
+    frame->m_fec = (dataBlock->m_txControlBlock.m_nbBlocksFEC != 0) && m_cm256p;
+    frame->m_job = 0;
+    frame->m_queuedNs = m_clock.nsecsElapsed();
+    frame->m_encodedNs = frame->m_queuedNs;
+
+    if (frame->m_fec)
+    {
+        frame->m_job = m_encoderPool.push([this, frame](int workerIndex) {
+            encodeDataBlock(frame->m_dataBlock, workerIndex);
+            frame->m_encodedNs = m_clock.nsecsElapsed();
+        });
+    }
+}
+
+void RemoteSinkSender::encodeDataBlock(RemoteDataBlock *dataBlock, int workerIndex)
 {
 	CM256::cm256_encoder_params cm256Params;  //!< Main interface with CM256 encoder
 	CM256::cm256_block descriptorBlocks[256]; //!< Pointers to data for CM256 encoder
-	RemoteProtectedBlock fecBlocks[256];   //!< FEC data
 
     uint16_t frameIndex = dataBlock->m_txControlBlock.m_frameIndex;
-    int nbBlocksFEC = dataBlock->m_txControlBlock.m_nbBlocksFEC;
+    int protectedBytes = dataBlock->getProtectedBytes();
+    std::vector<uint8_t>& fecBlocks = m_workerFECBlocks[workerIndex];
+
+    cm256Params.BlockBytes = protectedBytes;
+    cm256Params.OriginalCount = RemoteNbOrginalBlocks;
+    cm256Params.RecoveryCount = dataBlock->m_txControlBlock.m_nbBlocksFEC;
+
+    if (fecBlocks.size() < (std::size_t) (cm256Params.RecoveryCount * protectedBytes)) {
+        fecBlocks.resize(cm256Params.RecoveryCount * protectedBytes);
+    }
+
+    // Fill pointers to data
+    for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; ++i)
+    {
+        RemoteSuperBlock *superBlock = dataBlock->getSuperBlock(i);
+
+        if (i >= cm256Params.OriginalCount) {
+            memset((void *) dataBlock->getProtectedData(i), 0, protectedBytes);
+        }
+
+        superBlock->m_header.m_frameIndex = frameIndex;
+        superBlock->m_header.m_blockIndex = i;
+        superBlock->m_header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
+        superBlock->m_header.m_sampleBits = SDR_RX_SAMP_SZ;
+        descriptorBlocks[i].Block = (void *) dataBlock->getProtectedData(i);
+        descriptorBlocks[i].Index = superBlock->m_header.m_blockIndex;
+    }
+
+    // Encode FEC blocks
+    if (m_workerCM256[workerIndex].cm256_encode(cm256Params, descriptorBlocks, fecBlocks.data()))
+    {
+        qWarning("RemoteSinkSender::encodeDataBlock: CM256 encode failed. No transmission.");
+        // TODO: send without FEC changing meta data to set indication of no FEC
+    }
+
+    // Merge FEC with data to transmit
+    for (int i = 0; i < cm256Params.RecoveryCount; i++)
+    {
+        memcpy((void *) dataBlock->getProtectedData(i + cm256Params.OriginalCount), &fecBlocks[i * protectedBytes], protectedBytes);
+    }
+}
+
+void RemoteSinkSender::sendDataBlock(const PendingFrame& frame)
+{
+    RemoteDataBlock *dataBlock = frame.m_dataBlock;
+    int nbBlocksFEC = frame.m_fec ? dataBlock->m_txControlBlock.m_nbBlocksFEC : 0;
     int txDelay = dataBlock->m_txControlBlock.m_txDelay;
     m_address.setAddress(dataBlock->m_txControlBlock.m_dataAddress);
     uint16_t dataPort = dataBlock->m_txControlBlock.m_dataPort;
-    RemoteSuperBlock *txBlockx = dataBlock->m_superBlocks;
 
-    if ((nbBlocksFEC == 0) || !m_cm256p) // Do not FEC encode
+    // Transmit all blocks
+    sendBlocks(dataBlock, RemoteNbOrginalBlocks + nbBlocksFEC, txDelay, dataPort);
+    dataBlock->m_txControlBlock.m_processed = true;
+
+    m_statsFrames++;
+
+    if (frame.m_fec)
     {
-        if (m_socket)
-        {
-            for (int i = 0; i < RemoteNbOrginalBlocks; i++)
-            {
-                // send block via UDP
-                m_socket->writeDatagram((const char*)&txBlockx[i], (qint64 ) RemoteUdpSize, m_address, dataPort);
-                std::this_thread::sleep_for(std::chrono::microseconds(txDelay));
-            }
-        }
+        m_statsFECFrames++;
+        m_statsFECLatencyNs += frame.m_encodedNs - frame.m_queuedNs;
     }
-    else
+
+    qint64 nowNs = m_clock.nsecsElapsed();
+
+    if (nowNs - m_statsStartNs >= m_statsPeriodNs)
     {
-        cm256Params.BlockBytes = sizeof(RemoteProtectedBlock);
-        cm256Params.OriginalCount = RemoteNbOrginalBlocks;
-        cm256Params.RecoveryCount = nbBlocksFEC;
+        qDebug("RemoteSinkSender::sendDataBlock: %.1f frames/s FEC: %u frames latency: %lld us",
+            (m_statsFrames * 1e9) / (nowNs - m_statsStartNs),
+            m_statsFECFrames,
+            m_statsFECFrames == 0 ? 0LL : (m_statsFECLatencyNs / m_statsFECFrames) / 1000);
+        m_statsStartNs = nowNs;
+        m_statsFrames = 0;
+        m_statsFECFrames = 0;
+        m_statsFECLatencyNs = 0;
+    }
+}
 
-        // Fill pointers to data
-        for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; ++i)
-        {
-            if (i >= cm256Params.OriginalCount) {
-                memset((void *) &txBlockx[i].m_protectedBlock, 0, sizeof(RemoteProtectedBlock));
-            }
+void RemoteSinkSender::sendBlocks(RemoteDataBlock *dataBlock, int nbBlocks, int txDelay, uint16_t dataPort)
+{
+    int blockSize = dataBlock->getBlockSize();
 
-            txBlockx[i].m_header.m_frameIndex = frameIndex;
-            txBlockx[i].m_header.m_blockIndex = i;
-            txBlockx[i].m_header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
-            txBlockx[i].m_header.m_sampleBits = SDR_RX_SAMP_SZ;
-            descriptorBlocks[i].Block = (void *) &(txBlockx[i].m_protectedBlock);
-            descriptorBlocks[i].Index = txBlockx[i].m_header.m_blockIndex;
-        }
+    if (!m_socket) {
+        return;
+    }
 
-        // Encode FEC blocks
-        if (m_cm256p->cm256_encode(cm256Params, descriptorBlocks, fecBlocks))
-        {
-            qWarning("RemoteSinkSender::handleDataBlock: CM256 encode failed. No transmission.");
-            // TODO: send without FEC changing meta data to set indication of no FEC
-        }
+    if (UDPBatch::isBatchSupported())
+    {
+        // Send blocks by groups so that the delay between groups is long enough to be slept accurately.
+        // The average rate is the same as with the delay between each block.
+        int groupSize = txDelay <= 0 ? nbBlocks : (m_minGroupDelayUs + txDelay - 1) / txDelay;
+        groupSize = std::max(1, std::min(groupSize, nbBlocks));
 
-        // Merge FEC with data to transmit
-        for (int i = 0; i < cm256Params.RecoveryCount; i++)
+        for (int i = 0; i < nbBlocks; i += groupSize)
         {
-            txBlockx[i + cm256Params.OriginalCount].m_protectedBlock = fecBlocks[i];
-        }
+            int nbGroupBlocks = std::min(groupSize, nbBlocks - i);
+            int sent = UDPBatch::writeDatagrams(m_socket, (const char*) dataBlock->getSuperBlock(i), blockSize, nbGroupBlocks, m_address, dataPort);
 
-        // Transmit all blocks
-        if (m_socket)
-        {
-            for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; i++)
-            {
-                // send block via UDP
-                m_socket->writeDatagram((const char*)&txBlockx[i], (qint64 ) RemoteUdpSize, m_address, dataPort);
-                std::this_thread::sleep_for(std::chrono::microseconds(txDelay));
+            if ((sent != nbGroupBlocks) && (m_sendErrors++ % 1000 == 0)) {
+                qWarning("RemoteSinkSender::sendBlocks: %d of %d blocks sent", sent, nbGroupBlocks);
+            }
+
+            if (txDelay > 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(txDelay * nbGroupBlocks));
             }
         }
     }
-
-    dataBlock->m_txControlBlock.m_processed = true;
+    else
+    {
+        for (int i = 0; i < nbBlocks; i++)
+        {
+            // send block via UDP
+            m_socket->writeDatagram((const char*) dataBlock->getSuperBlock(i), (qint64 ) blockSize, m_address, dataPort);
+            std::this_thread::sleep_for(std::chrono::microseconds(txDelay));
+        }
+    }
 }
@@ -24,15 +24,20 @@
 #ifndef PLUGINS_CHANNELRX_REMOTESINK_REMOTESINKSENDER_H_
 #define PLUGINS_CHANNELRX_REMOTESINK_REMOTESINKSENDER_H_
 
+#include <vector>
+#include <deque>
+
 #include <QObject>
 #include <QMutex>
 #include <QWaitCondition>
 #include <QHostAddress>
+#include <QElapsedTimer>
 
 #include "cm256cc/cm256.h"
 
 #include "util/message.h"
 #include "util/messagequeue.h"
+#include "util/orderedworkerpool.h"
 
 #include "remotesinkfifo.h"
 
@@ -50,14 +55,43 @@ public:
     RemoteDataBlock *getDataBlock();
 
 private:
+    struct PendingFrame
+    {
+        RemoteDataBlock *m_dataBlock; //!< copy of the FIFO block owned by the sender
+        bool m_fec;          //!< FEC encoding job pushed
+        quint64 m_job;       //!< sequence of the encoding job
+        qint64 m_queuedNs;   //!< time the frame was queued
+        qint64 m_encodedNs;  //!< time the encoding ended
+    };
+
     RemoteSinkFifo m_fifo;
     CM256 m_cm256;
     CM256 *m_cm256p;
+    OrderedWorkerPool m_encoderPool;
+    CM256 *m_workerCM256;                   //!< encoder of each worker
+    std::vector<uint8_t> *m_workerFECBlocks; //!< FEC blocks output of the encoder of each worker
+    std::deque<PendingFrame> m_pendingFrames; //!< frames in the fifo order being encoded or waiting to be sent
+    std::vector<RemoteDataBlock*> m_frameBlocks;     //!< storage of the pending frames
+    std::vector<RemoteDataBlock*> m_freeFrameBlocks; //!< frame storage not pending
 
     QHostAddress m_address;
     QUdpSocket *m_socket;
+    unsigned int m_sendErrors;
+
+    QElapsedTimer m_clock;
+    qint64 m_statsStartNs;
+    unsigned int m_statsFrames;
+    unsigned int m_statsFECFrames;
+    qint64 m_statsFECLatencyNs;
+
+    static const int m_minGroupDelayUs = 500; //!< minimum delay between groups of blocks sent at once
+    static const unsigned int m_maxPendingFrames = 8; //!< well below the FIFO size so that its blocks are copied before being reused
+    static const qint64 m_statsPeriodNs = 10000000000LL;
 
-    void sendDataBlock(RemoteDataBlock *dataBlock);
+    void queueDataBlock(RemoteDataBlock *fifoDataBlock);
+    void encodeDataBlock(RemoteDataBlock *dataBlock, int workerIndex);
+    void sendDataBlock(const PendingFrame& frame);
+    void sendBlocks(RemoteDataBlock *dataBlock, int nbBlocks, int txDelay, uint16_t dataPort);
 
 private slots:
     void handleData();
@@ -26,6 +26,7 @@
 #include <QColor>
 
 #include "util/simpleserializer.h"
+#include "channel/remotedatablock.h"
 #include "settings/serializable.h"
 
 
@@ -38,6 +39,7 @@ void RemoteSinkSettings::resetToDefaults()
 {
     m_nbFECBlocks = 0;
     m_txDelay = 35;
+    m_blockSize = RemoteUdpSize;
     m_dataAddress = "127.0.0.1";
     m_dataPort = 9090;
     m_rgbColor = QColor(140, 4, 4).rgb();
@@ -70,6 +72,7 @@ QByteArray RemoteSinkSettings::serialize() const
     s.writeU32(12, m_log2Decim);
     s.writeU32(13, m_filterChainHash);
     s.writeS32(14, m_streamIndex);
+    s.writeU32(15, m_blockSize);
 
     return s.final();
 }
@@ -127,6 +130,8 @@ bool RemoteSinkSettings::deserialize(const QByteArray& data)
         m_log2Decim = tmp > 6 ? 6 : tmp;
         d.readU32(13, &m_filterChainHash, 0);
         d.readS32(14, &m_streamIndex, 0);
+        d.readU32(15, &tmp, RemoteUdpSize);
+        m_blockSize = isRemoteBlockSizeValid(tmp) ? tmp : RemoteUdpSize;
 
         return true;
     }
@@ -33,6 +33,7 @@ struct RemoteSinkSettings
 {
     uint16_t m_nbFECBlocks;
     uint32_t m_txDelay;
+    uint32_t m_blockSize; //!< datagram size in bytes
     QString  m_dataAddress;
     uint16_t m_dataPort;
     quint32 m_rgbColor;
@@ -37,6 +37,7 @@ RemoteSinkSink::RemoteSinkSink() :
         m_basebandSampleRate(48000),
         m_nbBlocksFEC(0),
         m_txDelay(35),
+        m_blockSize(RemoteUdpSize),
         m_dataAddress("127.0.0.1"),
         m_dataPort(9090)
 {
@@ -70,10 +71,10 @@ void RemoteSinkSink::stopSender()
 	m_senderThread->wait();
 }
 
-void RemoteSinkSink::setTxDelay(int txDelay, int nbBlocksFEC, int log2Decim)
+void RemoteSinkSink::setTxDelay(int txDelay, int nbBlocksFEC, int log2Decim, int blockSize)
 {
     double txDelayRatio = txDelay / 100.0;
-    int samplesPerBlock = RemoteNbBytesPerBlock / sizeof(Sample);
+    int samplesPerBlock = (blockSize - sizeof(RemoteHeader)) / sizeof(Sample);
     int sampleRate = m_basebandSampleRate / (1<<log2Decim);
     double delay = sampleRate == 0 ? 1.0 : (127*samplesPerBlock*txDelayRatio) / sampleRate;
     delay /= 128 + nbBlocksFEC;
@@ -81,7 +82,8 @@ void RemoteSinkSink::setTxDelay(int txDelay, int nbBlocksFEC, int log2Decim)
     qDebug() << "RemoteSinkSink::setTxDelay:"
         << "txDelay:" << txDelay << "%"
         << "m_txDelay:" << m_txDelay << "us"
-        << "sampleRate: " << sampleRate << "S/s";
+        << "sampleRate: " << sampleRate << "S/s"
+        << "blockSize: " << blockSize;
 }
 
 void RemoteSinkSink::setNbBlocksFEC(int nbBlocksFEC)
@@ -114,22 +116,26 @@ void RemoteSinkSink::feed(const SampleVector::const_iterator& begin, const Sampl
             metaData.m_nbFECBlocks = m_nbBlocksFEC;
             metaData.m_tv_sec = nowus / 1000000UL;  // tv.tv_sec;
             metaData.m_tv_usec = nowus % 1000000UL; // tv.tv_usec;
+            metaData.m_blockSize = m_blockSize;
 
             if (!m_dataBlock) { // on the very first cycle there is no data block allocated
                 m_dataBlock = m_remoteSinkSender->getDataBlock(); // ask a new block to sender
             }
 
+            m_dataBlock->setBlockSize(m_blockSize); // block size changes on frame boundaries only
             boost::crc_32_type crc32;
-            crc32.process_bytes(&metaData, sizeof(RemoteMetaDataFEC)-4);
+            crc32.process_bytes(&metaData, RemoteMetaDataFEC::getCRCBytes());
             metaData.m_crc32 = crc32.checksum();
-            RemoteSuperBlock& superBlock = m_dataBlock->m_superBlocks[0]; // first block
-            superBlock.init();
-            superBlock.m_header.m_frameIndex = m_frameCount;
-            superBlock.m_header.m_blockIndex = m_txBlockIndex;
-            superBlock.m_header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
-            superBlock.m_header.m_sampleBits = SDR_RX_SAMP_SZ;
-
-            RemoteMetaDataFEC *destMeta = (RemoteMetaDataFEC *) &superBlock.m_protectedBlock;
+            RemoteSuperBlock *superBlock = m_dataBlock->getSuperBlock(0); // first block
+            superBlock->m_header.init();
+            superBlock->m_header.m_frameIndex = m_frameCount;
+            superBlock->m_header.m_blockIndex = m_txBlockIndex;
+            superBlock->m_header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
+            superBlock->m_header.m_sampleBits = SDR_RX_SAMP_SZ;
+
+            uint8_t *protectedData = m_dataBlock->getProtectedData(0);
+            std::fill(protectedData, protectedData + m_dataBlock->getProtectedBytes(), 0);
+            RemoteMetaDataFEC *destMeta = (RemoteMetaDataFEC *) protectedData;
             *destMeta = metaData;
 
             if (!(metaData == m_currentMetaFEC))
@@ -141,6 +147,7 @@ void RemoteSinkSink::feed(const SampleVector::const_iterator& begin, const Sampl
                         << ":" << (int) metaData.m_sampleBits
                         << "|" << (int) metaData.m_nbOriginalBlocks
                         << ":" << (int) metaData.m_nbFECBlocks
+                        << ":" << metaData.m_blockSize
                         << "|" << metaData.m_tv_sec
                         << ":" << metaData.m_tv_usec;
 
@@ -151,10 +158,12 @@ void RemoteSinkSink::feed(const SampleVector::const_iterator& begin, const Sampl
         } // block zero
 
         // handle different sample sizes...
-        int samplesPerBlock = RemoteNbBytesPerBlock / (SDR_RX_SAMP_SZ <= 16 ? 4 : 8); // two I or Q samples
+        int samplesPerBlock = m_dataBlock->getProtectedBytes() / (SDR_RX_SAMP_SZ <= 16 ? 4 : 8); // two I or Q samples
+        uint8_t *protectedData = m_dataBlock->getProtectedData(m_txBlockIndex); // samples go directly to the frame block
+
         if (m_sampleIndex + inRemainingSamples < samplesPerBlock) // there is still room in the current super block
         {
-            memcpy((void *) &m_superBlock.m_protectedBlock.buf[m_sampleIndex*sizeof(Sample)],
+            memcpy((void *) &protectedData[m_sampleIndex*sizeof(Sample)],
                     (const void *) &(*(begin+inSamplesIndex)),
                     inRemainingSamples * sizeof(Sample));
             m_sampleIndex += inRemainingSamples;
@@ -162,17 +171,18 @@ void RemoteSinkSink::feed(const SampleVector::const_iterator& begin, const Sampl
         }
         else // complete super block and initiate the next if not end of frame
         {
-            memcpy((void *) &m_superBlock.m_protectedBlock.buf[m_sampleIndex*sizeof(Sample)],
+            memcpy((void *) &protectedData[m_sampleIndex*sizeof(Sample)],
                     (const void *) &(*(begin+inSamplesIndex)),
                     (samplesPerBlock - m_sampleIndex) * sizeof(Sample));
             it += samplesPerBlock - m_sampleIndex;
             m_sampleIndex = 0;
 
-            m_superBlock.m_header.m_frameIndex = m_frameCount;
-            m_superBlock.m_header.m_blockIndex = m_txBlockIndex;
-            m_superBlock.m_header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
-            m_superBlock.m_header.m_sampleBits = SDR_RX_SAMP_SZ;
-            m_dataBlock->m_superBlocks[m_txBlockIndex] = m_superBlock;
+            RemoteHeader& header = m_dataBlock->getSuperBlock(m_txBlockIndex)->m_header;
+            header.init();
+            header.m_frameIndex = m_frameCount;
+            header.m_blockIndex = m_txBlockIndex;
+            header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
+            header.m_sampleBits = SDR_RX_SAMP_SZ;
 
             if (m_txBlockIndex == RemoteNbOrginalBlocks - 1) // frame complete
             {
@@ -202,6 +212,7 @@ void RemoteSinkSink::applySettings(const RemoteSinkSettings& settings, bool forc
     qDebug() << "RemoteSinkSink::applySettings:"
             << " m_nbFECBlocks: " << settings.m_nbFECBlocks
             << " m_txDelay: " << settings.m_txDelay
+            << " m_blockSize: " << settings.m_blockSize
             << " m_dataAddress: " << settings.m_dataAddress
             << " m_dataPort: " << settings.m_dataPort
             << " m_streamIndex: " << settings.m_streamIndex
@@ -218,12 +229,14 @@ void RemoteSinkSink::applySettings(const RemoteSinkSettings& settings, bool forc
     if ((m_settings.m_log2Decim != settings.m_log2Decim)
      || (m_settings.m_filterChainHash != settings.m_filterChainHash)
      || (m_settings.m_nbFECBlocks != settings.m_nbFECBlocks)
-     || (m_settings.m_txDelay != settings.m_txDelay) || force)
+     || (m_settings.m_txDelay != settings.m_txDelay)
+     || (m_settings.m_blockSize != settings.m_blockSize) || force)
     {
         double shiftFactor = HBFilterChainConverter::getShiftFactor(settings.m_log2Decim, settings.m_filterChainHash);
         m_frequencyOffset = round(shiftFactor*m_basebandSampleRate);
+        m_blockSize = settings.m_blockSize;
         setNbBlocksFEC(settings.m_nbFECBlocks);
-        setTxDelay(settings.m_txDelay, settings.m_nbFECBlocks, settings.m_log2Decim);
+        setTxDelay(settings.m_txDelay, settings.m_nbFECBlocks, settings.m_log2Decim, settings.m_blockSize);
     }
 
     m_settings = settings;
@@ -234,5 +247,5 @@ void RemoteSinkSink::applyBasebandSampleRate(uint32_t sampleRate)
     m_basebandSampleRate = sampleRate;
     double shiftFactor = HBFilterChainConverter::getShiftFactor(m_settings.m_log2Decim, m_settings.m_filterChainHash);
     m_frequencyOffset = round(shiftFactor*m_basebandSampleRate);
-    setTxDelay(m_settings.m_txDelay, m_settings.m_nbFECBlocks, m_settings.m_log2Decim);
+    setTxDelay(m_settings.m_txDelay, m_settings.m_nbFECBlocks, m_settings.m_log2Decim, m_settings.m_blockSize);
 }
\ No newline at end of file
@@ -53,7 +53,6 @@ private:
     int m_txBlockIndex;                  //!< Current index in blocks to transmit in the Tx row
     uint16_t m_frameCount;               //!< transmission frame count
     int m_sampleIndex;                   //!< Current sample index in protected block data
-    RemoteSuperBlock m_superBlock;
     RemoteMetaDataFEC m_currentMetaFEC;
     RemoteDataBlock *m_dataBlock;
 
@@ -62,11 +61,12 @@ private:
     uint32_t m_basebandSampleRate;
     int m_nbBlocksFEC;
     int m_txDelay;
+    int m_blockSize;                     //!< datagram size applied from the next frame
     QString m_dataAddress;
     uint16_t m_dataPort;
 
     void setNbBlocksFEC(int nbBlocksFEC);
-    void setTxDelay(int txDelay, int nbBlocksFEC, int log2Decim);
+    void setTxDelay(int txDelay, int nbBlocksFEC, int log2Decim, int blockSize);
 };
 
 #endif // INCLUDE_REMOTESINKSINK_H_
\ No newline at end of file
@@ -27,6 +27,7 @@
 #include "SWGUDPSinkSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGUDPSinkReport.h"
+#include "SWGChannelPerf.h"
 
 #include "dsp/dspengine.h"
 #include "util/db.h"
@@ -52,6 +53,7 @@ UDPSink::UDPSink(DeviceAPI *deviceAPI) :
 
     m_thread = new QThread(this);
     m_basebandSink = new UDPSinkBaseband();
+    m_basebandSink->attachSharedFifo(m_deviceAPI->getSampleSinkSharedFifo());
     m_basebandSink->setSpectrum(&m_spectrumVis);
     m_basebandSink->moveToThread(m_thread);
 
@@ -390,6 +392,15 @@ int UDPSink::webapiReportGet(
     return 200;
 }
 
+int UDPSink::webapiPerfGet(
+        SWGSDRangel::SWGChannelPerf& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    webapiFormatChannelPerf(&response, m_basebandSink->getSampleFifo(), m_basebandSink->getInputMessageQueue());
+    return 200;
+}
+
 void UDPSink::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const UDPSinkSettings& settings)
 {
     response.getUdpSinkSettings()->setOutputSampleRate(settings.m_outputSampleRate);
@@ -30,6 +30,7 @@ UDPSinkBaseband::UDPSinkBaseband() :
     m_mutex(QMutex::Recursive)
 {
     m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(48000));
+    m_sampleFifo.setLockFree(true);
     m_channelizer = new DownChannelizer(&m_sink);
 
     qDebug("WFMDemodBaseband::WFMDemodBaseband");
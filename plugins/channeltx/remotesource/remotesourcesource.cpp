@@ -196,7 +196,7 @@ void RemoteSourceSource::handleDataBlock(RemoteDataBlock* dataBlock)
         {
             RemoteMetaDataFEC *metaData = (RemoteMetaDataFEC *) &(dataBlock->m_superBlocks[0].m_protectedBlock);
             boost::crc_32_type crc32;
-            crc32.process_bytes(metaData, sizeof(RemoteMetaDataFEC)-4);
+            crc32.process_bytes(metaData, RemoteMetaDataFEC::getCRCBytes());
 
             if (crc32.checksum() == metaData->m_crc32)
             {
@@ -140,7 +140,7 @@ void RemoteOutputSender::sendDataBlock(RemoteDataBlock *dataBlock)
             RemoteMetaDataFEC *destMeta = (RemoteMetaDataFEC *) &superBlock.m_protectedBlock;
             destMeta->m_nbFECBlocks = 0;
             boost::crc_32_type crc32;
-            crc32.process_bytes(destMeta, sizeof(RemoteMetaDataFEC)-4);
+            crc32.process_bytes(destMeta, RemoteMetaDataFEC::getCRCBytes());
             destMeta->m_crc32 = crc32.checksum();
         }
 
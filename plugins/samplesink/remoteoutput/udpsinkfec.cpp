@@ -134,13 +134,14 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
             metaData.m_nbFECBlocks = m_nbBlocksFEC;
             metaData.m_tv_sec = nowus / 1000000UL;  // tv.tv_sec;
             metaData.m_tv_usec = nowus % 1000000UL; // tv.tv_usec;
+            metaData.m_blockSize = RemoteUdpSize;
 
             if (!m_dataBlock) { // on the very first cycle there is no data block allocated
                 m_dataBlock = m_remoteOutputSender->getDataBlock(); // ask a new block to sender
             }
 
             boost::crc_32_type crc32;
-            crc32.process_bytes(&metaData, sizeof(RemoteMetaDataFEC)-4);
+            crc32.process_bytes(&metaData, RemoteMetaDataFEC::getCRCBytes());
             metaData.m_crc32 = crc32.checksum();
             RemoteSuperBlock& superBlock = m_dataBlock->m_superBlocks[0]; // first block
             superBlock.init();
@@ -59,8 +59,10 @@ AirspyHFInput::AirspyHFInput(DeviceAPI *deviceAPI) :
 {
     openDevice();
     m_fileSink = new FileRecord(QString("test_%1.sdriq").arg(m_deviceAPI->getDeviceUID()));
+    m_sampleFifo.setLockFree(true);
     m_deviceAPI->setNbSourceStreams(1);
     m_deviceAPI->addAncillarySink(m_fileSink);
+    m_deviceAPI->setFileRecord(m_fileSink);
     m_networkManager = new QNetworkAccessManager();
     connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
 }
@@ -74,6 +76,7 @@ AirspyHFInput::~AirspyHFInput()
         stop();
     }
 
+    m_deviceAPI->setFileRecord(nullptr);
     m_deviceAPI->removeAncillarySink(m_fileSink);
     delete m_fileSink;
     closeDevice();
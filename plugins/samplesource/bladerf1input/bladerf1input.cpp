@@ -52,8 +52,10 @@ Bladerf1Input::Bladerf1Input(DeviceAPI *deviceAPI) :
 {
     openDevice();
     m_fileSink = new FileRecord(QString("test_%1.sdriq").arg(m_deviceAPI->getDeviceUID()));
+    m_sampleFifo.setLockFree(true);
     m_deviceAPI->setNbSourceStreams(1);
     m_deviceAPI->addAncillarySink(m_fileSink);
+    m_deviceAPI->setFileRecord(m_fileSink);
 
     m_deviceAPI->setBuddySharedPtr(&m_sharedParams);
 
@@ -70,6 +72,7 @@ Bladerf1Input::~Bladerf1Input()
         stop();
     }
 
+    m_deviceAPI->setFileRecord(nullptr);
     m_deviceAPI->removeAncillarySink(m_fileSink);
     delete m_fileSink;
     closeDevice();
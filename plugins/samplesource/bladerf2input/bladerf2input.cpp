@@ -68,8 +68,10 @@ BladeRF2Input::BladeRF2Input(DeviceAPI *deviceAPI) :
     }
 
     m_fileSink = new FileRecord(QString("test_%1.sdriq").arg(m_deviceAPI->getDeviceUID()));
+    m_sampleFifo.setLockFree(true);
     m_deviceAPI->setNbSourceStreams(1);
     m_deviceAPI->addAncillarySink(m_fileSink);
+    m_deviceAPI->setFileRecord(m_fileSink);
     m_networkManager = new QNetworkAccessManager();
     connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
 }
@@ -83,6 +85,7 @@ BladeRF2Input::~BladeRF2Input()
         stop();
     }
 
+    m_deviceAPI->setFileRecord(nullptr);
     m_deviceAPI->removeAncillarySink(m_fileSink);
     delete m_fileSink;
     closeDevice();
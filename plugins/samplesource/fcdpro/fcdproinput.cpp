@@ -52,8 +52,10 @@ FCDProInput::FCDProInput(DeviceAPI *deviceAPI) :
     m_fcdFIFO.setSize(20*fcd_traits<Pro>::convBufSize);
     openDevice();
     m_fileSink = new FileRecord(QString("test_%1.sdriq").arg(m_deviceAPI->getDeviceUID()));
+    m_sampleFifo.setLockFree(true);
     m_deviceAPI->setNbSourceStreams(1);
     m_deviceAPI->addAncillarySink(m_fileSink);
+    m_deviceAPI->setFileRecord(m_fileSink);
     m_networkManager = new QNetworkAccessManager();
     connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
 }
@@ -67,6 +69,7 @@ FCDProInput::~FCDProInput()
         stop();
     }
 
+    m_deviceAPI->setFileRecord(nullptr);
     m_deviceAPI->removeAncillarySink(m_fileSink);
     delete m_fileSink;
 
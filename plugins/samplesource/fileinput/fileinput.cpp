@@ -32,6 +32,7 @@
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspengine.h"
 #include "dsp/filerecord.h"
+#include "dsp/samplecodec.h"
 #include "device/deviceapi.h"
 
 #include "fileinput.h"
@@ -52,6 +53,8 @@ MESSAGE_CLASS_DEFINITION(FileInput::MsgReportHeaderCRC, Message)
 FileInput::FileInput(DeviceAPI *deviceAPI) :
     m_deviceAPI(deviceAPI),
 	m_settings(),
+	m_fileMap(nullptr),
+	m_fileSize(0),
 	m_fileInputThread(nullptr),
 	m_deviceDescription(),
 	m_fileName("..."),
@@ -59,8 +62,11 @@ FileInput::FileInput(DeviceAPI *deviceAPI) :
 	m_sampleSize(0),
 	m_centerFrequency(0),
 	m_recordLength(0),
+	m_nbSamples(0),
     m_startingTimeStamp(0)
 {
+    m_sampleFifo.setLockFree(true);
+    m_sampleFifo.setReadNotify(m_deviceAPI->getSampleSinkSharedFifo()); // engine reads wake the free run replay
     m_deviceAPI->setNbSourceStreams(1);
     qDebug("FileInput::FileInput: device source engine: %p", m_deviceAPI->getDeviceSourceEngine());
     qDebug("FileInput::FileInput: device source engine message queue: %p", m_deviceAPI->getDeviceEngineInputMessageQueue());
@@ -78,6 +84,7 @@ FileInput::~FileInput()
     delete m_networkManager;
 
 	stop();
+	closeFileStream();
 }
 
 void FileInput::destroy()
@@ -85,26 +92,48 @@ void FileInput::destroy()
     delete this;
 }
 
+void FileInput::closeFileStream()
+{
+	if (m_fileMap)
+	{
+		m_file.unmap(m_fileMap);
+		m_fileMap = nullptr;
+	}
+
+	if (m_file.isOpen()) {
+		m_file.close();
+	}
+
+	m_fileSize = 0;
+}
+
 void FileInput::openFileStream()
 {
 	//stopInput();
 
-	if (m_ifstream.is_open()) {
-		m_ifstream.close();
+	closeFileStream();
+	m_file.setFileName(m_fileName);
+
+	if (m_file.open(QIODevice::ReadOnly))
+	{
+		m_fileSize = m_file.size();
+		m_fileMap = m_fileSize > 0 ? m_file.map(0, m_fileSize) : nullptr;
+
+		if (!m_fileMap) {
+			qCritical("FileInput::openFileStream: cannot map file: %s", qPrintable(m_file.errorString()));
+		}
+	}
+	else
+	{
+		qCritical("FileInput::openFileStream: cannot open file: %s", qPrintable(m_file.errorString()));
 	}
 
-#ifdef Q_OS_WIN
-	m_ifstream.open(m_fileName.toStdWString().c_str(), std::ios::binary | std::ios::ate);
-#else
-	m_ifstream.open(m_fileName.toStdString().c_str(), std::ios::binary | std::ios::ate);
-#endif
-	quint64 fileSize = m_ifstream.tellg();
+	quint64 fileSize = m_fileSize;
 
-	if (fileSize > sizeof(FileRecord::Header))
+	if (m_fileMap && (fileSize > sizeof(FileRecord::Header)))
 	{
 	    FileRecord::Header header;
-	    m_ifstream.seekg(0,std::ios_base::beg);
-		bool crcOK = FileRecord::readHeader(m_ifstream, header);
+		bool crcOK = FileRecord::readHeader(m_fileMap, header);
 		m_sampleRate = header.sampleRate;
 		m_centerFrequency = header.centerFrequency;
 		m_startingTimeStamp = header.startTimeStamp;
@@ -114,11 +143,28 @@ void FileInput::openFileStream()
 	    if (crcOK)
 	    {
 	        qDebug("FileInput::openFileStream: CRC32 OK for header: %s", qPrintable(crcHex));
-	        m_recordLength = (fileSize - sizeof(FileRecord::Header)) / ((m_sampleSize == 24 ? 8 : 4) * m_sampleRate);
+	        quint64 dataSize = fileSize - sizeof(FileRecord::Header);
+
+	        if (FileRecord::isLossless(m_sampleSize))
+	        {
+	            m_nbSamples = SampleCodec::indexLosslessBlocks(m_fileMap + sizeof(FileRecord::Header), dataSize, m_blockOffsets);
+
+	            if (m_nbSamples == 0) {
+	                qCritical("FileInput::openFileStream: invalid lossless blocks");
+	            }
+	        }
+	        else if (m_sampleSize == FileRecord::m_sampleSizePacked12) {
+	            m_nbSamples = dataSize / SampleCodec::m_packed12Bytes;
+	        } else {
+	            m_nbSamples = dataSize / (m_sampleSize == 24 ? 8 : 4);
+	        }
+
+	        m_recordLength = m_nbSamples / m_sampleRate;
 	    }
 	    else
 	    {
 	        qCritical("FileInput::openFileStream: bad CRC32 for header: %s", qPrintable(crcHex));
+	        m_nbSamples = 0;
 	        m_recordLength = 0;
 	    }
 
@@ -129,6 +175,7 @@ void FileInput::openFileStream()
 	}
 	else
 	{
+		m_nbSamples = 0;
 		m_recordLength = 0;
 	}
 
@@ -149,7 +196,7 @@ void FileInput::openFileStream()
 	}
 
 	if (m_recordLength == 0) {
-	    m_ifstream.close();
+	    closeFileStream();
 	}
 }
 
@@ -157,13 +204,11 @@ void FileInput::seekFileStream(int seekMillis)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
-	if ((m_ifstream.is_open()) && m_fileInputThread && !m_fileInputThread->isRunning())
+	if (m_fileMap && m_fileInputThread && !m_fileInputThread->isRunning())
 	{
+		// the file is mapped: seeking is just moving the read position
         quint64 seekPoint = ((m_recordLength * seekMillis) / 1000) * m_sampleRate;
 		m_fileInputThread->setSamplesCount(seekPoint);
-        seekPoint *= (m_sampleSize == 24 ? 8 : 4); // + sizeof(FileSink::Header)
-		m_ifstream.clear();
-		m_ifstream.seekg(seekPoint + sizeof(FileRecord::Header), std::ios::beg);
 	}
 }
 
@@ -175,7 +220,7 @@ void FileInput::init()
 
 bool FileInput::start()
 {
-    if (!m_ifstream.is_open())
+    if (!m_fileMap)
     {
         qWarning("FileInput::start: file not open. not starting");
         return false;
@@ -184,18 +229,25 @@ bool FileInput::start()
 	QMutexLocker mutexLocker(&m_mutex);
 	qDebug() << "FileInput::start";
 
-	if (m_ifstream.tellg() != (std::streampos)0) {
-		m_ifstream.clear();
-		m_ifstream.seekg(sizeof(FileRecord::Header), std::ios::beg);
-	}
-
 	if(!m_sampleFifo.setSize(m_settings.m_accelerationFactor * m_sampleRate * sizeof(Sample))) {
 		qCritical("Could not allocate SampleFifo");
 		return false;
 	}
 
-	m_fileInputThread = new FileInputThread(&m_ifstream, &m_sampleFifo, m_masterTimer, &m_inputMessageQueue);
+	m_fileInputThread = new FileInputThread(
+		m_fileMap + sizeof(FileRecord::Header),
+		m_fileSize - sizeof(FileRecord::Header),
+		&m_sampleFifo,
+		m_masterTimer,
+		&m_inputMessageQueue
+	);
 	m_fileInputThread->setSampleRateAndSize(m_settings.m_accelerationFactor * m_sampleRate, m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
+
+	if (FileRecord::isLossless(m_sampleSize)) {
+		m_fileInputThread->setBlockIndex(m_blockOffsets, m_nbSamples);
+	}
+
+	m_fileInputThread->setFreeRun(m_settings.m_freeRun, m_deviceAPI->getSampleSinkSharedFifo());
 	m_fileInputThread->startWork();
 	m_deviceDescription = "FileInput";
 
@@ -304,6 +356,13 @@ bool FileInput::handleMessage(const Message& message)
     else if (MsgConfigureFileSourceName::match(message))
 	{
 		MsgConfigureFileSourceName& conf = (MsgConfigureFileSourceName&) message;
+
+		if (m_fileInputThread) // samples are read from the current file mapping
+		{
+			qWarning("FileInput::handleMessage: MsgConfigureFileSourceName: stop acquisition before changing file");
+			return true;
+		}
+
 		m_fileName = conf.getFileName();
 		openFileStream();
 		return true;
@@ -426,6 +485,27 @@ bool FileInput::applySettings(const FileInputSettings& settings, bool force)
         }
     }
 
+    if ((m_settings.m_freeRun != settings.m_freeRun) || force)
+    {
+        reverseAPIKeys.append("freeRun");
+
+        if (m_fileInputThread)
+        {
+            QMutexLocker mutexLocker(&m_mutex);
+            bool running = m_fileInputThread->isRunning();
+
+            if (running) {
+                m_fileInputThread->stopWork();
+            }
+
+            m_fileInputThread->setFreeRun(settings.m_freeRun, m_deviceAPI->getSampleSinkSharedFifo());
+
+            if (running) {
+                m_fileInputThread->startWork();
+            }
+        }
+    }
+
     if ((m_settings.m_loop != settings.m_loop)) {
         reverseAPIKeys.append("loop");
     }
@@ -494,6 +574,9 @@ void FileInput::webapiUpdateDeviceSettings(
     if (deviceSettingsKeys.contains("loop")) {
         settings.m_loop = response.getFileInputSettings()->getLoop() != 0;
     }
+    if (deviceSettingsKeys.contains("freeRun")) {
+        settings.m_freeRun = response.getFileInputSettings()->getFreeRun() != 0;
+    }
     if (deviceSettingsKeys.contains("useReverseAPI")) {
         settings.m_useReverseAPI = response.getFileInputSettings()->getUseReverseApi() != 0;
     }
@@ -552,6 +635,7 @@ void FileInput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings& respo
     response.getFileInputSettings()->setFileName(new QString(settings.m_fileName));
     response.getFileInputSettings()->setAccelerationFactor(settings.m_accelerationFactor);
     response.getFileInputSettings()->setLoop(settings.m_loop ? 1 : 0);
+    response.getFileInputSettings()->setFreeRun(settings.m_freeRun ? 1 : 0);
 
     response.getFileInputSettings()->setUseReverseApi(settings.m_useReverseAPI ? 1 : 0);
 
@@ -618,6 +702,9 @@ void FileInput::webapiReverseSendSettings(QList<QString>& deviceSettingsKeys, co
     if (deviceSettingsKeys.contains("loop") || force) {
         swgFileInputSettings->setLoop(settings.m_loop);
     }
+    if (deviceSettingsKeys.contains("freeRun") || force) {
+        swgFileInputSettings->setFreeRun(settings.m_freeRun ? 1 : 0);
+    }
     if (deviceSettingsKeys.contains("fileName") || force) {
         swgFileInputSettings->setFileName(new QString(settings.m_fileName));
     }
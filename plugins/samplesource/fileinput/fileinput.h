@@ -19,12 +19,12 @@
 #define INCLUDE_FILEINPUT_H
 
 #include <ctime>
-#include <iostream>
-#include <fstream>
+#include <vector>
 
 #include <QString>
 #include <QByteArray>
 #include <QTimer>
+#include <QFile>
 #include <QNetworkRequest>
 
 #include "dsp/devicesamplesource.h"
@@ -332,7 +332,9 @@ public:
 	DeviceAPI *m_deviceAPI;
 	QMutex m_mutex;
 	FileInputSettings m_settings;
-	std::ifstream m_ifstream;
+	QFile m_file;
+	uchar *m_fileMap;    //!< whole file mapped read only
+	quint64 m_fileSize;
 	FileInputThread* m_fileInputThread;
 	QString m_deviceDescription;
 	QString m_fileName;
@@ -340,12 +342,15 @@ public:
 	quint32 m_sampleSize;
 	quint64 m_centerFrequency;
     quint64 m_recordLength; //!< record length in seconds computed from file size
+    quint64 m_nbSamples;    //!< record length in samples
+    std::vector<quint64> m_blockOffsets; //!< lossless blocks offsets
     quint64 m_startingTimeStamp;
 	QTimer m_masterTimer;
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
 
 	void openFileStream();
+	void closeFileStream();
 	void seekFileStream(int seekMillis);
 	bool applySettings(const FileInputSettings& settings, bool force = false);
     void webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& response);
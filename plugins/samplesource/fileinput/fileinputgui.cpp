@@ -31,6 +31,7 @@
 #include "gui/basicdevicesettingsdialog.h"
 #include "dsp/dspengine.h"
 #include "dsp/dspcommands.h"
+#include "dsp/filerecord.h"
 
 #include "mainwindow.h"
 
@@ -243,6 +244,7 @@ void FileInputGUI::displaySettings()
     blockApplySettings(true);
     ui->playLoop->setChecked(m_settings.m_loop);
     ui->acceleration->setCurrentIndex(FileInputSettings::getAccelerationIndex(m_settings.m_accelerationFactor));
+    ui->freeRun->setChecked(m_settings.m_freeRun);
     blockApplySettings(false);
 }
 
@@ -341,6 +343,16 @@ void FileInputGUI::on_acceleration_currentIndexChanged(int index)
     }
 }
 
+void FileInputGUI::on_freeRun_toggled(bool checked)
+{
+    if (m_doApplySettings)
+    {
+        m_settings.m_freeRun = checked;
+        FileInput::MsgConfigureFileInput *message = FileInput::MsgConfigureFileInput::create(m_settings, false);
+        m_sampleSource->getInputMessageQueue()->push(message);
+    }
+}
+
 void FileInputGUI::configureFileName()
 {
 	qDebug() << "FileInputGUI::configureFileName: " << m_fileName.toStdString().c_str();
@@ -359,7 +371,13 @@ void FileInputGUI::updateWithStreamData()
 {
 	ui->centerFrequency->setValue(m_centerFrequency/1000);
 	ui->sampleRateText->setText(tr("%1k").arg((float)m_sampleRate / 1000));
-	ui->sampleSizeText->setText(tr("%1b").arg(m_sampleSize));
+
+	if (FileRecord::isLossless(m_sampleSize)) {
+		ui->sampleSizeText->setText(tr("%1bL").arg(FileRecord::getSampleBits(m_sampleSize)));
+	} else {
+		ui->sampleSizeText->setText(tr("%1b").arg(m_sampleSize));
+	}
+
 	ui->play->setEnabled(m_acquisition);
 	QTime recordLength(0, 0, 0, 0);
 	recordLength = recordLength.addSecs(m_recordLength);
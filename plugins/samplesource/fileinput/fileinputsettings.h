@@ -27,6 +27,7 @@ struct FileInputSettings {
     QString m_fileName;
     quint32 m_accelerationFactor;
     bool m_loop;
+    bool m_freeRun; //!< replay as fast as the DSP consumes samples. Acceleration is ignored.
     bool     m_useReverseAPI;
     QString  m_reverseAPIAddress;
     uint16_t m_reverseAPIPort;
@@ -18,38 +18,47 @@
 #include <stdio.h>
 #include <errno.h>
 #include <assert.h>
+#include <algorithm>
 #include <QDebug>
 
 #include "dsp/filerecord.h"
+#include "dsp/samplecodec.h"
 #include "fileinputthread.h"
 #include "dsp/samplesinkfifo.h"
+#include "dsp/samplesinksharedfifo.h"
 #include "util/messagequeue.h"
 
 MESSAGE_CLASS_DEFINITION(FileInputThread::MsgReportEOF, Message)
 
-FileInputThread::FileInputThread(std::ifstream *samplesStream,
+FileInputThread::FileInputThread(const quint8 *samples,
+        quint64 samplesBytes,
         SampleSinkFifo* sampleFifo,
         const QTimer& timer,
         MessageQueue *fileInputMessageQueue,
         QObject* parent) :
 	QThread(parent),
 	m_running(false),
-	m_ifstream(samplesStream),
-	m_fileBuf(0),
+	m_samples(samples),
+	m_samplesBytes(samplesBytes),
 	m_convertBuf(0),
 	m_bufsize(0),
 	m_chunksize(0),
 	m_sampleFifo(sampleFifo),
+	m_sharedFifo(nullptr),
 	m_samplesCount(0),
+	m_eof(false),
+	m_freeRun(false),
 	m_timer(timer),
 	m_fileInputMessageQueue(fileInputMessageQueue),
     m_samplerate(0),
 	m_samplesize(0),
 	m_samplebytes(0),
+	m_nbSamples(0),
+	m_decodedBlockIndex(-1),
     m_throttlems(FILESOURCE_THROTTLE_MS),
     m_throttleToggle(false)
 {
-    assert(m_ifstream != 0);
+    assert(m_samples != 0);
 }
 
 FileInputThread::~FileInputThread()
@@ -58,10 +67,6 @@ FileInputThread::~FileInputThread()
 		stopWork();
 	}
 
-	if (m_fileBuf != 0) {
-		free(m_fileBuf);
-	}
-
 	if (m_convertBuf != 0) {
 		free(m_convertBuf);
 	}
@@ -69,22 +74,22 @@ FileInputThread::~FileInputThread()
 
 void FileInputThread::startWork()
 {
-	qDebug() << "FileInputThread::startWork: ";
+	qDebug() << "FileInputThread::startWork: " << (m_freeRun ? "free run" : "throttled");
+    m_startWaitMutex.lock();
+    m_elapsedTimer.start();
+    start();
+    while(!m_running)
+        m_startWaiter.wait(&m_startWaitMutex, 100);
+    m_startWaitMutex.unlock();
 
-    if (m_ifstream->is_open())
-    {
-        qDebug() << "FileInputThread::startWork: file stream open, starting...";
-        m_startWaitMutex.lock();
-        m_elapsedTimer.start();
-        start();
-        while(!m_running)
-            m_startWaiter.wait(&m_startWaitMutex, 100);
-        m_startWaitMutex.unlock();
+    if (!m_freeRun) {
         connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
     }
-    else
+
+    if (m_eof) // nothing left to play
     {
-        qDebug() << "FileInputThread::startWork: file stream closed, not starting.";
+        MsgReportEOF *message = MsgReportEOF::create();
+        m_fileInputMessageQueue->push(message);
     }
 }
 
@@ -96,6 +101,26 @@ void FileInputThread::stopWork()
 	wait();
 }
 
+void FileInputThread::setFreeRun(bool freeRun, SampleSinkSharedFifo *sharedFifo)
+{
+    m_freeRun = freeRun;
+    m_sharedFifo = sharedFifo;
+}
+
+void FileInputThread::setSamplesCount(quint64 samplesCount)
+{
+    m_samplesCount = samplesCount;
+    m_eof = false;
+}
+
+void FileInputThread::setBlockIndex(const std::vector<quint64>& blockOffsets, quint64 nbSamples)
+{
+    m_blockOffsets = blockOffsets;
+    m_nbSamples = nbSamples;
+    m_decodedBlock.resize(SampleCodec::m_losslessBlockSamples);
+    m_decodedBlockIndex = -1;
+}
+
 void FileInputThread::setSampleRateAndSize(int samplerate, quint32 samplesize)
 {
 	qDebug() << "FileInputThread::setSampleRateAndSize:"
@@ -112,7 +137,18 @@ void FileInputThread::setSampleRateAndSize(int samplerate, quint32 samplesize)
 
 		m_samplerate = samplerate;
 		m_samplesize = samplesize;
-		m_samplebytes = m_samplesize > 16 ? sizeof(int32_t) : sizeof(int16_t);
+
+        if ((m_samplesize == FileRecord::m_sampleSizePacked12) || FileRecord::isLossless(m_samplesize))
+        {
+            // chunks are counted in decoded samples
+            m_samplebytes = sizeof(FixReal);
+            m_nbSamples = m_samplesize == FileRecord::m_sampleSizePacked12 ? m_samplesBytes / SampleCodec::m_packed12Bytes : m_nbSamples;
+        }
+        else
+        {
+            m_samplebytes = m_samplesize > 16 ? sizeof(int32_t) : sizeof(int16_t);
+        }
+
         m_chunksize = (m_samplerate * 2 * m_samplebytes * m_throttlems) / 1000;
 
         setBuffers(m_chunksize);
@@ -123,24 +159,12 @@ void FileInputThread::setSampleRateAndSize(int samplerate, quint32 samplesize)
 
 void FileInputThread::setBuffers(std::size_t chunksize)
 {
-    if (chunksize > m_bufsize)
+    // samples are read in place from the file mapping. A buffer is needed only to convert sample size or decode.
+    if ((chunksize > m_bufsize) && (m_samplesize != SDR_RX_SAMP_SZ))
     {
         m_bufsize = chunksize;
         int nbSamples = m_bufsize/(2 * m_samplebytes);
 
-        if (m_fileBuf == 0)
-        {
-            qDebug() << "FileInputThread::setBuffers: Allocate file buffer";
-            m_fileBuf = (quint8*) malloc(m_bufsize);
-        }
-        else
-        {
-            qDebug() << "FileInputThread::setBuffers: Re-allocate file buffer";
-            quint8 *buf = m_fileBuf;
-            m_fileBuf = (quint8*) realloc((void*) m_fileBuf, m_bufsize);
-            if (!m_fileBuf) free(buf);
-        }
-
         if (m_convertBuf == 0)
         {
             qDebug() << "FileInputThread::setBuffers: Allocate conversion buffer";
@@ -164,9 +188,17 @@ void FileInputThread::run()
 	m_running = true;
 	m_startWaiter.wakeAll();
 
-	while(m_running) // actual work is in the tick() function
+	while(m_running)
 	{
-		sleep(1);
+		if (!m_freeRun) {
+			sleep(1); // actual work is in the tick() function
+		} else if (!writeFreeRun()) {
+			if (m_sharedFifo) {
+				m_sharedFifo->waitRead(FILESOURCE_FREERUN_WAIT_MS); // until the engine or a channel reads
+			} else {
+				msleep(FILESOURCE_FREERUN_WAIT_MS);
+			}
+		}
 	}
 
 	m_running = false;
@@ -186,21 +218,119 @@ void FileInputThread::tick()
             setBuffers(m_chunksize);
         }
 
-		// read samples directly feeding the SampleFifo (no callback)
-		m_ifstream->read(reinterpret_cast<char*>(m_fileBuf), m_chunksize);
+        writeChunk(m_chunksize);
+	}
+}
 
-        if (m_ifstream->eof())
-        {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_ifstream->gcount());
-        	MsgReportEOF *message = MsgReportEOF::create();
-        	m_fileInputMessageQueue->push(message);
-        }
-        else
+bool FileInputThread::writeFreeRun()
+{
+    // backpressure: wait for the engine and the slowest channel, on the baseband or on a sub-band, to drain half of their FIFO
+    unsigned int fifoFree = m_sampleFifo->size() - m_sampleFifo->fill();
+
+    if (fifoFree < m_sampleFifo->size() / 2) {
+        return false;
+    }
+
+    if (m_sharedFifo && m_sharedFifo->isBacklogged()) {
+        return false;
+    }
+
+    if (m_eof) {
+        return false;
+    }
+
+    quint64 nbBytes = std::min((quint64) fifoFree, (quint64) m_chunksize / (2 * m_samplebytes)) * 2 * m_samplebytes;
+    writeChunk(nbBytes);
+    return true;
+}
+
+void FileInputThread::writeChunk(quint64 nbBytes)
+{
+    if (m_eof) {
+        return;
+    }
+
+    if ((m_samplesize == FileRecord::m_sampleSizePacked12) || FileRecord::isLossless(m_samplesize))
+    {
+        writeDecodedChunk(nbBytes / (2 * m_samplebytes));
+        return;
+    }
+
+    quint64 position = m_samplesCount * 2 * m_samplebytes;
+    quint64 available = position < m_samplesBytes ? m_samplesBytes - position : 0;
+
+    if (nbBytes >= available)
+    {
+        // read samples directly from the file mapping
+        writeToSampleFifo(m_samples + position, (qint32) available);
+        m_samplesCount += available / (2 * m_samplebytes);
+        m_eof = true;
+        MsgReportEOF *message = MsgReportEOF::create();
+        m_fileInputMessageQueue->push(message);
+    }
+    else
+    {
+        writeToSampleFifo(m_samples + position, (qint32) nbBytes);
+        m_samplesCount += nbBytes / (2 * m_samplebytes);
+    }
+}
+
+void FileInputThread::writeDecodedChunk(quint64 nbSamples)
+{
+    // decoding is done here in the reading thread and not in the device engine thread
+    quint64 available = m_samplesCount < m_nbSamples ? m_nbSamples - m_samplesCount : 0;
+    bool eof = nbSamples >= available;
+    nbSamples = eof ? available : nbSamples;
+    Sample *samples = (Sample *) m_convertBuf;
+
+    if (m_samplesize == FileRecord::m_sampleSizePacked12) {
+        SampleCodec::decodePacked12(m_samples + m_samplesCount * SampleCodec::m_packed12Bytes, nbSamples, samples);
+    } else {
+        decodeLossless(samples, nbSamples);
+    }
+
+    m_sampleFifo->write((const quint8*) samples, nbSamples * sizeof(Sample));
+    m_samplesCount += nbSamples;
+
+    if (eof)
+    {
+        m_eof = true;
+        MsgReportEOF *message = MsgReportEOF::create();
+        m_fileInputMessageQueue->push(message);
+    }
+}
+
+void FileInputThread::decodeLossless(Sample *samples, quint64 nbSamples)
+{
+    quint64 position = m_samplesCount;
+    int shift = SDR_RX_SAMP_SZ - (int) FileRecord::getSampleBits(m_samplesize);
+
+    while (nbSamples > 0)
+    {
+        // all blocks but the last have m_losslessBlockSamples samples
+        qint64 blockIndex = position / SampleCodec::m_losslessBlockSamples;
+        quint64 blockStart = blockIndex * SampleCodec::m_losslessBlockSamples;
+        quint64 blockSamples = std::min((quint64) SampleCodec::m_losslessBlockSamples, m_nbSamples - blockStart);
+
+        if (blockIndex != m_decodedBlockIndex)
         {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_chunksize);
-    		m_samplesCount += m_chunksize / (2 * m_samplebytes);
+            quint64 offset = m_blockOffsets[blockIndex];
+
+            if (!SampleCodec::decodeLosslessBlock(m_samples + offset, m_samplesBytes - offset, m_decodedBlock.data(), m_decodedBlock.size(), shift))
+            {
+                qCritical("FileInputThread::decodeLossless: corrupted block %lld", blockIndex);
+                std::fill(m_decodedBlock.begin(), m_decodedBlock.end(), Sample{0, 0});
+            }
+
+            m_decodedBlockIndex = blockIndex;
         }
-	}
+
+        quint64 count = std::min(nbSamples, blockSamples - (position - blockStart));
+        std::copy(m_decodedBlock.begin() + (position - blockStart), m_decodedBlock.begin() + (position - blockStart + count), samples);
+        samples += count;
+        position += count;
+        nbSamples -= count;
+    }
 }
 
 void FileInputThread::writeToSampleFifo(const quint8* buf, qint32 nbBytes)
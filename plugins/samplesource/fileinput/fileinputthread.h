@@ -23,16 +23,18 @@
 #include <QWaitCondition>
 #include <QTimer>
 #include <QElapsedTimer>
-#include <iostream>
-#include <fstream>
 #include <cstdlib>
+#include <vector>
 
+#include "dsp/dsptypes.h"
 #include "dsp/inthalfbandfilter.h"
 #include "util/message.h"
 
 #define FILESOURCE_THROTTLE_MS 50
+#define FILESOURCE_FREERUN_WAIT_MS 10 //!< in case a read notification is missed
 
 class SampleSinkFifo;
+class SampleSinkSharedFifo;
 class MessageQueue;
 
 class FileInputThread : public QThread {
@@ -53,7 +55,8 @@ public:
         { }
     };
 
-	FileInputThread(std::ifstream *samplesStream,
+	FileInputThread(const quint8 *samples,
+	        quint64 samplesBytes,
 	        SampleSinkFifo* sampleFifo,
 	        const QTimer& timer,
 	        MessageQueue *fileInputMessageQueue,
@@ -64,34 +67,46 @@ public:
 	void stopWork();
 	void setSampleRateAndSize(int samplerate, quint32 samplesize);
     void setBuffers(std::size_t chunksize);
+    void setFreeRun(bool freeRun, SampleSinkSharedFifo *sharedFifo); //!< Replay as fast as the FIFOs are drained. Set when stopped.
+    void setBlockIndex(const std::vector<quint64>& blockOffsets, quint64 nbSamples); //!< Lossless record blocks. Set after sample size.
 	bool isRunning() const { return m_running; }
     quint64 getSamplesCount() const { return m_samplesCount; }
-    void setSamplesCount(quint64 samplesCount) { m_samplesCount = samplesCount; }
+    void setSamplesCount(quint64 samplesCount); //!< Read position in samples from the start of the record
 
 private:
 	QMutex m_startWaitMutex;
 	QWaitCondition m_startWaiter;
 	volatile bool m_running;
 
-	std::ifstream* m_ifstream;
-	quint8  *m_fileBuf;
+	const quint8 *m_samples;   //!< file mapping after the header
+	quint64 m_samplesBytes;
 	quint8  *m_convertBuf;
 	std::size_t m_bufsize;
     qint64 m_chunksize;
 	SampleSinkFifo* m_sampleFifo;
+	SampleSinkSharedFifo* m_sharedFifo; //!< FIFO read by the channels and the filter bank for free run backpressure
     quint64 m_samplesCount;
+    bool m_eof;
+    bool m_freeRun;
     const QTimer& m_timer;
     MessageQueue *m_fileInputMessageQueue;
 
 	int m_samplerate;      //!< File I/Q stream original sample rate
     quint64 m_samplesize;  //!< File effective sample size in bits (I or Q). Ex: 16, 24.
-    quint64 m_samplebytes; //!< Number of bytes used to store a I or Q sample. Ex: 2. 4.
+    quint64 m_samplebytes; //!< Number of bytes used to store a I or Q sample. Ex: 2. 4. Size of FixReal for coded samples.
+    quint64 m_nbSamples;   //!< Number of samples of coded records
+    std::vector<quint64> m_blockOffsets; //!< Lossless blocks offsets
+    SampleVector m_decodedBlock;         //!< Last lossless block decoded
+    qint64 m_decodedBlockIndex;
     qint64 m_throttlems;
     QElapsedTimer m_elapsedTimer;
     bool m_throttleToggle;
 
 	void run();
-	//void decimate1(SampleVector::iterator* it, const qint16* buf, qint32 len);
+	void writeChunk(quint64 nbBytes);
+	void writeDecodedChunk(quint64 nbSamples);
+	void decodeLossless(Sample *samples, quint64 nbSamples);
+	bool writeFreeRun();
 	void writeToSampleFifo(const quint8* buf, qint32 nbBytes);
 
 private slots:
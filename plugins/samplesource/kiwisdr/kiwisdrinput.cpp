@@ -55,8 +55,10 @@ KiwiSDRInput::KiwiSDRInput(DeviceAPI *deviceAPI) :
 	m_kiwiSDRWorkerThread.start();
 
     m_fileSink = new FileRecord();
+    m_sampleFifo.setLockFree(true);
     m_deviceAPI->setNbSourceStreams(1);
     m_deviceAPI->addAncillarySink(m_fileSink);
+    m_deviceAPI->setFileRecord(m_fileSink);
 
     if (!m_sampleFifo.setSize(getSampleRate() * 2)) {
         qCritical("KiwiSDRInput::KiwiSDRInput: Could not allocate SampleFifo");
@@ -78,6 +80,7 @@ KiwiSDRInput::~KiwiSDRInput()
 	m_kiwiSDRWorkerThread.quit();
 	m_kiwiSDRWorkerThread.wait();
 
+    m_deviceAPI->setFileRecord(nullptr);
     m_deviceAPI->removeAncillarySink(m_fileSink);
     delete m_fileSink;
 }
@@ -145,6 +145,8 @@ public:
         int getNbFECBlocksPerFrame() const { return m_nbFECBlocksPerFrame; }
         int getSampleBits() const { return m_sampleBits; }
         int getSampleBytes() const { return m_sampleBytes; }
+        float getFramesPerSec() const { return m_framesPerSec; }
+        int getFECLatencyUs() const { return m_fecLatencyUs; }
 
 		static MsgReportRemoteInputStreamTiming* create(uint64_t tv_msec,
 				float bufferLenSec,
@@ -160,7 +162,9 @@ public:
                 int nbOriginalBlocksPerFrame,
                 int nbFECBlocksPerFrame,
                 int sampleBits,
-                int sampleBytes)
+                int sampleBytes,
+                float framesPerSec,
+                int fecLatencyUs)
 		{
 			return new MsgReportRemoteInputStreamTiming(tv_msec,
 					bufferLenSec,
@@ -176,7 +180,9 @@ public:
                     nbOriginalBlocksPerFrame,
                     nbFECBlocksPerFrame,
                     sampleBits,
-                    sampleBytes);
+                    sampleBytes,
+                    framesPerSec,
+                    fecLatencyUs);
 		}
 
 	protected:
@@ -195,6 +201,8 @@ public:
         int      m_nbFECBlocksPerFrame;
         int      m_sampleBits;
         int      m_sampleBytes;
+        float    m_framesPerSec;  //!< frames complete per second
+        int      m_fecLatencyUs;  //!< average FEC decoding latency of frames using recovery blocks
 
 		MsgReportRemoteInputStreamTiming(uint64_t tv_msec,
 				float bufferLenSec,
@@ -210,7 +218,9 @@ public:
                 int nbOriginalBlocksPerFrame,
                 int nbFECBlocksPerFrame,
                 int sampleBits,
-                int sampleBytes) :
+                int sampleBytes,
+                float framesPerSec,
+                int fecLatencyUs) :
 			Message(),
 			m_tv_msec(tv_msec),
 			m_framesDecodingStatus(framesDecodingStatus),
@@ -226,7 +236,9 @@ public:
             m_nbOriginalBlocksPerFrame(nbOriginalBlocksPerFrame),
             m_nbFECBlocksPerFrame(nbFECBlocksPerFrame),
             m_sampleBits(sampleBits),
-            m_sampleBytes(sampleBytes)
+            m_sampleBytes(sampleBytes),
+            m_framesPerSec(framesPerSec),
+            m_fecLatencyUs(fecLatencyUs)
 		{ }
 	};
 
@@ -27,6 +27,11 @@
 
 
 RemoteInputBuffer::RemoteInputBuffer() :
+        m_blockSize(0),
+        m_blockBytes(0),
+        m_frameBytes(0),
+        m_frames(nullptr),
+        m_slotBlocks(nullptr),
         m_decoderIndexHead(nbDecoderSlots/2),
         m_frameHead(0),
         m_curNbBlocks(0),
@@ -43,15 +48,15 @@ RemoteInputBuffer::RemoteInputBuffer() :
         m_nbReads(0),
         m_nbWrites(0),
         m_balCorrection(0),
-	    m_balCorrLimit(0)
+	    m_balCorrLimit(0),
+        m_nbFrames(0),
+        m_nbFECFrames(0),
+        m_fecLatencyNs(0)
 {
 	m_currentMeta.init();
-	m_framesNbBytes = nbDecoderSlots * sizeof(BufferFrame);
-	m_wrDeltaEstimate = m_framesNbBytes / 2;
 	m_tvOut_sec = 0;
 	m_tvOut_usec = 0;
 	m_readNbBytes = 1;
-    m_paramsCM256.BlockBytes = sizeof(RemoteProtectedBlock); // never changes
     m_paramsCM256.OriginalCount = RemoteNbOrginalBlocks;  // never changes
 
     if (!m_cm256.isInitialized()) {
@@ -61,15 +66,69 @@ RemoteInputBuffer::RemoteInputBuffer() :
         m_cm256_OK = true;
     }
 
+    m_workerCM256 = new CM256[m_decoderPool.getNbWorkers()];
+    m_clock.start();
+    qDebug("RemoteInputBuffer::RemoteInputBuffer: %d FEC decoding workers", m_decoderPool.getNbWorkers());
+
     std::fill(m_decoderSlots, m_decoderSlots + nbDecoderSlots, DecoderSlot());
-    std::fill(m_frames, m_frames + nbDecoderSlots, BufferFrame());
+    setBlockSize(RemoteUdpSize);
+    m_frameHead = 0;
 }
 
 RemoteInputBuffer::~RemoteInputBuffer()
 {
+    m_decoderPool.waitAll(); // jobs use the slots buffers and the worker decoders
+    delete[] m_workerCM256;
+
 	if (m_readBuffer) {
 		delete[] m_readBuffer;
 	}
+
+    delete[] m_frames;
+    delete[] m_slotBlocks;
+}
+
+void RemoteInputBuffer::setBlockSize(int blockSize)
+{
+    qDebug("RemoteInputBuffer::setBlockSize: %d bytes", blockSize);
+    collectCompleteFrames(true); // no decoding in the buffers to be freed
+    delete[] m_frames;
+    delete[] m_slotBlocks;
+
+    m_blockSize = blockSize;
+    m_blockBytes = blockSize - sizeof(RemoteHeader);
+    m_frameBytes = (RemoteNbOrginalBlocks - 1) * m_blockBytes;
+    m_framesNbBytes = nbDecoderSlots * m_frameBytes;
+    m_frames = new uint8_t[m_framesNbBytes]();
+    // block zero followed by recovery blocks for each slot
+    m_slotBlocks = new uint8_t[nbDecoderSlots * (RemoteNbOrginalBlocks + 1) * m_blockBytes]();
+
+    for (int i = 0; i < nbDecoderSlots; i++)
+    {
+        m_decoderSlots[i].m_blockZero = &m_slotBlocks[i * (RemoteNbOrginalBlocks + 1) * m_blockBytes];
+        m_decoderSlots[i].m_recoveryBlocks = m_decoderSlots[i].m_blockZero + m_blockBytes;
+    }
+
+    m_paramsCM256.BlockBytes = m_blockBytes;
+    m_wrDeltaEstimate = m_framesNbBytes / 2;
+    m_readIndex = 0;
+    m_frameHead = -1; // restart from the next frame
+}
+
+bool RemoteInputBuffer::isBlockSizeAnnounced(const char *array, int size) const
+{
+    // a new block size is taken from a valid block zero of this size announcing it
+    const RemoteSuperBlock *superBlock = (const RemoteSuperBlock *) array;
+
+    if (!isRemoteBlockSizeValid(size) || (superBlock->m_header.m_blockIndex != 0)) {
+        return false;
+    }
+
+    const RemoteMetaDataFEC *metaData = (const RemoteMetaDataFEC *) (array + sizeof(RemoteHeader));
+    boost::crc_32_type crc32;
+    crc32.process_bytes(metaData, RemoteMetaDataFEC::getCRCBytes());
+
+    return (crc32.checksum() == metaData->m_crc32) && (metaData->getBlockSize() == size);
 }
 
 void RemoteInputBuffer::initDecodeAllSlots()
@@ -82,7 +141,7 @@ void RemoteInputBuffer::initDecodeAllSlots()
         m_decoderSlots[i].m_decoded = false;
         m_decoderSlots[i].m_metaRetrieved = false;
         resetOriginalBlocks(i);
-        memset((void *) m_decoderSlots[i].m_recoveryBlocks, 0, RemoteNbOrginalBlocks * sizeof(RemoteProtectedBlock));
+        memset((void *) m_decoderSlots[i].m_recoveryBlocks, 0, RemoteNbOrginalBlocks * m_blockBytes);
     }
 }
 
@@ -119,12 +178,12 @@ void RemoteInputBuffer::initDecodeSlot(int slotIndex)
     m_decoderSlots[slotIndex].m_metaRetrieved = false;
 
     resetOriginalBlocks(slotIndex);
-    memset((void *) m_decoderSlots[slotIndex].m_recoveryBlocks, 0, RemoteNbOrginalBlocks * sizeof(RemoteProtectedBlock));
+    memset((void *) m_decoderSlots[slotIndex].m_recoveryBlocks, 0, RemoteNbOrginalBlocks * m_blockBytes);
 }
 
 void RemoteInputBuffer::initReadIndex()
 {
-    m_readIndex = ((m_decoderIndexHead + (nbDecoderSlots/2)) % nbDecoderSlots) * sizeof(BufferFrame);
+    m_readIndex = ((m_decoderIndexHead + (nbDecoderSlots/2)) % nbDecoderSlots) * m_frameBytes;
     m_wrDeltaEstimate = m_framesNbBytes / 2;
     m_nbReads = 0;
     m_nbWrites = 0;
@@ -135,19 +194,19 @@ void RemoteInputBuffer::rwCorrectionEstimate(int slotIndex)
 	if (m_nbReads >= 40) // check every ~1s as tick is ~50ms
 	{
 		int targetPivotSlot = (slotIndex + (nbDecoderSlots/2))  % nbDecoderSlots; // slot at half buffer opposite of current write slot
-		int targetPivotIndex = targetPivotSlot * sizeof(BufferFrame);             // buffer index corresponding to start of above slot
-		int normalizedReadIndex = (m_readIndex < targetPivotIndex ? m_readIndex + nbDecoderSlots * sizeof(BufferFrame) :  m_readIndex)
-				- (targetPivotSlot * sizeof(BufferFrame)); // normalize read index so it is positive and zero at start of pivot slot
+		int targetPivotIndex = targetPivotSlot * m_frameBytes;             // buffer index corresponding to start of above slot
+		int normalizedReadIndex = (m_readIndex < targetPivotIndex ? m_readIndex + nbDecoderSlots * m_frameBytes :  m_readIndex)
+				- (targetPivotSlot * m_frameBytes); // normalize read index so it is positive and zero at start of pivot slot
 		int dBytes;
-        int rwDelta = (m_nbReads * m_readNbBytes) - (m_nbWrites * sizeof(BufferFrame));
+        int rwDelta = (m_nbReads * m_readNbBytes) - (m_nbWrites * m_frameBytes);
 
-		if (normalizedReadIndex < (nbDecoderSlots/ 2) * (int) sizeof(BufferFrame)) // read leads
+		if (normalizedReadIndex < (nbDecoderSlots/ 2) * (int) m_frameBytes) // read leads
 		{
 			dBytes = - normalizedReadIndex - rwDelta;
 		}
 		else // read lags
 		{
-            int bufSize = (nbDecoderSlots * sizeof(BufferFrame));
+            int bufSize = (nbDecoderSlots * m_frameBytes);
 			dBytes = bufSize - normalizedReadIndex - rwDelta;
 		}
 
@@ -169,9 +228,9 @@ void RemoteInputBuffer::rwCorrectionEstimate(int slotIndex)
 
 void RemoteInputBuffer::checkSlotData(int slotIndex)
 {
-    int pseudoWriteIndex = slotIndex * sizeof(BufferFrame);
+    int pseudoWriteIndex = slotIndex * m_frameBytes;
     m_wrDeltaEstimate = pseudoWriteIndex - m_readIndex;
-    int rwDelayBytes = (m_wrDeltaEstimate > 0 ? m_wrDeltaEstimate : sizeof(BufferFrame) * nbDecoderSlots + m_wrDeltaEstimate);
+    int rwDelayBytes = (m_wrDeltaEstimate > 0 ? m_wrDeltaEstimate : m_frameBytes * nbDecoderSlots + m_wrDeltaEstimate);
     int sampleRate = m_currentMeta.m_sampleRate;
 
     if (sampleRate > 0)
@@ -191,16 +250,29 @@ void RemoteInputBuffer::checkSlotData(int slotIndex)
     }
 }
 
-void RemoteInputBuffer::writeData(char *array)
+void RemoteInputBuffer::writeData(char *array, int size)
 {
+    if (size != m_blockSize)
+    {
+        if (!isBlockSizeAnnounced(array, size)) { // stale datagram of a previous size or not a block
+            return;
+        }
+
+        setBlockSize(size);
+    }
+
     RemoteSuperBlock *superBlock = (RemoteSuperBlock *) array;
+    const uint8_t *protectedBlock = (const uint8_t *) (array + sizeof(RemoteHeader));
     int frameIndex = superBlock->m_header.m_frameIndex;
     int decoderIndex = frameIndex % nbDecoderSlots;
 
     // frame break
 
+    collectCompleteFrames(false);
+
     if (m_frameHead == -1) // initial state
     {
+        collectCompleteFrames(true);
         m_decoderIndexHead = decoderIndex; // new decoder slot head
         m_frameHead = frameIndex;
         initReadIndex(); // reset read index
@@ -208,6 +280,7 @@ void RemoteInputBuffer::writeData(char *array)
     }
     else if (m_frameHead != frameIndex) // frame break => new frame starts
     {
+        waitCompleteSlot(decoderIndex);    // slot decoding and meta data check done before re-init
         m_decoderIndexHead = decoderIndex; // new decoder slot head
         m_frameHead = frameIndex;          // new frame head
         checkSlotData(decoderIndex);       // check slot before re-init
@@ -232,13 +305,14 @@ void RemoteInputBuffer::writeData(char *array)
 
         if (blockIndex < RemoteNbOrginalBlocks) // original data
         {
-            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) storeOriginalBlock(decoderIndex, blockIndex, superBlock->m_protectedBlock);
+            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) storeOriginalBlock(decoderIndex, blockIndex, protectedBlock);
             m_decoderSlots[decoderIndex].m_originalCount++;
         }
         else // recovery data
         {
-            m_decoderSlots[decoderIndex].m_recoveryBlocks[recoveryCount] = superBlock->m_protectedBlock;
-            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) &m_decoderSlots[decoderIndex].m_recoveryBlocks[recoveryCount];
+            uint8_t *recoveryBlock = &m_decoderSlots[decoderIndex].m_recoveryBlocks[recoveryCount * m_blockBytes];
+            std::copy(protectedBlock, protectedBlock + m_blockBytes, recoveryBlock);
+            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) recoveryBlock;
             m_decoderSlots[decoderIndex].m_recoveryCount++;
         }
     }
@@ -248,10 +322,17 @@ void RemoteInputBuffer::writeData(char *array)
     if (m_decoderSlots[decoderIndex].m_blockCount == RemoteNbOrginalBlocks) // ready to decode
     {
         m_decoderSlots[decoderIndex].m_decoded = true;
-
-        if (m_cm256_OK && (m_decoderSlots[decoderIndex].m_recoveryCount > 0)) // recovery data used => need to decode FEC
+        m_completeFrames.push_back(CompleteFrame());
+        CompleteFrame& frame = m_completeFrames.back();
+        frame.m_slotIndex = decoderIndex;
+        frame.m_fec = m_cm256_OK && (m_decoderSlots[decoderIndex].m_recoveryCount > 0);
+        frame.m_job = 0;
+        frame.m_queuedNs = m_clock.nsecsElapsed();
+        frame.m_decodedNs = frame.m_queuedNs;
+
+        if (frame.m_fec) // recovery data used => need to decode FEC
         {
-            m_paramsCM256.BlockBytes = sizeof(RemoteProtectedBlock); // never changes
+            m_paramsCM256.BlockBytes = m_blockBytes;
             m_paramsCM256.OriginalCount = RemoteNbOrginalBlocks;  // never changes
 
             if (m_decoderSlots[decoderIndex].m_metaRetrieved) {
@@ -260,86 +341,161 @@ void RemoteInputBuffer::writeData(char *array)
                 m_paramsCM256.RecoveryCount = m_decoderSlots[decoderIndex].m_recoveryCount;
             }
 
-            if (m_cm256.cm256_decode(m_paramsCM256, m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks)) // CM256 decode
-            {
-                qDebug() << "RemoteInputBuffer::writeData: decode CM256 error:"
-                        << " decoderIndex: " << decoderIndex
-                        << " m_blockCount: " << m_decoderSlots[decoderIndex].m_blockCount
-                        << " m_originalCount: " << m_decoderSlots[decoderIndex].m_originalCount
-                        << " m_recoveryCount: " << m_decoderSlots[decoderIndex].m_recoveryCount;
-            }
-            else
-            {
-                qDebug() << "RemoteInputBuffer::writeData: decode CM256 success:"
-                        << " decoderIndex: " << decoderIndex
-                        << " m_blockCount: " << m_decoderSlots[decoderIndex].m_blockCount
-                        << " m_originalCount: " << m_decoderSlots[decoderIndex].m_originalCount
-                        << " m_recoveryCount: " << m_decoderSlots[decoderIndex].m_recoveryCount;
+            // frames are decoded in parallel and their meta data checked in arrival order
+            CM256::cm256_encoder_params paramsCM256 = m_paramsCM256;
+            qint64 *decodedNs = &frame.m_decodedNs; // deque elements do not move when adding or removing at ends
 
-                for (int ir = 0; ir < m_decoderSlots[decoderIndex].m_recoveryCount; ir++) // restore missing blocks
-                {
-                    int recoveryIndex = RemoteNbOrginalBlocks - m_decoderSlots[decoderIndex].m_recoveryCount + ir;
-                    int blockIndex = m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Index;
-                    RemoteProtectedBlock *recoveredBlock = (RemoteProtectedBlock *) m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Block;
-
-                    if (blockIndex == 0) // first block with meta
-                    {
-                        RemoteMetaDataFEC *metaData = (RemoteMetaDataFEC *) recoveredBlock;
-
-                        boost::crc_32_type crc32;
-                        crc32.process_bytes(metaData, sizeof(RemoteMetaDataFEC)-4);
-
-                        if (crc32.checksum() == metaData->m_crc32)
-                        {
-                            m_decoderSlots[decoderIndex].m_metaRetrieved = true;
-                            printMeta("RemoteInputBuffer::writeData: recovered meta", metaData);
-                        }
-                        else
-                        {
-                            qDebug() << "RemoteInputBuffer::writeData: recovered meta: invalid CRC32";
-                        }
-                    }
-
-                    storeOriginalBlock(decoderIndex, blockIndex, *recoveredBlock);
-
-                    qDebug() << "RemoteInputBuffer::writeData: recovered block #" << blockIndex;
-                } // restore missing blocks
-            } // CM256 decode
-        } // recovery
-
-        if (m_decoderSlots[decoderIndex].m_metaRetrieved) // block zero with its meta data has been received
+            frame.m_job = m_decoderPool.push([this, decoderIndex, paramsCM256, decodedNs](int workerIndex) {
+                decodeSlot(decoderIndex, paramsCM256, m_workerCM256[workerIndex]);
+                *decodedNs = m_clock.nsecsElapsed();
+            });
+        }
+
+        collectCompleteFrames(false);
+    } // decode
+}
+
+void RemoteInputBuffer::decodeSlot(int slotIndex, CM256::cm256_encoder_params paramsCM256, CM256& cm256)
+{
+    DecoderSlot& decoderSlot = m_decoderSlots[slotIndex];
+
+    if (cm256.cm256_decode(paramsCM256, decoderSlot.m_cm256DescriptorBlocks)) // CM256 decode
+    {
+        qDebug() << "RemoteInputBuffer::decodeSlot: decode CM256 error:"
+                << " slotIndex: " << slotIndex
+                << " m_originalCount: " << decoderSlot.m_originalCount
+                << " m_recoveryCount: " << decoderSlot.m_recoveryCount;
+    }
+    else
+    {
+        qDebug() << "RemoteInputBuffer::decodeSlot: decode CM256 success:"
+                << " slotIndex: " << slotIndex
+                << " m_originalCount: " << decoderSlot.m_originalCount
+                << " m_recoveryCount: " << decoderSlot.m_recoveryCount;
+
+        for (int ir = 0; ir < decoderSlot.m_recoveryCount; ir++) // restore missing blocks
         {
-            RemoteMetaDataFEC *metaData = getMetaData(decoderIndex);
+            int recoveryIndex = RemoteNbOrginalBlocks - decoderSlot.m_recoveryCount + ir;
+            int blockIndex = decoderSlot.m_cm256DescriptorBlocks[recoveryIndex].Index;
+            uint8_t *recoveredBlock = (uint8_t *) decoderSlot.m_cm256DescriptorBlocks[recoveryIndex].Block;
 
-            if (!(*metaData == m_currentMeta))
+            if (blockIndex == 0) // first block with meta
             {
-                uint32_t sampleRate =  metaData->m_sampleRate;
+                RemoteMetaDataFEC *metaData = (RemoteMetaDataFEC *) recoveredBlock;
 
-                if (sampleRate != 0)
+                boost::crc_32_type crc32;
+                crc32.process_bytes(metaData, RemoteMetaDataFEC::getCRCBytes());
+
+                if (crc32.checksum() == metaData->m_crc32)
                 {
-                    m_bufferLenSec = (float) m_framesNbBytes / (float) (sampleRate * metaData->m_sampleBytes * 2);
-                    m_balCorrLimit = sampleRate / 400; // +/- 5% correction max per read
-                    m_readNbBytes = (sampleRate * metaData->m_sampleBytes * 2) / 20;
+                    decoderSlot.m_metaRetrieved = true;
+                    printMeta("RemoteInputBuffer::decodeSlot: recovered meta", metaData);
                 }
+                else
+                {
+                    qDebug() << "RemoteInputBuffer::decodeSlot: recovered meta: invalid CRC32";
+                }
+            }
+
+            storeOriginalBlock(slotIndex, blockIndex, recoveredBlock);
 
-                printMeta("RemoteInputBuffer::writeData: new meta", metaData); // print for change other than timestamp
+            qDebug() << "RemoteInputBuffer::decodeSlot: recovered block #" << blockIndex;
+        } // restore missing blocks
+    } // CM256 decode
+}
+
+void RemoteInputBuffer::checkSlotMeta(int slotIndex)
+{
+    if (m_decoderSlots[slotIndex].m_metaRetrieved) // block zero with its meta data has been received
+    {
+        RemoteMetaDataFEC *metaData = getMetaData(slotIndex);
+
+        if (!(*metaData == m_currentMeta))
+        {
+            uint32_t sampleRate =  metaData->m_sampleRate;
+
+            if (sampleRate != 0)
+            {
+                m_bufferLenSec = (float) m_framesNbBytes / (float) (sampleRate * metaData->m_sampleBytes * 2);
+                m_balCorrLimit = sampleRate / 400; // +/- 5% correction max per read
+                m_readNbBytes = (sampleRate * metaData->m_sampleBytes * 2) / 20;
             }
 
-            m_currentMeta = *metaData; // renew current meta
-        } // check block 0
-    } // decode
+            printMeta("RemoteInputBuffer::checkSlotMeta: new meta", metaData); // print for change other than timestamp
+        }
+
+        m_currentMeta = *metaData; // renew current meta
+    } // check block 0
+}
+
+void RemoteInputBuffer::collectCompleteFrames(bool wait)
+{
+    while (!m_completeFrames.empty())
+    {
+        const CompleteFrame& frame = m_completeFrames.front();
+
+        if (frame.m_fec)
+        {
+            if (wait) {
+                m_decoderPool.wait(frame.m_job);
+            } else if (!m_decoderPool.isDone(frame.m_job)) {
+                break;
+            }
+        }
+
+        completeFrame(frame);
+        m_completeFrames.pop_front();
+    }
+}
+
+void RemoteInputBuffer::waitCompleteSlot(int slotIndex)
+{
+    // frames are completed in order so the older frames are completed first
+    int nbFrames = 0;
+
+    for (int i = 0; i < (int) m_completeFrames.size(); i++)
+    {
+        if (m_completeFrames[i].m_slotIndex == slotIndex) {
+            nbFrames = i + 1;
+        }
+    }
+
+    for (int i = 0; i < nbFrames; i++)
+    {
+        const CompleteFrame& frame = m_completeFrames.front();
+
+        if (frame.m_fec) {
+            m_decoderPool.wait(frame.m_job);
+        }
+
+        completeFrame(frame);
+        m_completeFrames.pop_front();
+    }
+}
+
+void RemoteInputBuffer::completeFrame(const CompleteFrame& frame)
+{
+    m_nbFrames++;
+
+    if (frame.m_fec)
+    {
+        m_nbFECFrames++;
+        m_fecLatencyNs += frame.m_decodedNs - frame.m_queuedNs;
+    }
+
+    checkSlotMeta(frame.m_slotIndex);
 }
 
 uint8_t *RemoteInputBuffer::readData(int32_t length)
 {
-    uint8_t *buffer = (uint8_t *) m_frames;
+    uint8_t *buffer = m_frames;
     uint32_t readIndex = m_readIndex;
 
     m_nbReads++;
 
     // SEGFAULT FIX: arbitratily truncate so that it does not exceed buffer length
-    if (length > framesSize) {
-        length = framesSize;
+    if (length > m_framesNbBytes) {
+        length = m_framesNbBytes;
     }
 
     if (m_readIndex + length < m_framesNbBytes) // ends before buffer bound
@@ -381,6 +537,7 @@ void RemoteInputBuffer::printMeta(const QString& header, RemoteMetaDataFEC *meta
             << ":" << (int) metaData->m_sampleBits
             << ":" << (int) metaData->m_nbOriginalBlocks
             << ":" << (int) metaData->m_nbFECBlocks
+            << ":" << metaData->getBlockSize()
             << "|" << metaData->m_tv_sec
             << ":" << metaData->m_tv_usec
             << "|";
@@ -21,12 +21,14 @@
 #include <channel/remotedatablock.h>
 #include <QString>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <cstdlib>
+#include <deque>
 #include "cm256cc/cm256.h"
 #include "util/movingaverage.h"
+#include "util/orderedworkerpool.h"
 
 
-#define REMOTEINPUT_UDPSIZE 512               // UDP payload size
 #define REMOTEINPUT_NBORIGINALBLOCKS 128      // number of sample blocks per frame excluding FEC blocks
 #define REMOTEINPUT_NBDECODERSLOTS 16         // power of two sub multiple of uint16_t size. A too large one is superfluous.
 
@@ -37,9 +39,11 @@ public:
 	~RemoteInputBuffer();
 
 	// R/W operations
-	void writeData(char *array); //!< Write data into buffer.
+	void writeData(char *array, int size);        //!< Write a datagram into buffer.
 	uint8_t *readData(int32_t length);            //!< Read data from buffer
 
+	int getBlockSize() const { return m_blockSize; } //!< current datagram size
+
 	// meta data
 	const RemoteMetaDataFEC& getCurrentMeta() const { return m_currentMeta; }
 
@@ -56,6 +60,9 @@ public:
     float getAvgNbBlocks() const { return m_avgNbBlocks; }
     float getAvgOriginalBlocks() const { return m_avgOrigBlocks; }
     float getAvgNbRecovery() const { return m_avgNbRecovery; }
+    quint64 getNbFrames() const { return m_nbFrames; }       //!< frames complete since start
+    quint64 getNbFECFrames() const { return m_nbFECFrames; } //!< frames decoded with FEC since start
+    qint64 getFECLatencyNs() const { return m_fecLatencyNs; } //!< sum of the FEC decoding latencies since start
 
     int getMinNbBlocks()
     {
@@ -106,23 +113,13 @@ public:
         }
     }
 
-    static const int framesSize = REMOTEINPUT_NBDECODERSLOTS * (RemoteNbOrginalBlocks - 1) * RemoteNbBytesPerBlock;
-
 private:
     static const int nbDecoderSlots = REMOTEINPUT_NBDECODERSLOTS;
 
-#pragma pack(push, 1)
-    struct BufferFrame
-    {
-        RemoteProtectedBlock  m_blocks[RemoteNbOrginalBlocks - 1];
-    };
-#pragma pack(pop)
-
     struct DecoderSlot
     {
-        RemoteProtectedBlock m_blockZero;                                       //!< First block of a frame. Has meta data.
-        RemoteProtectedBlock m_originalBlocks[RemoteNbOrginalBlocks];        //!< Original blocks retrieved directly or by later FEC
-        RemoteProtectedBlock m_recoveryBlocks[RemoteNbOrginalBlocks];        //!< Recovery blocks (FEC blocks) with max size
+        uint8_t                *m_blockZero;          //!< First block of a frame. Has meta data.
+        uint8_t                *m_recoveryBlocks;     //!< Recovery blocks (FEC blocks) with max number
         CM256::cm256_block      m_cm256DescriptorBlocks[RemoteNbOrginalBlocks]; //!< CM256 decoder descriptors (block addresses and block indexes)
         int                     m_blockCount;         //!< number of blocks received for this frame
         int                     m_originalCount;      //!< number of original blocks received
@@ -131,10 +128,23 @@ private:
         bool                    m_metaRetrieved;      //!< true if meta data (block zero) was retrieved
     };
 
+    struct CompleteFrame
+    {
+        int     m_slotIndex;
+        bool    m_fec;       //!< FEC decoding job pushed
+        quint64 m_job;       //!< sequence of the decoding job
+        qint64  m_queuedNs;  //!< time the frame was complete
+        qint64  m_decodedNs; //!< time the decoding ended
+    };
+
     RemoteMetaDataFEC m_currentMeta;          //!< Stored current meta data
     CM256::cm256_encoder_params m_paramsCM256;          //!< CM256 decoder parameters block
     DecoderSlot          m_decoderSlots[nbDecoderSlots]; //!< CM256 decoding control/buffer slots
-    BufferFrame          m_frames[nbDecoderSlots];       //!< Samples buffer
+    int                  m_blockSize;                    //!< Size of the datagrams
+    int                  m_blockBytes;                   //!< Size of the protected data of a block
+    int                  m_frameBytes;                   //!< Size of the samples of a frame (all blocks but block zero)
+    uint8_t             *m_frames;                       //!< Samples buffer: one frame per decoder slot
+    uint8_t             *m_slotBlocks;                   //!< Block zero and recovery blocks of all decoder slots
     int                  m_framesNbBytes;                //!< Number of bytes in samples buffer
     int                  m_decoderIndexHead;     //!< index of the current head frame slot in decoding slots
     int                  m_frameHead;            //!< index of the current head frame sent
@@ -165,51 +175,53 @@ private:
     int      m_balCorrLimit;  //!< Correction absolute value limit in number of samples
     CM256    m_cm256;         //!< CM256 library
     bool     m_cm256_OK;      //!< CM256 library initialized OK
-
-    inline RemoteProtectedBlock* storeOriginalBlock(int slotIndex, int blockIndex, const RemoteProtectedBlock& protectedBlock)
+    OrderedWorkerPool m_decoderPool;            //!< FEC decoding of complete frames in parallel
+    CM256   *m_workerCM256;                     //!< decoder of each worker
+    std::deque<CompleteFrame> m_completeFrames; //!< complete frames in arrival order being decoded or waiting for their meta data check
+    QElapsedTimer m_clock;
+    quint64  m_nbFrames;      //!< (stats) frames complete
+    quint64  m_nbFECFrames;   //!< (stats) frames decoded with FEC
+    qint64   m_fecLatencyNs;  //!< (stats) sum of FEC decoding latencies
+
+    inline uint8_t *storeOriginalBlock(int slotIndex, int blockIndex, const uint8_t *protectedBlock)
     {
-        if (blockIndex == 0) {
-            // m_decoderSlots[slotIndex].m_originalBlocks[0] = protectedBlock;
-            // return &m_decoderSlots[slotIndex].m_originalBlocks[0];
-            m_decoderSlots[slotIndex].m_blockZero = protectedBlock;
-            return &m_decoderSlots[slotIndex].m_blockZero;
-        } else {
-            // m_decoderSlots[slotIndex].m_originalBlocks[blockIndex] = protectedBlock;
-            // return &m_decoderSlots[slotIndex].m_originalBlocks[blockIndex];
-            m_frames[slotIndex].m_blocks[blockIndex - 1] = protectedBlock;
-            return &m_frames[slotIndex].m_blocks[blockIndex - 1];
-        }
+        uint8_t *block = getOriginalBlock(slotIndex, blockIndex);
+        std::copy(protectedBlock, protectedBlock + m_blockBytes, block);
+        return block;
     }
 
-    inline RemoteProtectedBlock& getOriginalBlock(int slotIndex, int blockIndex)
+    inline uint8_t *getOriginalBlock(int slotIndex, int blockIndex)
     {
         if (blockIndex == 0) {
-            // return m_decoderSlots[slotIndex].m_originalBlocks[0];
             return m_decoderSlots[slotIndex].m_blockZero;
         } else {
-            // return m_decoderSlots[slotIndex].m_originalBlocks[blockIndex];
-            return m_frames[slotIndex].m_blocks[blockIndex - 1];
+            return &m_frames[slotIndex * m_frameBytes + (blockIndex - 1) * m_blockBytes];
         }
     }
 
     inline RemoteMetaDataFEC *getMetaData(int slotIndex)
     {
-        // return (MetaDataFEC *) &m_decoderSlots[slotIndex].m_originalBlocks[0];
-        return (RemoteMetaDataFEC *) &m_decoderSlots[slotIndex].m_blockZero;
+        return (RemoteMetaDataFEC *) m_decoderSlots[slotIndex].m_blockZero;
     }
 
     inline void resetOriginalBlocks(int slotIndex)
     {
-        // memset((void *) m_decoderSlots[slotIndex].m_originalBlocks, 0, m_nbOriginalBlocks * sizeof(ProtectedBlock));
-        memset((void *) &m_decoderSlots[slotIndex].m_blockZero, 0, sizeof(RemoteProtectedBlock));
-        memset((void *) m_frames[slotIndex].m_blocks, 0, (RemoteNbOrginalBlocks - 1) * sizeof(RemoteProtectedBlock));
+        memset((void *) m_decoderSlots[slotIndex].m_blockZero, 0, m_blockBytes);
+        memset((void *) &m_frames[slotIndex * m_frameBytes], 0, m_frameBytes);
     }
 
+    void setBlockSize(int blockSize);
+    bool isBlockSizeAnnounced(const char *array, int size) const;
     void initDecodeAllSlots();
     void initReadIndex();
     void rwCorrectionEstimate(int slotIndex);
     void checkSlotData(int slotIndex);
     void initDecodeSlot(int slotIndex);
+    void decodeSlot(int slotIndex, CM256::cm256_encoder_params paramsCM256, CM256& cm256);
+    void checkSlotMeta(int slotIndex);
+    void collectCompleteFrames(bool wait);
+    void waitCompleteSlot(int slotIndex);
+    void completeFrame(const CompleteFrame& frame);
 
     static void printMeta(const QString& header, RemoteMetaDataFEC *metaData);
 };
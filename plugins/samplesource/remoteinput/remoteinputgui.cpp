@@ -62,6 +62,8 @@ RemoteInputGui::RemoteInputGui(DeviceUISet *deviceUISet, QWidget* parent) :
     m_nbFECBlocks(0),
     m_sampleBits(16), // assume 16 bits to start with
     m_sampleBytes(2),
+    m_framesPerSec(0.0f),
+    m_fecLatencyUs(0),
     m_samplesCount(0),
     m_tickCount(0),
     m_addressEdited(false),
@@ -223,6 +225,8 @@ bool RemoteInputGui::handleMessage(const Message& message)
         m_nbOriginalBlocks = ((RemoteInput::MsgReportRemoteInputStreamTiming&)message).getNbOriginalBlocksPerFrame();
         m_sampleBits = ((RemoteInput::MsgReportRemoteInputStreamTiming&)message).getSampleBits();
         m_sampleBytes = ((RemoteInput::MsgReportRemoteInputStreamTiming&)message).getSampleBytes();
+        m_framesPerSec = ((RemoteInput::MsgReportRemoteInputStreamTiming&)message).getFramesPerSec();
+        m_fecLatencyUs = ((RemoteInput::MsgReportRemoteInputStreamTiming&)message).getFECLatencyUs();
 
         int nbFECBlocks = ((RemoteInput::MsgReportRemoteInputStreamTiming&)message).getNbFECBlocksPerFrame();
 
@@ -527,6 +531,8 @@ void RemoteInputGui::updateWithStreamTime()
 
     s = QString("%1").arg(m_maxNbRecovery, 2, 10, QChar('0'));
     ui->maxNbRecoveryText->setText(tr("%1").arg(s));
+    ui->maxNbRecoveryText->setToolTip(tr("Maximum number of recovery blocks used per frame\n%1 frames/s FEC decoding latency %2 ms")
+        .arg(m_framesPerSec, 0, 'f', 1).arg(m_fecLatencyUs / 1000.0, 0, 'f', 1));
 
     s = QString::number(m_nbOriginalBlocks + m_nbFECBlocks, 'f', 0);
     QString s1 = QString("%1").arg(m_nbFECBlocks, 2, 10, QChar('0'));
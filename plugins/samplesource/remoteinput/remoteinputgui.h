@@ -87,6 +87,8 @@ private:
     int m_nbFECBlocks;
     int m_sampleBits;
     int m_sampleBytes;
+    float m_framesPerSec;
+    int m_fecLatencyUs;
 
 	int m_samplesCount;
 	std::size_t m_tickCount;
@@ -22,6 +22,7 @@
 #include "dsp/dspcommands.h"
 #include "dsp/dspengine.h"
 #include "device/deviceapi.h"
+#include "util/udpbatch.h"
 
 #include "remoteinputudphandler.h"
 #include "remoteinput.h"
@@ -38,7 +39,7 @@ RemoteInputUDPHandler::RemoteInputUDPHandler(SampleSinkFifo *sampleFifo, DeviceA
 	m_dataPort(9090),
 	m_dataConnected(false),
 	m_udpBuf(0),
-	m_udpReadBytes(0),
+	m_udpSizes(0),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(0),
 	m_centerFrequency(0),
@@ -53,9 +54,15 @@ RemoteInputUDPHandler::RemoteInputUDPHandler(SampleSinkFifo *sampleFifo, DeviceA
     m_converterBuffer(0),
     m_converterBufferNbSamples(0),
     m_throttleToggle(false),
-	m_autoCorrBuffer(true)
+	m_autoCorrBuffer(true),
+    m_statsNbFrames(0),
+    m_statsNbFECFrames(0),
+    m_statsFECLatencyNs(0),
+    m_framesPerSec(0.0f),
+    m_fecLatencyUs(0)
 {
-    m_udpBuf = new char[RemoteUdpSize];
+    m_udpBuf = new char[RemoteMaxUdpSize * m_udpBatchSize];
+    m_udpSizes = new int[m_udpBatchSize];
 
 #ifdef USE_INTERNAL_TIMER
 #warning "Uses internal timer"
@@ -72,6 +79,7 @@ RemoteInputUDPHandler::~RemoteInputUDPHandler()
 {
 	stop();
 	delete[] m_udpBuf;
+	delete[] m_udpSizes;
 	if (m_converterBuffer) { delete[] m_converterBuffer; }
 #ifdef USE_INTERNAL_TIMER
     if (m_timer) {
@@ -111,6 +119,7 @@ void RemoteInputUDPHandler::start()
 	}
 
     m_elapsedTimer.start();
+    m_statsTimer.start();
     m_running = true;
 }
 
@@ -159,23 +168,27 @@ void RemoteInputUDPHandler::configureUDPLink(const QString& address, quint16 por
 
 void RemoteInputUDPHandler::dataReadyRead()
 {
-    m_udpReadBytes = 0;
-
-	while (m_dataSocket->hasPendingDatagrams() && m_dataConnected)
+	while (m_dataConnected && m_dataSocket->hasPendingDatagrams())
 	{
-		qint64 pendingDataSize = m_dataSocket->pendingDatagramSize();
-		m_udpReadBytes += m_dataSocket->readDatagram(&m_udpBuf[m_udpReadBytes], pendingDataSize, &m_remoteAddress, 0);
+		// with recvmmsg support all pending datagrams up to the batch size are read in one call
+		int nbDatagrams = UDPBatch::readDatagrams(m_dataSocket, m_udpBuf, RemoteMaxUdpSize, m_udpBatchSize, m_udpSizes, &m_remoteAddress);
+
+		for (int i = 0; i < nbDatagrams; i++)
+		{
+			if (m_udpSizes[i] >= RemoteUdpSize) { // the buffer checks the block size
+			    processData(&m_udpBuf[i * RemoteMaxUdpSize], m_udpSizes[i]);
+			}
+		}
 
-		if (m_udpReadBytes == RemoteUdpSize) {
-		    processData();
-		    m_udpReadBytes = 0;
+		if (nbDatagrams == 0) {
+			break;
 		}
 	}
 }
 
-void RemoteInputUDPHandler::processData()
+void RemoteInputUDPHandler::processData(char *udpBuf, int size)
 {
-    m_remoteInputBuffer.writeData(m_udpBuf);
+    m_remoteInputBuffer.writeData(udpBuf, size);
     const RemoteMetaDataFEC& metaData =  m_remoteInputBuffer.getCurrentMeta();
     bool change = false;
 
@@ -325,6 +338,7 @@ void RemoteInputUDPHandler::tick()
 	else
 	{
 		m_tickCount = 0;
+        updateFrameStats();
 
 		if (m_outputMessageQueueToGUI)
 		{
@@ -360,9 +374,33 @@ void RemoteInputUDPHandler::tick()
 	            nbOriginalBlocks,
 	            nbFECblocks,
 	            sampleBits,
-	            sampleBytes);
+	            sampleBytes,
+	            m_framesPerSec,
+	            m_fecLatencyUs);
 
 	            m_outputMessageQueueToGUI->push(report);
 		}
 	}
 }
+
+void RemoteInputUDPHandler::updateFrameStats()
+{
+    qint64 elapsedNs = m_statsTimer.nsecsElapsed();
+
+    if (elapsedNs <= 0) {
+        return;
+    }
+
+    quint64 nbFrames = m_remoteInputBuffer.getNbFrames();
+    quint64 nbFECFrames = m_remoteInputBuffer.getNbFECFrames();
+    qint64 fecLatencyNs = m_remoteInputBuffer.getFECLatencyNs();
+
+    m_framesPerSec = ((nbFrames - m_statsNbFrames) * 1e9) / elapsedNs;
+    m_fecLatencyUs = nbFECFrames == m_statsNbFECFrames ?
+        0 : ((fecLatencyNs - m_statsFECLatencyNs) / (qint64) (nbFECFrames - m_statsNbFECFrames)) / 1000;
+
+    m_statsNbFrames = nbFrames;
+    m_statsNbFECFrames = nbFECFrames;
+    m_statsFECLatencyNs = fecLatencyNs;
+    m_statsTimer.restart();
+}
@@ -52,6 +52,8 @@ public:
     uint64_t getTVmSec() const { return m_tv_msec; }
     int getMinNbBlocks() { return m_remoteInputBuffer.getMinNbBlocks(); }
     int getMaxNbRecovery() { return m_remoteInputBuffer.getMaxNbRecovery(); }
+    float getFramesPerSec() const { return m_framesPerSec; }
+    int getFECLatencyUs() const { return m_fecLatencyUs; }
 public slots:
 	void dataReadyRead();
 
@@ -67,8 +69,8 @@ private:
 	QHostAddress m_remoteAddress;
 	quint16 m_dataPort;
 	bool m_dataConnected;
-	char *m_udpBuf;
-	qint64 m_udpReadBytes;
+	char *m_udpBuf;  //!< m_udpBatchSize datagrams of up to RemoteMaxUdpSize bytes
+	int *m_udpSizes; //!< size of each datagram read in m_udpBuf
 	SampleSinkFifo *m_sampleFifo;
 	uint32_t m_samplerate;
 	uint64_t m_centerFrequency;
@@ -87,9 +89,19 @@ private:
     bool m_throttleToggle;
     bool m_autoCorrBuffer;
 
+    QElapsedTimer m_statsTimer;
+    quint64 m_statsNbFrames;      //!< frames complete at start of stats period
+    quint64 m_statsNbFECFrames;   //!< frames decoded with FEC at start of stats period
+    qint64 m_statsFECLatencyNs;   //!< sum of FEC latencies at start of stats period
+    float m_framesPerSec;         //!< frames complete per second during last stats period
+    int m_fecLatencyUs;           //!< average FEC decoding latency during last stats period
+
+	static const int m_udpBatchSize = 64; //!< datagrams read at once
+
 	void connectTimer();
     void disconnectTimer();
-	void processData();
+	void processData(char *udpBuf, int size);
+    void updateFrameStats();
 
 private slots:
 	void tick();
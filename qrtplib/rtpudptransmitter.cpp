@@ -187,6 +187,19 @@ int RTPUDPTransmitter::BindSockets()
     return 0;
 }
 
+void RTPUDPTransmitter::moveToThread(QThread *thread)
+{
+    QObject::moveToThread(thread);
+
+    if (m_rtpsock) {
+        m_rtpsock->moveToThread(thread);
+    }
+
+    if (m_rtcpsock && (m_rtcpsock != m_rtpsock)) {
+        m_rtcpsock->moveToThread(thread);
+    }
+}
+
 void RTPUDPTransmitter::Destroy()
 {
     if (!m_init) {
@@ -26,17 +26,21 @@
 
 AudioFifo::AudioFifo() :
 	m_fifo(0),
-	m_sampleSize(sizeof(AudioSample))
+	m_sampleSize(sizeof(AudioSample)),
+	m_size(0),
+	m_head(0),
+	m_tail(0),
+	m_clearRequest(0)
 {
-	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
 }
 
 AudioFifo::AudioFifo(uint32_t numSamples) :
 	m_fifo(0),
-    m_sampleSize(sizeof(AudioSample))
+    m_sampleSize(sizeof(AudioSample)),
+	m_size(0),
+	m_head(0),
+	m_tail(0),
+	m_clearRequest(0)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
@@ -65,101 +69,89 @@ bool AudioFifo::setSize(uint32_t numSamples)
 
 uint AudioFifo::write(const quint8* data, uint32_t numSamples)
 {
-	uint32_t total;
-	uint32_t remaining;
-	uint32_t copyLen;
-
 	if (m_fifo == 0) {
 		return 0;
 	}
 
-	m_mutex.lock();
-
-	total = MIN(numSamples, m_size - m_fill);
-	remaining = total;
+	uint32_t tail = m_tail.load();
+	uint32_t total = MIN(numSamples, m_size - distance(m_head.loadAcquire(), tail));
+	uint32_t remaining = total;
 
 	while (remaining != 0)
 	{
-		if (isFull())
-		{
-			m_mutex.unlock();
-			return total - remaining; // written so far
-		}
-
-		copyLen = MIN(remaining, m_size - m_fill);
-		copyLen = MIN(copyLen, m_size - m_tail);
-		memcpy(m_fifo + (m_tail * m_sampleSize), data, copyLen * m_sampleSize);
-		m_tail += copyLen;
-		m_tail %= m_size;
-		m_fill += copyLen;
+		uint32_t copyLen = MIN(remaining, m_size - position(tail));
+		memcpy(m_fifo + (position(tail) * m_sampleSize), data, copyLen * m_sampleSize);
+		tail = advance(tail, copyLen);
 		data += copyLen * m_sampleSize;
 		remaining -= copyLen;
 	}
 
-	m_mutex.unlock();
+	m_tail.storeRelease(tail); // publish samples to the reader
 	return total;
 }
 
 uint AudioFifo::read(quint8* data, uint32_t numSamples)
 {
-	uint32_t total;
-	uint32_t remaining;
-	uint32_t copyLen;
-
-	if (m_fifo == 0) {
+	if (!m_mutex.tryLock()) { // being resized
 		return 0;
 	}
 
-	m_mutex.lock();
+	if (m_fifo == 0)
+	{
+		m_mutex.unlock();
+		return 0;
+	}
 
-	total = MIN(numSamples, m_fill);
-	remaining = total;
+	serveClearRequest();
+	uint32_t head = m_head.load();
+	uint32_t total = MIN(numSamples, distance(head, m_tail.loadAcquire()));
+	uint32_t remaining = total;
 
 	while (remaining != 0)
 	{
-		if (isEmpty())
-		{
-			m_mutex.unlock();
-			return total - remaining; // read so far
-		}
-
-		copyLen = MIN(remaining, m_fill);
-		copyLen = MIN(copyLen, m_size - m_head);
-		memcpy(data, m_fifo + (m_head * m_sampleSize), copyLen * m_sampleSize);
-
-		m_head += copyLen;
-		m_head %= m_size;
-		m_fill -= copyLen;
+		uint32_t copyLen = MIN(remaining, m_size - position(head));
+		memcpy(data, m_fifo + (position(head) * m_sampleSize), copyLen * m_sampleSize);
+		head = advance(head, copyLen);
 		data += copyLen * m_sampleSize;
 		remaining -= copyLen;
 	}
 
+	m_head.storeRelease(head); // release space to the writer
 	m_mutex.unlock();
 	return total;
 }
 
 uint AudioFifo::drain(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	if (!m_mutex.tryLock()) { // being resized
+		return 0;
+	}
 
-	if(numSamples > m_fill)
+	if (m_size == 0)
 	{
-		numSamples = m_fill;
+		m_mutex.unlock();
+		return 0;
 	}
 
-	m_head = (m_head + numSamples) % m_size;
-	m_fill -= numSamples;
+	serveClearRequest();
+	uint32_t head = m_head.load();
+	numSamples = MIN(numSamples, distance(head, m_tail.loadAcquire()));
+	m_head.storeRelease(advance(head, numSamples));
+	m_mutex.unlock();
 
 	return numSamples;
 }
 
 void AudioFifo::clear()
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	m_clearRequest.storeRelease(1);
+}
 
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+void AudioFifo::serveClearRequest()
+{
+	if (m_clearRequest.loadAcquire() && m_clearRequest.testAndSetOrdered(1, 0)) {
+		m_head.storeRelease(m_tail.loadAcquire());
+	}
 }
 
 bool AudioFifo::create(uint32_t numSamples)
@@ -170,9 +162,9 @@ bool AudioFifo::create(uint32_t numSamples)
 		m_fifo = 0;
 	}
 
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	m_head.storeRelease(0);
+	m_tail.storeRelease(0);
+	m_clearRequest.storeRelease(0);
 
 	m_fifo = new qint8[numSamples * m_sampleSize];
 	m_size = numSamples;
@@ -22,10 +22,18 @@
 #include <QObject>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QAtomicInteger>
 
 #include "dsp/dsptypes.h"
 #include "export.h"
 
+/**
+ * Lock-free single producer single consumer ring of audio samples. Head and tail indexes run over
+ * twice the size so that a full FIFO can be told from an empty one. Each index is only written by
+ * its owner (the reader for head and the writer for tail) and they are kept on separate cache lines.
+ * The mutex only keeps the buffer from being reallocated by setSize() during a read. The reader
+ * never waits on it: it reads nothing while a resize is in progress.
+ */
 class SDRBASE_API AudioFifo : public QObject {
 	Q_OBJECT
 public:
@@ -33,18 +41,18 @@ public:
 	AudioFifo(uint32_t numSamples);
 	~AudioFifo();
 
-	bool setSize(uint32_t numSamples);
+	bool setSize(uint32_t numSamples); //!< Not to be called concurrently with write()
 
-	uint32_t write(const quint8* data, uint32_t numSamples);
-	uint32_t read(quint8* data, uint32_t numSamples);
+	uint32_t write(const quint8* data, uint32_t numSamples); //!< Writer side
+	uint32_t read(quint8* data, uint32_t numSamples);        //!< Reader side
 
-	uint32_t drain(uint32_t numSamples);
-	void clear();
+	uint32_t drain(uint32_t numSamples); //!< Reader side
+	void clear(); //!< Either side: samples written so far are dropped by the reader at its next read or drain
 
-	inline uint32_t flush() { return drain(m_fill); }
-	inline uint32_t fill() const { return m_fill; }
-	inline bool isEmpty() const { return m_fill == 0; }
-	inline bool isFull() const { return m_fill == m_size; }
+	inline uint32_t flush() { return drain(fill()); }
+	inline uint32_t fill() const { return distance(m_head.loadAcquire(), m_tail.loadAcquire()); }
+	inline bool isEmpty() const { return fill() == 0; }
+	inline bool isFull() const { return fill() == m_size; }
 	inline uint32_t size() const { return m_size; }
 
 private:
@@ -55,11 +63,15 @@ private:
 	const uint32_t m_sampleSize;
 
 	uint32_t m_size;
-	uint32_t m_fill;
-	uint32_t m_head;
-	uint32_t m_tail;
+	alignas(64) QAtomicInteger<uint32_t> m_head; //!< Read index in [0, 2*size[ - written by the reader only
+	alignas(64) QAtomicInteger<uint32_t> m_tail; //!< Write index in [0, 2*size[ - written by the writer only
+	alignas(64) QAtomicInt m_clearRequest;       //!< Set by clear() and served by the reader
 
 	bool create(uint32_t numSamples);
+	void serveClearRequest();
+	uint32_t distance(uint32_t head, uint32_t tail) const { return tail >= head ? tail - head : tail + 2*m_size - head; }
+	uint32_t advance(uint32_t index, uint32_t count) const { index += count; return index >= 2*m_size ? index - 2*m_size : index; }
+	uint32_t position(uint32_t index) const { return index < m_size ? index : index - m_size; }
 };
 
 #endif // INCLUDE_AUDIOFIFO_H
@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "audiomix.h"
+
+void AudioMix::add(qint32 *mix, const qint16 *samples, unsigned int nbValues)
+{
+    unsigned int i = 0;
+#ifdef USE_SSE2
+    for (; i + 8 <= nbValues; i += 8)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i*) &samples[i]);
+        // sign extension: 16 bit values in the upper half of 32 bit lanes shifted down arithmetically
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+        _mm_storeu_si128((__m128i*) &mix[i], _mm_add_epi32(_mm_loadu_si128((const __m128i*) &mix[i]), lo));
+        _mm_storeu_si128((__m128i*) &mix[i + 4], _mm_add_epi32(_mm_loadu_si128((const __m128i*) &mix[i + 4]), hi));
+    }
+#endif
+    for (; i < nbValues; i++) {
+        mix[i] += samples[i];
+    }
+}
+
+void AudioMix::saturate(qint16 *out, const qint32 *mix, unsigned int nbValues)
+{
+    unsigned int i = 0;
+#ifdef USE_SSE2
+    for (; i + 8 <= nbValues; i += 8)
+    {
+        __m128i lo = _mm_loadu_si128((const __m128i*) &mix[i]);
+        __m128i hi = _mm_loadu_si128((const __m128i*) &mix[i + 4]);
+        _mm_storeu_si128((__m128i*) &out[i], _mm_packs_epi32(lo, hi)); // signed saturation
+    }
+#endif
+    for (; i < nbValues; i++) {
+        out[i] = mix[i] < -32768 ? -32768 : mix[i] > 32767 ? 32767 : mix[i];
+    }
+}
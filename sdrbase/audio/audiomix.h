@@ -0,0 +1,38 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AUDIO_AUDIOMIX_H_
+#define SDRBASE_AUDIO_AUDIOMIX_H_
+
+#include <QtGlobal>
+
+#include "export.h"
+
+/**
+ * Kernels used to mix the audio FIFOs of the channels into an audio output. Channels are summed in
+ * 32 bit then the sum is saturated to 16 bit once so that the result does not depend on the order
+ * of the channels.
+ */
+class SDRBASE_API AudioMix
+{
+public:
+    static void add(qint32 *mix, const qint16 *samples, unsigned int nbValues);  //!< mix[i] += samples[i]
+    static void saturate(qint16 *out, const qint32 *mix, unsigned int nbValues); //!< out[i] = mix[i] clamped to [-32768, 32767]
+};
+
+#endif // SDRBASE_AUDIO_AUDIOMIX_H_
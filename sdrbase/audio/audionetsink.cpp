@@ -20,9 +20,12 @@
 
 #include "audionetsink.h"
 #include "util/rtpsink.h"
+#include "util/udpbatch.h"
 
 #include <QDebug>
 #include <QUdpSocket>
+#include <QThread>
+#include <QTimer>
 
 const int AudioNetSink::m_udpBlockSize = 512;
 
@@ -33,16 +36,21 @@ AudioNetSink::AudioNetSink(QObject *parent) :
     m_sampleRate(48000),
     m_stereo(false),
     m_decimation(1),
-    m_decimationCount(0),
     m_codecInputSize(960),
     m_codecInputIndex(0),
     m_bufferIndex(0),
-    m_port(9998)
+    m_port(9998),
+    m_channelMode(ChannelLeft),
+    m_batchCount(0),
+    m_thread(nullptr),
+    m_timer(nullptr)
 {
     std::fill(m_data, m_data+m_dataBlockSize, 0);
     std::fill(m_opusIn, m_opusIn+m_opusBlockSize, 0);
     m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
-    m_udpSocket = new QUdpSocket(parent);
+    m_udpSocket = new QUdpSocket(); // no parent so that it can be moved to the worker thread
+    m_fifo.setSize(m_sampleRate); // 1s
+    Q_UNUSED(parent);
 }
 
 AudioNetSink::AudioNetSink(QObject *parent, int sampleRate, bool stereo) :
@@ -52,26 +60,61 @@ AudioNetSink::AudioNetSink(QObject *parent, int sampleRate, bool stereo) :
     m_sampleRate(48000),
     m_stereo(false),
     m_decimation(1),
-    m_decimationCount(0),
     m_codecInputSize(960),
     m_codecInputIndex(0),
     m_bufferIndex(0),
-    m_port(9998)
+    m_port(9998),
+    m_channelMode(ChannelLeft),
+    m_batchCount(0),
+    m_thread(nullptr),
+    m_timer(nullptr)
 {
     std::fill(m_data, m_data+m_dataBlockSize, 0);
     std::fill(m_opusIn, m_opusIn+m_opusBlockSize, 0);
     m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
-    m_udpSocket = new QUdpSocket(parent);
+    m_udpSocket = new QUdpSocket(); // no parent so that it can be moved to the worker thread
     m_rtpBufferAudio = new RTPSink(m_udpSocket, sampleRate, stereo);
+    m_fifo.setSize(sampleRate); // 1s
+    Q_UNUSED(parent);
 }
 
 AudioNetSink::~AudioNetSink()
 {
+    if (m_thread)
+    {
+        m_thread->quit();
+        m_thread->wait();
+        delete m_thread; // the timer is deleted when the thread finishes
+    }
+
     if (m_rtpBufferAudio) {
         delete m_rtpBufferAudio;
     }
 
-    m_udpSocket->deleteLater(); // this thread is not the owner thread (was moved)
+    delete m_udpSocket; // the worker thread if any has finished so no event can reach the socket
+}
+
+void AudioNetSink::startWorker()
+{
+    if (m_thread) {
+        return;
+    }
+
+    m_batch.resize(UDPBatch::m_maxBatchSize * m_udpBlockSize);
+    m_thread = new QThread();
+    m_timer = new QTimer();
+    m_timer->setInterval(m_workerPeriodMs);
+    m_timer->moveToThread(m_thread);
+    m_udpSocket->moveToThread(m_thread); // written to by the worker only
+
+    if (m_rtpBufferAudio) {
+        m_rtpBufferAudio->moveToThread(m_thread);
+    }
+
+    QObject::connect(m_timer, &QTimer::timeout, m_timer, [this]() { handleInput(); });
+    QObject::connect(m_thread, &QThread::started, m_timer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    QObject::connect(m_thread, &QThread::finished, m_timer, &QObject::deleteLater);
+    m_thread->start();
 }
 
 bool AudioNetSink::isRTPCapable() const
@@ -81,6 +124,8 @@ bool AudioNetSink::isRTPCapable() const
 
 bool AudioNetSink::selectType(SinkType type)
 {
+    QMutexLocker mutexLocker(&m_mutex);
+
     if (type == SinkUDP)
     {
         m_type = SinkUDP;
@@ -95,6 +140,7 @@ bool AudioNetSink::selectType(SinkType type)
 
 void AudioNetSink::setDestination(const QString& address, uint16_t port)
 {
+    QMutexLocker mutexLocker(&m_mutex);
     m_address.setAddress(const_cast<QString&>(address));
     m_port = port;
 
@@ -105,6 +151,8 @@ void AudioNetSink::setDestination(const QString& address, uint16_t port)
 
 void AudioNetSink::addDestination(const QString& address, uint16_t port)
 {
+    QMutexLocker mutexLocker(&m_mutex);
+
     if (m_rtpBufferAudio) {
         m_rtpBufferAudio->addDestination(address, port);
     }
@@ -112,6 +160,8 @@ void AudioNetSink::addDestination(const QString& address, uint16_t port)
 
 void AudioNetSink::deleteDestination(const QString& address, uint16_t port)
 {
+    QMutexLocker mutexLocker(&m_mutex);
+
     if (m_rtpBufferAudio) {
         m_rtpBufferAudio->deleteDestination(address, port);
     }
@@ -124,6 +174,7 @@ void AudioNetSink::setParameters(Codec codec, bool stereo, int sampleRate)
             << " stereo: " << stereo
             << " sampleRate: " << sampleRate;
 
+    QMutexLocker mutexLocker(&m_mutex);
     m_codec = codec;
     m_stereo = stereo;
     m_sampleRate = sampleRate;
@@ -161,10 +212,17 @@ void AudioNetSink::setParameters(Codec codec, bool stereo, int sampleRate)
 
 void AudioNetSink::setDecimation(uint32_t decimation)
 {
+    QMutexLocker mutexLocker(&m_mutex);
     m_decimation = decimation < 1 ? 1 : decimation > 6 ? 6 : decimation;
     qDebug() << "AudioNetSink::setDecimation: " << m_decimation << " from: " << decimation;
     setNewCodecData();
-    m_decimationCount = 0;
+}
+
+void AudioNetSink::setChannelMode(ChannelMode channelMode)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_channelMode = channelMode;
+    setDecimationFilters(); // mono or stereo resampling
 }
 
 void AudioNetSink::setNewCodecData()
@@ -190,44 +248,116 @@ void AudioNetSink::setNewCodecData()
 void AudioNetSink::setDecimationFilters()
 {
     int decimatedSampleRate = m_sampleRate / m_decimation;
+    bool stereo = m_channelMode == ChannelStereo;
 
     switch (m_codec)
     {
     case CodecPCMA:
     case CodecPCMU:
-        m_audioFilter.setDecimFilters(m_sampleRate, decimatedSampleRate, 3300.0, 300.0);
+        m_audioResampler.setRates(m_sampleRate, decimatedSampleRate, stereo, 3300.0f);
         break;
     case CodecG722:
-        m_audioFilter.setDecimFilters(m_sampleRate, decimatedSampleRate, 7000.0, 50.0);
+        m_audioResampler.setRates(m_sampleRate, decimatedSampleRate, stereo, 7000.0f);
         break;
     case CodecOpus:
     case CodecL8:
     case CodecL16:
     default:
-        m_audioFilter.setDecimFilters(m_sampleRate, decimatedSampleRate, 0.45*decimatedSampleRate, 50.0);
+        m_audioResampler.setRates(m_sampleRate, decimatedSampleRate, stereo, 0.45f*decimatedSampleRate);
         break;
     }
 }
 
-void AudioNetSink::write(qint16 isample)
+uint32_t AudioNetSink::write(const AudioSample *samples, uint32_t nbSamples)
 {
-    qint16& sample = isample;
+    return m_fifo.write((const quint8*) samples, nbSamples);
+}
+
+void AudioNetSink::handleInput()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    uint32_t frameSamples = m_sampleRate < 50 ? 1 : m_sampleRate / 50; // 20ms
+
+    if (m_frames.size() < frameSamples) {
+        m_frames.resize(frameSamples);
+    }
+
+    bool stereo = m_channelMode == ChannelStereo;
 
-    if (m_decimation > 1)
+    if (m_codecSamples.size() < (stereo ? 2 : 1) * frameSamples) {
+        m_codecSamples.resize((stereo ? 2 : 1) * frameSamples);
+    }
+
+    while (m_fifo.fill() >= frameSamples)
     {
-        float lpSample = m_audioFilter.run(sample / 32768.0f);
+        uint32_t nbSamples = m_fifo.read((quint8*) m_frames.data(), frameSamples);
 
-        if (m_decimationCount >= m_decimation - 1)
+        for (uint32_t i = 0; i < nbSamples; i++)
         {
-            sample = lpSample * 32768.0f;
-            m_decimationCount = 0;
+            const AudioSample& s = m_frames[i];
+
+            switch (m_channelMode)
+            {
+            case ChannelStereo:
+                m_codecSamples[2*i]   = s.l;
+                m_codecSamples[2*i+1] = s.r;
+                break;
+            case ChannelMixed:
+                m_codecSamples[i] = (s.l + s.r) / 2;
+                break;
+            case ChannelRight:
+                m_codecSamples[i] = s.r;
+                break;
+            case ChannelLeft:
+            default:
+                m_codecSamples[i] = s.l;
+                break;
+            }
         }
-        else
+
+        const qint16 *codecSamples = m_codecSamples.data();
+
+        if (m_decimation > 1) // the whole frame is decimated in one block
         {
-            m_decimationCount++;
-            return;
+            nbSamples = m_audioResampler.resample(m_codecSamples.data(), nbSamples, m_resampledSamples);
+            codecSamples = m_resampledSamples.data();
         }
+
+        for (uint32_t i = 0; i < nbSamples; i++)
+        {
+            if (stereo) {
+                encode(codecSamples[2*i], codecSamples[2*i+1]);
+            } else {
+                encode(codecSamples[i]);
+            }
+        }
+    }
+
+    sendBatch();
+}
+
+void AudioNetSink::queueDatagram()
+{
+    if (m_batchCount == UDPBatch::m_maxBatchSize) {
+        sendBatch();
+    }
+
+    std::copy(m_data, m_data + m_udpBlockSize, &m_batch[m_batchCount * m_udpBlockSize]);
+    m_batchCount++;
+}
+
+void AudioNetSink::sendBatch()
+{
+    if (m_batchCount > 0)
+    {
+        UDPBatch::writeDatagrams(m_udpSocket, m_batch.data(), m_udpBlockSize, m_batchCount, m_address, m_port);
+        m_batchCount = 0;
     }
+}
+
+void AudioNetSink::encode(qint16 isample)
+{
+    qint16& sample = isample;
 
     if (m_type == SinkUDP)
     {
@@ -235,7 +365,7 @@ void AudioNetSink::write(qint16 isample)
         {
             if (m_bufferIndex >= 2*m_udpBlockSize)
             {
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
+                queueDatagram();
                 m_bufferIndex = 0;
             }
         }
@@ -243,7 +373,7 @@ void AudioNetSink::write(qint16 isample)
         {
             if (m_bufferIndex >= m_udpBlockSize)
             {
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
+                queueDatagram();
                 m_bufferIndex = 0;
             }
         }
@@ -340,7 +470,7 @@ void AudioNetSink::write(qint16 isample)
             {
                 int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
                 if (nbBytes != AudioOpus::m_bitrate/400) { // 8 bits for 1/50s (20ms)
-                    qWarning("AudioNetSink::write: CodecOpus mono: unexpected output frame size: %d bytes", nbBytes);
+                    qWarning("AudioNetSink::encode: CodecOpus mono: unexpected output frame size: %d bytes", nbBytes);
                 }
                 m_bufferIndex = 0;
                 m_codecInputIndex = 0;
@@ -361,34 +491,16 @@ void AudioNetSink::write(qint16 isample)
     }
 }
 
-void AudioNetSink::write(qint16 ilSample, qint16 irSample)
+void AudioNetSink::encode(qint16 ilSample, qint16 irSample)
 {
     qint16& lSample = ilSample;
     qint16& rSample = irSample;
 
-    if (m_decimation > 1)
-    {
-        float lpLSample = m_audioFilter.runLP(lSample / 32768.0f);
-        float lpRSample = m_audioFilter.runLP(rSample / 32768.0f);
-
-        if (m_decimationCount >= m_decimation - 1)
-        {
-            lSample = lpLSample * 32768.0f;
-            rSample = lpRSample * 32768.0f;
-            m_decimationCount = 0;
-        }
-        else
-        {
-            m_decimationCount++;
-            return;
-        }
-    }
-
     if (m_type == SinkUDP)
     {
         if (m_bufferIndex >= m_udpBlockSize)
         {
-            m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
+            queueDatagram();
             m_bufferIndex = 0;
         }
 
@@ -450,7 +562,7 @@ void AudioNetSink::write(qint16 ilSample, qint16 irSample)
             {
                 int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
                 if (nbBytes != AudioOpus::m_bitrate/400) { // 8 bits for 1/50s (20ms)
-                    qWarning("AudioNetSink::write: CodecOpus stereo: unexpected output frame size: %d bytes", nbBytes);
+                    qWarning("AudioNetSink::encode: CodecOpus stereo: unexpected output frame size: %d bytes", nbBytes);
                 }
                 m_bufferIndex = 0;
                 m_codecInputIndex = 0;
@@ -479,9 +591,3 @@ void AudioNetSink::write(qint16 ilSample, qint16 irSample)
         }
     }
 }
-
-void AudioNetSink::moveToThread(QThread *thread)
-{
-    m_udpSocket->moveToThread(thread);
-}
-
@@ -20,20 +20,30 @@
 #define SDRBASE_AUDIO_AUDIONETSINK_H_
 
 #include "dsp/dsptypes.h"
-#include "audiofilter.h"
+#include "audiofifo.h"
+#include "audioresampler.h"
 #include "audiocompressor.h"
 #include "audiog722.h"
 #include "audioopus.h"
 #include "export.h"
 
 #include <QObject>
+#include <QMutex>
 #include <QHostAddress>
 #include <stdint.h>
+#include <vector>
 
 class QUdpSocket;
 class RTPSink;
 class QThread;
+class QTimer;
 
+/**
+ * Copies audio to the network as plain UDP or RTP. The audio thread only copies stereo frames
+ * into a FIFO. Channel selection, decimation, encoding and packetization run in a worker thread
+ * that consumes the FIFO in whole 20ms frames. Fixed size UDP blocks produced by one pass of
+ * the worker are sent in one batch.
+ */
 class SDRBASE_API AudioNetSink {
 public:
     typedef enum
@@ -52,6 +62,14 @@ public:
         CodecOpus  //!< Opus compressed 8 bit samples at 64kbits/s (8kS/s out). Various input sample rates
     } Codec;
 
+    typedef enum
+    {
+        ChannelLeft,   //!< same values as AudioOutput::UDPChannelMode
+        ChannelRight,
+        ChannelMixed,
+        ChannelStereo
+    } ChannelMode;
+
     AudioNetSink(QObject *parent); //!< without RTP
     AudioNetSink(QObject *parent, int sampleRate, bool stereo); //!< with RTP
     ~AudioNetSink();
@@ -61,24 +79,29 @@ public:
     void deleteDestination(const QString& address, uint16_t port);
     void setParameters(Codec codec, bool stereo, int sampleRate);
     void setDecimation(uint32_t decimation);
+    void setChannelMode(ChannelMode channelMode);
 
-    void write(qint16 sample);
-    void write(qint16 lSample, qint16 rSample);
+    uint32_t write(const AudioSample *samples, uint32_t nbSamples); //!< Audio thread: returns the number of frames queued
+    void startWorker(); //!< Starts the encoding thread if not running. Until then nothing is sent
 
     bool isRTPCapable() const;
     bool selectType(SinkType type);
 
-    void moveToThread(QThread *thread);
-
     static const int m_udpBlockSize;
     static const int m_dataBlockSize = 65536; // room for G722 conversion (64000 = 12800*5 largest to date)
     static const int m_g722BlockSize = 12800; // number of resulting G722 bytes (80*20ms frames)
     static const int m_opusBlockSize = 960*2; // provision for 20ms of 2 int16 channels at 48 kS/s
     static const int m_opusOutputSize = 160;  // output frame: 20ms of 8 bit data @ 64 kbits/s = 160 bytes
+    static const int m_workerPeriodMs = 10;   // worker FIFO polling period
 
 protected:
     void setNewCodecData();       // actions to take when changes affecting codec dependent data occurs
-    void setDecimationFilters();  // set decimation filters limits depending on effective sample rate and codec
+    void setDecimationFilters();  // set resampler rates and cutoff depending on effective sample rate, codec and channel mode
+    void handleInput();           // worker: consumes the FIFO in 20ms frames
+    void encode(qint16 sample);
+    void encode(qint16 lSample, qint16 rSample);
+    void queueDatagram();         // worker: adds a UDP block of m_data to the batch
+    void sendBatch();
 
     SinkType m_type;
     Codec m_codec;
@@ -87,11 +110,10 @@ protected:
     AudioCompressor m_audioCompressor;
     AudioG722 m_g722;
     AudioOpus m_opus;
-    AudioFilter m_audioFilter;
+    AudioResampler m_audioResampler;
     int m_sampleRate;
     bool m_stereo;
     uint32_t m_decimation;
-    uint32_t m_decimationCount;
     char m_data[m_dataBlockSize];
     int16_t m_opusIn[m_opusBlockSize];
     int m_codecInputSize;  // codec input block size - for codecs with actual encoding (Opus only for now)
@@ -100,6 +122,16 @@ protected:
     unsigned int m_bufferIndex;
     QHostAddress m_address;
     unsigned int m_port;
+    ChannelMode m_channelMode;
+    AudioFifo m_fifo;          //!< audio thread to worker
+    AudioVector m_frames;      //!< worker read buffer
+    std::vector<qint16> m_codecSamples;     //!< worker: selected channels of a frame, stereo interleaved
+    std::vector<qint16> m_resampledSamples; //!< worker: codec samples after decimation
+    std::vector<char> m_batch; //!< UDP blocks waiting to be sent
+    int m_batchCount;
+    QThread *m_thread;         //!< worker thread started on demand
+    QTimer *m_timer;           //!< lives in the worker thread
+    QMutex m_mutex;            //!< settings against the worker
 };
 
 #endif /* SDRBASE_AUDIO_AUDIONETSINK_H_ */
@@ -23,6 +23,7 @@
 #include "audiooutput.h"
 #include "audiofifo.h"
 #include "audionetsink.h"
+#include "audiomix.h"
 
 AudioOutput::AudioOutput() :
 	m_mutex(QMutex::Recursive),
@@ -114,6 +115,11 @@ bool AudioOutput::start(int device, int rate)
 
         m_audioOutput = new QAudioOutput(devInfo, m_audioFormat);
         m_audioNetSink = new AudioNetSink(0, m_audioFormat.sampleRate(), false);
+        m_audioNetSink->setChannelMode((AudioNetSink::ChannelMode) m_udpChannelMode);
+
+        if (m_copyAudioToUdp) {
+            m_audioNetSink->startWorker();
+        }
 
         QIODevice::open(QIODevice::ReadOnly);
 
@@ -188,6 +194,10 @@ void AudioOutput::setUdpDestination(const QString& address, uint16_t port)
 void AudioOutput::setUdpCopyToUDP(bool copyToUDP)
 {
     m_copyAudioToUdp = copyToUDP;
+
+    if (m_copyAudioToUdp && m_audioNetSink) { // the worker keeps running once started
+        m_audioNetSink->startWorker();
+    }
 }
 
 void AudioOutput::setUdpUseRTP(bool useRTP)
@@ -200,6 +210,10 @@ void AudioOutput::setUdpUseRTP(bool useRTP)
 void AudioOutput::setUdpChannelMode(UDPChannelMode udpChannelMode)
 {
     m_udpChannelMode = udpChannelMode;
+
+    if (m_audioNetSink) {
+        m_audioNetSink->setChannelMode((AudioNetSink::ChannelMode) m_udpChannelMode);
+    }
 }
 
 void AudioOutput::setUdpChannelFormat(UDPChannelCodec udpChannelCodec, bool stereo, int sampleRate)
@@ -253,83 +267,16 @@ qint64 AudioOutput::readData(char* data, qint64 maxLen)
 	{
 		// use outputBuffer as temp - yes, one memcpy could be saved
 		unsigned int samples = (*it)->read((quint8*) data, samplesPerBuffer);
-		const qint16* src = (const qint16*) data;
-		std::vector<qint32>::iterator dst = m_mixBuffer.begin();
-
-//		if (samples != framesPerBuffer)
-//		{
-//            qDebug("AudioOutput::readData: read %d samples vs %d requested", samples, framesPerBuffer);
-//		}
-
-		for (unsigned int i = 0; i < samples; i++)
-		{
-			*dst += *src;
-			++src;
-			++dst;
-			*dst += *src;
-			++src;
-			++dst;
-		}
+		AudioMix::add(&m_mixBuffer[0], (const qint16*) data, 2 * samples); // stereo
     }
+
 	// convert to int16
 
-	//std::vector<qint32>::const_iterator src = m_mixBuffer.begin(); // Valgrind optim
 	qint16* dst = (qint16*) data;
-	qint32 sl, sr;
+	AudioMix::saturate(dst, &m_mixBuffer[0], 2 * samplesPerBuffer);
 
-	for (unsigned int i = 0; i < samplesPerBuffer; i++)
-	{
-		// left channel
-
-		//s = *src++; // Valgrind optim
-		sl = m_mixBuffer[2*i];
-
-		if(sl < -32768)
-		{
-			sl = -32768;
-		}
-		else if (sl > 32767)
-		{
-			sl = 32767;
-		}
-
-		*dst++ = sl;
-
-		// right channel
-
-		//s = *src++; // Valgrind optim
-		sr = m_mixBuffer[2*i + 1];
-
-		if(sr < -32768)
-		{
-			sr = -32768;
-		}
-		else if (sr > 32767)
-		{
-			sr = 32767;
-		}
-
-		*dst++ = sr;
-
-		if ((m_copyAudioToUdp) && (m_audioNetSink))
-		{
-	        switch (m_udpChannelMode)
-	        {
-            case UDPChannelStereo:
-                m_audioNetSink->write(sl, sr);
-                break;
-            case UDPChannelMixed:
-                m_audioNetSink->write((sl+sr)/2);
-                break;
-            case UDPChannelRight:
-                m_audioNetSink->write(sr);
-                break;
-	        case UDPChannelLeft:
-	        default:
-	            m_audioNetSink->write(sl);
-	            break;
-	        }
-		}
+	if ((m_copyAudioToUdp) && (m_audioNetSink)) {
+		m_audioNetSink->write((const AudioSample*) dst, samplesPerBuffer); // encoded and sent by the sink worker
 	}
 
 	return samplesPerBuffer * 4;
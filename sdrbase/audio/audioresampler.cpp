@@ -16,12 +16,35 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <math.h>
+#include <algorithm>
+#ifdef USE_AVX
+#include <immintrin.h>
+#elif defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
+#include <QDebug>
+
 #include "audioresampler.h"
 
+const int AudioResampler::m_minTapsPerPhase;
+const int AudioResampler::m_maxPhases;
+
 AudioResampler::AudioResampler() :
     m_decimation(1),
-    m_decimationCount(0)
-{}
+    m_decimationCount(0),
+    m_inputRate(0),
+    m_outputRate(0),
+    m_interpolation(1),
+    m_decimationQ(1),
+    m_nbChannels(1),
+    m_tapsPerPhase(m_minTapsPerPhase),
+    m_phase(0),
+    m_position(m_minTapsPerPhase - 1)
+{
+    setRates(48000, 48000);
+}
 
 AudioResampler::~AudioResampler()
 {}
@@ -93,3 +116,192 @@ bool AudioResampler::upSample(qint16 sampleIn, qint16& sampleOut)
 }
 
 
+
+void AudioResampler::setRates(int inputRate, int outputRate, bool stereo, float cutoff, float gain)
+{
+    inputRate = inputRate < 1 ? 1 : inputRate;
+    outputRate = outputRate < 1 ? 1 : outputRate;
+    m_inputRate = inputRate;
+    m_outputRate = outputRate;
+
+    int a = inputRate, b = outputRate;
+
+    while (b != 0)
+    {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+
+    m_interpolation = outputRate / a;
+    m_decimationQ = inputRate / a;
+
+    if (m_interpolation > m_maxPhases) // approximate the ratio
+    {
+        m_decimationQ = (int) round(((double) m_decimationQ * m_maxPhases) / m_interpolation);
+        m_decimationQ = m_decimationQ < 1 ? 1 : m_decimationQ;
+        m_interpolation = m_maxPhases;
+        qWarning("AudioResampler::setRates: %d -> %d approximated by %d/%d",
+            inputRate, outputRate, m_interpolation, m_decimationQ);
+    }
+
+    m_nbChannels = stereo ? 2 : 1;
+    // keep the same filter span in output samples when downsampling
+    m_tapsPerPhase = m_minTapsPerPhase * ((m_decimationQ + m_interpolation - 1) / m_interpolation);
+
+    // prototype low pass at the upsampled rate P * inputRate
+    int P = m_interpolation;
+    int nbTaps = P * m_tapsPerPhase;
+    double fc = cutoff > 0.0f ? cutoff : 0.45 * std::min(inputRate, outputRate);
+    fc = std::min(fc, 0.5 * std::min(inputRate, outputRate));
+    fc /= (double) inputRate * P; // normalized to the upsampled rate
+    std::vector<double> prototype(nbTaps);
+    double center = (nbTaps - 1) / 2.0;
+
+    for (int i = 0; i < nbTaps; i++)
+    {
+        double x = i - center;
+        double sinc = x == 0.0 ? 2.0 * fc : sin(2.0 * M_PI * fc * x) / (M_PI * x);
+        // Blackman-Harris window
+        double w = 2.0 * M_PI * i / (nbTaps - 1);
+        double window = 0.35875 - 0.48829 * cos(w) + 0.14128 * cos(2.0 * w) - 0.01168 * cos(3.0 * w);
+        prototype[i] = sinc * window;
+    }
+
+    double sum = 0.0;
+
+    for (int i = 0; i < nbTaps; i++) {
+        sum += prototype[i];
+    }
+
+    double norm = (P * gain) / sum; // each branch has a DC gain of about one
+
+    // branch p holds prototype[p + j*P] for j = 0..taps per phase - 1 in reverse order so that
+    // it runs forward on the samples from the oldest to the newest
+    m_taps.resize(P * m_tapsPerPhase * m_nbChannels);
+
+    for (int p = 0; p < P; p++)
+    {
+        for (int j = 0; j < m_tapsPerPhase; j++)
+        {
+            for (int c = 0; c < m_nbChannels; c++) {
+                m_taps[(p * m_tapsPerPhase + m_tapsPerPhase - 1 - j) * m_nbChannels + c] = prototype[p + j * P] * norm;
+            }
+        }
+    }
+
+    m_buffer.assign((m_tapsPerPhase - 1) * m_nbChannels, 0.0f);
+    m_phase = 0;
+    m_position = m_tapsPerPhase - 1;
+
+    qDebug("AudioResampler::setRates: %d -> %d P: %d Q: %d channels: %d",
+        inputRate, outputRate, m_interpolation, m_decimationQ, m_nbChannels);
+}
+
+unsigned int AudioResampler::getMaxOutputFrames(unsigned int nbInputFrames) const
+{
+    return (unsigned int) (((quint64) nbInputFrames * m_interpolation) / m_decimationQ) + 2;
+}
+
+unsigned int AudioResampler::resample(const float *in, unsigned int nbFrames, std::vector<float>& out)
+{
+    const int nbHistory = m_tapsPerPhase - 1;
+    const int nbFloats = m_tapsPerPhase * m_nbChannels;
+    unsigned int end = nbHistory + nbFrames;
+
+    m_buffer.resize(end * m_nbChannels);
+    std::copy(in, in + nbFrames * m_nbChannels, m_buffer.begin() + nbHistory * m_nbChannels);
+    out.resize(getMaxOutputFrames(nbFrames) * m_nbChannels);
+    unsigned int nbOut = 0;
+
+    while (m_position < end)
+    {
+        dotProduct(
+            &m_buffer[(m_position - nbHistory) * m_nbChannels],
+            &m_taps[m_phase * nbFloats],
+            nbFloats,
+            m_nbChannels,
+            &out[nbOut * m_nbChannels]
+        );
+        nbOut++;
+        m_phase += m_decimationQ;
+        m_position += m_phase / m_interpolation;
+        m_phase %= m_interpolation;
+    }
+
+    m_position -= nbFrames;
+    std::copy(m_buffer.begin() + nbFrames * m_nbChannels, m_buffer.begin() + end * m_nbChannels, m_buffer.begin());
+    out.resize(nbOut * m_nbChannels);
+
+    return nbOut;
+}
+
+unsigned int AudioResampler::resample(const qint16 *in, unsigned int nbFrames, std::vector<qint16>& out)
+{
+    unsigned int n = nbFrames * m_nbChannels;
+    m_floatIn.resize(n);
+
+    for (unsigned int i = 0; i < n; i++) {
+        m_floatIn[i] = in[i];
+    }
+
+    unsigned int nbOut = resample(m_floatIn.data(), nbFrames, m_floatOut);
+    n = nbOut * m_nbChannels;
+    out.resize(n);
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+        float s = m_floatOut[i];
+        out[i] = s < -32768.0f ? -32768 : s > 32767.0f ? 32767 : (qint16) lrintf(s);
+    }
+
+    return nbOut;
+}
+
+void AudioResampler::dotProduct(const float *samples, const float *taps, int n, int nbChannels, float *out)
+{
+    int i = 0;
+    float acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+#if defined(USE_AVX)
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+
+    for (; i + 16 <= n; i += 16)
+    {
+        sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(samples + i), _mm256_loadu_ps(taps + i)));
+        sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_loadu_ps(samples + i + 8), _mm256_loadu_ps(taps + i + 8)));
+    }
+
+    _mm256_storeu_ps(acc, _mm256_add_ps(sum0, sum1));
+#elif defined(USE_SSE2)
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+
+    for (; i + 8 <= n; i += 8)
+    {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(samples + i), _mm_loadu_ps(taps + i)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(samples + i + 4), _mm_loadu_ps(taps + i + 4)));
+    }
+
+    _mm_storeu_ps(acc, _mm_add_ps(sum0, sum1));
+#endif
+    // lanes alternate left and right for stereo: n is a multiple of 8 so lanes stay aligned with channels
+    for (; i < n; i += 2)
+    {
+        acc[0] += samples[i] * taps[i];
+        acc[1] += samples[i + 1] * taps[i + 1];
+    }
+
+    float even = acc[0] + acc[2] + acc[4] + acc[6];
+    float odd = acc[1] + acc[3] + acc[5] + acc[7];
+
+    if (nbChannels == 2)
+    {
+        out[0] = even;
+        out[1] = odd;
+    }
+    else
+    {
+        out[0] = even + odd;
+    }
+}
@@ -19,25 +19,61 @@
 #ifndef SDRBASE_AUDIO_AUDIORESAMPLER_H_
 #define SDRBASE_AUDIO_AUDIORESAMPLER_H_
 
+#include <vector>
+
 #include "dsp/dsptypes.h"
 #include "audiofilter.h"
+#include "export.h"
 
-class AudioResampler
+/**
+ * Two modes of operation:
+ * - per sample integer decimation or interpolation through a biquad audio filter (downSample, upSample)
+ * - block polyphase resampling by any P/Q rational ratio (setRates, resample). The ratio is the
+ *   input and output rates reduced by their GCD. Each output sample is the dot product of the
+ *   last input samples (taps per phase) with one of the P branches of a windowed sinc prototype.
+ *   Mono or interleaved stereo frames.
+ */
+class SDRBASE_API AudioResampler
 {
 public:
     AudioResampler();
     ~AudioResampler();
 
+    void setRates(int inputRate, int outputRate, bool stereo = false, float cutoff = 0.0f, float gain = 1.0f); //!< cutoff in Hz 0 for 0.45 of lowest rate
+    int getInputRate() const { return m_inputRate; }
+    int getOutputRate() const { return m_outputRate; }
+    unsigned int resample(const float *in, unsigned int nbFrames, std::vector<float>& out);   //!< returns number of output frames
+    unsigned int resample(const qint16 *in, unsigned int nbFrames, std::vector<qint16>& out); //!< returns number of output frames
+    unsigned int getMaxOutputFrames(unsigned int nbInputFrames) const; //!< upper bound of output frames for a number of input frames
+
     void setDecimation(uint32_t decimation);
     uint32_t getDecimation() const { return m_decimation; }
     void setAudioFilters(int srHigh, int srLow, int fcLow, int fcHigh, float gain=1.0f);
     bool downSample(qint16 sampleIn, qint16& sampleOut);
     bool upSample(qint16 sampleIn, qint16& sampleOut);
 
+    static const int m_minTapsPerPhase = 32; //!< when upsampling. Scaled by the decimation ratio when downsampling
+    static const int m_maxPhases = 1024;
+
 private:
     AudioFilter m_audioFilter;
     uint32_t m_decimation;
     uint32_t m_decimationCount;
+
+    int m_inputRate;
+    int m_outputRate;
+    int m_interpolation;         //!< P: number of polyphase branches
+    int m_decimationQ;           //!< Q: phase step per output sample
+    int m_nbChannels;
+    int m_tapsPerPhase;
+    int m_phase;                 //!< current branch
+    unsigned int m_position;     //!< frame index of the newest sample of the current output in the linear buffer
+    std::vector<float> m_taps;   //!< P branches of m_tapsPerPhase reversed taps repeated for each channel
+    std::vector<float> m_buffer; //!< linear buffer: m_tapsPerPhase - 1 history frames followed by the input block
+    std::vector<float> m_floatIn;
+    std::vector<float> m_floatOut;
+
+    static void dotProduct(const float *samples, const float *taps, int n, int nbChannels, float *out);
 };
 
 #endif /* SDRBASE_AUDIO_AUDIORESAMPLER_H_ */
@@ -33,6 +33,7 @@ namespace SWGSDRangel
     class SWGChannelSettings;
     class SWGChannelReport;
     class SWGChannelActions;
+    class SWGChannelPerf;
 }
 
 class SDRBASE_API ChannelAPI {
@@ -107,6 +108,17 @@ public:
         errorMessage = "Not implemented"; return 501;
     }
 
+    /**
+     * API adapter for the channel DSP performance counters GET requests
+     */
+    virtual int webapiPerfGet(
+            SWGSDRangel::SWGChannelPerf& response,
+            QString& errorMessage)
+    {
+        (void) response;
+        errorMessage = "Not implemented"; return 501;
+    }
+
     int getIndexInDeviceSet() const { return m_indexInDeviceSet; }
     void setIndexInDeviceSet(int indexInDeviceSet) { m_indexInDeviceSet = indexInDeviceSet; }
     int getDeviceSetIndex() const { return m_deviceSetIndex; }
@@ -26,12 +26,14 @@
 #define CHANNEL_REMOTEDATABLOCK_H_
 
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 #include <algorithm>
 #include <QString>
 #include "dsp/dsptypes.h"
 
-#define UDPSINKFEC_UDPSIZE 512
+#define UDPSINKFEC_UDPSIZE 512     // default datagram size
+#define UDPSINKFEC_MAXUDPSIZE 8952 // 9000 bytes jumbo frame MTU less IPv6 and UDP headers
 #define UDPSINKFEC_NBORIGINALBLOCKS 128
 //#define UDPSINKFEC_NBTXBLOCKS 8
 
@@ -48,18 +50,23 @@ struct RemoteMetaDataFEC
     uint32_t m_tv_sec;            //!< 20 seconds of timestamp at start time of super-frame processing
     uint32_t m_tv_usec;           //!< 24 microseconds of timestamp at start time of super-frame processing
     uint32_t m_crc32;             //!< 28 CRC32 of the above
+    uint16_t m_blockSize;         //!< 30 size of the frame datagrams in bytes. Not in CRC. 0 (older senders) for RemoteUdpSize
 
     bool operator==(const RemoteMetaDataFEC& rhs)
     {
-        // Only the first 6 fields are relevant
+        // Only the first 6 fields and block size are relevant
         return (m_centerFrequency == rhs.m_centerFrequency)
             && (m_sampleRate == rhs.m_sampleRate)
             && (m_sampleBytes == rhs.m_sampleBytes)
             && (m_sampleBits == rhs.m_sampleBits)
             && (m_nbOriginalBlocks == rhs.m_nbOriginalBlocks)
-            && (m_nbFECBlocks == rhs.m_nbFECBlocks);
+            && (m_nbFECBlocks == rhs.m_nbFECBlocks)
+            && (m_blockSize == rhs.m_blockSize);
     }
 
+    int getBlockSize() const { return m_blockSize == 0 ? UDPSINKFEC_UDPSIZE : m_blockSize; }
+    static int getCRCBytes() { return offsetof(RemoteMetaDataFEC, m_crc32); } //!< bytes covered by the CRC
+
     void init()
     {
         m_centerFrequency = 0;
@@ -71,6 +78,7 @@ struct RemoteMetaDataFEC
         m_tv_sec = 0;
         m_tv_usec = 0;
         m_crc32 = 0;
+        m_blockSize = 0;
     }
 };
 
@@ -95,9 +103,16 @@ struct RemoteHeader
 };
 
 static const int RemoteUdpSize = UDPSINKFEC_UDPSIZE;
+static const int RemoteMaxUdpSize = UDPSINKFEC_MAXUDPSIZE;
 static const int RemoteNbOrginalBlocks = UDPSINKFEC_NBORIGINALBLOCKS;
 static const int RemoteNbBytesPerBlock = UDPSINKFEC_UDPSIZE - sizeof(RemoteHeader);
 
+/** Datagram sizes from RemoteUdpSize to RemoteMaxUdpSize in multiples of 8 so that blocks hold whole 24 bit samples */
+inline bool isRemoteBlockSizeValid(int blockSize)
+{
+    return (blockSize >= RemoteUdpSize) && (blockSize <= RemoteMaxUdpSize) && (blockSize % 8 == 0);
+}
+
 struct RemoteProtectedBlock
 {
     uint8_t buf[RemoteNbBytesPerBlock];
@@ -158,18 +173,45 @@ struct RemoteRxControlBlock
     }
 };
 
+/**
+ * 256 blocks of a frame. Blocks are contiguous datagrams of block size bytes. m_superBlocks indexes
+ * them only with the default RemoteUdpSize; getSuperBlock() and getProtectedData() work with any size.
+ */
 class RemoteDataBlock
 {
 public:
-    RemoteDataBlock() {
-        m_superBlocks = new RemoteSuperBlock[256];
+    RemoteDataBlock() :
+        m_superBlocks(nullptr),
+        m_blockSize(0)
+    {
+        setBlockSize(RemoteUdpSize);
     }
     ~RemoteDataBlock() {
-        delete[] m_superBlocks;
+        delete[] (uint8_t *) m_superBlocks;
     }
+
+    void setBlockSize(int blockSize)
+    {
+        if (blockSize == m_blockSize) {
+            return;
+        }
+
+        delete[] (uint8_t *) m_superBlocks;
+        m_superBlocks = (RemoteSuperBlock *) new uint8_t[256 * blockSize]();
+        m_blockSize = blockSize;
+    }
+
+    int getBlockSize() const { return m_blockSize; }
+    int getProtectedBytes() const { return m_blockSize - sizeof(RemoteHeader); }
+    RemoteSuperBlock *getSuperBlock(int blockIndex) { return (RemoteSuperBlock *) &((uint8_t *) m_superBlocks)[blockIndex * m_blockSize]; }
+    uint8_t *getProtectedData(int blockIndex) { return &((uint8_t *) m_superBlocks)[blockIndex * m_blockSize + sizeof(RemoteHeader)]; }
+
     RemoteTxControlBlock m_txControlBlock;
     RemoteRxControlBlock m_rxControlBlock;
     RemoteSuperBlock     *m_superBlocks;
+
+private:
+    int m_blockSize;
 };
 
 #endif /* CHANNEL_REMOTEDATABLOCK_H_ */
@@ -49,6 +49,7 @@ DeviceAPI::DeviceAPI(
     m_buddySharedPtr(nullptr),
     m_isBuddyLeader(false),
     m_deviceSourceEngine(deviceSourceEngine),
+    m_fileRecord(nullptr),
     m_deviceSinkEngine(deviceSinkEngine),
     m_deviceMIMOEngine(deviceMIMOEngine)
 {
@@ -212,6 +213,24 @@ DeviceSampleSource *DeviceAPI::getSampleSource()
     }
 }
 
+SampleSinkSharedFifo *DeviceAPI::getSampleSinkSharedFifo()
+{
+    if (m_deviceSourceEngine) {
+        return m_deviceSourceEngine->getSharedFifo();
+    } else {
+        return nullptr;
+    }
+}
+
+FilterBankChannelizer *DeviceAPI::getFilterBankChannelizer()
+{
+    if (m_deviceSourceEngine) {
+        return m_deviceSourceEngine->getFilterBankChannelizer();
+    } else {
+        return nullptr;
+    }
+}
+
 DeviceSampleSink *DeviceAPI::getSampleSink()
 {
     if (m_deviceSinkEngine) {
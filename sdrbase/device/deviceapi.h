@@ -37,6 +37,9 @@ class PluginInstanceGUI;
 class DSPDeviceSourceEngine;
 class DSPDeviceSinkEngine;
 class DSPDeviceMIMOEngine;
+class SampleSinkSharedFifo;
+class FilterBankChannelizer;
+class FileRecord;
 class Preset;
 
 class SDRBASE_API DeviceAPI : public QObject {
@@ -90,6 +93,8 @@ public:
     DeviceSampleSource *getSampleSource();            //!< Return pointer to the device sample source (single Rx) or nullptr
     DeviceSampleSink *getSampleSink();                //!< Return pointer to the device sample sink (single Tx) or nullptr
     DeviceSampleMIMO *getSampleMIMO();                //!< Return pointer to the device sample MIMO or nullptr
+    void setFileRecord(FileRecord *fileRecord) { m_fileRecord = fileRecord; } //!< Set the baseband recorder of the device (single Rx)
+    FileRecord *getFileRecord() { return m_fileRecord; }                       //!< Return the baseband recorder of the device or nullptr
 
     bool initDeviceEngine(int subsystemIndex = 0);    //!< Init the device engine corresponding to the stream type
     bool startDeviceEngine(int subsystemIndex = 0);   //!< Start the device engine corresponding to the stream type
@@ -151,6 +156,8 @@ public:
     // void saveSinkSettings(Preset* preset);
 
     DSPDeviceSourceEngine *getDeviceSourceEngine() { return m_deviceSourceEngine; }
+    SampleSinkSharedFifo *getSampleSinkSharedFifo(); //!< Baseband FIFO shared by channels (single Rx) or nullptr
+    FilterBankChannelizer *getFilterBankChannelizer(); //!< Sub-bands of the shared baseband (single Rx) or nullptr
     DSPDeviceSinkEngine *getDeviceSinkEngine() { return m_deviceSinkEngine; }
 
     void addSourceBuddy(DeviceAPI* buddy);
@@ -202,6 +209,7 @@ protected:
 
     DSPDeviceSourceEngine *m_deviceSourceEngine;
     QList<ChannelAPI*> m_channelSinkAPIs;
+    FileRecord *m_fileRecord;
 
     // Single Tx (i.e. sink)
 
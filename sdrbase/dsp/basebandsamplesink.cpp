@@ -1,3 +1,6 @@
+#include "SWGChannelPerf.h"
+
+#include "dsp/samplesinkfifo.h"
 #include "basebandsamplesink.h"
 
 MESSAGE_CLASS_DEFINITION(BasebandSampleSink::MsgThreadedSink, Message)
@@ -25,3 +28,14 @@ void BasebandSampleSink::handleInputMessages()
 	}
 }
 
+void BasebandSampleSink::webapiFormatChannelPerf(
+    SWGSDRangel::SWGChannelPerf *apiChannelPerf,
+    SampleSinkFifo& basebandFifo,
+    MessageQueue *basebandInputMessageQueue
+)
+{
+    PerfCounter::webapiFormatPerfCounter(apiChannelPerf->getFeed(), m_feedPerf);
+    PerfCounter::webapiFormatPerfCounter(apiChannelPerf->getHandleData(), basebandFifo.getReadPerf());
+    SampleSinkFifo::webapiFormatFifoPerf(apiChannelPerf->getFifo(), basebandFifo);
+    apiChannelPerf->setInputQueueDepth(basebandInputMessageQueue->size());
+}
@@ -24,8 +24,15 @@
 #include "export.h"
 #include "util/messagequeue.h"
 #include "util/message.h"
+#include "util/perfcounter.h"
 
 class Message;
+class SampleSinkFifo;
+
+namespace SWGSDRangel
+{
+    class SWGChannelPerf;
+}
 
 class SDRBASE_API BasebandSampleSink : public QObject {
 	Q_OBJECT
@@ -62,10 +69,19 @@ public:
 	MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     void setMessageQueueToGUI(MessageQueue *queue) { m_guiMessageQueue = queue; }
     MessageQueue *getMessageQueueToGUI() { return m_guiMessageQueue; }
+    PerfCounter& getFeedPerf() { return m_feedPerf; } //!< Calls to feed() timed by the device DSP engine
 
 protected:
 	MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
     MessageQueue *m_guiMessageQueue;  //!< Input message queue to the GUI
+    PerfCounter m_feedPerf;
+
+    /** Performance counters of a channel: feed from the device engine then processing of the baseband FIFO in the channel thread */
+    void webapiFormatChannelPerf(
+        SWGSDRangel::SWGChannelPerf *apiChannelPerf,
+        SampleSinkFifo& basebandFifo,
+        MessageQueue *basebandInputMessageQueue
+    );
 
 protected slots:
 	void handleInputMessages();
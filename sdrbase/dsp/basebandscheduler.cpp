@@ -0,0 +1,414 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <iterator>
+
+#include <QFile>
+#include <QStringList>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include "dsp/samplesinkfifo.h"
+#include "basebandscheduler.h"
+
+BasebandTask::BasebandTask(BasebandScheduler *scheduler, SampleSinkFifo *sampleFifo, const std::function<void()>& run) :
+    m_scheduler(scheduler),
+    m_sampleFifo(sampleFifo),
+    m_run(run),
+    m_node(-1),
+    m_state(StateIdle),
+    m_enabled(0),
+    m_scheduling(0)
+{
+    // direct connection: scheduled from the thread writing to the FIFO
+    m_dataReadyConnection = QObject::connect(m_sampleFifo, &SampleSinkFifo::dataReady, [this]() { schedule(); });
+}
+
+BasebandTask::~BasebandTask()
+{
+    QObject::disconnect(m_dataReadyConnection);
+    stop();
+}
+
+void BasebandTask::start(int deviceSetIndex)
+{
+    m_node = m_scheduler->getDeviceSetNode(deviceSetIndex);
+    m_enabled.storeRelease(1);
+    schedule(); // process what has been queued while stopped
+}
+
+void BasebandTask::stop()
+{
+    m_enabled.storeRelease(0);
+
+    while (m_scheduling.loadAcquire() != 0) { // let schedule() calls in progress complete
+        QThread::yieldCurrentThread();
+    }
+
+    m_scheduler->remove(this);
+
+    while (m_state.loadAcquire() != StateIdle) { // popped by a worker or running
+        QThread::yieldCurrentThread();
+    }
+}
+
+void BasebandTask::schedule()
+{
+    m_scheduling.ref();
+
+    while (m_enabled.loadAcquire())
+    {
+        int state = m_state.loadAcquire();
+
+        if (state == StateIdle)
+        {
+            if (m_state.testAndSetOrdered(StateIdle, StateScheduled))
+            {
+                m_scheduler->push(this);
+                break;
+            }
+        }
+        else if (state == StateRunning)
+        {
+            if (m_state.testAndSetOrdered(StateRunning, StateRescheduled)) {
+                break;
+            }
+        }
+        else // already scheduled
+        {
+            break;
+        }
+    }
+
+    m_scheduling.deref();
+}
+
+BasebandScheduler::BasebandScheduler(int nbWorkers, bool numaPinning) :
+    m_numaPinning(numaPinning),
+    m_nextWorker(0),
+    m_nbIdle(0),
+    m_stop(false)
+{
+    if (nbWorkers <= 0) {
+        nbWorkers = std::max(1, QThread::idealThreadCount());
+    }
+
+    if (m_numaPinning) {
+        getNUMANodes(m_nodeCPUs);
+    }
+
+    if (m_nodeCPUs.size() == 0) // no pinning: all workers in a single node
+    {
+        m_numaPinning = false;
+        m_nodeWorkers.resize(1);
+
+        for (int i = 0; i < nbWorkers; i++) {
+            m_nodeWorkers[0].push_back(i);
+        }
+    }
+    else // spread the workers on the nodes in proportion to their number of CPUs
+    {
+        std::vector<int> cpuNodes; // node of each CPU interleaving the nodes
+        unsigned int maxNodeCPUs = 0;
+        m_nodeWorkers.resize(m_nodeCPUs.size());
+
+        for (unsigned int node = 0; node < m_nodeCPUs.size(); node++) {
+            maxNodeCPUs = std::max(maxNodeCPUs, (unsigned int) m_nodeCPUs[node].size());
+        }
+
+        for (unsigned int i = 0; i < maxNodeCPUs; i++)
+        {
+            for (unsigned int node = 0; node < m_nodeCPUs.size(); node++)
+            {
+                if (i < m_nodeCPUs[node].size()) {
+                    cpuNodes.push_back(node);
+                }
+            }
+        }
+
+        for (int i = 0; i < nbWorkers; i++) {
+            m_nodeWorkers[cpuNodes[i % cpuNodes.size()]].push_back(i);
+        }
+
+        for (unsigned int node = 0; node < m_nodeWorkers.size();) // less workers than nodes
+        {
+            if (m_nodeWorkers[node].size() == 0)
+            {
+                m_nodeWorkers.erase(m_nodeWorkers.begin() + node);
+                m_nodeCPUs.erase(m_nodeCPUs.begin() + node);
+            }
+            else
+            {
+                node++;
+            }
+        }
+    }
+
+    m_workers.resize(nbWorkers);
+
+    for (unsigned int node = 0; node < m_nodeWorkers.size(); node++)
+    {
+        for (std::vector<int>::const_iterator it = m_nodeWorkers[node].begin(); it != m_nodeWorkers[node].end(); ++it) {
+            m_workers[*it] = new Worker(this, *it, node);
+        }
+    }
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it) {
+        (*it)->start();
+    }
+
+    qDebug("BasebandScheduler::BasebandScheduler: %d workers on %d nodes NUMA pinning: %s",
+        nbWorkers, getNbNodes(), m_numaPinning ? "on" : "off");
+}
+
+BasebandScheduler::~BasebandScheduler()
+{
+    m_idleMutex.lock();
+    m_stop = true;
+    m_taskQueued.wakeAll();
+    m_idleMutex.unlock();
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+}
+
+int BasebandScheduler::getDeviceSetNode(int deviceSetIndex) const
+{
+    if (!m_numaPinning || (deviceSetIndex < 0)) {
+        return -1;
+    }
+
+    return deviceSetIndex % m_nodeWorkers.size();
+}
+
+void BasebandScheduler::push(BasebandTask *task)
+{
+    unsigned int next = m_nextWorker.fetchAndAddRelaxed(1);
+
+    if (task->m_node < 0) {
+        push(task, next % m_workers.size());
+    } else {
+        push(task, m_nodeWorkers[task->m_node][next % m_nodeWorkers[task->m_node].size()]);
+    }
+}
+
+void BasebandScheduler::push(BasebandTask *task, int workerIndex)
+{
+    Worker *worker = m_workers[workerIndex];
+    worker->m_mutex.lock();
+    worker->m_tasks.push_back(task);
+    worker->m_mutex.unlock();
+
+    // full barrier: pairs with the increment of the idle count before an idle worker checks the queues
+    if (m_nbIdle.fetchAndAddOrdered(0) > 0)
+    {
+        QMutexLocker mutexLocker(&m_idleMutex);
+
+        if (task->m_node < 0) {
+            m_taskQueued.wakeOne();
+        } else {
+            m_taskQueued.wakeAll(); // the woken worker has to be on the node
+        }
+    }
+}
+
+void BasebandScheduler::remove(BasebandTask *task)
+{
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        QMutexLocker mutexLocker(&(*it)->m_mutex);
+        std::deque<BasebandTask*>::iterator taskIt = std::find((*it)->m_tasks.begin(), (*it)->m_tasks.end(), task);
+
+        if (taskIt != (*it)->m_tasks.end())
+        {
+            (*it)->m_tasks.erase(taskIt);
+            task->m_state.storeRelease(BasebandTask::StateIdle);
+        }
+    }
+}
+
+bool BasebandScheduler::canRun(const BasebandTask *task, int workerIndex) const
+{
+    return (task->m_node < 0) || (task->m_node == m_workers[workerIndex]->getNode());
+}
+
+BasebandTask *BasebandScheduler::pop(int workerIndex)
+{
+    Worker *worker = m_workers[workerIndex];
+    BasebandTask *task = nullptr;
+
+    worker->m_mutex.lock();
+
+    if (worker->m_tasks.size() > 0)
+    {
+        task = worker->m_tasks.front();
+        worker->m_tasks.pop_front();
+    }
+
+    worker->m_mutex.unlock();
+
+    if (task) {
+        return task;
+    }
+
+    // steal from the other workers starting with the next one
+    for (unsigned int i = 1; i < m_workers.size(); i++)
+    {
+        Worker *victim = m_workers[(workerIndex + i) % m_workers.size()];
+        QMutexLocker mutexLocker(&victim->m_mutex);
+
+        for (std::deque<BasebandTask*>::reverse_iterator it = victim->m_tasks.rbegin(); it != victim->m_tasks.rend(); ++it)
+        {
+            if (canRun(*it, workerIndex))
+            {
+                task = *it;
+                victim->m_tasks.erase(std::next(it).base());
+                return task;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+bool BasebandScheduler::hasWork(int workerIndex)
+{
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        QMutexLocker mutexLocker(&(*it)->m_mutex);
+
+        for (std::deque<BasebandTask*>::const_iterator taskIt = (*it)->m_tasks.begin(); taskIt != (*it)->m_tasks.end(); ++taskIt)
+        {
+            if (canRun(*taskIt, workerIndex)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void BasebandScheduler::runWorker(int index)
+{
+    if (m_numaPinning) {
+        pinWorker(index);
+    }
+
+    while (true)
+    {
+        BasebandTask *task = pop(index);
+
+        if (!task)
+        {
+            QMutexLocker mutexLocker(&m_idleMutex);
+
+            if (m_stop) {
+                break;
+            }
+
+            m_nbIdle.fetchAndAddOrdered(1);
+
+            if (!hasWork(index)) {
+                m_taskQueued.wait(&m_idleMutex);
+            }
+
+            m_nbIdle.fetchAndAddOrdered(-1);
+            continue;
+        }
+
+        task->m_state.storeRelease(BasebandTask::StateRunning);
+
+        if (task->m_enabled.loadAcquire()) {
+            task->m_run();
+        }
+
+        if (!task->m_state.testAndSetOrdered(BasebandTask::StateRunning, BasebandTask::StateIdle)) // scheduled while running
+        {
+            if (task->m_enabled.loadAcquire())
+            {
+                task->m_state.storeRelease(BasebandTask::StateScheduled);
+                push(task, canRun(task, index) ? index : m_nodeWorkers[task->m_node].front());
+            }
+            else
+            {
+                task->m_state.storeRelease(BasebandTask::StateIdle);
+            }
+        }
+    }
+}
+
+void BasebandScheduler::pinWorker(int index)
+{
+#if defined(__linux__)
+    const std::vector<int>& cpus = m_nodeCPUs[m_workers[index]->getNode()];
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+
+    for (std::vector<int>::const_iterator it = cpus.begin(); it != cpus.end(); ++it) {
+        CPU_SET(*it, &cpuSet);
+    }
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0) {
+        qWarning("BasebandScheduler::pinWorker: cannot pin worker %d to node %d", index, m_workers[index]->getNode());
+    }
+#else
+    (void) index;
+#endif
+}
+
+void BasebandScheduler::getNUMANodes(std::vector<std::vector<int>>& nodeCPUs)
+{
+    nodeCPUs.clear();
+#if defined(__linux__)
+    for (int node = 0;; node++)
+    {
+        QFile cpuList(QString("/sys/devices/system/node/node%1/cpulist").arg(node));
+
+        if (!cpuList.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            break;
+        }
+
+        std::vector<int> cpus;
+        QStringList ranges = QString(cpuList.readAll()).trimmed().split(",", QString::SkipEmptyParts);
+
+        for (int i = 0; i < ranges.size(); i++) // e.g. 0-7,16-23
+        {
+            QStringList bounds = ranges[i].split("-");
+            int first = bounds[0].toInt();
+            int last = bounds.size() > 1 ? bounds[1].toInt() : first;
+
+            for (int cpu = first; cpu <= last; cpu++) {
+                cpus.push_back(cpu);
+            }
+        }
+
+        if (cpus.size() > 0) { // memory only nodes have no CPU
+            nodeCPUs.push_back(cpus);
+        }
+    }
+#endif
+}
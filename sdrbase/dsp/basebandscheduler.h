@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_BASEBANDSCHEDULER_H_
+#define SDRBASE_DSP_BASEBANDSCHEDULER_H_
+
+#include <deque>
+#include <vector>
+#include <functional>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QMetaObject>
+
+#include "export.h"
+
+class SampleSinkFifo;
+class BasebandScheduler;
+
+/**
+ * Processing of a channel baseband by the workers of a BasebandScheduler. The task is scheduled each time
+ * its sample FIFO signals new data. It never runs on two workers at the same time and if it is scheduled
+ * again while running it runs once more afterwards so that the samples of a channel are always processed
+ * in order by a single worker at a time.
+ */
+class SDRBASE_API BasebandTask
+{
+public:
+    BasebandTask(BasebandScheduler *scheduler, SampleSinkFifo *sampleFifo, const std::function<void()>& run);
+    ~BasebandTask(); //!< Stops the task
+
+    void start(int deviceSetIndex); //!< Start processing on the workers of the NUMA node of the device set if pinned
+    void stop();     //!< Stop processing. Returns when the task is no longer running.
+    void schedule(); //!< Run the task as soon as possible. May be called from any thread.
+
+private:
+    enum State
+    {
+        StateIdle,
+        StateScheduled,
+        StateRunning,
+        StateRescheduled //!< scheduled again while running
+    };
+
+    BasebandScheduler *m_scheduler;
+    SampleSinkFifo *m_sampleFifo;
+    std::function<void()> m_run;
+    QMetaObject::Connection m_dataReadyConnection;
+    int m_node;              //!< NUMA node or -1 if runnable by any worker
+    QAtomicInt m_state;
+    QAtomicInt m_enabled;
+    QAtomicInt m_scheduling; //!< schedule() calls in progress
+
+    friend class BasebandScheduler;
+};
+
+/**
+ * Work stealing executor running the baseband tasks of the channels on a fixed number of threads
+ * instead of one thread per channel. Each worker has its own queue of scheduled tasks. A worker with
+ * an empty queue takes the tasks queued on the other workers. When NUMA pinning is enabled the workers
+ * are bound to the CPUs of their node and the tasks of a device set only run on the workers of the node
+ * the device set is assigned to (round robin on the device set index).
+ */
+class SDRBASE_API BasebandScheduler
+{
+public:
+    BasebandScheduler(int nbWorkers = 0, bool numaPinning = false); //!< 0 workers: one per core
+    ~BasebandScheduler();
+
+    int getNbWorkers() const { return m_workers.size(); }
+    int getNbNodes() const { return m_nodeWorkers.size(); }
+    bool getNUMAPinning() const { return m_numaPinning; }
+    int getDeviceSetNode(int deviceSetIndex) const; //!< -1 if tasks of the device set are not pinned
+
+private:
+    class Worker : public QThread
+    {
+    public:
+        Worker(BasebandScheduler *scheduler, int index, int node) :
+            m_scheduler(scheduler),
+            m_index(index),
+            m_node(node)
+        {}
+        int getNode() const { return m_node; }
+        QMutex m_mutex; //!< protects the queue
+        std::deque<BasebandTask*> m_tasks;
+    protected:
+        virtual void run() { m_scheduler->runWorker(m_index); }
+    private:
+        BasebandScheduler *m_scheduler;
+        int m_index;
+        int m_node;
+    };
+
+    std::vector<Worker*> m_workers;
+    std::vector<std::vector<int>> m_nodeWorkers; //!< worker indexes per NUMA node
+    std::vector<std::vector<int>> m_nodeCPUs;    //!< CPUs per NUMA node
+    bool m_numaPinning;
+    QAtomicInt m_nextWorker; //!< round robin of the tasks scheduled from outside the workers
+    QAtomicInt m_nbIdle;     //!< workers waiting for tasks
+    bool m_stop;
+    QMutex m_idleMutex;
+    QWaitCondition m_taskQueued;
+
+    void push(BasebandTask *task);
+    void push(BasebandTask *task, int workerIndex);
+    void remove(BasebandTask *task); //!< Remove a stopped task from the queues
+    BasebandTask *pop(int workerIndex);
+    bool hasWork(int workerIndex);
+    bool canRun(const BasebandTask *task, int workerIndex) const;
+    void runWorker(int index);
+    void pinWorker(int index);
+    static void getNUMANodes(std::vector<std::vector<int>>& nodeCPUs);
+
+    friend class BasebandTask;
+};
+
+#endif // SDRBASE_DSP_BASEBANDSCHEDULER_H_
@@ -16,6 +16,8 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <QString>
 #include <QDebug>
 
@@ -26,6 +28,7 @@
 
 DownChannelizer::DownChannelizer(ChannelSampleSink* sampleSink) :
     m_filterChainSetMode(false),
+    m_blockMode(true),
 	m_sampleSink(sampleSink),
 	m_basebandSampleRate(0),
 	m_requestedOutputSampleRate(0),
@@ -50,41 +53,79 @@ void DownChannelizer::feed(const SampleVector::const_iterator& begin, const Samp
 		return;
 	}
 
-	if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
-	{
+	if (m_filterStages.size() == 0) { // optimization when no downsampling is done anyway
 		m_sampleSink->feed(begin, end);
+	} else if (m_blockMode) {
+		feedBlock(begin, end);
+	} else {
+		feedSample(begin, end);
+	}
+}
+
+void DownChannelizer::feedBlock(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+	int nbSamples = end - begin;
+
+	if ((int) m_blockBuffer.size() < nbSamples) {
+		m_blockBuffer.resize(nbSamples);
 	}
-	else
+
+	std::copy(begin, end, m_blockBuffer.begin());
+	Sample *samples = m_blockBuffer.data();
+
+	for (FilterStages::iterator stage = m_filterStages.begin(); stage != m_filterStages.end(); ++stage)
 	{
-		for (SampleVector::const_iterator sample = begin; sample != end; ++sample)
+#ifndef SDR_RX_SAMPLE_24BIT
+		for (int i = 0; i < nbSamples; i++)
 		{
-			Sample s(*sample);
-			FilterStages::iterator stage = m_filterStages.begin();
+			samples[i].m_real /= 2; // avoid saturation on 16 bit samples
+			samples[i].m_imag /= 2;
+		}
+#endif
+		nbSamples = (*stage)->workBlock(samples, nbSamples);
+	}
+
+#ifdef SDR_RX_SAMPLE_24BIT
+	for (int i = 0; i < nbSamples; i++)
+	{
+		samples[i].m_real /= (1<<(m_filterStages.size())); // on 32 bit samples there is enough headroom to just divide the final result
+		samples[i].m_imag /= (1<<(m_filterStages.size()));
+	}
+#endif
+
+	m_sampleSink->feed(m_blockBuffer.begin(), m_blockBuffer.begin() + nbSamples);
+}
+
+void DownChannelizer::feedSample(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+	for (SampleVector::const_iterator sample = begin; sample != end; ++sample)
+	{
+		Sample s(*sample);
+		FilterStages::iterator stage = m_filterStages.begin();
 
-			for (; stage != m_filterStages.end(); ++stage)
-			{
+		for (; stage != m_filterStages.end(); ++stage)
+		{
 #ifndef SDR_RX_SAMPLE_24BIT
-                s.m_real /= 2; // avoid saturation on 16 bit samples
-                s.m_imag /= 2;
+			s.m_real /= 2; // avoid saturation on 16 bit samples
+			s.m_imag /= 2;
 #endif
-				if (!(*stage)->work(&s)) {
-					break;
-				}
+			if (!(*stage)->work(&s)) {
+				break;
 			}
+		}
 
-			if(stage == m_filterStages.end())
-			{
+		if(stage == m_filterStages.end())
+		{
 #ifdef SDR_RX_SAMPLE_24BIT
-			    s.m_real /= (1<<(m_filterStages.size())); // on 32 bit samples there is enough headroom to just divide the final result
-			    s.m_imag /= (1<<(m_filterStages.size()));
+			s.m_real /= (1<<(m_filterStages.size())); // on 32 bit samples there is enough headroom to just divide the final result
+			s.m_imag /= (1<<(m_filterStages.size()));
 #endif
-				m_sampleBuffer.push_back(s);
-			}
+			m_sampleBuffer.push_back(s);
 		}
-
-		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end());
-		m_sampleBuffer.clear();
 	}
+
+	m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end());
+	m_sampleBuffer.clear();
 }
 
 void DownChannelizer::setChannelization(int requestedSampleRate, qint64 requestedCenterFrequency)
@@ -166,20 +207,24 @@ void DownChannelizer::applyDecimation()
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>),
     m_workFunction(0),
+    m_blockWorkFunction(0),
     m_mode(mode),
     m_sse(true)
 {
     switch(mode) {
         case ModeCenter:
             m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
+            m_blockWorkFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenterBlock;
             break;
 
         case ModeLowerHalf:
             m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
+            m_blockWorkFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalfBlock;
             break;
 
         case ModeUpperHalf:
             m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
+            m_blockWorkFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalfBlock;
             break;
     }
 }
@@ -187,20 +232,24 @@ DownChannelizer::FilterStage::FilterStage(Mode mode) :
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>),
     m_workFunction(0),
+    m_blockWorkFunction(0),
     m_mode(mode),
     m_sse(true)
 {
     switch(mode) {
         case ModeCenter:
             m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
+            m_blockWorkFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenterBlock;
             break;
 
         case ModeLowerHalf:
             m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
+            m_blockWorkFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalfBlock;
             break;
 
         case ModeUpperHalf:
             m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
+            m_blockWorkFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalfBlock;
             break;
     }
 }
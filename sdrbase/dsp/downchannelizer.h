@@ -43,6 +43,8 @@ public:
 	int getBasebandSampleRate() const { return m_basebandSampleRate; }
     int getChannelSampleRate() const { return m_channelSampleRate; }
 	int getChannelFrequencyOffset() const { return m_channelFrequencyOffset; }
+    void setBlockMode(bool blockMode) { m_blockMode = blockMode; } //!< true: run each stage over the whole block (default) false: run each sample through all stages
+    bool getBlockMode() const { return m_blockMode; }
 
 protected:
 	struct FilterStage {
@@ -54,13 +56,16 @@ protected:
 
 #ifdef SDR_RX_SAMPLE_24BIT
         typedef bool (IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
+        typedef int (IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::*BlockWorkFunction)(Sample* samples, int nbSamples);
         IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
 #else
         typedef bool (IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
+        typedef int (IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::*BlockWorkFunction)(Sample* samples, int nbSamples);
         IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
 #endif
 
 		WorkFunction m_workFunction;
+		BlockWorkFunction m_blockWorkFunction;
 		Mode m_mode;
 		bool m_sse;
 
@@ -71,10 +76,16 @@ protected:
 		{
 			return (m_filter->*m_workFunction)(sample);
 		}
+
+		int workBlock(Sample* samples, int nbSamples)
+		{
+			return (m_filter->*m_blockWorkFunction)(samples, nbSamples);
+		}
 	};
 	typedef std::list<FilterStage*> FilterStages;
 	FilterStages m_filterStages;
     bool m_filterChainSetMode;
+    bool m_blockMode;
 	ChannelSampleSink* m_sampleSink; //!< Demodulator
     int m_basebandSampleRate;
 	int m_requestedOutputSampleRate;
@@ -84,7 +95,10 @@ protected:
     unsigned int m_log2Decim;
     unsigned int m_filterChainHash;
 	SampleVector m_sampleBuffer;
+	SampleVector m_blockBuffer; //!< Scratch buffer for block mode. Stages are run in place.
 
+	void feedBlock(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+	void feedSample(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
 	void applyChannelization();
     void applyDecimation();
 	bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
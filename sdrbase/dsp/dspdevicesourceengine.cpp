@@ -25,6 +25,7 @@
 #include "dsp/dspcommands.h"
 #include "util/fixed.h"
 #include "samplesinkfifo.h"
+#include "filterbankchannelizer.h"
 
 DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	QThread(parent),
@@ -43,6 +44,8 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	m_qRange(1 << 16),
 	m_imbalance(65536)
 {
+	m_filterBankChannelizer = new FilterBankChannelizer(&m_sharedFifo);
+
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
 
@@ -53,6 +56,7 @@ DSPDeviceSourceEngine::~DSPDeviceSourceEngine()
 {
     stop();
     wait();
+    delete m_filterBankChannelizer;
 }
 
 void DSPDeviceSourceEngine::run()
@@ -331,10 +335,17 @@ void DSPDeviceSourceEngine::work()
                 iqCorrections(part1begin, part1end, m_iqImbalanceCorrection);
             }
 
+			// publish data once to channels attached to the shared FIFO
+			if (m_sharedFifo.hasReaders()) {
+				m_sharedFifo.write(part1begin, part1end);
+			}
+
 			// feed data to direct sinks
 			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); ++it)
 			{
+				m_feedTimer.start();
 				(*it)->feed(part1begin, part1end, positiveOnly);
+				(*it)->getFeedPerf().add(m_feedTimer.nsecsElapsed(), part1end - part1begin);
 			}
 
 		}
@@ -348,10 +359,17 @@ void DSPDeviceSourceEngine::work()
                 iqCorrections(part2begin, part2end, m_iqImbalanceCorrection);
             }
 
+			// publish data once to channels attached to the shared FIFO
+			if (m_sharedFifo.hasReaders()) {
+				m_sharedFifo.write(part2begin, part2end);
+			}
+
 			// feed data to direct sinks
 			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); it++)
 			{
+				m_feedTimer.start();
 				(*it)->feed(part2begin, part2end, positiveOnly);
+				(*it)->getFeedPerf().add(m_feedTimer.nsecsElapsed(), part2end - part2begin);
 			}
 
 		}
@@ -434,6 +452,8 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoInit()
 	m_deviceDescription = m_deviceSampleSource->getDeviceDescription();
 	m_centerFrequency = m_deviceSampleSource->getCenterFrequency();
 	m_sampleRate = m_deviceSampleSource->getSampleRate();
+	m_sharedFifo.setSize(SampleSinkFifo::getSizePolicy(m_sampleRate));
+	m_filterBankChannelizer->setBasebandSampleRate(m_sampleRate);
 
 	qDebug() << "DSPDeviceSourceEngine::gotoInit: "
 	        << " m_deviceDescription: " << m_deviceDescription.toStdString().c_str()
@@ -649,6 +669,8 @@ void DSPDeviceSourceEngine::handleInputMessages()
 
 			m_sampleRate = notif->getSampleRate();
 			m_centerFrequency = notif->getCenterFrequency();
+			m_sharedFifo.setSize(SampleSinkFifo::getSizePolicy(m_sampleRate));
+			m_filterBankChannelizer->setBasebandSampleRate(m_sampleRate);
 
 			qDebug() << "DSPDeviceSourceEngine::handleInputMessages: DSPSignalNotification:"
 				<< " m_sampleRate: " << m_sampleRate
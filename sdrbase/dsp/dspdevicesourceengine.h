@@ -23,8 +23,10 @@
 #include <QTimer>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QElapsedTimer>
 #include "dsp/dsptypes.h"
 #include "dsp/fftwindow.h"
+#include "dsp/samplesinksharedfifo.h"
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
 #include "export.h"
@@ -32,6 +34,7 @@
 
 class DeviceSampleSource;
 class BasebandSampleSink;
+class FilterBankChannelizer;
 
 class SDRBASE_API DSPDeviceSourceEngine : public QThread {
 	Q_OBJECT
@@ -65,6 +68,8 @@ public:
 
 	void addSink(BasebandSampleSink* sink); //!< Add a sample sink
 	void removeSink(BasebandSampleSink* sink); //!< Remove a sample sink
+	SampleSinkSharedFifo *getSharedFifo() { return &m_sharedFifo; } //!< Baseband published once for all channels reading it
+	FilterBankChannelizer *getFilterBankChannelizer() { return m_filterBankChannelizer; } //!< Sub-bands of the shared baseband
 
 	void configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection); //!< Configure DSP corrections
 
@@ -89,6 +94,8 @@ private:
 
 	typedef std::list<BasebandSampleSink*> BasebandSampleSinks;
 	BasebandSampleSinks m_basebandSampleSinks; //!< sample sinks within main thread (usually spectrum, file output)
+	SampleSinkSharedFifo m_sharedFifo; //!< baseband samples shared by channel FIFOs attached to it
+	FilterBankChannelizer *m_filterBankChannelizer; //!< reads m_sharedFifo and publishes sub-bands
 
 	uint m_sampleRate;
 	quint64 m_centerFrequency;
@@ -123,6 +130,8 @@ private:
 	qint32 m_qRange;
 	qint32 m_imbalance;
 
+	QElapsedTimer m_feedTimer; //!< Times the feed of each sink for its performance counter
+
 	void run();
 
 	void iqCorrections(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection);
@@ -24,6 +24,7 @@
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
 #include "dsp/fftfactory.h"
+#include "dsp/basebandscheduler.h"
 
 DSPEngine::DSPEngine() :
     m_deviceSourceEnginesUIDSequence(0),
@@ -31,7 +32,8 @@ DSPEngine::DSPEngine() :
     m_deviceMIMOEnginesUIDSequence(0),
     m_audioInputDeviceIndex(-1),    // default device
     m_audioOutputDeviceIndex(-1),   // default device
-    m_fftFactory(nullptr)
+    m_fftFactory(nullptr),
+    m_basebandScheduler(nullptr)
 {
 	m_dvSerialSupport = false;
     m_mimoSupport = false;
@@ -51,6 +53,10 @@ DSPEngine::~DSPEngine()
     if (m_fftFactory) {
         delete m_fftFactory;
     }
+
+    if (m_basebandScheduler) {
+        delete m_basebandScheduler;
+    }
 }
 
 Q_GLOBAL_STATIC(DSPEngine, dspEngine)
@@ -197,6 +203,11 @@ void DSPEngine::createFFTFactory(const QString& fftWisdomFileName)
     m_fftFactory = new FFTFactory(fftWisdomFileName);
 }
 
+void DSPEngine::createBasebandScheduler(int nbWorkers, bool numaPinning)
+{
+    m_basebandScheduler = new BasebandScheduler(nbWorkers, numaPinning);
+}
+
 void DSPEngine::preAllocateFFTs()
 {
     m_fftFactory->preallocate(7, 10, 1, 0); // pre-acllocate forward FFT only 1 per size from 128 to 1024
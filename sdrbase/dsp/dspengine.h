@@ -33,6 +33,7 @@ class DSPDeviceSourceEngine;
 class DSPDeviceSinkEngine;
 class DSPDeviceMIMOEngine;
 class FFTFactory;
+class BasebandScheduler;
 
 class SDRBASE_API DSPEngine : public QObject {
 	Q_OBJECT
@@ -88,6 +89,8 @@ public:
     void createFFTFactory(const QString& fftWisdomFileName);
     void preAllocateFFTs();
     FFTFactory *getFFTFactory() { return m_fftFactory; }
+    void createBasebandScheduler(int nbWorkers, bool numaPinning); //!< Run channel basebands on shared workers (0: one per core)
+    BasebandScheduler *getBasebandScheduler() { return m_basebandScheduler; } //!< nullptr if channels run their own thread
 
 private:
 	std::vector<DSPDeviceSourceEngine*> m_deviceSourceEngines;
@@ -104,6 +107,7 @@ private:
     bool m_mimoSupport;
 	AMBEEngine m_ambeEngine;
     FFTFactory *m_fftFactory;
+    BasebandScheduler *m_basebandScheduler;
 };
 
 #endif // INCLUDE_DSPENGINE_H
@@ -41,17 +41,36 @@
 
 #include <dsp/misc.h>
 #include <dsp/fftfilt.h>
+#include <dsp/fftengine.h>
+#include <dsp/fftfactory.h>
+#include <dsp/dspengine.h>
 
 //------------------------------------------------------------------------------
 // initialize the filter
 // create forward and reverse FFTs
 //------------------------------------------------------------------------------
 
-// Only need a single instance of g_fft, used for both forward and reverse
+// Forward and inverse engines come from the FFT factory (FFTW with wisdom when available)
+// Without a factory only need a single instance of g_fft, used for both forward and reverse
 void fftfilt::init_filter()
 {
 	flen2	= flen >> 1;
-	fft	= new g_fft<float>(flen);
+	fft	= nullptr;
+	m_fftFactory = DSPEngine::instance()->getFFTFactory();
+	m_fwdFFT = nullptr;
+	m_invFFT = nullptr;
+	m_fwdFFTSequence = 0;
+	m_invFFTSequence = 0;
+
+	if (m_fftFactory)
+	{
+		m_fwdFFTSequence = m_fftFactory->getEngine(flen, false, &m_fwdFFT);
+		m_invFFTSequence = m_fftFactory->getEngine(flen, true, &m_invFFT);
+	}
+	else
+	{
+		fft = new g_fft<float>(flen);
+	}
 
 	filter		= new cmplx[flen];
     filterOpp   = new cmplx[flen];
@@ -97,6 +116,12 @@ fftfilt::~fftfilt()
 {
 	if (fft) delete fft;
 
+	if (m_fftFactory)
+	{
+		m_fftFactory->releaseEngine(flen, false, m_fwdFFTSequence);
+		m_fftFactory->releaseEngine(flen, true, m_invFFTSequence);
+	}
+
 	if (filter) delete [] filter;
     if (filterOpp) delete [] filterOpp;
 	if (data) delete [] data;
@@ -104,6 +129,39 @@ fftfilt::~fftfilt()
 	if (ovlbuf) delete [] ovlbuf;
 }
 
+void fftfilt::forwardFFT(cmplx *buf)
+{
+	if (m_fwdFFT)
+	{
+		std::copy(buf, buf + flen, m_fwdFFT->in());
+		m_fwdFFT->transform();
+		std::copy(m_fwdFFT->out(), m_fwdFFT->out() + flen, buf);
+	}
+	else
+	{
+		fft->ComplexFFT(buf);
+	}
+}
+
+void fftfilt::inverseFFT(cmplx *buf)
+{
+	if (m_invFFT)
+	{
+		std::copy(buf, buf + flen, m_invFFT->in());
+		m_invFFT->transform();
+		const float scale = 1.0f / flen; // FFT engines do not normalize the inverse transform
+		const cmplx *out = m_invFFT->out();
+
+		for (int i = 0; i < flen; i++) {
+			buf[i] = out[i] * scale;
+		}
+	}
+	else
+	{
+		fft->InverseComplexFFT(buf);
+	}
+}
+
 void fftfilt::create_filter(float f1, float f2)
 {
 	// initialize the filter to zero
@@ -130,7 +188,7 @@ void fftfilt::create_filter(float f1, float f2)
 	for (int i = 0; i < flen2; i++)
 		filter[i] *= _blackman(i, flen2);
 
-	fft->ComplexFFT(filter); // filter was expressed in the time domain (impulse response)
+	forwardFFT(filter); // filter was expressed in the time domain (impulse response)
 
 	// normalize the output filter for unity gain
 	float scale = 0, mag;
@@ -155,7 +213,7 @@ void fftfilt::create_dsb_filter(float f2)
 		filter[i] *= _blackman(i, flen2);
 	}
 
-	fft->ComplexFFT(filter); // filter was expressed in the time domain (impulse response)
+	forwardFFT(filter); // filter was expressed in the time domain (impulse response)
 
 	// normalize the output filter for unity gain
 	float scale = 0, mag;
@@ -182,7 +240,7 @@ void fftfilt::create_asym_filter(float fopp, float fin)
         filter[i] *= _blackman(i, flen2);
     }
 
-    fft->ComplexFFT(filter); // filter was expressed in the time domain (impulse response)
+    forwardFFT(filter); // filter was expressed in the time domain (impulse response)
 
     // normalize the output filter for unity gain
     float scale = 0, mag;
@@ -204,7 +262,7 @@ void fftfilt::create_asym_filter(float fopp, float fin)
         filterOpp[i] *= _blackman(i, flen2);
     }
 
-    fft->ComplexFFT(filterOpp); // filter was expressed in the time domain (impulse response)
+    forwardFFT(filterOpp); // filter was expressed in the time domain (impulse response)
 
     // normalize the output filter for unity gain
     scale = 0;
@@ -264,11 +322,11 @@ int fftfilt::runFilt(const cmplx & in, cmplx **out)
 		return 0;
 	inptr = 0;
 
-	fft->ComplexFFT(data);
+	forwardFFT(data);
 	for (int i = 0; i < flen; i++)
 		data[i] *= filter[i];
 
-	fft->InverseComplexFFT(data);
+	inverseFFT(data);
 
 	for (int i = 0; i < flen2; i++) {
 		output[i] = ovlbuf[i] + data[i];
@@ -288,7 +346,7 @@ int fftfilt::runSSB(const cmplx & in, cmplx **out, bool usb, bool getDC)
 		return 0;
 	inptr = 0;
 
-	fft->ComplexFFT(data);
+	forwardFFT(data);
 
 	// get or reject DC component
 	data[0] = getDC ? data[0]*filter[0] : 0;
@@ -310,7 +368,7 @@ int fftfilt::runSSB(const cmplx & in, cmplx **out, bool usb, bool getDC)
 	}
 
 	// in-place FFT: freqdata overwritten with filtered timedata
-	fft->InverseComplexFFT(data);
+	inverseFFT(data);
 
 	// overlap and add
 	for (int i = 0; i < flen2; i++) {
@@ -331,7 +389,7 @@ int fftfilt::runDSB(const cmplx & in, cmplx **out, bool getDC)
 		return 0;
 	inptr = 0;
 
-	fft->ComplexFFT(data);
+	forwardFFT(data);
 
 	for (int i = 0; i < flen2; i++) {
 		data[i] *= filter[i];
@@ -342,7 +400,7 @@ int fftfilt::runDSB(const cmplx & in, cmplx **out, bool getDC)
     data[0] = getDC ? data[0] : 0;
 
 	// in-place FFT: freqdata overwritten with filtered timedata
-	fft->InverseComplexFFT(data);
+	inverseFFT(data);
 
 	// overlap and add
 	for (int i = 0; i < flen2; i++) {
@@ -364,7 +422,7 @@ int fftfilt::runAsym(const cmplx & in, cmplx **out, bool usb)
         return 0;
     inptr = 0;
 
-    fft->ComplexFFT(data);
+    forwardFFT(data);
 
     data[0] *= filter[0]; // always keep DC
 
@@ -386,7 +444,7 @@ int fftfilt::runAsym(const cmplx & in, cmplx **out, bool usb)
     }
 
     // in-place FFT: freqdata overwritten with filtered timedata
-    fft->InverseComplexFFT(data);
+    inverseFFT(data);
 
     // overlap and add
     for (int i = 0; i < flen2; i++) {
@@ -9,6 +9,9 @@
 #include "gfft.h"
 #include "export.h"
 
+class FFTEngine;
+class FFTFactory;
+
 #undef M_PI
 #define M_PI 3.14159265358979323846
 
@@ -36,10 +39,17 @@ public:
 	int runDSB(const cmplx& in, cmplx **out, bool getDC = true);
 	int runAsym(const cmplx & in, cmplx **out, bool usb); //!< Asymmetrical fitering can be used for vestigial sideband
 
+	bool usesFFTFactory() const { return m_fwdFFT != nullptr; } //!< false if running on the built-in g_fft
+
 protected:
 	int flen;
 	int flen2;
-	g_fft<float> *fft;
+	g_fft<float> *fft;    //!< fallback when there is no FFT factory
+	FFTFactory *m_fftFactory;
+	FFTEngine *m_fwdFFT;
+	FFTEngine *m_invFFT;
+	unsigned int m_fwdFFTSequence;
+	unsigned int m_invFFTSequence;
 	cmplx *filter;
     cmplx *filterOpp;
 	cmplx *data;
@@ -88,6 +98,8 @@ protected:
 
 	void init_filter();
 	void init_dsb_filter();
+	void forwardFFT(cmplx *buf);  //!< in place
+	void inverseFFT(cmplx *buf);  //!< in place and normalized like g_fft
 };
 
 
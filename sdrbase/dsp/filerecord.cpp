@@ -17,14 +17,19 @@
 
 #include <boost/crc.hpp>
 #include <boost/cstdint.hpp>
+#include <cstring>
+#include <algorithm>
 
 #include <QDebug>
 #include <QDateTime>
 
 #include "dsp/dspcommands.h"
+#include "dsp/samplecodec.h"
 #include "util/simpleserializer.h"
 #include "util/message.h"
 
+#include "SWGDeviceRecord.h"
+
 #include "filerecord.h"
 
 FileRecord::FileRecord() :
@@ -32,8 +37,12 @@ FileRecord::FileRecord() :
     m_fileName("test.sdriq"),
     m_sampleRate(0),
     m_centerFrequency(0),
-	m_recordOn(false),
+	m_recordOn(0),
     m_recordStart(false),
+    m_directIO(false),
+    m_preallocate(0),
+    m_sampleSize(SDR_RX_SAMP_SZ),
+    m_recordSampleSize(SDR_RX_SAMP_SZ),
     m_byteCount(0)
 {
 	setObjectName("FileSink");
@@ -44,8 +53,12 @@ FileRecord::FileRecord(const QString& filename) :
     m_fileName(filename),
     m_sampleRate(0),
     m_centerFrequency(0),
-    m_recordOn(false),
+    m_recordOn(0),
     m_recordStart(false),
+    m_directIO(false),
+    m_preallocate(0),
+    m_sampleSize(SDR_RX_SAMP_SZ),
+    m_recordSampleSize(SDR_RX_SAMP_SZ),
     m_byteCount(0)
 {
     setObjectName("FileRecord");
@@ -58,12 +71,30 @@ FileRecord::~FileRecord()
 
 void FileRecord::setFileName(const QString& filename)
 {
-    if (!m_recordOn)
+    if (m_recordOn.loadAcquire() == 0)
     {
         m_fileName = filename;
     }
 }
 
+void FileRecord::setWriteOptions(bool directIO, quint64 preallocate)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_directIO = directIO;
+    m_preallocate = preallocate;
+}
+
+void FileRecord::setSampleSize(quint32 sampleSize)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if ((sampleSize == m_sampleSizePacked12) || isLossless(sampleSize)) {
+        m_sampleSize = sampleSize;
+    } else {
+        m_sampleSize = SDR_RX_SAMP_SZ;
+    }
+}
+
 void FileRecord::genUniqueFileName(uint deviceUID, int istream)
 {
     if (istream < 0) {
@@ -76,9 +107,17 @@ void FileRecord::genUniqueFileName(uint deviceUID, int istream)
 void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
 {
     (void) positiveOnly;
-    // if no recording is active, send the samples to /dev/null
-    if(!m_recordOn)
+
+    // if no recording is active, send the samples to /dev/null. Checked without locking.
+    if (m_recordOn.loadAcquire() == 0) {
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex); // only contended while recording stops
+
+    if (m_recordOn.load() == 0) {
         return;
+    }
 
     if (begin < end) // if there is something to put out
     {
@@ -88,7 +127,32 @@ void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVec
             m_recordStart = false;
         }
 
-        m_sampleFile.write(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample));
+        // never blocks: the writer thread does the file I/O
+        if (m_recordSampleSize == m_sampleSizePacked12)
+        {
+            unsigned int nbSamples = end - begin;
+            m_codedBuffer.resize(nbSamples * SampleCodec::m_packed12Bytes);
+            SampleCodec::encodePacked12(&*begin, nbSamples, m_codedBuffer.data());
+            m_writer.write(reinterpret_cast<const char*>(m_codedBuffer.data()), nbSamples * SampleCodec::m_packed12Bytes);
+        }
+        else if (isLossless(m_recordSampleSize))
+        {
+            for (SampleVector::const_iterator it = begin; it < end;)
+            {
+                unsigned int count = std::min((unsigned int) (end - it), SampleCodec::m_losslessBlockSamples - (unsigned int) m_losslessBlock.size());
+                m_losslessBlock.insert(m_losslessBlock.end(), it, it + count);
+                it += count;
+
+                if (m_losslessBlock.size() == SampleCodec::m_losslessBlockSamples) {
+                    writeLosslessBlock();
+                }
+            }
+        }
+        else
+        {
+            m_writer.write(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample));
+        }
+
         m_byteCount += end - begin;
     }
 }
@@ -104,24 +168,55 @@ void FileRecord::stop()
 
 void FileRecord::startRecording()
 {
-    if (!m_sampleFile.is_open())
+    if (m_writer.isOpen()) {
+        return;
+    }
+
+    qDebug() << "FileRecord::startRecording";
+    m_mutex.lock();
+    bool directIO = m_directIO;
+    quint64 preallocate = m_preallocate;
+    quint32 sampleSize = m_sampleSize;
+    m_mutex.unlock();
+
+    // feed does not touch the writer nor the recording state until m_recordOn is published. Opening
+    // with direct I/O and preallocation may take long: it must not hold the mutex feed takes.
+    if (!m_writer.open(m_fileName, directIO, preallocate)) {
+        return;
+    }
+
+    m_recordStart = true;
+    m_byteCount = 0;
+    m_recordSampleSize = sampleSize;
+
+    if (isLossless(m_recordSampleSize))
     {
-    	qDebug() << "FileRecord::startRecording";
-        m_sampleFile.open(m_fileName.toStdString().c_str(), std::ios::binary);
-        m_recordOn = true;
-        m_recordStart = true;
-        m_byteCount = 0;
+        m_codedBuffer.resize(SampleCodec::getLosslessMaxBlockBytes(SampleCodec::m_losslessBlockSamples));
+        m_losslessBlock.reserve(SampleCodec::m_losslessBlockSamples);
+        m_losslessBlock.clear();
     }
+
+    m_recordOn.storeRelease(1);
 }
 
 void FileRecord::stopRecording()
 {
-    if (m_sampleFile.is_open())
+    if (m_writer.isOpen())
     {
-    	qDebug() << "FileRecord::stopRecording";
-        m_sampleFile.close();
-        m_recordOn = false;
+        m_mutex.lock();
+
+        if (!m_recordStart && isLossless(m_recordSampleSize) && (m_losslessBlock.size() != 0)) {
+            writeLosslessBlock(); // last block
+        }
+
+        m_recordOn.storeRelease(0);
         m_recordStart = false;
+        m_mutex.unlock();
+        // feed does not touch the writer anymore and does not wait for the queued data to be written
+        m_writer.close();
+    	qDebug() << "FileRecord::stopRecording:"
+            << " dropped buffers: " << m_writer.getDroppedBuffers()
+            << " queue high water: " << m_writer.getQueueHighWater() << "/" << m_writer.getNbBlocks();
     }
 }
 
@@ -159,10 +254,20 @@ void FileRecord::writeHeader()
     header.centerFrequency = m_centerFrequency;
     std::time_t ts = time(0);
     header.startTimeStamp = ts;
-    header.sampleSize = SDR_RX_SAMP_SZ;
+    header.sampleSize = isLossless(m_recordSampleSize) ? m_sampleSizeLossless | SDR_RX_SAMP_SZ : m_recordSampleSize;
     header.filler = 0;
 
-    writeHeader(m_sampleFile, header);
+    boost::crc_32_type crc32;
+    crc32.process_bytes(&header, 28);
+    header.crc32 = crc32.checksum();
+    m_writer.write((const char *) &header, sizeof(Header));
+}
+
+void FileRecord::writeLosslessBlock()
+{
+    unsigned int blockBytes = SampleCodec::encodeLosslessBlock(m_losslessBlock.data(), m_losslessBlock.size(), m_codedBuffer.data());
+    m_writer.write(reinterpret_cast<const char*>(m_codedBuffer.data()), blockBytes);
+    m_losslessBlock.clear();
 }
 
 bool FileRecord::readHeader(std::ifstream& sampleFile, Header& header)
@@ -173,6 +278,14 @@ bool FileRecord::readHeader(std::ifstream& sampleFile, Header& header)
     return header.crc32 == crc32.checksum();
 }
 
+bool FileRecord::readHeader(const quint8 *buffer, Header& header)
+{
+    memcpy((void *) &header, buffer, sizeof(Header));
+    boost::crc_32_type crc32;
+    crc32.process_bytes(&header, 28);
+    return header.crc32 == crc32.checksum();
+}
+
 void FileRecord::writeHeader(std::ofstream& sampleFile, Header& header)
 {
     boost::crc_32_type crc32;
@@ -180,3 +293,58 @@ void FileRecord::writeHeader(std::ofstream& sampleFile, Header& header)
     header.crc32 = crc32.checksum();
     sampleFile.write((const char *) &header, sizeof(Header));
 }
+
+void FileRecord::webapiFormatDeviceRecord(
+    SWGSDRangel::SWGDeviceRecord *apiDeviceRecord,
+    FileRecord& fileRecord
+)
+{
+    apiDeviceRecord->setDirectIo(fileRecord.getDirectIO() ? 1 : 0);
+    apiDeviceRecord->setPreallocate(fileRecord.getPreallocate());
+
+    if (fileRecord.getSampleSize() == m_sampleSizePacked12) {
+        apiDeviceRecord->setSampleFormat(1);
+    } else if (isLossless(fileRecord.getSampleSize())) {
+        apiDeviceRecord->setSampleFormat(2);
+    } else {
+        apiDeviceRecord->setSampleFormat(0);
+    }
+
+    apiDeviceRecord->setRecording(fileRecord.isRecording() ? 1 : 0);
+    apiDeviceRecord->setSampleCount(fileRecord.getByteCount());
+    apiDeviceRecord->setNbBlocks(fileRecord.getNbBlocks());
+    apiDeviceRecord->setQueueHighWater(fileRecord.getQueueHighWater());
+    apiDeviceRecord->setDroppedBuffers(fileRecord.getDroppedBuffers());
+}
+
+void FileRecord::webapiUpdateDeviceRecord(
+    const QStringList& deviceRecordKeys,
+    SWGSDRangel::SWGDeviceRecord *apiDeviceRecord,
+    FileRecord& fileRecord
+)
+{
+    bool directIO = fileRecord.getDirectIO();
+    quint64 preallocate = fileRecord.getPreallocate();
+
+    if (deviceRecordKeys.contains("directIO")) {
+        directIO = apiDeviceRecord->getDirectIo() != 0;
+    }
+    if (deviceRecordKeys.contains("preallocate")) {
+        preallocate = apiDeviceRecord->getPreallocate() < 0 ? 0 : apiDeviceRecord->getPreallocate();
+    }
+
+    fileRecord.setWriteOptions(directIO, preallocate);
+
+    if (deviceRecordKeys.contains("sampleFormat"))
+    {
+        int sampleFormat = apiDeviceRecord->getSampleFormat();
+
+        if (sampleFormat == 1) {
+            fileRecord.setSampleSize(m_sampleSizePacked12);
+        } else if (sampleFormat == 2) {
+            fileRecord.setSampleSize(m_sampleSizeLossless);
+        } else {
+            fileRecord.setSampleSize(SDR_RX_SAMP_SZ);
+        }
+    }
+}
@@ -24,10 +24,21 @@
 #include <fstream>
 
 #include <ctime>
+#include <vector>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QStringList>
+
+#include "dsp/filerecordwriter.h"
 #include "export.h"
 
 class Message;
 
+namespace SWGSDRangel
+{
+    class SWGDeviceRecord;
+}
+
 class SDRBASE_API FileRecord : public BasebandSampleSink {
 public:
 
@@ -48,6 +59,14 @@ public:
 	virtual ~FileRecord();
 
     quint64 getByteCount() const { return m_byteCount; }
+    void setWriteOptions(bool directIO, quint64 preallocate); //!< Applies on next recording start. preallocate in bytes, 0 for none
+    bool getDirectIO() const { return m_directIO; }
+    quint64 getPreallocate() const { return m_preallocate; }
+    void setSampleSize(quint32 sampleSize); //!< SDR_RX_SAMP_SZ (default), m_sampleSizePacked12 or m_sampleSizeLossless. Applies on next recording start.
+    quint32 getSampleSize() const { return m_sampleSize; }
+    unsigned int getDroppedBuffers() const { return m_writer.getDroppedBuffers(); } //!< Sample buffers not entirely recorded
+    unsigned int getQueueHighWater() const { return m_writer.getQueueHighWater(); } //!< Maximum number of blocks waiting for the writer
+    unsigned int getNbBlocks() const { return m_writer.getNbBlocks(); }
 
     void setFileName(const QString& filename);
     void genUniqueFileName(uint deviceUID, int istream = -1);
@@ -58,21 +77,45 @@ public:
 	virtual bool handleMessage(const Message& message);
     void startRecording();
     void stopRecording();
-    bool isRecording() const { return m_recordOn; }
+    bool isRecording() const { return m_recordOn.loadAcquire() != 0; }
     static bool readHeader(std::ifstream& samplefile, Header& header); //!< returns true if CRC checksum is correct else false
+    static bool readHeader(const quint8 *buffer, Header& header);      //!< from a file mapping. Returns true if CRC checksum is correct else false
     static void writeHeader(std::ofstream& samplefile, Header& header);
+    static bool isLossless(quint32 sampleSize) { return (sampleSize & m_sampleSizeLossless) != 0; }
+    static quint32 getSampleBits(quint32 sampleSize) { return sampleSize & 0xFF; } //!< I or Q bits from header sample size
+
+    static void webapiFormatDeviceRecord(
+        SWGSDRangel::SWGDeviceRecord *apiDeviceRecord,
+        FileRecord& fileRecord
+    );
+    static void webapiUpdateDeviceRecord(
+        const QStringList& deviceRecordKeys,
+        SWGSDRangel::SWGDeviceRecord *apiDeviceRecord,
+        FileRecord& fileRecord
+    );
+
+    static const quint32 m_sampleSizePacked12 = 12;    //!< Header sample size of 12 bit I and Q packed in 3 bytes
+    static const quint32 m_sampleSizeLossless = 0x100; //!< Header sample size flag of lossless blocks or'ed with the coded bits
 
 private:
 	QString m_fileName;
 	quint32 m_sampleRate;
 	quint64 m_centerFrequency;
-	bool m_recordOn;
+	QAtomicInt m_recordOn; //!< published once the writer is open. Checked by feed without locking.
     bool m_recordStart;
-    std::ofstream m_sampleFile;
+    FileRecordWriter m_writer; //!< writes the file from its own thread
+    bool m_directIO;
+    quint64 m_preallocate;
+    quint32 m_sampleSize;              //!< header sample size of next recording
+    quint32 m_recordSampleSize;        //!< header sample size of current recording
+    std::vector<quint8> m_codedBuffer; //!< packed samples or a lossless block
+    SampleVector m_losslessBlock;      //!< samples of the lossless block being filled
     quint64 m_byteCount;
+    QMutex m_mutex; //!< keeps feed out of the writer while recording stops
 
 	void handleConfigure(const QString& fileName);
     void writeHeader();
+    void writeLosslessBlock();
 };
 
 #endif // INCLUDE_FILERECORD_H
@@ -0,0 +1,287 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+#include <QDebug>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
+
+#include "filerecordwriter.h"
+
+FileRecordWriter::FileRecordWriter(unsigned int blockSize, unsigned int nbBlocks) :
+    m_blockSize(((blockSize + m_alignment - 1) / m_alignment) * m_alignment),
+    m_nbBlocks(nbBlocks < 2 ? 2 : nbBlocks),
+    m_fullHead(0),
+    m_fullCount(0),
+    m_current(nullptr),
+    m_currentSize(0),
+    m_directIO(false),
+    m_stop(false),
+    m_bytesWritten(0),
+    m_droppedBytes(0),
+    m_droppedBuffers(0),
+    m_queueHighWater(0),
+    m_writeError(false)
+{
+}
+
+FileRecordWriter::~FileRecordWriter()
+{
+    close();
+}
+
+void FileRecordWriter::allocateBlocks()
+{
+    m_blocks.resize(m_nbBlocks);
+    m_freeBlocks.clear();
+    m_freeBlocks.reserve(m_nbBlocks);
+    m_fullBlocks.resize(m_nbBlocks);
+
+    for (unsigned int i = 0; i < m_nbBlocks; i++)
+    {
+        m_blocks[i] = (char *) qMallocAligned(m_blockSize, m_alignment);
+        m_freeBlocks.push_back(m_blocks[i]);
+    }
+
+    m_fullHead = 0;
+    m_fullCount = 0;
+    m_current = nullptr;
+    m_currentSize = 0;
+}
+
+void FileRecordWriter::freeBlocks()
+{
+    for (std::vector<char*>::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it) {
+        qFreeAligned(*it);
+    }
+
+    m_blocks.clear();
+    m_freeBlocks.clear();
+    m_fullBlocks.clear();
+    m_current = nullptr;
+}
+
+bool FileRecordWriter::open(const QString& fileName, bool directIO, quint64 preallocate)
+{
+    if (m_file.isOpen()) {
+        close();
+    }
+
+    m_file.setFileName(fileName);
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered))
+    {
+        qCritical() << "FileRecordWriter::open: cannot open" << fileName << ":" << m_file.errorString();
+        return false;
+    }
+
+    m_directIO = false;
+#ifdef Q_OS_LINUX
+    if (preallocate != 0)
+    {
+        int res = posix_fallocate(m_file.handle(), 0, (off_t) preallocate);
+
+        if (res != 0) {
+            qWarning("FileRecordWriter::open: cannot preallocate %llu bytes: %s", preallocate, strerror(res));
+        }
+    }
+
+    if (directIO) {
+        setDirectIO(true);
+    }
+#else
+    (void) preallocate;
+
+    if (directIO) {
+        qWarning("FileRecordWriter::open: direct I/O is not supported on this system");
+    }
+#endif
+
+    allocateBlocks();
+    m_stop = false;
+    m_bytesWritten.storeRelease(0);
+    m_droppedBytes.storeRelease(0);
+    m_droppedBuffers.store(0);
+    m_queueHighWater.store(0);
+    m_writeError = false;
+    start();
+
+    qDebug("FileRecordWriter::open: %s: %u blocks of %u bytes direct I/O: %s",
+        qPrintable(fileName), m_nbBlocks, m_blockSize, m_directIO ? "on" : "off");
+
+    return true;
+}
+
+void FileRecordWriter::close()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    m_mutex.lock();
+
+    if (m_current && (m_currentSize != 0)) {
+        queueCurrentBlock();
+    }
+
+    m_stop = true;
+    m_blockReady.wakeOne();
+    m_mutex.unlock();
+    wait();
+
+    // the preallocation may have extended the file
+    if ((quint64) m_file.size() != m_bytesWritten.load()) {
+        m_file.resize(m_bytesWritten.load());
+    }
+
+    m_file.close();
+    freeBlocks();
+
+    qDebug("FileRecordWriter::close: %s: %llu bytes written %llu bytes dropped in %u buffers queue high water: %u/%u blocks",
+        qPrintable(m_file.fileName()), m_bytesWritten.load(), m_droppedBytes.load(),
+        (unsigned int) m_droppedBuffers.load(), (unsigned int) m_queueHighWater.load(), m_nbBlocks);
+}
+
+void FileRecordWriter::write(const char *data, unsigned int size)
+{
+    while (size > 0)
+    {
+        if (!m_current)
+        {
+            QMutexLocker mutexLocker(&m_mutex);
+
+            if (m_freeBlocks.empty()) // writer is late
+            {
+                if (m_droppedBuffers.fetchAndAddRelaxed(1) % 1000 == 0) {
+                    qWarning("FileRecordWriter::write: %s: no free block: dropping data", qPrintable(m_file.fileName()));
+                }
+
+                m_droppedBytes.fetchAndAddRelease(size);
+                return;
+            }
+
+            m_current = m_freeBlocks.back();
+            m_freeBlocks.pop_back();
+            m_currentSize = 0;
+        }
+
+        unsigned int chunk = std::min(size, m_blockSize - m_currentSize);
+        std::memcpy(m_current + m_currentSize, data, chunk);
+        m_currentSize += chunk;
+        data += chunk;
+        size -= chunk;
+
+        if (m_currentSize == m_blockSize)
+        {
+            QMutexLocker mutexLocker(&m_mutex);
+            queueCurrentBlock();
+        }
+    }
+}
+
+void FileRecordWriter::queueCurrentBlock()
+{
+    // all blocks fit in the ring so it cannot overflow
+    Block& block = m_fullBlocks[(m_fullHead + m_fullCount) % m_nbBlocks];
+    block.m_data = m_current;
+    block.m_size = m_currentSize;
+    m_fullCount++;
+    m_current = nullptr;
+    m_currentSize = 0;
+
+    if (m_fullCount > (unsigned int) m_queueHighWater.load()) {
+        m_queueHighWater.store(m_fullCount);
+    }
+
+    m_blockReady.wakeOne();
+}
+
+void FileRecordWriter::run()
+{
+    m_mutex.lock();
+
+    while (true)
+    {
+        while ((m_fullCount == 0) && !m_stop) {
+            m_blockReady.wait(&m_mutex);
+        }
+
+        if (m_fullCount == 0) { // stopped and nothing left
+            break;
+        }
+
+        Block block = m_fullBlocks[m_fullHead];
+        m_fullHead = (m_fullHead + 1) % m_nbBlocks;
+        m_fullCount--;
+        m_mutex.unlock();
+
+        writeBlock(block);
+
+        m_mutex.lock();
+        m_freeBlocks.push_back(block.m_data);
+    }
+
+    m_mutex.unlock();
+}
+
+void FileRecordWriter::writeBlock(const Block& block)
+{
+    if (m_writeError) {
+        return;
+    }
+
+    // direct I/O needs aligned sizes. Only the last block can be partial.
+    if (m_directIO && (block.m_size % m_alignment != 0)) {
+        setDirectIO(false);
+    }
+
+    qint64 written = m_file.write(block.m_data, block.m_size);
+
+    if (written != (qint64) block.m_size)
+    {
+        qCritical() << "FileRecordWriter::writeBlock:" << m_file.fileName() << ":" << m_file.errorString();
+        m_writeError = true;
+    }
+
+    if (written > 0) {
+        m_bytesWritten.fetchAndAddRelease(written);
+    }
+}
+
+void FileRecordWriter::setDirectIO(bool directIO)
+{
+#ifdef Q_OS_LINUX
+    int fd = m_file.handle();
+    int flags = fcntl(fd, F_GETFL);
+
+    if ((flags < 0) || (fcntl(fd, F_SETFL, directIO ? flags | O_DIRECT : flags & ~O_DIRECT) < 0))
+    {
+        qWarning("FileRecordWriter::setDirectIO: cannot %s direct I/O: %s", directIO ? "set" : "clear", strerror(errno));
+        return;
+    }
+
+    m_directIO = directIO;
+#else
+    (void) directIO;
+#endif
+}
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// Writes a record file from a dedicated thread so that a stalled file system    //
+// does not stall the DSP thread feeding the record                              //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDWRITER_H_
+#define SDRBASE_DSP_FILERECORDWRITER_H_
+
+#include <vector>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QFile>
+
+#include "export.h"
+
+/**
+ * The producer copies data into the current block and queues it when full. The writer thread writes
+ * queued blocks and gives them back. Blocks are allocated aligned on open and freed on close so an idle
+ * recorder holds no memory. When no block is free the data is dropped and counted: write() never waits.
+ *
+ * With direct I/O (Linux only) full blocks bypass the page cache. The last partial block is written
+ * with direct I/O turned off. With preallocation the file space is reserved on open and the file is
+ * truncated to the data written on close.
+ */
+class SDRBASE_API FileRecordWriter : public QThread
+{
+    Q_OBJECT
+public:
+    FileRecordWriter(unsigned int blockSize = m_defaultBlockSize, unsigned int nbBlocks = m_defaultNbBlocks);
+    ~FileRecordWriter();
+
+    bool open(const QString& fileName, bool directIO = false, quint64 preallocate = 0);
+    void close(); //!< Writes the queued data and the current block then closes the file
+    bool isOpen() const { return m_file.isOpen(); }
+    void write(const char *data, unsigned int size); //!< Producer side. Never blocks.
+
+    quint64 getBytesWritten() const { return m_bytesWritten.loadAcquire(); }
+    unsigned int getDroppedBuffers() const { return m_droppedBuffers.load(); } //!< write() calls not stored entirely
+    quint64 getDroppedBytes() const { return m_droppedBytes.loadAcquire(); }
+    unsigned int getQueueHighWater() const { return m_queueHighWater.load(); } //!< maximum number of blocks waiting to be written
+    unsigned int getNbBlocks() const { return m_nbBlocks; }
+
+    static const unsigned int m_defaultBlockSize = 4*1024*1024;
+    static const unsigned int m_defaultNbBlocks = 16;
+    static const unsigned int m_alignment = 4096; //!< direct I/O alignment of buffers, sizes and offsets
+
+private:
+    struct Block
+    {
+        char *m_data;
+        unsigned int m_size;
+    };
+
+    QFile m_file;
+    unsigned int m_blockSize;
+    unsigned int m_nbBlocks;
+    std::vector<char*> m_blocks;     //!< all blocks
+    std::vector<char*> m_freeBlocks; //!< stack of blocks available to the producer
+    std::vector<Block> m_fullBlocks; //!< ring of blocks to write
+    unsigned int m_fullHead;
+    unsigned int m_fullCount;
+    char *m_current;                 //!< block being filled by the producer
+    unsigned int m_currentSize;
+    bool m_directIO;
+    bool m_stop;
+    QMutex m_mutex;
+    QWaitCondition m_blockReady;
+    QAtomicInteger<quint64> m_bytesWritten; //!< updated by the writer thread
+    QAtomicInteger<quint64> m_droppedBytes; //!< updated by the producer
+    QAtomicInt m_droppedBuffers;
+    QAtomicInt m_queueHighWater;
+    bool m_writeError;
+
+    void run();
+    void queueCurrentBlock();
+    void writeBlock(const Block& block);
+    void setDirectIO(bool directIO);
+    void allocateBlocks();
+    void freeBlocks();
+};
+
+#endif // SDRBASE_DSP_FILERECORDWRITER_H_
@@ -0,0 +1,217 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QThread>
+
+#include "dsp/samplesinksharedfifo.h"
+#include "filterbankchannelizer.h"
+
+FilterBankChannelizer::FilterBankChannelizer(SampleSinkSharedFifo *basebandFifo) :
+    m_basebandFifo(basebandFifo),
+    m_subbandFifos(m_maxNbSubbands, nullptr),
+    m_outputs(m_maxNbSubbands),
+    m_outputPointers(m_maxNbSubbands, nullptr),
+    m_basebandSampleRate(0),
+    m_nbSubbands(0),
+    m_mutex(QMutex::Recursive)
+{
+    QObject::connect(
+        &m_sampleFifo,
+        &SampleSinkFifo::dataReady,
+        this,
+        &FilterBankChannelizer::handleData,
+        Qt::QueuedConnection
+    );
+
+    m_thread = new QThread(); // started on first subscription
+    moveToThread(m_thread);
+}
+
+FilterBankChannelizer::~FilterBankChannelizer()
+{
+    m_sampleFifo.detachSharedFifo();
+    m_thread->quit();
+    m_thread->wait();
+    delete m_thread;
+
+    for (std::vector<SampleSinkSharedFifo*>::iterator it = m_subbandFifos.begin(); it != m_subbandFifos.end(); ++it)
+    {
+        if (*it)
+        {
+            m_basebandFifo->removeDownstream(*it);
+            delete *it;
+        }
+    }
+}
+
+void FilterBankChannelizer::setBasebandSampleRate(int sampleRate)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    unsigned int nbSubbands = 1;
+
+    while ((nbSubbands < m_maxNbSubbands) && (sampleRate / (int) (2*nbSubbands) >= m_minSubbandSpacing)) {
+        nbSubbands *= 2;
+    }
+
+    nbSubbands = nbSubbands < m_minNbSubbands ? 0 : nbSubbands;
+
+    if (nbSubbands != m_nbSubbands)
+    {
+        if ((nbSubbands != 0) && !m_subscriptions.empty()) { // else created on first subscription
+            m_filterBank.create(nbSubbands);
+        }
+
+        m_nbSubbands = nbSubbands;
+    }
+
+    m_basebandSampleRate = sampleRate;
+
+    if (m_nbSubbands != 0)
+    {
+        for (unsigned int k = 0; k < m_nbSubbands; k++)
+        {
+            if (m_subbandFifos[k]) {
+                m_subbandFifos[k]->setSize(SampleSinkFifo::getSizePolicy((2 * m_basebandSampleRate) / m_nbSubbands));
+            }
+        }
+    }
+
+    qDebug("FilterBankChannelizer::setBasebandSampleRate: %d S/s %u sub-bands", sampleRate, m_nbSubbands);
+}
+
+int FilterBankChannelizer::getSubband(qint64 frequencyOffset, int bandwidth, int& subbandSampleRate, qint64& subbandFrequencyOffset)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_nbSubbands == 0) {
+        return -1;
+    }
+
+    qint64 spacing = m_basebandSampleRate / m_nbSubbands;
+    qint64 subband = (frequencyOffset + (frequencyOffset < 0 ? -spacing/2 : spacing/2)) / spacing; // nearest
+    qint64 offset = frequencyOffset - subband * spacing;
+
+    // flat up to 0.75 spacing from the sub-band center
+    if ((offset < 0 ? -offset : offset) + bandwidth/2 > (3 * spacing) / 4) {
+        return -1;
+    }
+
+    subbandSampleRate = (2 * m_basebandSampleRate) / m_nbSubbands;
+    subbandFrequencyOffset = offset;
+
+    return (int) ((subband < 0 ? subband + m_nbSubbands : subband) % m_nbSubbands);
+}
+
+SampleSinkSharedFifo *FilterBankChannelizer::subscribe(qint64 frequencyOffset, int bandwidth, int& subbandSampleRate, qint64& subbandFrequencyOffset)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    int subband = getSubband(frequencyOffset, bandwidth, subbandSampleRate, subbandFrequencyOffset);
+
+    if (subband < 0) {
+        return nullptr;
+    }
+
+    unsigned int k = (unsigned int) subband;
+
+    if (!m_subbandFifos[k])
+    {
+        m_subbandFifos[k] = new SampleSinkSharedFifo();
+        m_subbandFifos[k]->setSize(SampleSinkFifo::getSizePolicy(subbandSampleRate));
+        m_basebandFifo->addDownstream(m_subbandFifos[k]); // sub-band readers count in the baseband backpressure
+    }
+
+    if (m_subscriptions.empty())
+    {
+        if (m_filterBank.getNbSubbands() != m_nbSubbands) {
+            m_filterBank.create(m_nbSubbands);
+        }
+
+        if (!m_thread->isRunning()) {
+            m_thread->start();
+        }
+
+        m_filterBank.reset();
+        m_sampleFifo.attachSharedFifo(m_basebandFifo);
+    }
+
+    m_subscriptions.insert(m_subbandFifos[k]);
+    qDebug("FilterBankChannelizer::subscribe: offset: %lld bandwidth: %d sub-band: %u residual offset: %lld",
+        frequencyOffset, bandwidth, k, subbandFrequencyOffset);
+
+    return m_subbandFifos[k];
+}
+
+void FilterBankChannelizer::unsubscribe(SampleSinkSharedFifo *subbandFifo)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    std::multiset<SampleSinkSharedFifo*>::iterator it = m_subscriptions.find(subbandFifo);
+
+    if (it == m_subscriptions.end()) { // not subscribed or already unsubscribed
+        return;
+    }
+
+    m_subscriptions.erase(it); // one subscription only
+
+    if (m_subscriptions.empty()) {
+        m_sampleFifo.detachSharedFifo();
+    }
+}
+
+void FilterBankChannelizer::handleData()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    while ((m_sampleFifo.fill() > 0) && m_sampleFifo.isAttachedToSharedFifo())
+    {
+        SampleVector::iterator part1begin;
+        SampleVector::iterator part1end;
+        SampleVector::iterator part2begin;
+        SampleVector::iterator part2end;
+
+        std::size_t count = m_sampleFifo.readBegin(m_sampleFifo.fill(), &part1begin, &part1end, &part2begin, &part2end);
+
+        if (m_nbSubbands != 0)
+        {
+            // only compute output of sub-bands being read
+            for (unsigned int k = 0; k < m_nbSubbands; k++) {
+                m_outputPointers[k] = m_subbandFifos[k] && m_subbandFifos[k]->hasReaders() ? &m_outputs[k] : nullptr;
+            }
+
+            if (part1begin != part1end) {
+                m_filterBank.feed(part1begin, part1end, m_outputPointers.data());
+            }
+
+            if (part2begin != part2end) {
+                m_filterBank.feed(part2begin, part2end, m_outputPointers.data());
+            }
+
+            for (unsigned int k = 0; k < m_nbSubbands; k++)
+            {
+                if (m_outputPointers[k])
+                {
+                    m_subbandFifos[k]->write(m_outputs[k].begin(), m_outputs[k].end());
+                    m_outputs[k].clear();
+                }
+            }
+        }
+
+        m_sampleFifo.readCommit((unsigned int) count);
+    }
+}
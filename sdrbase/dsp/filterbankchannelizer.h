@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// Device level polyphase filter bank shared by channels. The baseband is split  //
+// once into uniform sub-bands and channels read the sub-band containing them    //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILTERBANKCHANNELIZER_H_
+#define SDRBASE_DSP_FILTERBANKCHANNELIZER_H_
+
+#include <set>
+#include <vector>
+
+#include <QObject>
+#include <QMutex>
+
+#include "dsp/dsptypes.h"
+#include "dsp/samplesinkfifo.h"
+#include "dsp/polyphasefilterbank.h"
+#include "export.h"
+
+class QThread;
+class SampleSinkSharedFifo;
+
+/**
+ * Reads the device baseband from its shared FIFO in its own thread and publishes each sub-band that
+ * has readers in a sub-band shared FIFO. The number of sub-bands follows the baseband sample rate so
+ * that sub-bands are at least m_minSubbandSpacing apart and the sub-band sample rate stays between
+ * 2 and 4 times that whatever the device sample rate. The bank only runs while it has subscribers and
+ * its thread and filter are only created on the first subscription.
+ *
+ * A channel subscribes with its offset and bandwidth, attaches its FIFO to the sub-band FIFO returned
+ * and channelizes from the sub-band sample rate with the returned residual offset. On each baseband sample
+ * rate change it checks with getSubband() if its sub-band is still the same and subscribes again if not.
+ */
+class SDRBASE_API FilterBankChannelizer : public QObject
+{
+    Q_OBJECT
+public:
+    FilterBankChannelizer(SampleSinkSharedFifo *basebandFifo);
+    ~FilterBankChannelizer();
+
+    void setBasebandSampleRate(int sampleRate); //!< Called by the device engine before channels are notified
+
+    /**
+     * Returns the FIFO of the sub-band containing [frequencyOffset - bandwidth/2, frequencyOffset + bandwidth/2]
+     * in its flat part or nullptr if there is none. Sets the sub-band sample rate and the channel frequency offset
+     * from the sub-band center.
+     */
+    int getSubband(qint64 frequencyOffset, int bandwidth, int& subbandSampleRate, qint64& subbandFrequencyOffset); //!< Same as subscribe but only returns the sub-band index or -1
+    SampleSinkSharedFifo *subscribe(qint64 frequencyOffset, int bandwidth, int& subbandSampleRate, qint64& subbandFrequencyOffset);
+    void unsubscribe(SampleSinkSharedFifo *subbandFifo); //!< Releases one subscription to this FIFO - ignored if there is none
+    unsigned int getNbSubbands() const { return m_nbSubbands; }
+
+    static const int m_minSubbandSpacing = 100000;  //!< Hz
+    static const unsigned int m_minNbSubbands = 8;  //!< below this channels are better off channelizing the baseband themselves
+    static const unsigned int m_maxNbSubbands = 256;
+
+private:
+    SampleSinkSharedFifo *m_basebandFifo;
+    SampleSinkFifo m_sampleFifo; //!< reader of the baseband shared FIFO
+    QThread *m_thread; //!< started on first subscription
+    PolyphaseFilterBank m_filterBank;
+    std::vector<SampleSinkSharedFifo*> m_subbandFifos; //!< allocated on first subscription and kept until destruction
+    std::vector<SampleVector> m_outputs;
+    std::vector<SampleVector*> m_outputPointers;
+    int m_basebandSampleRate;
+    unsigned int m_nbSubbands; //!< 0 if disabled
+    std::multiset<SampleSinkSharedFifo*> m_subscriptions; //!< one sub-band FIFO per subscription - several channels may share a sub-band
+    QMutex m_mutex;
+
+private slots:
+    void handleData();
+};
+
+#endif // SDRBASE_DSP_FILTERBANKCHANNELIZER_H_
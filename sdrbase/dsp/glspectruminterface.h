@@ -27,6 +27,8 @@ public:
     GLSpectrumInterface() {}
     virtual ~GLSpectrumInterface() {}
     virtual void newSpectrum(const std::vector<Real>& spectrum, int fftSize) {}
+    //! Spectrum of nbBins bins pooled from an FFT of fftSize
+    virtual void newSpectrum(const std::vector<Real>& spectrum, int nbBins, int fftSize) { (void) fftSize; newSpectrum(spectrum, nbBins); }
 };
 
 #endif // SDRBASE_DSP_GLSPECTRUMINTERFACE_H_
@@ -47,6 +47,8 @@ void GLSpectrumSettings::resetToDefaults()
 	m_averagingMode = AvgModeNone;
 	m_averagingIndex = 0;
 	m_linear = false;
+	m_reductionBins = 0;
+	m_reductionMode = ReductionMax;
 }
 
 QByteArray GLSpectrumSettings::serialize() const
@@ -74,6 +76,8 @@ QByteArray GLSpectrumSettings::serialize() const
 	s.writeS32(19, (int) m_averagingMode);
 	s.writeS32(20, (qint32) getAveragingValue(m_averagingIndex, m_averagingMode));
 	s.writeBool(21, m_linear);
+	s.writeS32(22, m_reductionBins);
+	s.writeS32(23, (int) m_reductionMode);
 
 	return s.final();
 }
@@ -116,6 +120,9 @@ bool GLSpectrumSettings::deserialize(const QByteArray& data)
 		m_averagingIndex = getAveragingIndex(tmp, m_averagingMode);
 	    m_averagingNb = getAveragingValue(m_averagingIndex, m_averagingMode);
 	    d.readBool(21, &m_linear, false);
+		d.readS32(22, &m_reductionBins, 0);
+		d.readS32(23, &tmp, 0);
+		m_reductionMode = tmp == 1 ? ReductionMean : ReductionMax;
 
 		return true;
 	}
@@ -36,6 +36,12 @@ public:
         AvgModeMax
     };
 
+    enum ReductionMode
+    {
+        ReductionMax,
+        ReductionMean
+    };
+
 	int m_fftSize;
 	int m_fftOverlap;
 	FFTWindow::Function m_fftWindow;
@@ -58,6 +64,8 @@ public:
 	int m_averagingIndex;
 	unsigned int m_averagingNb;
 	bool m_linear; //!< linear else logarithmic scale
+	int m_reductionBins; //!< number of bins sent to displays. 0 or not less than FFT size for full resolution
+	ReductionMode m_reductionMode; //!< how FFT bins are pooled into display bins
 
     GLSpectrumSettings();
 	virtual ~GLSpectrumSettings();
@@ -1,6 +1,10 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include <vector>
+#include <algorithm>
+#ifdef USE_AVX
+#include <immintrin.h>
+#endif
 #include "dsp/interpolator.h"
 
 
@@ -159,6 +163,18 @@ void Interpolator::create(int phaseSteps, double sampleRate, double cutoff, doub
 		m_alignedTaps2[2 * (i - 1) + 0] = polyphase[i];
 		m_alignedTaps2[2 * (i - 1) + 1] = polyphase[i];
 	}
+
+	// block processing runs on samples in time order thus with the taps reversed
+	m_blockTaps.resize(2 * taps.size());
+
+	for (int phase = 0; phase < phaseSteps; phase++)
+	{
+		for (int i = 0; i < m_nTaps; i++)
+		{
+			m_blockTaps[2 * (phase * m_nTaps + i) + 0] = polyphase[phase * m_nTaps + m_nTaps - 1 - i];
+			m_blockTaps[2 * (phase * m_nTaps + i) + 1] = polyphase[phase * m_nTaps + m_nTaps - 1 - i];
+		}
+	}
 }
 
 void Interpolator::free()
@@ -173,3 +189,111 @@ void Interpolator::free()
 		m_alignedTaps2 = NULL;
 	}
 }
+
+int Interpolator::decimate(Real *distance, Real step, const Complex *in, int nbIn, std::vector<Complex>& out)
+{
+	m_schedulePositions.clear();
+	m_schedulePhases.clear();
+
+	for (int i = 0; i < nbIn; i++)
+	{
+		*distance -= 1.0;
+
+		if (*distance >= 1.0) {
+			continue;
+		}
+
+		m_schedulePositions.push_back(i + 1); // after the sample is pushed
+		m_schedulePhases.push_back((int) floor(*distance * (Real)m_phaseSteps));
+		*distance += step;
+	}
+
+	runSchedule(in, nbIn, out);
+	return out.size();
+}
+
+int Interpolator::interpolate(Real *distance, Real step, const Complex *in, int nbIn, std::vector<Complex>& out)
+{
+	m_schedulePositions.clear();
+	m_schedulePhases.clear();
+
+	for (int i = 0; i < nbIn; i++)
+	{
+		while (*distance < 1.0)
+		{
+			m_schedulePositions.push_back(i); // before the sample is pushed
+			m_schedulePhases.push_back((int) floor(*distance * (Real)m_phaseSteps));
+			*distance += step;
+		}
+
+		*distance -= 1.0;
+	}
+
+	runSchedule(in, nbIn, out);
+	return out.size();
+}
+
+void Interpolator::runSchedule(const Complex *in, int nbIn, std::vector<Complex>& out)
+{
+	// oldest history sample first
+	m_blockSamples.resize(m_nTaps + nbIn);
+
+	for (int i = 0; i < m_nTaps; i++) {
+		m_blockSamples[i] = m_samples[(m_ptr + m_nTaps - 1 - i) % m_nTaps];
+	}
+
+	std::copy(in, in + nbIn, m_blockSamples.begin() + m_nTaps);
+	out.resize(m_schedulePositions.size());
+
+	for (unsigned int i = 0; i < m_schedulePositions.size(); i++)
+	{
+		int phase = std::min(std::max(m_schedulePhases[i], 0), m_phaseSteps - 1);
+		out[i] = dotProduct(&m_blockSamples[m_schedulePositions[i]], &m_blockTaps[phase * m_nTaps * 2], m_nTaps);
+	}
+
+	// back to the ring buffer with the newest sample at index 0
+	for (int i = 0; i < m_nTaps; i++) {
+		m_samples[i] = m_blockSamples[m_nTaps + nbIn - 1 - i];
+	}
+
+	m_ptr = 0;
+}
+
+Complex Interpolator::dotProduct(const Complex *samples, const float *taps, int nTaps)
+{
+	const float *src = (const float*) samples;
+	int n = 2 * nTaps; // I and Q interleaved
+	int i = 0;
+	float acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+#if defined(USE_AVX)
+	__m256 sum0 = _mm256_setzero_ps();
+	__m256 sum1 = _mm256_setzero_ps();
+
+	for (; i + 16 <= n; i += 16)
+	{
+		sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(src + i), _mm256_loadu_ps(taps + i)));
+		sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_loadu_ps(src + i + 8), _mm256_loadu_ps(taps + i + 8)));
+	}
+
+	_mm256_storeu_ps(acc, _mm256_add_ps(sum0, sum1));
+#elif defined(USE_SSE2)
+	__m128 sum0 = _mm_setzero_ps();
+	__m128 sum1 = _mm_setzero_ps();
+
+	for (; i + 8 <= n; i += 8)
+	{
+		sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(src + i), _mm_loadu_ps(taps + i)));
+		sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(src + i + 4), _mm_loadu_ps(taps + i + 4)));
+	}
+
+	_mm_storeu_ps(acc, _mm_add_ps(sum0, sum1));
+#endif
+	// even indexes are I odd indexes are Q
+	for (; i < n; i += 2)
+	{
+		acc[0] += src[i] * taps[i];
+		acc[1] += src[i + 1] * taps[i + 1];
+	}
+
+	return Complex(acc[0] + acc[2] + acc[4] + acc[6], acc[1] + acc[3] + acc[5] + acc[7]);
+}
@@ -21,6 +21,8 @@
 #ifdef USE_SSE2
 #include <emmintrin.h>
 #endif
+#include <vector>
+
 #include "dsp/dsptypes.h"
 #include "export.h"
 #include <stdio.h>
@@ -89,6 +91,13 @@ public:
 		return true;
 	}
 
+	// Block versions of decimate and interpolate: all nbIn samples are consumed and the results replace the content of out.
+	// *distance is incremented by step after each result like the per sample loops do. The phase of each result is
+	// worked out first then the filters run on a linear copy of the samples. Results are the same as the per sample
+	// methods up to the order of the floating point additions.
+	int decimate(Real *distance, Real step, const Complex *in, int nbIn, std::vector<Complex>& out);
+	int interpolate(Real *distance, Real step, const Complex *in, int nbIn, std::vector<Complex>& out);
+
 private:
 	float* m_taps;
 	float* m_alignedTaps;
@@ -98,6 +107,10 @@ private:
 	int m_ptr;
 	int m_phaseSteps;
 	int m_nTaps;
+	std::vector<float> m_blockTaps;     //!< taps of each phase in reverse order doubled for I and Q
+	std::vector<Complex> m_blockSamples; //!< filter history then block samples in time order
+	std::vector<int> m_schedulePositions; //!< number of block samples in the filter for each result
+	std::vector<int> m_schedulePhases;
 
 	static void createPolyphaseLowPass(
 	    std::vector<Real>& taps,
@@ -117,6 +130,8 @@ private:
         double nbTapsPerPhase);
 
 	void createTaps(int nTaps, double sampleRate, double cutoff, std::vector<Real>* taps);
+	void runSchedule(const Complex *in, int nbIn, std::vector<Complex>& out);
+	static Complex dotProduct(const Complex *samples, const float *taps, int nTaps);
 
 	void advanceFilter(const Complex& next)
 	{
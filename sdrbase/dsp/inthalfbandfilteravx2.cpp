@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "inthalfbandfilteravx2.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define HB_AVX2_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define HB_AVX2_TARGET
+#else
+// compile only these functions for AVX2 so that the rest of the library keeps the base instruction set
+#define HB_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+bool IntHalfbandFilterAVX2::m_enabled = IntHalfbandFilterAVX2::isSupported();
+
+bool IntHalfbandFilterAVX2::isSupported()
+{
+#if defined(HB_AVX2_X86)
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+
+    if (info[0] < 7) {
+        return false;
+    }
+
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    if (!osxsave || !avx || ((_xgetbv(0) & 0x6) != 0x6)) { // OS saves YMM registers
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init(); // may run from a static initializer
+    return __builtin_cpu_supports("avx2");
+#endif
+#else
+    return false;
+#endif
+}
+
+void IntHalfbandFilterAVX2::setEnabled(bool enabled)
+{
+    m_enabled = enabled && isSupported();
+}
+
+#if defined(HB_AVX2_X86)
+
+HB_AVX2_TARGET static inline quint32 hsum32(__m256i v)
+{
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (quint32) _mm_cvtsi128_si32(s);
+}
+
+HB_AVX2_TARGET static inline quint64 hsum64(__m256i v)
+{
+    __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi64(s, _mm_unpackhi_epi64(s, s));
+    quint64 r;
+    _mm_storel_epi64((__m128i*) &r, s);
+    return r;
+}
+
+HB_AVX2_TARGET static void symmetricFIR32AVX2(
+    const qint32 *tipI, const qint32 *tailI,
+    const qint32 *tipQ, const qint32 *tailQ,
+    const int32_t *coeffs, int nbTaps,
+    qint32 *iAcc, qint32 *qAcc)
+{
+    const __m256i reverse = _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i accI = _mm256_setzero_si256();
+    __m256i accQ = _mm256_setzero_si256();
+    int i = 0;
+
+    for (; i + 8 <= nbTaps; i += 8)
+    {
+        __m256i c = _mm256_loadu_si256((const __m256i*) &coeffs[i]);
+        __m256i tI = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) (tipI - i - 7)), reverse);
+        __m256i tQ = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) (tipQ - i - 7)), reverse);
+        __m256i sI = _mm256_add_epi32(tI, _mm256_loadu_si256((const __m256i*) (tailI + i)));
+        __m256i sQ = _mm256_add_epi32(tQ, _mm256_loadu_si256((const __m256i*) (tailQ + i)));
+        accI = _mm256_add_epi32(accI, _mm256_mullo_epi32(sI, c));
+        accQ = _mm256_add_epi32(accQ, _mm256_mullo_epi32(sQ, c));
+    }
+
+    quint32 iSum = hsum32(accI);
+    quint32 qSum = hsum32(accQ);
+
+    for (; i < nbTaps; i++)
+    {
+        iSum += ((quint32) tipI[-i] + (quint32) tailI[i]) * (quint32) coeffs[i];
+        qSum += ((quint32) tipQ[-i] + (quint32) tailQ[i]) * (quint32) coeffs[i];
+    }
+
+    *iAcc += (qint32) iSum;
+    *qAcc += (qint32) qSum;
+}
+
+HB_AVX2_TARGET static void symmetricFIR64AVX2(
+    const qint64 *tipI, const qint64 *tailI,
+    const qint64 *tipQ, const qint64 *tailQ,
+    const int32_t *coeffs, int nbTaps,
+    qint64 *iAcc, qint64 *qAcc)
+{
+    __m256i accI = _mm256_setzero_si256();
+    __m256i accQ = _mm256_setzero_si256();
+    int i = 0;
+
+    for (; i + 4 <= nbTaps; i += 4)
+    {
+        __m256i c = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*) &coeffs[i]));
+        __m256i tI = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i*) (tipI - i - 3)), _MM_SHUFFLE(0, 1, 2, 3));
+        __m256i tQ = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i*) (tipQ - i - 3)), _MM_SHUFFLE(0, 1, 2, 3));
+        // stored samples always come from 32 bit values so the signed 32x32 bit multiply is exact
+        // and tip*c + tail*c is equal to (tip + tail)*c modulo 2^64
+        accI = _mm256_add_epi64(accI, _mm256_mul_epi32(tI, c));
+        accI = _mm256_add_epi64(accI, _mm256_mul_epi32(_mm256_loadu_si256((const __m256i*) (tailI + i)), c));
+        accQ = _mm256_add_epi64(accQ, _mm256_mul_epi32(tQ, c));
+        accQ = _mm256_add_epi64(accQ, _mm256_mul_epi32(_mm256_loadu_si256((const __m256i*) (tailQ + i)), c));
+    }
+
+    quint64 iSum = hsum64(accI);
+    quint64 qSum = hsum64(accQ);
+
+    for (; i < nbTaps; i++)
+    {
+        iSum += ((quint64) tipI[-i] + (quint64) tailI[i]) * (quint64) (qint64) coeffs[i];
+        qSum += ((quint64) tipQ[-i] + (quint64) tailQ[i]) * (quint64) (qint64) coeffs[i];
+    }
+
+    *iAcc += (qint64) iSum;
+    *qAcc += (qint64) qSum;
+}
+
+#endif // HB_AVX2_X86
+
+void IntHalfbandFilterAVX2::symmetricFIR(
+    const qint32 *tipI, const qint32 *tailI,
+    const qint32 *tipQ, const qint32 *tailQ,
+    const int32_t *coeffs, int nbTaps,
+    qint32 *iAcc, qint32 *qAcc)
+{
+#if defined(HB_AVX2_X86)
+    symmetricFIR32AVX2(tipI, tailI, tipQ, tailQ, coeffs, nbTaps, iAcc, qAcc);
+#else
+    (void) tipI; (void) tailI; (void) tipQ; (void) tailQ; (void) coeffs; (void) nbTaps; (void) iAcc; (void) qAcc;
+#endif
+}
+
+void IntHalfbandFilterAVX2::symmetricFIR(
+    const qint64 *tipI, const qint64 *tailI,
+    const qint64 *tipQ, const qint64 *tailQ,
+    const int32_t *coeffs, int nbTaps,
+    qint64 *iAcc, qint64 *qAcc)
+{
+#if defined(HB_AVX2_X86)
+    symmetricFIR64AVX2(tipI, tailI, tipQ, tailQ, coeffs, nbTaps, iAcc, qAcc);
+#else
+    (void) tipI; (void) tailI; (void) tipQ; (void) tailQ; (void) coeffs; (void) nbTaps; (void) iAcc; (void) qAcc;
+#endif
+}
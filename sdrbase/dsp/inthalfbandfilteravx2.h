@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// AVX2 kernels for the even/odd integer half-band filters. Selected at run time //
+// so that the same binary runs on CPUs without AVX2                             //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_INTHALFBANDFILTERAVX2_H_
+#define SDRBASE_DSP_INTHALFBANDFILTERAVX2_H_
+
+#include <stdint.h>
+#include <QtGlobal>
+
+#include "export.h"
+
+/**
+ * Symmetric FIR half of the even/odd half-band convolution:
+ *   acc = sum(i = 0..nbTaps-1) (tip[-i] + tail[i]) * coeffs[i]
+ * computed for I and Q. Arithmetic wraps exactly like the scalar code so results are bit identical.
+ */
+class SDRBASE_API IntHalfbandFilterAVX2
+{
+public:
+    static bool isSupported();                             //!< CPU and OS support AVX2
+    static bool isEnabled() { return m_enabled; }          //!< AVX2 kernels are used
+    static void setEnabled(bool enabled);                  //!< Only effective if supported. For benchmarks.
+
+    static void symmetricFIR(
+        const qint32 *tipI, const qint32 *tailI,
+        const qint32 *tipQ, const qint32 *tailQ,
+        const int32_t *coeffs, int nbTaps,
+        qint32 *iAcc, qint32 *qAcc);
+
+    static void symmetricFIR(
+        const qint64 *tipI, const qint64 *tailI,
+        const qint64 *tipQ, const qint64 *tailQ,
+        const int32_t *coeffs, int nbTaps,
+        qint64 *iAcc, qint64 *qAcc);
+
+private:
+    static bool m_enabled;
+};
+
+/**
+ * Dispatch helpers used by the half-band filter templates. Return false if the caller must run its scalar code.
+ * Below the thresholds the inlined scalar loop is auto vectorized and the call to the AVX2 kernel costs as much as
+ * it saves. This keeps the DownChannelizer (order 48, 12 taps) and the 16 bit Decimators (order 64 with 32 bit
+ * storage, 16 taps) on the scalar code: measured within noise of each other with the thresholds lowered.
+ */
+template<typename StorageType, typename AccuType>
+inline bool hbSymmetricFIRAVX2(
+    const StorageType*, const StorageType*, const StorageType*, const StorageType*,
+    const int32_t*, int, AccuType*, AccuType*)
+{
+    return false;
+}
+
+inline bool hbSymmetricFIRAVX2(
+    const qint32 *tipI, const qint32 *tailI, const qint32 *tipQ, const qint32 *tailQ,
+    const int32_t *coeffs, int nbTaps, qint32 *iAcc, qint32 *qAcc)
+{
+    if (!IntHalfbandFilterAVX2::isEnabled() || (nbTaps < 24)) { // order 96 and above
+        return false;
+    }
+
+    IntHalfbandFilterAVX2::symmetricFIR(tipI, tailI, tipQ, tailQ, coeffs, nbTaps, iAcc, qAcc);
+    return true;
+}
+
+inline bool hbSymmetricFIRAVX2(
+    const qint64 *tipI, const qint64 *tailI, const qint64 *tipQ, const qint64 *tailQ,
+    const int32_t *coeffs, int nbTaps, qint64 *iAcc, qint64 *qAcc)
+{
+    if (!IntHalfbandFilterAVX2::isEnabled() || (nbTaps < 16)) { // order 64 and above
+        return false;
+    }
+
+    IntHalfbandFilterAVX2::symmetricFIR(tipI, tailI, tipQ, tailQ, coeffs, nbTaps, iAcc, qAcc);
+    return true;
+}
+
+#endif // SDRBASE_DSP_INTHALFBANDFILTERAVX2_H_
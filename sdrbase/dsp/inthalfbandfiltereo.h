@@ -27,6 +27,7 @@
 #include <cstdlib>
 #include "dsp/dsptypes.h"
 #include "dsp/hbfiltertraits.h"
+#include "dsp/inthalfbandfilteravx2.h"
 
 template<typename EOStorageType, typename AccuType, uint32_t HBFilterOrder>
 class IntHalfbandFilterEO {
@@ -568,6 +569,52 @@ public:
         }
     }
 
+    /** Block variants of the decimators. Samples are processed in place: the decimated output
+     *  is compacted at the start of the buffer and the number of output samples is returned.
+     *  Output is identical to calling the single sample variant on each sample in sequence.
+     */
+    int workDecimateCenterBlock(Sample* samples, int nbSamples)
+    {
+        int nbOut = 0;
+
+        for (int i = 0; i < nbSamples; i++)
+        {
+            if (workDecimateCenter(&samples[i])) {
+                samples[nbOut++] = samples[i];
+            }
+        }
+
+        return nbOut;
+    }
+
+    int workDecimateLowerHalfBlock(Sample* samples, int nbSamples)
+    {
+        int nbOut = 0;
+
+        for (int i = 0; i < nbSamples; i++)
+        {
+            if (workDecimateLowerHalf(&samples[i])) {
+                samples[nbOut++] = samples[i];
+            }
+        }
+
+        return nbOut;
+    }
+
+    int workDecimateUpperHalfBlock(Sample* samples, int nbSamples)
+    {
+        int nbOut = 0;
+
+        for (int i = 0; i < nbSamples; i++)
+        {
+            if (workDecimateUpperHalf(&samples[i])) {
+                samples[nbOut++] = samples[i];
+            }
+        }
+
+        return nbOut;
+    }
+
     void myDecimate(const Sample* sample1, Sample* sample2)
     {
         storeSample((FixReal) sample1->real(), (FixReal) sample1->imag());
@@ -837,30 +884,32 @@ protected:
         m_ptr = m_ptr + 1 < 2*m_size ? m_ptr + 1: 0;
     }
 
-    void doFIR(Sample* sample)
+    void doSymmetricFIR(AccuType& iAcc, AccuType& qAcc)
     {
-        AccuType iAcc = 0;
-        AccuType qAcc = 0;
-
         int a = m_ptr/2 + m_size; // tip pointer
         int b = m_ptr/2 + 1; // tail pointer
+        EOStorageType (*buf)[HBFIRFilterTraits<HBFilterOrder>::hbOrder] = (m_ptr % 2) == 0 ? m_even : m_odd;
+
+        if (hbSymmetricFIRAVX2(&buf[0][a], &buf[0][b], &buf[1][a], &buf[1][b],
+            HBFIRFilterTraits<HBFilterOrder>::hbCoeffs, HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4, &iAcc, &qAcc)) {
+            return;
+        }
 
         for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
         {
-            if ((m_ptr % 2) == 0)
-            {
-                iAcc += ((EOStorageType)(m_even[0][a] + m_even[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_even[1][a] + m_even[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-            else
-            {
-                iAcc += ((EOStorageType)(m_odd[0][a] + m_odd[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_odd[1][a] + m_odd[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-
+            iAcc += ((EOStorageType)(buf[0][a] + buf[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+            qAcc += ((EOStorageType)(buf[1][a] + buf[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
             a -= 1;
             b += 1;
         }
+    }
+
+    void doFIR(Sample* sample)
+    {
+        AccuType iAcc = 0;
+        AccuType qAcc = 0;
+
+        doSymmetricFIR(iAcc, qAcc);
 
         if ((m_ptr % 2) == 0)
         {
@@ -882,25 +931,7 @@ protected:
         AccuType iAcc = 0;
         AccuType qAcc = 0;
 
-        int a = m_ptr/2 + m_size; // tip pointer
-        int b = m_ptr/2 + 1; // tail pointer
-
-        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
-        {
-            if ((m_ptr % 2) == 0)
-            {
-                iAcc += ((EOStorageType)(m_even[0][a] + m_even[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_even[1][a] + m_even[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-            else
-            {
-                iAcc += ((EOStorageType)(m_odd[0][a] + m_odd[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_odd[1][a] + m_odd[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-
-            a -= 1;
-            b += 1;
-        }
+        doSymmetricFIR(iAcc, qAcc);
 
         if ((m_ptr % 2) == 0)
         {
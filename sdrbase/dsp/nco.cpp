@@ -26,6 +26,7 @@
 #define M_PI		3.14159265358979323846
 
 Real NCO::m_table[NCO::TableSize];
+Complex NCO::m_tableIQ[NCO::TableSize];
 bool NCO::m_tableInitialized = false;
 
 void NCO::initTable()
@@ -36,6 +37,9 @@ void NCO::initTable()
 	for(int i = 0; i < TableSize; i++)
 		m_table[i] = cos((2.0 * M_PI * i) / TableSize);
 
+	for(int i = 0; i < TableSize; i++)
+		m_tableIQ[i] = Complex(m_table[i], -m_table[(i + TableSize / 4) % TableSize]);
+
 	m_tableInitialized = true;
 }
 
@@ -48,26 +52,28 @@ NCO::NCO()
 
 void NCO::setFreq(Real freq, Real sampleRate)
 {
-	m_phaseIncrement = (freq * TableSize) / sampleRate;
-	qDebug("NCO freq: %f phase inc %d", freq, m_phaseIncrement);
+	// negative frequencies wrap around
+	m_phaseIncrement = (quint32) (qint64) round(((double) freq / sampleRate) * 4294967296.0);
+	qDebug("NCO freq: %f phase inc %u", freq, m_phaseIncrement);
 }
 
 float NCO::next()
 {
 	nextPhase();
-	return m_table[m_phase];
+	return m_table[index()];
 }
 
 Complex NCO::nextIQ()
 {
 	nextPhase();
-	return Complex(m_table[m_phase], -m_table[(m_phase + TableSize / 4) % TableSize]);
+	return m_tableIQ[index()];
 }
 
 Complex NCO::nextQI()
 {
 	nextPhase();
-	return Complex(-m_table[(m_phase + TableSize / 4) % TableSize], m_table[m_phase]);
+	const Complex& iq = m_tableIQ[index()];
+	return Complex(iq.imag(), iq.real());
 }
 
 void NCO::nextIQMul(Real& i, Real& q)
@@ -75,35 +81,85 @@ void NCO::nextIQMul(Real& i, Real& q)
     nextPhase();
     Real x = i;
     Real y = q;
-    const Real& u = m_table[m_phase];
-    const Real& v = -m_table[(m_phase + TableSize / 4) % TableSize];
+    const Real& u = m_tableIQ[index()].real();
+    const Real& v = m_tableIQ[index()].imag();
     i = x*u - y*v;
     q = x*v + y*u;
 }
 
 float NCO::get()
 {
-	return m_table[m_phase];
+	return m_table[index()];
 }
 
 Complex NCO::getIQ()
 {
-	return Complex(m_table[m_phase], -m_table[(m_phase + TableSize / 4) % TableSize]);
+	return m_tableIQ[index()];
 }
 
 void NCO::getIQ(Complex& c)
 {
-	c.real(m_table[m_phase]);
-	c.imag(-m_table[(m_phase + TableSize / 4) % TableSize]);
+	c = m_tableIQ[index()];
 }
 
 Complex NCO::getQI()
 {
-	return Complex(-m_table[(m_phase + TableSize / 4) % TableSize], m_table[m_phase]);
+	const Complex& iq = m_tableIQ[index()];
+	return Complex(iq.imag(), iq.real());
 }
 
 void NCO::getQI(Complex& c)
 {
-	c.imag(m_table[m_phase]);
-	c.real(-m_table[(m_phase + TableSize / 4) % TableSize]);
+	const Complex& iq = m_tableIQ[index()];
+	c.imag(iq.real());
+	c.real(iq.imag());
+}
+
+void NCO::nextIQ(Complex *iq, int nbSamples)
+{
+	quint32 phase = m_phase;
+
+	for (int i = 0; i < nbSamples; i++)
+	{
+		phase += m_phaseIncrement;
+		iq[i] = m_tableIQ[phase >> PhaseShift];
+	}
+
+	m_phase = phase;
+}
+
+void NCO::mix(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, Complex *out)
+{
+	quint32 phase = m_phase;
+	const quint32 phaseIncrement = m_phaseIncrement;
+
+	for (SampleVector::const_iterator it = begin; it != end; ++it, ++out)
+	{
+		phase += phaseIncrement;
+		const Complex& iq = m_tableIQ[phase >> PhaseShift];
+		Real re = it->real();
+		Real im = it->imag();
+		out->real(re * iq.real() - im * iq.imag());
+		out->imag(re * iq.imag() + im * iq.real());
+	}
+
+	m_phase = phase;
+}
+
+void NCO::mix(Complex *samples, int nbSamples)
+{
+	quint32 phase = m_phase;
+	const quint32 phaseIncrement = m_phaseIncrement;
+
+	for (int i = 0; i < nbSamples; i++)
+	{
+		phase += phaseIncrement;
+		const Complex& iq = m_tableIQ[phase >> PhaseShift];
+		Real re = samples[i].real();
+		Real im = samples[i].imag();
+		samples[i].real(re * iq.real() - im * iq.imag());
+		samples[i].imag(re * iq.imag() + im * iq.real());
+	}
+
+	m_phase = phase;
 }
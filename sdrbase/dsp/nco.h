@@ -25,29 +25,30 @@
 class SDRBASE_API NCO {
 private:
 	enum {
-		TableSize = (1 << 12),
+		TableBits = 12,
+		TableSize = (1 << TableBits),
+		PhaseShift = 32 - TableBits //!< table index is the top bits of the phase accumulator
 	};
 	static Real m_table[TableSize];
+	static Complex m_tableIQ[TableSize]; //!< nextIQ() values
 	static bool m_tableInitialized;
 
 	static void initTable();
 
-	int m_phaseIncrement;
-	int m_phase;
+	quint32 m_phaseIncrement; //!< 32 bit wrapping phase accumulator increment: sample rate / 2^32 resolution
+	quint32 m_phase;
+
+	int index() const { return m_phase >> PhaseShift; }
 
 public:
 	NCO();
 
 	void setFreq(Real freq, Real sampleRate);
-	void setPhase(int phase) { m_phase = phase; }
+	void setPhase(int phase) { m_phase = ((quint32) phase) << PhaseShift; } //!< phase in 1/4096 turn
 
 	void nextPhase()        //!< Increment phase
 	{
 		m_phase += m_phaseIncrement;
-		while(m_phase >= TableSize)
-			m_phase -= TableSize;
-		while(m_phase < 0)
-			m_phase += TableSize;
 	}
 
 	Real next();            //!< Return next real sample
@@ -59,6 +60,11 @@ public:
 	void getIQ(Complex& c); //!< Sets to the current complex sample (no phase increment)
 	Complex getQI();        //!< Return current complex sample (no phase increment, reversed)
 	void getQI(Complex& c); //!< Sets to the current complex sample (no phase increment, reversed)
+
+	// Block versions giving the same values as the per sample calls
+	void nextIQ(Complex *iq, int nbSamples); //!< Fill with the next complex samples
+	void mix(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, Complex *out); //!< out[i] = sample[i] * nextIQ()
+	void mix(Complex *samples, int nbSamples); //!< samples[i] *= nextIQ() in place
 };
 
 #endif // INCLUDE_NCO_H
@@ -24,9 +24,9 @@
 #undef M_PI
 #define M_PI		3.14159265358979323846
 
-Real NCOF::m_table[NCOF::TableSize+1];
+Real NCOF::m_table[NCOF::TableSize];
+Complex NCOF::m_tableIQ[NCOF::TableSize];
 bool NCOF::m_tableInitialized = false;
-float NCOF::m_tableSizeLimit = (float) NCOF::TableSize;
 
 void NCOF::initTable()
 {
@@ -34,24 +34,29 @@ void NCOF::initTable()
 		return;
 	}
 
-	for(int i = 0; i <= TableSize; i++) {
+	for(int i = 0; i < TableSize; i++) {
 		m_table[i] = cos((2.0 * M_PI * i) / TableSize);
 	}
 
+	for(int i = 0; i < TableSize; i++) {
+		m_tableIQ[i] = Complex(m_table[i], -m_table[(i + TableSize / 4) % TableSize]);
+	}
+
 	m_tableInitialized = true;
 }
 
 NCOF::NCOF()
 {
 	initTable();
-	m_phase = 0.0f;
-	m_phaseIncrement = 0.0f;
+	m_phase = 0;
+	m_phaseIncrement = 0;
 }
 
 void NCOF::setFreq(Real freq, Real sampleRate)
 {
-	m_phaseIncrement = (freq * TableSize) / sampleRate;
-	qDebug("NCOF::setFreq: freq: %f m_phaseIncrement: %f", freq, m_phaseIncrement);
+	// negative frequencies wrap around
+	m_phaseIncrement = (quint32) (qint64) round(((double) freq / sampleRate) * 4294967296.0);
+	qDebug("NCOF::setFreq: freq: %f m_phaseIncrement: %u", freq, m_phaseIncrement);
 }
 
 float NCOF::next()
@@ -63,7 +68,7 @@ float NCOF::next()
 Complex NCOF::nextIQ()
 {
     int phase = nextPhase();
-	return Complex(m_table[phase], -m_table[(phase + TableSize / 4) % TableSize]);
+	return m_tableIQ[phase];
 }
 
 Complex NCOF::nextIQ(float imbalance)
@@ -77,32 +82,82 @@ Complex NCOF::nextIQ(float imbalance)
 Complex NCOF::nextQI()
 {
     int phase = nextPhase();
-	return Complex(-m_table[(phase + TableSize / 4) % TableSize], m_table[phase]);
+	return Complex(m_tableIQ[phase].imag(), m_tableIQ[phase].real());
 }
 
 float NCOF::get()
 {
-	return m_table[(int) m_phase];
+	return m_table[m_phase >> PhaseShift];
 }
 
 Complex NCOF::getIQ()
 {
-	return Complex(m_table[(int) m_phase], -m_table[((int) m_phase + TableSize / 4) % TableSize]);
+	return m_tableIQ[m_phase >> PhaseShift];
 }
 
 void NCOF::getIQ(Complex& c)
 {
-	c.real(m_table[(int) m_phase]);
-	c.imag(-m_table[((int) m_phase + TableSize / 4) % TableSize]);
+	c = m_tableIQ[m_phase >> PhaseShift];
 }
 
 Complex NCOF::getQI()
 {
-	return Complex(-m_table[((int) m_phase + TableSize / 4) % TableSize], m_table[(int) m_phase]);
+	const Complex& iq = m_tableIQ[m_phase >> PhaseShift];
+	return Complex(iq.imag(), iq.real());
 }
 
 void NCOF::getQI(Complex& c)
 {
-	c.imag(m_table[(int) m_phase]);
-	c.real(-m_table[((int) m_phase + TableSize / 4) % TableSize]);
+	const Complex& iq = m_tableIQ[m_phase >> PhaseShift];
+	c.imag(iq.real());
+	c.real(iq.imag());
+}
+
+void NCOF::nextIQ(Complex *iq, int nbSamples)
+{
+	quint32 phase = m_phase;
+
+	for (int i = 0; i < nbSamples; i++)
+	{
+		phase += m_phaseIncrement;
+		iq[i] = m_tableIQ[phase >> PhaseShift];
+	}
+
+	m_phase = phase;
+}
+
+void NCOF::mix(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, Complex *out)
+{
+	quint32 phase = m_phase;
+	const quint32 phaseIncrement = m_phaseIncrement;
+
+	for (SampleVector::const_iterator it = begin; it != end; ++it, ++out)
+	{
+		phase += phaseIncrement;
+		const Complex& iq = m_tableIQ[phase >> PhaseShift];
+		Real re = it->real();
+		Real im = it->imag();
+		out->real(re * iq.real() - im * iq.imag());
+		out->imag(re * iq.imag() + im * iq.real());
+	}
+
+	m_phase = phase;
+}
+
+void NCOF::mix(Complex *samples, int nbSamples)
+{
+	quint32 phase = m_phase;
+	const quint32 phaseIncrement = m_phaseIncrement;
+
+	for (int i = 0; i < nbSamples; i++)
+	{
+		phase += phaseIncrement;
+		const Complex& iq = m_tableIQ[phase >> PhaseShift];
+		Real re = samples[i].real();
+		Real im = samples[i].imag();
+		samples[i].real(re * iq.real() - im * iq.imag());
+		samples[i].imag(re * iq.imag() + im * iq.real());
+	}
+
+	m_phase = phase;
 }
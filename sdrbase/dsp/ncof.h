@@ -24,33 +24,29 @@
 class SDRBASE_API NCOF {
 private:
 	enum {
-		TableSize = (1 << 12),
+		TableBits = 12,
+		TableSize = (1 << TableBits),
+		PhaseShift = 32 - TableBits //!< table index is the top bits of the phase accumulator
 	};
-	static Real m_table[TableSize+1];
+	static Real m_table[TableSize];
+	static Complex m_tableIQ[TableSize]; //!< nextIQ() values
 	static bool m_tableInitialized;
-	static float m_tableSizeLimit;
 
 	static void initTable();
 
-	Real m_phaseIncrement;
-	Real m_phase;
+	quint32 m_phaseIncrement; //!< 32 bit wrapping phase accumulator increment: sample rate / 2^32 resolution
+	quint32 m_phase;
 
 public:
 	NCOF();
 
 	void setFreq(Real freq, Real sampleRate);
-	void setPhase(Real phase) { m_phase = phase; }
+	void setPhase(Real phase) { m_phase = (quint32) (qint64) (phase * (1 << PhaseShift)); } //!< phase in 1/4096 turn
 
 	int nextPhase()        //!< Increment phase and return its integer value
 	{
 		m_phase += m_phaseIncrement;
-		while(m_phase >= m_tableSizeLimit) {
-			m_phase -= TableSize;
-		}
-		while(m_phase < 0.0) {
-			m_phase += TableSize;
-		}
-		return (int) m_phase;
+		return m_phase >> PhaseShift;
 	}
 
 	Real next();                        //!< Return next real sample
@@ -62,6 +58,11 @@ public:
 	void getIQ(Complex& c);             //!< Sets to the current complex sample (no phase increment)
 	Complex getQI();                    //!< Return current complex sample (no phase increment, reversed)
 	void getQI(Complex& c);             //!< Sets to the current complex sample (no phase increment, reversed)
+
+	// Block versions giving the same values as the per sample calls
+	void nextIQ(Complex *iq, int nbSamples); //!< Fill with the next complex samples
+	void mix(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, Complex *out); //!< out[i] = sample[i] * nextIQ()
+	void mix(Complex *samples, int nbSamples); //!< samples[i] *= nextIQ() in place
 };
 
 #endif // INCLUDE_NCO_H
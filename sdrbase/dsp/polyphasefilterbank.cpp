@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <algorithm>
+
+#include <QDebug>
+
+#include "dsp/dspengine.h"
+#include "dsp/fftfactory.h"
+#include "dsp/fftengine.h"
+#include "polyphasefilterbank.h"
+
+PolyphaseFilterBank::PolyphaseFilterBank() :
+    m_nbSubbands(0),
+    m_tapsPerBranch(0),
+    m_length(0),
+    m_historyIndex(0),
+    m_inputCount(0),
+    m_frameCount(0),
+    m_fftFactory(nullptr),
+    m_fft(nullptr),
+    m_fftSequence(0)
+{
+}
+
+PolyphaseFilterBank::~PolyphaseFilterBank()
+{
+    releaseFFT();
+}
+
+void PolyphaseFilterBank::releaseFFT()
+{
+    if (m_fft)
+    {
+        if (m_fftFactory) {
+            m_fftFactory->releaseEngine(m_nbSubbands, true, m_fftSequence);
+        } else {
+            delete m_fft;
+        }
+
+        m_fft = nullptr;
+    }
+}
+
+void PolyphaseFilterBank::create(unsigned int nbSubbands, unsigned int tapsPerBranch)
+{
+    releaseFFT();
+
+    m_nbSubbands = nbSubbands;
+    m_tapsPerBranch = tapsPerBranch;
+    m_length = nbSubbands * tapsPerBranch;
+
+    // windowed sinc prototype with cutoff at fs/N in the middle of the transition band.
+    // Blackman-Harris window gives more than 90 dB alias rejection.
+    std::vector<double> taps(m_length);
+    double sum = 0.0;
+    double center = (m_length - 1) / 2.0;
+
+    for (unsigned int i = 0; i < m_length; i++)
+    {
+        double x = (2.0 * (i - center)) / m_nbSubbands;
+        double sinc = x == 0.0 ? 1.0 : sin(M_PI * x) / (M_PI * x);
+        double a = (2.0 * M_PI * i) / (m_length - 1);
+        double window = 0.35875 - 0.48829 * cos(a) + 0.14128 * cos(2.0 * a) - 0.01168 * cos(3.0 * a);
+        taps[i] = sinc * window;
+        sum += taps[i];
+    }
+
+    // unity gain and time reversed
+    m_taps.resize(m_length);
+
+    for (unsigned int i = 0; i < m_length; i++) {
+        m_taps[i] = taps[m_length - 1 - i] / sum;
+    }
+
+    m_history.resize(2 * m_length);
+    m_folded.resize(m_nbSubbands);
+    m_fftFactory = DSPEngine::instance()->getFFTFactory();
+
+    if (m_fftFactory)
+    {
+        m_fftSequence = m_fftFactory->getEngine(m_nbSubbands, true, &m_fft);
+    }
+    else // no factory: own engine
+    {
+        m_fft = FFTEngine::create(QString(""));
+
+        if (m_fft) {
+            m_fft->configure(m_nbSubbands, true);
+        }
+    }
+
+    reset();
+
+    qDebug("PolyphaseFilterBank::create: %u sub-bands %u taps per branch", m_nbSubbands, m_tapsPerBranch);
+}
+
+void PolyphaseFilterBank::reset()
+{
+    std::fill(m_history.begin(), m_history.end(), Complex{0, 0});
+    m_historyIndex = 0;
+    m_inputCount = 0;
+    m_frameCount = 0;
+}
+
+void PolyphaseFilterBank::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, SampleVector **outputs)
+{
+    if (!m_fft) {
+        return;
+    }
+
+    unsigned int decimation = getDecimation();
+
+    for (SampleVector::const_iterator it = begin; it != end; ++it)
+    {
+        Complex c(it->real(), it->imag());
+        m_history[m_historyIndex] = c;
+        m_history[m_historyIndex + m_length] = c;
+        m_historyIndex = m_historyIndex == m_length - 1 ? 0 : m_historyIndex + 1;
+
+        if (++m_inputCount == decimation)
+        {
+            m_inputCount = 0;
+            outputFrame(outputs);
+        }
+    }
+}
+
+void PolyphaseFilterBank::outputFrame(SampleVector **outputs)
+{
+    // oldest to newest sample of the last m_length
+    const Complex *window = &m_history[m_historyIndex];
+    const float *taps = m_taps.data();
+    Complex *folded = m_folded.data();
+
+    std::fill(m_folded.begin(), m_folded.end(), Complex{0, 0});
+
+    for (unsigned int q = 0; q < m_tapsPerBranch; q++)
+    {
+        for (unsigned int m = 0; m < m_nbSubbands; m++) {
+            folded[m] += taps[m] * window[m];
+        }
+
+        taps += m_nbSubbands;
+        window += m_nbSubbands;
+    }
+
+    // sub-band k = (-1)^(k*frame) * sum(m) folded[N-1-m] * exp(+j*2*pi*k*m/N) that is an inverse FFT
+    Complex *in = m_fft->in();
+
+    for (unsigned int m = 0; m < m_nbSubbands; m++) {
+        in[m] = folded[m_nbSubbands - 1 - m];
+    }
+
+    m_fft->transform();
+    const Complex *out = m_fft->out();
+    bool oddFrame = (m_frameCount & 1) != 0;
+    m_frameCount++;
+
+    for (unsigned int k = 0; k < m_nbSubbands; k++)
+    {
+        if (outputs[k])
+        {
+            Complex y = (oddFrame && (k & 1)) ? -out[k] : out[k];
+            outputs[k]->push_back(Sample(
+                (FixReal) std::max(std::min(std::round(y.real()), (float) SDR_RX_SCALEF - 1.0f), -(float) SDR_RX_SCALEF),
+                (FixReal) std::max(std::min(std::round(y.imag()), (float) SDR_RX_SCALEF - 1.0f), -(float) SDR_RX_SCALEF)
+            ));
+        }
+    }
+}
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// FFT based polyphase analysis filter bank. Splits the baseband into uniformly  //
+// spaced sub-bands shifted to zero frequency with twice oversampled outputs     //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_POLYPHASEFILTERBANK_H_
+#define SDRBASE_DSP_POLYPHASEFILTERBANK_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class FFTEngine;
+class FFTFactory;
+
+/**
+ * With N sub-bands sub-band k is centered at k*fs/N (k > N/2 are the negative frequencies) and
+ * is output at 2*fs/N that is one output sample per sub-band every N/2 input samples. The prototype
+ * filter is flat up to 0.75*fs/N and aliases are rejected down to 1.25*fs/N so that any channel up
+ * to fs/(2N) wide fits in the flat part of the nearest sub-band. Each output frame costs one folding
+ * of N*tapsPerBranch samples and one N points FFT whatever the number of sub-bands used.
+ */
+class SDRBASE_API PolyphaseFilterBank
+{
+public:
+    PolyphaseFilterBank();
+    ~PolyphaseFilterBank();
+
+    void create(unsigned int nbSubbands, unsigned int tapsPerBranch = 16); //!< nbSubbands is a power of two at least 4
+    unsigned int getNbSubbands() const { return m_nbSubbands; }
+    unsigned int getDecimation() const { return m_nbSubbands / 2; } //!< input samples per sub-band output sample
+    void reset(); //!< clear history
+
+    /**
+     * Run samples through the bank and append the output of sub-band k to outputs[k] when it is not null.
+     * outputs has nbSubbands elements.
+     */
+    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, SampleVector **outputs);
+
+private:
+    unsigned int m_nbSubbands;
+    unsigned int m_tapsPerBranch;
+    unsigned int m_length;             //!< prototype length nbSubbands * tapsPerBranch
+    std::vector<float> m_taps;         //!< prototype taps in time reversed order to match the history window
+    std::vector<Complex> m_history;    //!< doubled history so that the last m_length samples are contiguous
+    unsigned int m_historyIndex;
+    unsigned int m_inputCount;         //!< input samples since last output frame
+    unsigned int m_frameCount;         //!< output frame parity for the (-1)^k phase correction
+    std::vector<Complex> m_folded;
+    FFTFactory *m_fftFactory;         //!< factory the engine comes from. Null if the engine is owned
+    FFTEngine *m_fft;
+    unsigned int m_fftSequence;
+
+    void releaseFFT();
+    void outputFrame(SampleVector **outputs);
+};
+
+#endif // SDRBASE_DSP_POLYPHASEFILTERBANK_H_
@@ -0,0 +1,392 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "samplecodec.h"
+
+namespace {
+
+inline int countLeadingZeros(quint64 x) // x != 0
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return 63 - (int) index;
+#else
+    return __builtin_clzll(x);
+#endif
+}
+
+inline quint32 zigzag(qint32 r) {
+    return ((quint32) r << 1) ^ (quint32) (r >> 31);
+}
+
+inline qint32 unzigzag(quint32 u) {
+    return (qint32) (u >> 1) ^ -(qint32) (u & 1);
+}
+
+// wraps on corrupted data
+inline qint32 predict(int order, qint32 x1, qint32 x2)
+{
+    return order == 0 ? 0 : order == 1 ? x1 : (qint32) (2U*(quint32) x1 - (quint32) x2);
+}
+
+// saturates decoded values of corrupted data or of a wrong shift
+inline FixReal clampFixReal(qint64 x)
+{
+    return x < std::numeric_limits<FixReal>::min() ? std::numeric_limits<FixReal>::min()
+        : x > std::numeric_limits<FixReal>::max() ? std::numeric_limits<FixReal>::max()
+        : (FixReal) x;
+}
+
+// MSB first
+class BitWriter
+{
+public:
+    BitWriter(quint8 *out) : m_out(out), m_acc(0), m_nbBits(0) {}
+
+    inline void put(quint32 value, unsigned int nbBits) // nbBits <= 32
+    {
+        m_acc = (m_acc << nbBits) | value;
+        m_nbBits += nbBits;
+
+        if (m_nbBits >= 32)
+        {
+            m_nbBits -= 32;
+            quint32 word = (quint32) (m_acc >> m_nbBits);
+            m_out[0] = (quint8) (word >> 24);
+            m_out[1] = (quint8) (word >> 16);
+            m_out[2] = (quint8) (word >> 8);
+            m_out[3] = (quint8) word;
+            m_out += 4;
+        }
+    }
+
+    quint8 *flush()
+    {
+        while (m_nbBits >= 8)
+        {
+            m_nbBits -= 8;
+            *m_out++ = (quint8) (m_acc >> m_nbBits);
+        }
+
+        if (m_nbBits > 0) {
+            *m_out++ = (quint8) (m_acc << (8 - m_nbBits));
+        }
+
+        m_nbBits = 0;
+        return m_out;
+    }
+
+private:
+    quint8 *m_out;
+    quint64 m_acc;       //!< m_nbBits pending bits right aligned
+    unsigned int m_nbBits;
+};
+
+// MSB first. Reads zeros past the end so that a corrupted stream ends in an escape or length error.
+class BitReader
+{
+public:
+    BitReader(const quint8 *in, const quint8 *end) : m_in(in), m_end(end), m_acc(0), m_nbBits(0) {}
+
+    inline void refill()
+    {
+        if ((m_nbBits <= 56) && (m_end - m_in >= 8))
+        {
+            quint64 word = ((quint64) m_in[0] << 56) | ((quint64) m_in[1] << 48) | ((quint64) m_in[2] << 40) | ((quint64) m_in[3] << 32)
+                | ((quint64) m_in[4] << 24) | ((quint64) m_in[5] << 16) | ((quint64) m_in[6] << 8) | (quint64) m_in[7];
+            unsigned int nbBytes = (63 - m_nbBits) / 8;
+            m_acc |= word >> m_nbBits;
+            m_in += nbBytes;
+            m_nbBits += 8 * nbBytes;
+            return;
+        }
+
+        while (m_nbBits <= 56)
+        {
+            m_acc |= (quint64) (m_in < m_end ? *m_in : 0) << (56 - m_nbBits);
+            m_in++;
+            m_nbBits += 8;
+        }
+    }
+
+    inline quint32 get(unsigned int nbBits) // nbBits <= 32 after refill
+    {
+        if (nbBits == 0) {
+            return 0;
+        }
+
+        quint32 value = (quint32) (m_acc >> (64 - nbBits));
+        m_acc <<= nbBits;
+        m_nbBits -= nbBits;
+        return value;
+    }
+
+    inline int leadingZeros() const { return m_acc == 0 ? 64 : countLeadingZeros(m_acc); }
+    bool overrun() const { return m_in - (m_nbBits / 8) > m_end; }
+
+private:
+    const quint8 *m_in;
+    const quint8 *m_end;
+    quint64 m_acc; //!< m_nbBits valid bits left aligned
+    unsigned int m_nbBits;
+};
+
+} // namespace
+
+void SampleCodec::encodePacked12(const Sample *samples, unsigned int nbSamples, quint8 *packed)
+{
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        quint32 re = (quint32) (samples[i].m_real >> (SDR_RX_SAMP_SZ - 12)) & 0xFFF;
+        quint32 im = (quint32) (samples[i].m_imag >> (SDR_RX_SAMP_SZ - 12)) & 0xFFF;
+        packed[0] = (quint8) re;
+        packed[1] = (quint8) ((re >> 8) | (im << 4));
+        packed[2] = (quint8) (im >> 4);
+        packed += m_packed12Bytes;
+    }
+}
+
+void SampleCodec::decodePacked12(const quint8 *packed, unsigned int nbSamples, Sample *samples)
+{
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        // sign extend from bit 11
+        qint32 re = (qint32) ((quint32) (packed[0] | (packed[1] << 8)) << 20) >> 20;
+        qint32 im = (qint32) ((quint32) ((packed[1] >> 4) | (packed[2] << 4)) << 20) >> 20;
+        samples[i].m_real = (FixReal) (re * (1 << (SDR_RX_SAMP_SZ - 12)));
+        samples[i].m_imag = (FixReal) (im * (1 << (SDR_RX_SAMP_SZ - 12)));
+        packed += m_packed12Bytes;
+    }
+}
+
+unsigned int SampleCodec::getLosslessMaxBlockBytes(unsigned int nbSamples)
+{
+    return sizeof(LosslessBlockHeader) + (2 * nbSamples * (m_riceEscape + 1 + 32) + 7) / 8;
+}
+
+unsigned int SampleCodec::encodeLosslessBlock(const Sample *samples, unsigned int nbSamples, quint8 *block)
+{
+    // least significant bits at zero in all samples like 12 bit samples in 16 bits
+    quint32 bits = 0;
+
+    for (unsigned int i = 0; i < nbSamples; i++) {
+        bits |= (quint32) samples[i].m_real | (quint32) samples[i].m_imag;
+    }
+
+    unsigned int wastedBits = 0;
+
+    while ((bits != 0) && ((bits & 1) == 0) && (wastedBits < 16))
+    {
+        bits >>= 1;
+        wastedBits++;
+    }
+
+    // sums of zigzag residuals per predictor order and component
+    quint64 sums[3][2] = {{0, 0}, {0, 0}, {0, 0}};
+    qint32 i1 = 0, i2 = 0, q1 = 0, q2 = 0;
+
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        qint32 re = samples[i].m_real >> wastedBits;
+        qint32 im = samples[i].m_imag >> wastedBits;
+        sums[0][0] += zigzag(re);
+        sums[0][1] += zigzag(im);
+        sums[1][0] += zigzag(re - i1);
+        sums[1][1] += zigzag(im - q1);
+        sums[2][0] += zigzag(re - 2*i1 + i2);
+        sums[2][1] += zigzag(im - 2*q1 + q2);
+        i2 = i1; i1 = re;
+        q2 = q1; q1 = im;
+    }
+
+    int order = 0;
+
+    for (int o = 1; o < 3; o++)
+    {
+        if (sums[o][0] + sums[o][1] < sums[order][0] + sums[order][1]) {
+            order = o;
+        }
+    }
+
+    // smallest k with n*2^k >= sum
+    unsigned int k[2] = {0, 0};
+
+    for (int c = 0; c < 2; c++)
+    {
+        while ((k[c] < 30) && (((quint64) nbSamples << k[c]) < sums[order][c])) {
+            k[c]++;
+        }
+    }
+
+    LosslessBlockHeader header;
+    header.sync = m_losslessSync;
+    header.nbSamples = (quint16) nbSamples;
+    header.predictor = (quint8) order;
+    header.riceI = (quint8) k[0];
+    header.riceQ = (quint8) k[1];
+    header.wastedBits = (quint8) wastedBits;
+
+    BitWriter writer(block + sizeof(LosslessBlockHeader));
+    i1 = i2 = q1 = q2 = 0;
+
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        qint32 x[2] = {samples[i].m_real >> wastedBits, samples[i].m_imag >> wastedBits};
+        quint32 u[2] = {zigzag(x[0] - predict(order, i1, i2)), zigzag(x[1] - predict(order, q1, q2))};
+        i2 = i1; i1 = x[0];
+        q2 = q1; q1 = x[1];
+
+        for (int c = 0; c < 2; c++)
+        {
+            quint32 quotient = u[c] >> k[c];
+
+            if (quotient < m_riceEscape)
+            {
+                writer.put(1, quotient + 1);
+                writer.put(u[c] & ((1U << k[c]) - 1), k[c]);
+            }
+            else
+            {
+                writer.put(1, m_riceEscape + 1);
+                writer.put(u[c], 32);
+            }
+        }
+    }
+
+    quint8 *end = writer.flush();
+    header.payloadBytes = (quint32) (end - block - sizeof(LosslessBlockHeader));
+    std::memcpy(block, &header, sizeof(LosslessBlockHeader));
+
+    return (unsigned int) (end - block);
+}
+
+bool SampleCodec::decodeLosslessBlock(const quint8 *block, quint64 available, Sample *samples, unsigned int maxSamples, int shift)
+{
+    LosslessBlockHeader header;
+
+    if (available < sizeof(LosslessBlockHeader)) {
+        return false;
+    }
+
+    std::memcpy(&header, block, sizeof(LosslessBlockHeader));
+
+    if ((header.sync != m_losslessSync) || (header.nbSamples > maxSamples)
+     || (header.predictor > 2) || (header.riceI > 30) || (header.riceQ > 30) || (header.wastedBits > 16)
+     || (available - sizeof(LosslessBlockHeader) < header.payloadBytes)) {
+        return false;
+    }
+
+    const quint8 *payload = block + sizeof(LosslessBlockHeader);
+    BitReader reader(payload, payload + header.payloadBytes);
+    unsigned int k[2] = {header.riceI, header.riceQ};
+    int order = header.predictor;
+    shift += header.wastedBits;
+
+    if ((shift > 31) || (shift < -31)) { // keeps the 64 bit scaling below from overflowing
+        return false;
+    }
+    qint32 i1 = 0, i2 = 0, q1 = 0, q2 = 0;
+
+    for (unsigned int i = 0; i < header.nbSamples; i++)
+    {
+        qint32 x[2];
+
+        for (int c = 0; c < 2; c++)
+        {
+            reader.refill();
+            unsigned int quotient = reader.leadingZeros();
+            quint32 u;
+
+            if (quotient < m_riceEscape)
+            {
+                reader.get(quotient + 1);
+                u = (quotient << k[c]) | reader.get(k[c]);
+            }
+            else if (quotient == m_riceEscape)
+            {
+                reader.get(quotient + 1);
+                reader.refill();
+                u = reader.get(32);
+            }
+            else
+            {
+                return false;
+            }
+
+            x[c] = unzigzag(u);
+        }
+
+        x[0] = (qint32) ((quint32) x[0] + (quint32) predict(order, i1, i2));
+        x[1] = (qint32) ((quint32) x[1] + (quint32) predict(order, q1, q2));
+        i2 = i1; i1 = x[0];
+        q2 = q1; q1 = x[1];
+
+        if (shift >= 0)
+        {
+            samples[i].m_real = clampFixReal((qint64) x[0] * ((qint64) 1 << shift));
+            samples[i].m_imag = clampFixReal((qint64) x[1] * ((qint64) 1 << shift));
+        }
+        else
+        {
+            samples[i].m_real = clampFixReal(x[0] >> -shift);
+            samples[i].m_imag = clampFixReal(x[1] >> -shift);
+        }
+    }
+
+    return !reader.overrun();
+}
+
+quint64 SampleCodec::indexLosslessBlocks(const quint8 *data, quint64 size, std::vector<quint64>& blockOffsets)
+{
+    quint64 offset = 0;
+    quint64 nbSamples = 0;
+    unsigned int lastBlockSamples = m_losslessBlockSamples;
+    LosslessBlockHeader header;
+    blockOffsets.clear();
+
+    while (offset + sizeof(LosslessBlockHeader) <= size)
+    {
+        std::memcpy(&header, data + offset, sizeof(LosslessBlockHeader));
+
+        if ((header.sync != m_losslessSync) || (size - offset - sizeof(LosslessBlockHeader) < header.payloadBytes)) {
+            break;
+        }
+
+        // readers locate samples by block index: only the last block may be shorter
+        if ((header.nbSamples == 0) || (header.nbSamples > m_losslessBlockSamples) || (lastBlockSamples != m_losslessBlockSamples))
+        {
+            blockOffsets.clear();
+            return 0;
+        }
+
+        lastBlockSamples = header.nbSamples;
+        blockOffsets.push_back(offset);
+        nbSamples += header.nbSamples;
+        offset += sizeof(LosslessBlockHeader) + header.payloadBytes;
+    }
+
+    return nbSamples;
+}
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// Compact I/Q sample formats for record files: 12 bit packed and lossless       //
+// blocks                                                                        //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SAMPLECODEC_H_
+#define SDRBASE_DSP_SAMPLECODEC_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Packed 12 bit: the 12 most significant bits of I and Q in 3 bytes. Exact for 12 bit ADCs
+ * not decimated as their samples have their least significant bits at zero.
+ *
+ * Lossless: independent blocks of up to m_losslessBlockSamples samples each starting with a
+ * LosslessBlockHeader. Least significant bits at zero in the whole block are not coded. I and Q
+ * residuals of a fixed predictor of order 0, 1 or 2 chosen per block are Rice coded with a parameter
+ * per block and component. Blocks can be decoded alone so that seeking needs only an index of
+ * block offsets.
+ */
+class SDRBASE_API SampleCodec
+{
+public:
+#pragma pack(push, 1)
+    struct LosslessBlockHeader
+    {
+        quint16 sync;
+        quint16 nbSamples;
+        quint8  predictor;   //!< predictor order
+        quint8  riceI;       //!< Rice parameter of I residuals
+        quint8  riceQ;       //!< Rice parameter of Q residuals
+        quint8  wastedBits;  //!< least significant bits at zero in all samples and not coded
+        quint32 payloadBytes; //!< coded bytes following the header
+    };
+#pragma pack(pop)
+
+    static void encodePacked12(const Sample *samples, unsigned int nbSamples, quint8 *packed);
+    static void decodePacked12(const quint8 *packed, unsigned int nbSamples, Sample *samples);
+
+    static unsigned int getLosslessMaxBlockBytes(unsigned int nbSamples); //!< size of the buffer to encode a block
+    static unsigned int encodeLosslessBlock(const Sample *samples, unsigned int nbSamples, quint8 *block); //!< returns block size with header
+    /**
+     * Returns false if the block is truncated, corrupted or has more than maxSamples samples (the room in samples).
+     * shift is the left shift from coded to output bits (negative for right)
+     */
+    static bool decodeLosslessBlock(const quint8 *block, quint64 available, Sample *samples, unsigned int maxSamples, int shift);
+    /**
+     * Block offsets from data start and returns the number of samples. Stops at the first truncated or corrupted block.
+     * Returns 0 with no offsets if a block but the last has not m_losslessBlockSamples samples.
+     */
+    static quint64 indexLosslessBlocks(const quint8 *data, quint64 size, std::vector<quint64>& blockOffsets);
+
+    static const unsigned int m_packed12Bytes = 3;           //!< bytes per sample
+    static const unsigned int m_losslessBlockSamples = 4096; //!< samples per block but the last
+    static const quint16 m_losslessSync = 0x5153;
+
+private:
+    static const unsigned int m_riceEscape = 24; //!< unary quotients from this are escaped by a raw 32 bit value
+};
+
+#endif // SDRBASE_DSP_SAMPLECODEC_H_
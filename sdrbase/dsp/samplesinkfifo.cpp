@@ -16,43 +16,133 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
+#include <QThread>
+
+#include "SWGFifoPerf.h"
+
+#include "samplesinksharedfifo.h"
 #include "samplesinkfifo.h"
 
 //#define MIN(x, y) (((x) < (y)) ? (x) : (y))
 
 void SampleSinkFifo::create(unsigned int s)
 {
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (m_lockFree)
+	{
+		// The reader and the writer set their flag then check m_resizing. Here m_resizing is set then
+		// their flags are checked. Ordered operations make sure at least one side sees the other.
+		m_resizing.fetchAndStoreOrdered(1);
+
+		while ((m_reading.fetchAndAddOrdered(0) != 0) || (m_writing.fetchAndAddOrdered(0) != 0)) {
+			QThread::yieldCurrentThread();
+		}
+	}
+
 	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	m_head.store(0);
+	m_tail.store(0);
+	m_resetRequest.store(0);
+	m_highWaterMark.storeRelease(0);
 
 	m_data.resize(s);
 	m_size = m_data.size();
+	m_resizing.fetchAndStoreOrdered(0);
 }
 
 void SampleSinkFifo::reset()
 {
+	if (m_sharedFifo || m_lockFree)
+	{
+		m_resetRequest.storeRelease(1); // the reader moves its cursor at next readBegin
+		return;
+	}
+
+	QMutexLocker mutexLocker(&m_mutex);
 	m_suppressed = -1;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	m_head.store(0);
+	m_tail.store(0);
+}
+
+bool SampleSinkFifo::enter(QAtomicInt& flag)
+{
+	if (!m_lockFree) { // serialized by the mutex
+		return true;
+	}
+
+	flag.fetchAndStoreOrdered(1);
+
+	if (m_resizing.fetchAndAddOrdered(0) != 0)
+	{
+		flag.storeRelease(0);
+		return false;
+	}
+
+	return true;
+}
+
+void SampleSinkFifo::leave(QAtomicInt& flag)
+{
+	if (m_lockFree) {
+		flag.storeRelease(0);
+	}
+}
+
+bool SampleSinkFifo::serveResetRequest()
+{
+	if (m_resetRequest.loadAcquire() && m_resetRequest.testAndSetOrdered(1, 0))
+	{
+		m_head.storeRelease(m_tail.loadAcquire());
+		return true;
+	}
+
+	return false;
 }
 
 SampleSinkFifo::SampleSinkFifo(QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_lockFree(false),
+	m_data(),
+	m_resizing(0),
+	m_resetRequest(0),
+	m_head(0),
+	m_reading(0),
+	m_tail(0),
+	m_writing(0),
+	m_sharedFifo(nullptr),
+	m_sharedHead(0),
+	m_sharedLagged(0),
+	m_sharedGeneration(0),
+	m_readNotify(nullptr),
+	m_highWaterMark(0),
+	m_overflows(0),
+	m_droppedSamples(0)
 {
 	m_suppressed = -1;
 	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
 }
 
 SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_lockFree(false),
+	m_data(),
+	m_resizing(0),
+	m_resetRequest(0),
+	m_head(0),
+	m_reading(0),
+	m_tail(0),
+	m_writing(0),
+	m_sharedFifo(nullptr),
+	m_sharedHead(0),
+	m_sharedLagged(0),
+	m_sharedGeneration(0),
+	m_readNotify(nullptr),
+	m_highWaterMark(0),
+	m_overflows(0),
+	m_droppedSamples(0)
 {
 	m_suppressed = -1;
 	create(size);
@@ -60,23 +150,70 @@ SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 
 SampleSinkFifo::SampleSinkFifo(const SampleSinkFifo& other) :
     QObject(other.parent()),
-    m_data(other.m_data)
+    m_lockFree(other.m_lockFree),
+    m_data(other.m_data),
+    m_resizing(0),
+    m_resetRequest(0),
+    m_head(0),
+    m_reading(0),
+    m_tail(0),
+    m_writing(0),
+    m_sharedFifo(nullptr),
+    m_sharedHead(0),
+    m_sharedLagged(0),
+    m_sharedGeneration(0),
+    m_readNotify(nullptr),
+    m_highWaterMark(0),
+    m_overflows(0),
+    m_droppedSamples(0)
 {
   	m_suppressed = -1;
 	m_size = m_data.size();
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
 }
 
 SampleSinkFifo::~SampleSinkFifo()
 {
+	detachSharedFifo();
 	QMutexLocker mutexLocker(&m_mutex);
 	m_size = 0;
 }
 
+void SampleSinkFifo::attachSharedFifo(SampleSinkSharedFifo *sharedFifo)
+{
+	detachSharedFifo();
+
+	if (sharedFifo)
+	{
+		sharedFifo->addReader(this);
+		m_sharedFifo = sharedFifo;
+	}
+}
+
+void SampleSinkFifo::detachSharedFifo()
+{
+	if (m_sharedFifo)
+	{
+		m_sharedFifo->removeReader(this);
+		m_sharedFifo = nullptr;
+	}
+}
+
+unsigned int SampleSinkFifo::fill()
+{
+	if (m_sharedFifo) {
+		return m_sharedFifo->fill(this);
+	}
+
+	QMutexLocker mutexLocker(m_lockFree ? nullptr : &m_mutex);
+	return distance(m_head.loadAcquire(), m_tail.loadAcquire());
+}
+
 bool SampleSinkFifo::setSize(int size)
 {
+	if (m_sharedFifo) { // size is managed by the device engine
+		return true;
+	}
+
 	create(size);
 
 	return m_data.size() == (unsigned int)size;
@@ -84,70 +221,43 @@ bool SampleSinkFifo::setSize(int size)
 
 unsigned int SampleSinkFifo::write(const quint8* data, unsigned int count)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-	unsigned int total;
-	unsigned int remaining;
-	unsigned int len;
-	const Sample* begin = (const Sample*)data;
-	count /= sizeof(Sample);
-
-	total = std::min(count, m_size - m_fill);
-
-    if (total < count)
-    {
-		if (m_suppressed < 0)
-        {
-			m_suppressed = 0;
-			m_msgRateTimer.start();
-			qCritical("SampleSinkFifo::write: overflow - dropping %u samples", count - total);
-		}
-        else
-        {
-			if (m_msgRateTimer.elapsed() > 2500)
-            {
-				qCritical("SampleSinkFifo::write: %u messages dropped", m_suppressed);
-				qCritical("SampleSinkFifo::write: overflow - dropping %u samples", count - total);
-				m_suppressed = -1;
-			}
-            else
-            {
-				m_suppressed++;
-			}
-		}
+	if (m_sharedFifo) { // data is already available in the shared FIFO
+		return 0;
 	}
 
-	remaining = total;
+	return writeSamples((const Sample*) data, count / sizeof(Sample));
+}
 
-    while (remaining > 0)
-    {
-		len = std::min(remaining, m_size - m_tail);
-		std::copy(begin, begin + len, m_data.begin() + m_tail);
-		m_tail += len;
-		m_tail %= m_size;
-		m_fill += len;
-		begin += len;
-		remaining -= len;
+unsigned int SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+	if (m_sharedFifo || (begin == end)) { // data is already available in the shared FIFO or nothing to write
+		return 0;
 	}
 
-	if (m_fill > 0) {
-		emit dataReady();
-    }
-
-	return total;
+	return writeSamples(&(*begin), end - begin);
 }
 
-unsigned int SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+unsigned int SampleSinkFifo::writeSamples(const Sample* begin, unsigned int count)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-	unsigned int count = end - begin;
+	QMutexLocker mutexLocker(m_lockFree ? nullptr : &m_mutex);
+
+	if (!enter(m_writing)) { // being resized
+		return 0;
+	}
+
+	unsigned int tail = m_tail.load(); // only the writer changes tail
+	unsigned int head = m_head.loadAcquire();
 	unsigned int total;
 	unsigned int remaining;
 	unsigned int len;
 
-	total = std::min(count, m_size - m_fill);
+	total = std::min(count, m_size - distance(head, tail));
 
     if (total < count)
     {
+		m_overflows.storeRelease(m_overflows.load() + 1);
+		m_droppedSamples.storeRelease(m_droppedSamples.load() + (count - total));
+
 		if (m_suppressed < 0)
         {
 			m_suppressed = 0;
@@ -173,16 +283,18 @@ unsigned int SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVec
 
     while (remaining > 0)
     {
-		len = std::min(remaining, m_size - m_tail);
-		std::copy(begin, begin + len, m_data.begin() + m_tail);
-		m_tail += len;
-		m_tail %= m_size;
-		m_fill += len;
+		unsigned int pos = position(tail);
+		len = std::min(remaining, m_size - pos);
+		std::copy(begin, begin + len, m_data.begin() + pos);
+		tail = advance(tail, len);
 		begin += len;
 		remaining -= len;
 	}
 
-	if (m_fill > 0) {
+	m_tail.storeRelease(tail); // publish samples to the reader
+	leave(m_writing);
+
+	if (distance(head, tail) > 0) {
 		emit dataReady();
     }
 
@@ -191,15 +303,23 @@ unsigned int SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVec
 
 unsigned int SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::iterator end)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	QMutexLocker mutexLocker(m_lockFree ? nullptr : &m_mutex);
+
+	if (!enter(m_reading)) { // being resized
+		return 0;
+	}
+
+	bool reset = serveResetRequest();
+	unsigned int head = m_head.load(); // only the reader changes head
+	unsigned int tail = m_tail.loadAcquire();
 	unsigned int count = end - begin;
 	unsigned int total;
 	unsigned int remaining;
 	unsigned int len;
 
-	total = std::min(count, m_fill);
+	total = std::min(count, distance(head, tail));
 
-    if (total < count) {
+    if ((total < count) && !reset) {
 		qCritical("SampleSinkFifo::read: underflow - missing %u samples", count - total);
     }
 
@@ -207,15 +327,21 @@ unsigned int SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::it
 
     while (remaining > 0)
     {
-		len = std::min(remaining, m_size - m_head);
-		std::copy(m_data.begin() + m_head, m_data.begin() + m_head + len, begin);
-		m_head += len;
-		m_head %= m_size;
-		m_fill -= len;
+		unsigned int pos = position(head);
+		len = std::min(remaining, m_size - pos);
+		std::copy(m_data.begin() + pos, m_data.begin() + pos + len, begin);
+		head = advance(head, len);
 		begin += len;
 		remaining -= len;
 	}
 
+	m_head.storeRelease(head); // release space to the writer
+	leave(m_reading);
+
+	if (m_readNotify) {
+		m_readNotify->notifyRead();
+	}
+
 	return total;
 }
 
@@ -223,15 +349,34 @@ unsigned int SampleSinkFifo::readBegin(unsigned int count,
 	SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
 	SampleVector::iterator* part2Begin, SampleVector::iterator* part2End)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	m_readTimer.start();
+
+	if (m_sharedFifo)
+	{
+		unsigned int total = m_sharedFifo->readBegin(this, count, part1Begin, part1End, part2Begin, part2End);
+		updateHighWaterMark(total); // readers ask for all available samples
+		return total;
+	}
+
+	QMutexLocker mutexLocker(m_lockFree ? nullptr : &m_mutex);
+
+	if (!enter(m_reading)) // being resized
+	{
+		*part1Begin = *part1End = *part2Begin = *part2End = SampleVector::iterator();
+		return 0;
+	}
+
+	bool reset = serveResetRequest();
 	unsigned int total;
 	unsigned int remaining;
 	unsigned int len;
-	unsigned int head = m_head;
+	unsigned int head = position(m_head.load());
+	unsigned int fill = distance(m_head.load(), m_tail.loadAcquire());
 
-	total = std::min(count, m_fill);
+	total = std::min(count, fill);
+	updateHighWaterMark(fill);
 
-    if (total < count) {
+    if ((total < count) && !reset) {
 		qCritical("SampleSinkFifo::readBegin: underflow - missing %u samples", count - total);
     }
 
@@ -264,26 +409,75 @@ unsigned int SampleSinkFifo::readBegin(unsigned int count,
 		*part2End = m_data.end();
 	}
 
+	if (total == 0) {
+		leave(m_reading);
+	}
+
 	return total;
 }
 
 unsigned int SampleSinkFifo::readCommit(unsigned int count)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	if (m_sharedFifo)
+	{
+		count = m_sharedFifo->readCommit(this, count);
+
+		if (count > 0) {
+			m_readPerf.add(m_readTimer.nsecsElapsed(), count);
+		}
+
+		return count;
+	}
 
-	if (count > m_fill)
+	QMutexLocker mutexLocker(m_lockFree ? nullptr : &m_mutex);
+
+	if (m_lockFree && (m_reading.load() == 0)) { // nothing was handed out by readBegin
+		return 0;
+	}
+
+	unsigned int head = m_head.load();
+	unsigned int fill = distance(head, m_tail.loadAcquire());
+
+	if (count > fill)
     {
 		qCritical("SampleSinkFifo::readCommit: cannot commit more than available samples");
-		count = m_fill;
+		count = fill;
 	}
 
-    m_head = (m_head + count) % m_size;
-	m_fill -= count;
+	m_head.storeRelease(advance(head, count)); // release space to the writer
+	leave(m_reading);
+
+	if (m_readNotify) {
+		m_readNotify->notifyRead();
+	}
+
+	if (count > 0) {
+		m_readPerf.add(m_readTimer.nsecsElapsed(), count);
+	}
 
 	return count;
 }
 
+void SampleSinkFifo::updateHighWaterMark(unsigned int fill)
+{
+	if (fill > m_highWaterMark.load()) {
+		m_highWaterMark.storeRelease(fill);
+	}
+}
+
 unsigned int SampleSinkFifo::getSizePolicy(unsigned int sampleRate)
 {
     return (sampleRate/100)*64; // .64s
-}
\ No newline at end of file
+}
+
+void SampleSinkFifo::webapiFormatFifoPerf(
+	SWGSDRangel::SWGFifoPerf *apiFifoPerf,
+	SampleSinkFifo& fifo
+)
+{
+	apiFifoPerf->setSize(fifo.size());
+	apiFifoPerf->setFill(fifo.fill());
+	apiFifoPerf->setHighWaterMark(fifo.getHighWaterMark());
+	apiFifoPerf->setOverflows(fifo.getOverflows());
+	apiFifoPerf->setDroppedSamples(fifo.getDroppedSamples());
+}
@@ -21,26 +21,70 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QAtomicInteger>
 #include <QElapsedTimer>
 #include "dsp/dsptypes.h"
+#include "util/perfcounter.h"
 #include "export.h"
 
+class SampleSinkSharedFifo;
+
+namespace SWGSDRangel
+{
+    class SWGFifoPerf;
+}
+
+/**
+ * Head and tail indexes run over twice the size so that a full FIFO can be told from an empty one.
+ * By default all accesses are serialized with a mutex. A FIFO known to have exactly one writer and
+ * one reader thread can be made lock-free with setLockFree(true): each index is then only written by
+ * its owner (the reader for head and the writer for tail) and they are kept on separate cache lines.
+ * In that mode reset() is served by the reader at its next readBegin or read and setSize() waits for
+ * the reader and the writer to be out of the ring so both can still be called from any thread.
+ */
 class SDRBASE_API SampleSinkFifo : public QObject {
 	Q_OBJECT
 
 private:
-	QMutex m_mutex;
+	QMutex m_mutex; //!< Serializes all accesses when not lock-free. Serializes setSize() calls when lock-free.
+	bool m_lockFree;
 	QElapsedTimer m_msgRateTimer;
 	int m_suppressed;
 
 	SampleVector m_data;
 
 	unsigned int m_size;
-	unsigned int m_fill;
-	unsigned int m_head;
-	unsigned int m_tail;
+	QAtomicInt m_resizing;     //!< Set by setSize() while the ring is reallocated
+	QAtomicInt m_resetRequest; //!< Set by reset() and served by the reader
+
+	alignas(64) QAtomicInteger<unsigned int> m_head; //!< Read index in [0, 2*size[ - written by the reader only
+	QAtomicInt m_reading;                            //!< Set by the reader while it accesses the ring
+	alignas(64) QAtomicInteger<unsigned int> m_tail; //!< Write index in [0, 2*size[ - written by the writer only
+	QAtomicInt m_writing;                            //!< Set by the writer while it accesses the ring
+
+	alignas(64) SampleSinkSharedFifo *m_sharedFifo; //!< When attached samples are read from this shared FIFO
+	QAtomicInteger<quint64> m_sharedHead;       //!< Read cursor in shared FIFO - written by the reader only
+	QAtomicInteger<quint64> m_sharedLagged;     //!< Samples skipped because this reader was too late
+	QAtomicInt m_sharedGeneration;              //!< Shared FIFO allocation the read cursor refers to
+	SampleSinkSharedFifo *m_readNotify;         //!< Shared FIFO whose waiting writers are woken by reads of this FIFO
+
+	PerfCounter m_readPerf;             //!< Time from readBegin to readCommit
+	QElapsedTimer m_readTimer;
+	QAtomicInteger<unsigned int> m_highWaterMark; //!< Largest fill seen by the reader - written by the reader only
+	QAtomicInteger<quint64> m_overflows;          //!< Writes not stored entirely - written by the writer only
+	QAtomicInteger<quint64> m_droppedSamples;     //!< Samples of these writes that were dropped
+
+	friend class SampleSinkSharedFifo;
 
 	void create(unsigned int s);
+	bool enter(QAtomicInt& flag);
+	void leave(QAtomicInt& flag);
+	bool serveResetRequest();
+	unsigned int writeSamples(const Sample* begin, unsigned int count);
+	unsigned int distance(unsigned int head, unsigned int tail) const { return tail >= head ? tail - head : tail + 2*m_size - head; }
+	unsigned int advance(unsigned int index, unsigned int count) const { index += count; return index >= 2*m_size ? index - 2*m_size : index; }
+	unsigned int position(unsigned int index) const { return index < m_size ? index : index - m_size; }
+	void updateHighWaterMark(unsigned int fill);
 
 public:
 	SampleSinkFifo(QObject* parent = nullptr);
@@ -51,7 +95,21 @@ public:
 	bool setSize(int size);
     void reset();
 	inline unsigned int size() const { return m_size; }
-	inline unsigned int fill() { QMutexLocker mutexLocker(&m_mutex); unsigned int fill = m_fill; return fill; }
+	unsigned int fill();
+	void setLockFree(bool lockFree) { m_lockFree = lockFree; } //!< Only for a single writer and a single reader thread. Set before use.
+	bool getLockFree() const { return m_lockFree; }
+
+	void attachSharedFifo(SampleSinkSharedFifo *sharedFifo); //!< Read from device engine shared FIFO. Writes are then ignored.
+	void detachSharedFifo();
+	bool isAttachedToSharedFifo() const { return m_sharedFifo != nullptr; }
+	SampleSinkSharedFifo *getSharedFifo() const { return m_sharedFifo; }
+	quint64 getLaggedSamples() const { return m_sharedLagged.loadAcquire(); }
+	void setReadNotify(SampleSinkSharedFifo *sharedFifo) { m_readNotify = sharedFifo; } //!< Reads wake writers waiting on sharedFifo. Set before use.
+
+	const PerfCounter& getReadPerf() const { return m_readPerf; } //!< Processing of the samples between readBegin and readCommit
+	unsigned int getHighWaterMark() const { return m_highWaterMark.loadAcquire(); }
+	quint64 getOverflows() const { return m_overflows.loadAcquire(); }
+	quint64 getDroppedSamples() const { return m_droppedSamples.loadAcquire() + m_sharedLagged.loadAcquire(); } //!< Overflows and shared FIFO lag
 
 	unsigned int write(const quint8* data, unsigned int count);
 	unsigned int write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
@@ -64,6 +122,11 @@ public:
 	unsigned int readCommit(unsigned int count);
     static unsigned int getSizePolicy(unsigned int sampleRate);
 
+	static void webapiFormatFifoPerf(
+		SWGSDRangel::SWGFifoPerf *apiFifoPerf,
+		SampleSinkFifo& fifo
+	);
+
 signals:
 	void dataReady();
 };
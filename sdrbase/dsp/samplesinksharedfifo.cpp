@@ -0,0 +1,398 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "dsp/samplesinkfifo.h"
+#include "samplesinksharedfifo.h"
+
+SampleSinkSharedFifo::SampleSinkSharedFifo() :
+    m_size(0),
+    m_window(0),
+    m_requestedSize(0),
+    m_tail(0),
+    m_resizing(0),
+    m_generation(0),
+    m_nbReaders(0),
+    m_suppressed(-1),
+    m_upstream(nullptr),
+    m_readWaiters(0)
+{
+}
+
+SampleSinkSharedFifo::~SampleSinkSharedFifo()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (std::vector<SampleSinkFifo*>::iterator it = m_readers.begin(); it != m_readers.end(); ++it) {
+        (*it)->m_sharedFifo = nullptr;
+    }
+
+    m_readers.clear();
+    m_nbReaders.store(0);
+
+    for (std::vector<SampleSinkSharedFifo*>::iterator it = m_downstreams.begin(); it != m_downstreams.end(); ++it) {
+        (*it)->m_upstream = nullptr;
+    }
+}
+
+void SampleSinkSharedFifo::setSize(unsigned int size)
+{
+    m_requestedSize.storeRelease(size); // the ring is reallocated by the writer
+}
+
+bool SampleSinkSharedFifo::resize()
+{
+    // A reader sets its reading flag then checks m_resizing. The writer sets m_resizing then checks
+    // the reading flags. Both use ordered operations so at least one of them sees the other.
+    m_resizing.fetchAndStoreOrdered(1);
+
+    for (std::vector<SampleSinkFifo*>::const_iterator it = m_readers.begin(); it != m_readers.end(); ++it)
+    {
+        if ((*it)->m_reading.fetchAndAddOrdered(0) != 0)
+        {
+            m_resizing.fetchAndStoreOrdered(0);
+            return false; // retry at next write
+        }
+    }
+
+    // Samples of the previous size were at the previous sample rate. They are dropped.
+    unsigned int requestedSize = m_requestedSize.loadAcquire();
+    m_data.resize(2*requestedSize);
+    m_size = m_data.size();
+    m_window.storeRelease(requestedSize);
+    m_tail.storeRelease(0);
+    m_generation.fetchAndAddOrdered(1);
+    m_resizing.fetchAndStoreOrdered(0);
+
+    return true;
+}
+
+unsigned int SampleSinkSharedFifo::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+    if (m_requestedSize.loadAcquire() != m_window.load())
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+
+        if (!resize()) {
+            return 0;
+        }
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    unsigned int count = end - begin;
+    // A reader not holding samples syncs at most one window behind the write position. Writing no
+    // more than a window at once never reaches the samples it may start reading meanwhile.
+    unsigned int total = std::min(count, m_window.load());
+    quint64 tail = m_tail.load(); // only the writer changes tail
+
+    // Samples handed out by readBegin and not yet committed are never written over: the new samples
+    // that do not fit before the oldest of them are dropped. Same ordered flag check as resize().
+    for (std::vector<SampleSinkFifo*>::const_iterator it = m_readers.begin(); it != m_readers.end(); ++it)
+    {
+        if ((*it)->m_reading.fetchAndAddOrdered(0) != 0)
+        {
+            quint64 head = (*it)->m_sharedHead.loadAcquire();
+            quint64 room = head + m_size > tail ? head + m_size - tail : 0;
+            total = std::min((quint64) total, room);
+        }
+    }
+
+    if (total < count)
+    {
+        if (m_suppressed < 0)
+        {
+            m_suppressed = 0;
+            m_msgRateTimer.start();
+            qCritical("SampleSinkSharedFifo::write: overflow - dropping %u samples", count - total);
+        }
+        else
+        {
+            if (m_msgRateTimer.elapsed() > 2500)
+            {
+                qCritical("SampleSinkSharedFifo::write: %u messages dropped", m_suppressed);
+                qCritical("SampleSinkSharedFifo::write: overflow - dropping %u samples", count - total);
+                m_suppressed = -1;
+            }
+            else
+            {
+                m_suppressed++;
+            }
+        }
+    }
+
+    unsigned int remaining = total;
+
+    while (remaining > 0)
+    {
+        unsigned int pos = tail % m_size;
+        unsigned int len = std::min(remaining, m_size - pos);
+        std::copy(begin, begin + len, m_data.begin() + pos);
+        tail += len;
+        begin += len;
+        remaining -= len;
+    }
+
+    m_tail.storeRelease(tail); // publish samples to the readers
+
+    if (total > 0)
+    {
+        for (std::vector<SampleSinkFifo*>::iterator it = m_readers.begin(); it != m_readers.end(); ++it) {
+            emit (*it)->dataReady();
+        }
+    }
+
+    return total;
+}
+
+bool SampleSinkSharedFifo::sync(SampleSinkFifo *reader, quint64 tail)
+{
+    int generation = m_generation.loadAcquire();
+
+    if (reader->m_sharedGeneration.load() != generation) // ring reallocated: restart at its beginning
+    {
+        reader->m_sharedGeneration.storeRelease(generation);
+        reader->m_resetRequest.storeRelease(0);
+        reader->m_sharedHead.storeRelease(0);
+        return true;
+    }
+
+    if (reader->m_resetRequest.fetchAndStoreAcquire(0) != 0)
+    {
+        reader->m_sharedHead.storeRelease(tail);
+        return true;
+    }
+
+    quint64 head = reader->m_sharedHead.load(); // only the reader changes its head
+    quint64 window = m_window.load();
+
+    if (tail > head + window)
+    {
+        reader->m_sharedHead.storeRelease(tail - window);
+        lagged(reader, tail - window - head);
+    }
+
+    return false;
+}
+
+void SampleSinkSharedFifo::lagged(SampleSinkFifo *reader, quint64 count)
+{
+    reader->m_sharedLagged.storeRelease(reader->m_sharedLagged.load() + count);
+
+    if (reader->m_suppressed < 0)
+    {
+        reader->m_suppressed = 0;
+        reader->m_msgRateTimer.start();
+        qWarning("SampleSinkSharedFifo::lagged: reader %p lagging - skipped %llu samples", reader, count);
+    }
+    else if (reader->m_msgRateTimer.elapsed() > 2500)
+    {
+        qWarning("SampleSinkSharedFifo::lagged: reader %p lagging - %llu samples skipped so far", reader, reader->m_sharedLagged.load());
+        reader->m_suppressed = -1;
+    }
+    else
+    {
+        reader->m_suppressed++;
+    }
+}
+
+void SampleSinkSharedFifo::addReader(SampleSinkFifo *reader)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    reader->m_sharedGeneration.storeRelease(m_generation.loadAcquire());
+    reader->m_sharedHead.storeRelease(m_tail.loadAcquire());
+    reader->m_reading.storeRelease(0);
+    reader->m_resetRequest.storeRelease(0);
+    reader->m_sharedLagged.storeRelease(0);
+    m_readers.push_back(reader);
+    m_nbReaders.store((int) m_readers.size());
+}
+
+void SampleSinkSharedFifo::removeReader(SampleSinkFifo *reader)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_readers.erase(std::remove(m_readers.begin(), m_readers.end(), reader), m_readers.end());
+    m_nbReaders.store((int) m_readers.size());
+}
+
+unsigned int SampleSinkSharedFifo::getMaxFill()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    quint64 tail = m_tail.loadAcquire();
+    quint64 window = m_window.load();
+    quint64 maxFill = 0;
+
+    for (std::vector<SampleSinkFifo*>::const_iterator it = m_readers.begin(); it != m_readers.end(); ++it)
+    {
+        // a reader not yet restarted after a resize restarts from the beginning
+        quint64 head = (*it)->m_sharedGeneration.loadAcquire() == m_generation.load() ? (*it)->m_sharedHead.loadAcquire() : 0;
+
+        if (tail > head) {
+            maxFill = std::max(maxFill, std::min(tail - head, window));
+        }
+    }
+
+    return maxFill;
+}
+
+bool SampleSinkSharedFifo::isBacklogged()
+{
+    return getBacklog() > 0.5f;
+}
+
+float SampleSinkSharedFifo::getBacklog()
+{
+    unsigned int window = m_window.load();
+    float backlog = window == 0 ? 0.0f : getMaxFill() / (float) window;
+    float downstreamBacklog = 0.0f;
+    QMutexLocker mutexLocker(&m_mutex);
+
+    // samples waiting here are still to be written downstream
+    for (std::vector<SampleSinkSharedFifo*>::const_iterator it = m_downstreams.begin(); it != m_downstreams.end(); ++it) {
+        downstreamBacklog = std::max(downstreamBacklog, (*it)->getBacklog());
+    }
+
+    return backlog + downstreamBacklog;
+}
+
+void SampleSinkSharedFifo::addDownstream(SampleSinkSharedFifo *fifo)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    fifo->m_upstream = this;
+    m_downstreams.push_back(fifo);
+}
+
+void SampleSinkSharedFifo::removeDownstream(SampleSinkSharedFifo *fifo)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_downstreams.erase(std::remove(m_downstreams.begin(), m_downstreams.end(), fifo), m_downstreams.end());
+    fifo->m_upstream = nullptr;
+}
+
+void SampleSinkSharedFifo::waitRead(unsigned long timeoutMs)
+{
+    // a read committed between the caller check and here is missed: hence the timeout
+    QMutexLocker mutexLocker(&m_readWaitMutex);
+    m_readWaiters.fetchAndAddOrdered(1);
+    m_readWait.wait(&m_readWaitMutex, timeoutMs);
+    m_readWaiters.fetchAndAddOrdered(-1);
+}
+
+void SampleSinkSharedFifo::notifyRead()
+{
+    if (m_readWaiters.loadAcquire() != 0)
+    {
+        QMutexLocker mutexLocker(&m_readWaitMutex);
+        m_readWait.wakeAll();
+    }
+
+    if (m_upstream) {
+        m_upstream->notifyRead();
+    }
+}
+
+unsigned int SampleSinkSharedFifo::fill(SampleSinkFifo *reader)
+{
+    quint64 tail = m_tail.loadAcquire();
+    quint64 window = m_window.loadAcquire();
+    quint64 head = reader->m_sharedGeneration.load() == m_generation.loadAcquire() ? reader->m_sharedHead.loadAcquire() : 0;
+
+    return tail > head ? std::min(tail - head, window) : 0;
+}
+
+unsigned int SampleSinkSharedFifo::readBegin(SampleSinkFifo *reader, unsigned int count,
+    SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
+    SampleVector::iterator* part2Begin, SampleVector::iterator* part2End)
+{
+    reader->m_reading.fetchAndStoreOrdered(1);
+
+    if (m_resizing.fetchAndAddOrdered(0) != 0)
+    {
+        reader->m_reading.storeRelease(0);
+        *part1Begin = *part1End = *part2Begin = *part2End = SampleVector::iterator();
+        return 0;
+    }
+
+    quint64 tail = m_tail.loadAcquire();
+    bool restarted = sync(reader, tail);
+    quint64 head = reader->m_sharedHead.load();
+    unsigned int total = std::min((quint64) count, tail - head);
+    unsigned int remaining = total;
+    unsigned int pos = m_size == 0 ? 0 : head % m_size;
+    unsigned int len;
+
+    if ((total < count) && !restarted) {
+        qCritical("SampleSinkSharedFifo::readBegin: underflow - missing %u samples", count - total);
+    }
+
+    if (remaining > 0)
+    {
+        len = std::min(remaining, m_size - pos);
+        *part1Begin = m_data.begin() + pos;
+        *part1End = m_data.begin() + pos + len;
+        pos += len;
+        pos %= m_size;
+        remaining -= len;
+    }
+    else
+    {
+        *part1Begin = m_data.end();
+        *part1End = m_data.end();
+    }
+
+    if (remaining > 0)
+    {
+        len = std::min(remaining, m_size - pos);
+        *part2Begin = m_data.begin() + pos;
+        *part2End = m_data.begin() + pos + len;
+    }
+    else
+    {
+        *part2Begin = m_data.end();
+        *part2End = m_data.end();
+    }
+
+    if (total == 0) {
+        reader->m_reading.storeRelease(0);
+    }
+
+    return total;
+}
+
+unsigned int SampleSinkSharedFifo::readCommit(SampleSinkFifo *reader, unsigned int count)
+{
+    if (reader->m_reading.load() == 0) {
+        return 0; // nothing was handed out by readBegin
+    }
+
+    quint64 head = reader->m_sharedHead.load();
+    quint64 tail = m_tail.loadAcquire();
+
+    if (count > tail - head)
+    {
+        qCritical("SampleSinkSharedFifo::readCommit: cannot commit more than available samples");
+        count = tail - head;
+    }
+
+    reader->m_sharedHead.storeRelease(head + count);
+    reader->m_reading.storeRelease(0);
+    sync(reader, tail);
+    notifyRead();
+
+    return count;
+}
@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// Single writer multiple readers sample FIFO. The device engine writes the      //
+// baseband once and each attached channel FIFO reads it through its own cursor  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SAMPLESINKSHAREDFIFO_H_
+#define SDRBASE_DSP_SAMPLESINKSHAREDFIFO_H_
+
+#include <vector>
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class SampleSinkFifo;
+
+/**
+ * The writer never waits for the readers and never takes a lock a reader holds: samples are written
+ * to a ring of twice the requested size and published by an atomic write position. Each reader has
+ * its own read position that only it changes. A reader more than the requested size behind skips
+ * forward at its next read and is reported as lagging. Samples a reader holds between readBegin and
+ * readCommit are never written over: the writer drops the new samples that do not fit before them.
+ * Samples are never copied per reader.
+ * The mutex only guards the list of readers against the writer and the controlling thread.
+ *
+ * A writer that can wait (file replay) checks isBacklogged() and sleeps in waitRead() until a reader
+ * commits a read. FIFOs written from the samples of this one (filter bank sub-bands) are added as
+ * downstream FIFOs so that their readers count in the backlog and wake the writer too. Sizes follow
+ * SampleSinkFifo::getSizePolicy so all FIFOs of a chain hold the same duration and the backlog is the
+ * sum of the fill ratios along the chain. Readers only take the wait mutex when a writer is waiting.
+ */
+class SDRBASE_API SampleSinkSharedFifo
+{
+public:
+    SampleSinkSharedFifo();
+    ~SampleSinkSharedFifo();
+
+    void setSize(unsigned int size); //!< Effective at next write when no reader holds samples. Buffered samples are dropped.
+    unsigned int size() const { return m_window.load(); }
+    bool hasReaders() const { return m_nbReaders.load() != 0; } //!< Unlocked check for the writer
+    unsigned int getMaxFill(); //!< Samples not yet read by the slowest reader. For writers that can wait.
+    bool isBacklogged();       //!< More than half of the FIFO duration is left to read through this FIFO and the downstream ones
+    void waitRead(unsigned long timeoutMs); //!< Until a reader of this FIFO or of a downstream FIFO commits a read
+    void addDownstream(SampleSinkSharedFifo *fifo); //!< FIFO written from the samples read from this one
+    void removeDownstream(SampleSinkSharedFifo *fifo);
+    unsigned int write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
+
+private:
+    friend class SampleSinkFifo;
+
+    QMutex m_mutex; //!< Guards m_readers. Never taken on the reader side.
+    SampleVector m_data;
+    unsigned int m_size;   //!< ring size
+    QAtomicInteger<unsigned int> m_window; //!< maximum distance of a reader to the writer before it is lagging
+    QAtomicInteger<unsigned int> m_requestedSize;
+    alignas(64) QAtomicInteger<quint64> m_tail;     //!< absolute write position published after the samples are written
+    QAtomicInt m_resizing;                          //!< set by the writer while it reallocates the ring
+    QAtomicInt m_generation;                        //!< incremented at each resize. Readers restart from the beginning.
+    std::vector<SampleSinkFifo*> m_readers;
+    QAtomicInt m_nbReaders;
+    QElapsedTimer m_msgRateTimer;
+    int m_suppressed;
+    std::vector<SampleSinkSharedFifo*> m_downstreams; //!< guarded by m_mutex
+    SampleSinkSharedFifo *m_upstream;                 //!< FIFO this one is fed from if any
+    QMutex m_readWaitMutex;
+    QWaitCondition m_readWait;
+    QAtomicInt m_readWaiters;                         //!< writers in waitRead
+
+    // reader side called from SampleSinkFifo
+    void addReader(SampleSinkFifo *reader);
+    void removeReader(SampleSinkFifo *reader);
+    unsigned int fill(SampleSinkFifo *reader);
+    unsigned int readBegin(SampleSinkFifo *reader, unsigned int count,
+        SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
+        SampleVector::iterator* part2Begin, SampleVector::iterator* part2End);
+    unsigned int readCommit(SampleSinkFifo *reader, unsigned int count);
+    void notifyRead(); //!< Wake the writers waiting on this FIFO and upstream
+    float getBacklog(); //!< Fill of the slowest reader in FIFO sizes plus the largest downstream backlog
+
+    bool resize();
+    bool sync(SampleSinkFifo *reader, quint64 tail); //!< Reader side: serve reset and lag. True if the reader restarted.
+    void lagged(SampleSinkFifo *reader, quint64 count);
+};
+
+#endif // SDRBASE_DSP_SAMPLESINKSHAREDFIFO_H_
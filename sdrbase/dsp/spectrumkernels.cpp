@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <limits>
+
+#include "spectrumkernels.h"
+
+void SpectrumKernels::magSq(const Complex *in, float *out, unsigned int n)
+{
+    for (unsigned int i = 0; i < n; i++) {
+        out[i] = in[i].real() * in[i].real() + in[i].imag() * in[i].imag();
+    }
+}
+
+void SpectrumKernels::log2(const float *in, float *out, unsigned int n, float mult, float ofs)
+{
+    // x = 2^e * m with m in [sqrt(1/2), sqrt(2)[ then log2(m) = 2/ln(2) * atanh(t) with t = (m - 1)/(m + 1) in ]-0.172, 0.172[
+    // Zero would give e = -127 (about -382 dB) so it is mapped explicitly to -inf as log2 does
+    const float k = 2.8853900817779268f * mult; // 2/ln(2)
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+        int32_t bits;
+        memcpy(&bits, &in[i], sizeof(float));
+        int32_t x = bits - 0x3f3504f3; // sqrt(1/2)
+        int32_t e = x >> 23;
+        bits = (x & 0x007fffff) + 0x3f3504f3;
+        float m;
+        memcpy(&m, &bits, sizeof(float));
+        float t = (m - 1.0f) / (m + 1.0f);
+        float t2 = t * t;
+        float s = t * (1.0f + t2 * (1.0f/3.0f + t2 * (1.0f/5.0f + t2 * (1.0f/7.0f))));
+        float v = mult * (float) e + k * s + ofs;
+        out[i] = in[i] > 0.0f ? v : -std::numeric_limits<float>::infinity();
+    }
+}
+
+void SpectrumKernels::scale(const float *in, float *out, unsigned int n, float factor)
+{
+    for (unsigned int i = 0; i < n; i++) {
+        out[i] = factor * in[i];
+    }
+}
+
+void SpectrumKernels::reduceMax(const float *in, unsigned int n, float *out, unsigned int nbOut)
+{
+    unsigned int start = 0;
+
+    for (unsigned int j = 0; j < nbOut; j++)
+    {
+        unsigned int end = (unsigned int) ((((uint64_t) j + 1) * n) / nbOut);
+        float max = in[start];
+
+        for (unsigned int i = start + 1; i < end; i++) {
+            max = std::max(max, in[i]);
+        }
+
+        out[j] = max;
+        start = end;
+    }
+}
+
+void SpectrumKernels::reduceMean(const float *in, unsigned int n, float *out, unsigned int nbOut)
+{
+    unsigned int start = 0;
+
+    for (unsigned int j = 0; j < nbOut; j++)
+    {
+        unsigned int end = (unsigned int) ((((uint64_t) j + 1) * n) / nbOut);
+        float sum = 0.0f;
+
+        for (unsigned int i = start; i < end; i++) {
+            sum += in[i];
+        }
+
+        out[j] = sum / (end - start);
+        start = end;
+    }
+}
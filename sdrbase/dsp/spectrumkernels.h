@@ -0,0 +1,38 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// Block kernels for the power spectrum post processing. Written as plain loops  //
+// without branches so that the compiler vectorizes them                        //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SPECTRUMKERNELS_H_
+#define SDRBASE_DSP_SPECTRUMKERNELS_H_
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class SDRBASE_API SpectrumKernels
+{
+public:
+    static void magSq(const Complex *in, float *out, unsigned int n);   //!< out = re^2 + im^2
+    static void log2(const float *in, float *out, unsigned int n, float mult, float ofs); //!< out = mult * log2(in) + ofs. Max error 4e-6 on log2. -inf for zero
+    static void scale(const float *in, float *out, unsigned int n, float factor); //!< out = factor * in
+    static void reduceMax(const float *in, unsigned int n, float *out, unsigned int nbOut);  //!< max pooling of n bins into nbOut bins
+    static void reduceMean(const float *in, unsigned int n, float *out, unsigned int nbOut); //!< mean pooling of n bins into nbOut bins
+};
+
+#endif // SDRBASE_DSP_SPECTRUMKERNELS_H_
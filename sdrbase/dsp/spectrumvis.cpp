@@ -22,6 +22,7 @@
 #include "dspcommands.h"
 #include "dspengine.h"
 #include "fftfactory.h"
+#include "spectrumkernels.h"
 #include "util/messagequeue.h"
 
 #include "spectrumvis.h"
@@ -48,6 +49,8 @@ SpectrumVis::SpectrumVis(Real scalef) :
     m_fftEngineSequence(0),
 	m_fftBuffer(MAX_FFT_SIZE),
 	m_powerSpectrum(MAX_FFT_SIZE),
+	m_powerBuffer(MAX_FFT_SIZE),
+	m_reductionBuffer(MAX_FFT_SIZE),
 	m_fftBufferFill(0),
 	m_needMoreSamples(false),
 	m_scalef(scalef),
@@ -89,7 +92,9 @@ void SpectrumVis::configure(
     unsigned int averagingNb,
     AvgMode averagingMode,
     FFTWindow::Function window,
-    bool linear)
+    bool linear,
+    int reductionBins,
+    GLSpectrumSettings::ReductionMode reductionMode)
 {
     GLSpectrumSettings settings = m_settings;
     settings.m_fftSize = fftSize;
@@ -100,6 +105,8 @@ void SpectrumVis::configure(
     settings.m_averagingIndex = GLSpectrumSettings::getAveragingIndex(averagingNb, settings.m_averagingMode);
     settings.m_fftWindow = window;
     settings.m_linear = linear;
+    settings.m_reductionBins = reductionBins;
+    settings.m_reductionMode = reductionMode;
 
     MsgConfigureSpectrumVis* cmd = MsgConfigureSpectrumVis::create(settings, false);
 
@@ -149,170 +156,10 @@ void SpectrumVis::feed(const Complex *begin, unsigned int length)
         return;
     }
 
-    Complex c;
-    Real v;
-
-    if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeNone)
-    {
-        for (unsigned int i = 0; i < m_settings.m_fftSize; i++)
-        {
-            if (i < length) {
-                c = begin[i];
-            } else {
-                c = Complex{0,0};
-            }
-
-            v = c.real() * c.real() + c.imag() * c.imag();
-            v = m_settings.m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-            m_powerSpectrum[i] = v;
-        }
-
-        // send new data to visualisation
-        if (m_glSpectrum) {
-            m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-        }
-
-        // web socket spectrum connections
-        if (m_wsSpectrum.socketOpened())
-        {
-            m_wsSpectrum.newSpectrum(
-                m_powerSpectrum,
-                m_settings.m_fftSize,
-                m_settings.m_refLevel,
-                m_settings.m_powerRange,
-                m_centerFrequency,
-                m_sampleRate,
-                m_settings.m_linear
-            );
-        }
-    }
-    else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMoving)
-    {
-        for (unsigned int i = 0; i < m_settings.m_fftSize; i++)
-        {
-            if (i < length) {
-                c = begin[i];
-            } else {
-                c = Complex{0,0};
-            }
-
-            v = c.real() * c.real() + c.imag() * c.imag();
-            v = m_movingAverage.storeAndGetAvg(v, i);
-            v = m_settings.m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-            m_powerSpectrum[i] = v;
-        }
-
-        // send new data to visualisation
-        if (m_glSpectrum) {
-            m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-        }
-
-        // web socket spectrum connections
-        if (m_wsSpectrum.socketOpened())
-        {
-            m_wsSpectrum.newSpectrum(
-                m_powerSpectrum,
-                m_settings.m_fftSize,
-                m_settings.m_refLevel,
-                m_settings.m_powerRange,
-                m_centerFrequency,
-                m_sampleRate,
-                m_settings.m_linear
-            );
-        }
-
-        m_movingAverage.nextAverage();
-    }
-    else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeFixed)
-    {
-        double avg;
-
-        for (unsigned int i = 0; i < m_settings.m_fftSize; i++)
-        {
-            if (i < length) {
-                c = begin[i];
-            } else {
-                c = Complex{0,0};
-            }
-
-            v = c.real() * c.real() + c.imag() * c.imag();
-
-            // result available
-            if (m_fixedAverage.storeAndGetAvg(avg, v, i))
-            {
-                avg = m_settings.m_linear ? avg/m_powFFTDiv : m_mult * log2f(avg) + m_ofs;
-                m_powerSpectrum[i] = avg;
-            }
-        }
-
-        // result available
-        if (m_fixedAverage.nextAverage())
-        {
-            // send new data to visualisation
-            if (m_glSpectrum) {
-                m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-            }
-
-            // web socket spectrum connections
-            if (m_wsSpectrum.socketOpened())
-            {
-                m_wsSpectrum.newSpectrum(
-                    m_powerSpectrum,
-                    m_settings.m_fftSize,
-                    m_settings.m_refLevel,
-                    m_settings.m_powerRange,
-                    m_centerFrequency,
-                    m_sampleRate,
-                    m_settings.m_linear
-                );
-            }
-        }
-    }
-    else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMax)
-    {
-        double max;
-
-        for (unsigned int i = 0; i < m_settings.m_fftSize; i++)
-        {
-            if (i < length) {
-                c = begin[i];
-            } else {
-                c = Complex{0,0};
-            }
-
-            v = c.real() * c.real() + c.imag() * c.imag();
-
-            // result available
-            if (m_max.storeAndGetMax(max, v, i))
-            {
-                max = m_settings.m_linear ? max/m_powFFTDiv : m_mult * log2f(max) + m_ofs;
-                m_powerSpectrum[i] = max;
-            }
-        }
-
-        // result available
-        if (m_max.nextMax())
-        {
-            // send new data to visualisation
-            if (m_glSpectrum) {
-                m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-            }
-
-            // web socket spectrum connections
-            if (m_wsSpectrum.socketOpened())
-            {
-                m_wsSpectrum.newSpectrum(
-                    m_powerSpectrum,
-                    m_settings.m_fftSize,
-                    m_settings.m_refLevel,
-                    m_settings.m_powerRange,
-                    m_centerFrequency,
-                    m_sampleRate,
-                    m_settings.m_linear
-                );
-            }
-        }
-    }
+    unsigned int nbSamples = length < (unsigned int) m_settings.m_fftSize ? length : m_settings.m_fftSize;
+    SpectrumKernels::magSq(begin, &m_powerBuffer[0], nbSamples);
+    std::fill(m_powerBuffer.begin() + nbSamples, m_powerBuffer.begin() + m_settings.m_fftSize, 0.0f); // zero padding
+    processPowerBuffer(m_settings.m_fftSize, false);
 
     m_mutex.unlock();
 }
@@ -354,247 +201,19 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 
 			// extract power spectrum and reorder buckets
 			const Complex* fftOut = m_fft->out();
-			Complex c;
-			Real v;
 			std::size_t halfSize = m_settings.m_fftSize / 2;
 
-			if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeNone)
-			{
-                if ( positiveOnly )
-                {
-                    for (std::size_t i = 0; i < halfSize; i++)
-                    {
-                        c = fftOut[i];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-                        v = m_settings.m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-                        m_powerSpectrum[i * 2] = v;
-                        m_powerSpectrum[i * 2 + 1] = v;
-                    }
-                }
-                else
-                {
-                    for (std::size_t i = 0; i < halfSize; i++)
-                    {
-                        c = fftOut[i + halfSize];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-                        v = m_settings.m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-                        m_powerSpectrum[i] = v;
-
-                        c = fftOut[i];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-                        v = m_settings.m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-                        m_powerSpectrum[i + halfSize] = v;
-                    }
-                }
-
-                // send new data to visualisation
-                if (m_glSpectrum) {
-                    m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-                }
-
-                // web socket spectrum connections
-                if (m_wsSpectrum.socketOpened())
-                {
-                    m_wsSpectrum.newSpectrum(
-                        m_powerSpectrum,
-                        m_settings.m_fftSize,
-                        m_settings.m_refLevel,
-                        m_settings.m_powerRange,
-                        m_centerFrequency,
-                        m_sampleRate,
-                        m_settings.m_linear
-                    );
-                }
-			}
-			else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMoving)
-			{
-	            if ( positiveOnly )
-	            {
-	                for (std::size_t i = 0; i < halfSize; i++)
-	                {
-	                    c = fftOut[i];
-	                    v = c.real() * c.real() + c.imag() * c.imag();
-	                    v = m_movingAverage.storeAndGetAvg(v, i);
-	                    v = m_settings.m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-	                    m_powerSpectrum[i * 2] = v;
-	                    m_powerSpectrum[i * 2 + 1] = v;
-	                }
-	            }
-	            else
-	            {
-	                for (std::size_t i = 0; i < halfSize; i++)
-	                {
-	                    c = fftOut[i + halfSize];
-	                    v = c.real() * c.real() + c.imag() * c.imag();
-	                    v = m_movingAverage.storeAndGetAvg(v, i+halfSize);
-	                    v = m_settings.m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-	                    m_powerSpectrum[i] = v;
-
-	                    c = fftOut[i];
-	                    v = c.real() * c.real() + c.imag() * c.imag();
-	                    v = m_movingAverage.storeAndGetAvg(v, i);
-	                    v = m_settings.m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-	                    m_powerSpectrum[i + halfSize] = v;
-	                }
-	            }
-
-	            // send new data to visualisation
-                if (m_glSpectrum) {
-    	            m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-                }
-
-                // web socket spectrum connections
-                if (m_wsSpectrum.socketOpened())
-                {
-                    m_wsSpectrum.newSpectrum(
-                        m_powerSpectrum,
-                        m_settings.m_fftSize,
-                        m_settings.m_refLevel,
-                        m_settings.m_powerRange,
-                        m_centerFrequency,
-                        m_sampleRate,
-                        m_settings.m_linear
-                    );
-                }
-
-	            m_movingAverage.nextAverage();
-			}
-			else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeFixed)
-			{
-			    double avg;
-
-                if ( positiveOnly )
-                {
-                    for (std::size_t i = 0; i < halfSize; i++)
-                    {
-                        c = fftOut[i];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-
-                        if (m_fixedAverage.storeAndGetAvg(avg, v, i))
-                        {
-                            avg = m_settings.m_linear ? avg/m_powFFTDiv : m_mult * log2f(avg) + m_ofs;
-                            m_powerSpectrum[i * 2] = avg;
-                            m_powerSpectrum[i * 2 + 1] = avg;
-                        }
-                    }
-                }
-                else
-                {
-                    for (std::size_t i = 0; i < halfSize; i++)
-                    {
-                        c = fftOut[i + halfSize];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-
-                        // result available
-                        if (m_fixedAverage.storeAndGetAvg(avg, v, i+halfSize))
-                        {
-                            avg = m_settings.m_linear ? avg/m_powFFTDiv : m_mult * log2f(avg) + m_ofs;
-                            m_powerSpectrum[i] = avg;
-                        }
-
-                        c = fftOut[i];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-
-                        // result available
-                        if (m_fixedAverage.storeAndGetAvg(avg, v, i))
-                        {
-                            avg = m_settings.m_linear ? avg/m_powFFTDiv : m_mult * log2f(avg) + m_ofs;
-                            m_powerSpectrum[i + halfSize] = avg;
-                        }
-                    }
-                }
-
-                // result available
-                if (m_fixedAverage.nextAverage())
-                {
-                    // send new data to visualisation
-                    if (m_glSpectrum) {
-                        m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-                    }
-
-                    // web socket spectrum connections
-                    if (m_wsSpectrum.socketOpened())
-                    {
-                        m_wsSpectrum.newSpectrum(
-                            m_powerSpectrum,
-                            m_settings.m_fftSize,
-                            m_settings.m_refLevel,
-                            m_settings.m_powerRange,
-                            m_centerFrequency,
-                            m_sampleRate,
-                            m_settings.m_linear
-                        );
-                    }
-                }
-			}
-			else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMax)
-			{
-			    double max;
-
-                if ( positiveOnly )
-                {
-                    for (std::size_t i = 0; i < halfSize; i++)
-                    {
-                        c = fftOut[i];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-
-                        if (m_max.storeAndGetMax(max, v, i))
-                        {
-                            max = m_settings.m_linear ? max/m_powFFTDiv : m_mult * log2f(max) + m_ofs;
-                            m_powerSpectrum[i * 2] = max;
-                            m_powerSpectrum[i * 2 + 1] = max;
-                        }
-                    }
-                }
-                else
-                {
-                    for (std::size_t i = 0; i < halfSize; i++)
-                    {
-                        c = fftOut[i + halfSize];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-
-                        // result available
-                        if (m_max.storeAndGetMax(max, v, i+halfSize))
-                        {
-                            max = m_settings.m_linear ? max/m_powFFTDiv : m_mult * log2f(max) + m_ofs;
-                            m_powerSpectrum[i] = max;
-                        }
-
-                        c = fftOut[i];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-
-                        // result available
-                        if (m_max.storeAndGetMax(max, v, i))
-                        {
-                            max = m_settings.m_linear ? max/m_powFFTDiv : m_mult * log2f(max) + m_ofs;
-                            m_powerSpectrum[i + halfSize] = max;
-                        }
-                    }
-                }
-
-                // result available
-                if (m_max.nextMax())
-                {
-                    // send new data to visualisation
-                    if (m_glSpectrum) {
-                        m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-                    }
-
-                    // web socket spectrum connections
-                    if (m_wsSpectrum.socketOpened())
-                    {
-                        m_wsSpectrum.newSpectrum(
-                            m_powerSpectrum,
-                            m_settings.m_fftSize,
-                            m_settings.m_refLevel,
-                            m_settings.m_powerRange,
-                            m_centerFrequency,
-                            m_sampleRate,
-                            m_settings.m_linear
-                        );
-                    }
-                }
-			}
+            if (positiveOnly)
+            {
+                SpectrumKernels::magSq(fftOut, &m_powerBuffer[0], halfSize);
+                processPowerBuffer(halfSize, true);
+            }
+            else
+            {
+                SpectrumKernels::magSq(fftOut + halfSize, &m_powerBuffer[0], halfSize);
+                SpectrumKernels::magSq(fftOut, &m_powerBuffer[halfSize], halfSize);
+                processPowerBuffer(m_settings.m_fftSize, false);
+            }
 
 			// advance buffer respecting the fft overlap factor
 			std::copy(m_fftBuffer.begin() + m_refillSize, m_fftBuffer.end(), m_fftBuffer.begin());
@@ -619,6 +238,88 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 	 m_mutex.unlock();
 }
 
+void SpectrumVis::processPowerBuffer(unsigned int nbBins, bool positiveOnly)
+{
+    // average squared magnitudes in place
+    bool available = true;
+
+    if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMoving)
+    {
+        m_movingAverage.storeAndGetAvg(&m_powerBuffer[0], nbBins);
+        m_movingAverage.nextAverage();
+    }
+    else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeFixed)
+    {
+        m_fixedAverage.storeAndGetAvg(&m_powerBuffer[0], nbBins);
+        available = m_fixedAverage.nextAverage();
+    }
+    else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMax)
+    {
+        m_max.storeAndGetMax(&m_powerBuffer[0], nbBins);
+        available = m_max.nextMax();
+    }
+
+    if (!available) {
+        return;
+    }
+
+    // pool bins down to the display resolution
+    float *power = &m_powerBuffer[0];
+    unsigned int nbOut = nbBins;
+
+    if (m_settings.m_reductionBins > 0)
+    {
+        nbOut = positiveOnly ? m_settings.m_reductionBins / 2 : m_settings.m_reductionBins;
+
+        if (m_settings.m_reductionMode == GLSpectrumSettings::ReductionMean) {
+            SpectrumKernels::reduceMean(power, nbBins, &m_reductionBuffer[0], nbOut);
+        } else {
+            SpectrumKernels::reduceMax(power, nbBins, &m_reductionBuffer[0], nbOut);
+        }
+
+        power = &m_reductionBuffer[0];
+    }
+
+    // scale to dB or linear. Positive only spectrum bins are doubled to span the display.
+    float *scaled = positiveOnly ? power : &m_powerSpectrum[0];
+
+    if (m_settings.m_linear) {
+        SpectrumKernels::scale(power, scaled, nbOut, 1.0f / m_powFFTDiv);
+    } else {
+        SpectrumKernels::log2(power, scaled, nbOut, m_mult, m_ofs);
+    }
+
+    if (positiveOnly)
+    {
+        for (unsigned int i = 0; i < nbOut; i++)
+        {
+            m_powerSpectrum[i * 2] = scaled[i];
+            m_powerSpectrum[i * 2 + 1] = scaled[i];
+        }
+
+        nbOut *= 2;
+    }
+
+    // send new data to visualisation
+    if (m_glSpectrum) {
+        m_glSpectrum->newSpectrum(m_powerSpectrum, nbOut, m_settings.m_fftSize);
+    }
+
+    // web socket spectrum connections
+    if (m_wsSpectrum.socketOpened())
+    {
+        m_wsSpectrum.newSpectrum(
+            m_powerSpectrum,
+            nbOut,
+            m_settings.m_refLevel,
+            m_settings.m_powerRange,
+            m_centerFrequency,
+            m_sampleRate,
+            m_settings.m_linear
+        );
+    }
+}
+
 void SpectrumVis::start()
 {
 }
@@ -685,6 +386,11 @@ void SpectrumVis::applySettings(const GLSpectrumSettings& settings, bool force)
             0 :
             settings.m_fftOverlap;
 
+    // even so that a positive only spectrum is reduced to half of it
+    int reductionBins = (settings.m_reductionBins < 2) || (settings.m_reductionBins >= fftSize) ?
+        0 :
+        settings.m_reductionBins & ~1;
+
     qDebug() << "SpectrumVis::applySettings:"
         << " m_fftSize: " << fftSize
         << " m_fftWindow: " << settings.m_fftWindow
@@ -694,6 +400,8 @@ void SpectrumVis::applySettings(const GLSpectrumSettings& settings, bool force)
         << " m_refLevel: " << settings.m_refLevel
         << " m_powerRange: " << settings.m_powerRange
         << " m_linear: " << settings.m_linear
+        << " m_reductionBins: " << reductionBins
+        << " m_reductionMode: " << settings.m_reductionMode
         << " force: " << force;
 
     if ((fftSize != m_settings.m_fftSize) || force)
@@ -737,6 +445,7 @@ void SpectrumVis::applySettings(const GLSpectrumSettings& settings, bool force)
     m_settings = settings;
     m_settings.m_fftSize = fftSize;
     m_settings.m_fftOverlap = overlapPercent;
+    m_settings.m_reductionBins = reductionBins;
 }
 
 void SpectrumVis::handleConfigureDSP(uint64_t centerFrequency, int sampleRate)
@@ -86,7 +86,9 @@ public:
         unsigned int averagingNb,
         AvgMode averagingMode,
         FFTWindow::Function window,
-        bool m_linear
+        bool m_linear,
+        int reductionBins = 0, //!< bins sent to displays. 0 for full resolution
+        GLSpectrumSettings::ReductionMode reductionMode = GLSpectrumSettings::ReductionMax
     );
     void setScalef(Real scalef);
     void configureWSSpectrum(const QString& address, uint16_t port);
@@ -156,6 +158,8 @@ private:
 
 	std::vector<Complex> m_fftBuffer;
 	std::vector<Real> m_powerSpectrum;
+	std::vector<float> m_powerBuffer;     //!< squared magnitudes in display order then averaged in place
+	std::vector<float> m_reductionBuffer; //!< bins pooled down to m_settings.m_reductionBins
 
     GLSpectrumSettings m_settings;
 	std::size_t m_overlapSize;
@@ -166,9 +170,9 @@ private:
 	Real m_scalef;
 	GLSpectrumInterface* m_glSpectrum;
     WSSpectrum m_wsSpectrum;
-	MovingAverage2D<double> m_movingAverage;
-	FixedAverage2D<double> m_fixedAverage;
-	Max2D<double> m_max;
+	MovingAverage2D<float, double> m_movingAverage; //!< float history with double running sums
+	FixedAverage2D<float, double> m_fixedAverage;
+	Max2D<float> m_max;
 
     uint64_t m_centerFrequency;
     int m_sampleRate;
@@ -179,6 +183,7 @@ private:
 
 	QMutex m_mutex;
 
+    void processPowerBuffer(unsigned int nbBins, bool positiveOnly); //!< average, reduce, scale and send m_powerBuffer
     void applySettings(const GLSpectrumSettings& settings, bool force = false);
     void handleConfigureDSP(uint64_t centerFrequency, int sampleRate);
     void handleScalef(Real scalef);
@@ -34,12 +34,23 @@ MainParser::MainParser() :
     m_fftwfWisdomOption(QStringList() << "w" << "fftwf-wisdom",
         "FFTW Wisdom file.",
         "file",
-        "")
+        ""),
+    m_schedulerWorkersOption(QStringList() << "s" << "scheduler-workers",
+        "Run channel basebands on a shared pool of workers instead of one thread per channel (0: one worker per core).",
+        "workers"),
+    m_schedulerNUMAOption(QStringList() << "scheduler-numa",
+        "Pin the shared workers to NUMA nodes and the channels of a device set to one node."),
+    m_reportsPortOption(QStringList() << "reports-port",
+        "Web socket server port pushing channel and device reports on the Web API address (default: disabled).",
+        "port")
 {
     m_serverAddress = "127.0.0.1";
     m_serverPort = 8091;
     m_mimoSupport = false;
     m_fftwfWindowFileName = "";
+    m_schedulerWorkers = -1;
+    m_schedulerNUMA = false;
+    m_reportsPort = 0;
 
     m_parser.setApplicationDescription("Software Defined Radio application");
     m_parser.addHelpOption();
@@ -48,6 +59,9 @@ MainParser::MainParser() :
     m_parser.addOption(m_serverAddressOption);
     m_parser.addOption(m_serverPortOption);
     m_parser.addOption(m_fftwfWisdomOption);
+    m_parser.addOption(m_schedulerWorkersOption);
+    m_parser.addOption(m_schedulerNUMAOption);
+    m_parser.addOption(m_reportsPortOption);
 }
 
 MainParser::~MainParser()
@@ -92,6 +106,34 @@ void MainParser::parse(const QCoreApplication& app)
 
     m_fftwfWindowFileName = m_parser.value(m_fftwfWisdomOption);
 
+    // baseband scheduler
+
+    if (m_parser.isSet(m_schedulerWorkersOption))
+    {
+        int schedulerWorkers = m_parser.value(m_schedulerWorkersOption).toInt(&ok);
+
+        if (ok && (schedulerWorkers >= 0)) {
+            m_schedulerWorkers = schedulerWorkers;
+        } else {
+            qWarning() << "MainParser::parse: scheduler workers invalid. Defaulting to one thread per channel";
+        }
+    }
+
+    m_schedulerNUMA = m_parser.isSet(m_schedulerNUMAOption);
+
+    // reports web socket server
+
+    if (m_parser.isSet(m_reportsPortOption))
+    {
+        int reportsPort = m_parser.value(m_reportsPortOption).toInt(&ok);
+
+        if (ok && (reportsPort > 1023) && (reportsPort < 65536) && (reportsPort != m_serverPort)) {
+            m_reportsPort = reportsPort;
+        } else {
+            qWarning() << "MainParser::parse: reports port invalid. Reports web socket server disabled";
+        }
+    }
+
     // MIMO - from version
 
     QStringList versionParts = app.applicationVersion().split(".");
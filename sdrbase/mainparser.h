@@ -36,17 +36,26 @@ public:
     uint16_t getServerPort() const { return m_serverPort; }
     bool getMIMOSupport() const { return m_mimoSupport; }
     const QString& getFFTWFWisdomFileName() const { return m_fftwfWindowFileName; }
+    int getSchedulerWorkers() const { return m_schedulerWorkers; } //!< -1 if one thread per channel
+    bool getSchedulerNUMA() const { return m_schedulerNUMA; }
+    uint16_t getReportsPort() const { return m_reportsPort; } //!< 0 if the reports web socket server is disabled
 
 private:
     QString  m_serverAddress;
     uint16_t m_serverPort;
     QString  m_fftwfWindowFileName;
     bool m_mimoSupport; //!< obtained from major version
+    int m_schedulerWorkers;
+    bool m_schedulerNUMA;
+    uint16_t m_reportsPort;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_serverAddressOption;
     QCommandLineOption m_serverPortOption;
     QCommandLineOption m_fftwfWisdomOption;
+    QCommandLineOption m_schedulerWorkersOption;
+    QCommandLineOption m_schedulerNUMAOption;
+    QCommandLineOption m_reportsPortOption;
 };
 
 
@@ -21,7 +21,11 @@
 
 #include <algorithm>
 
-template<typename T>
+/**
+ * Average of size rows of width values. S is the type of the sums that can be wider than the
+ * values type T to keep precision over long averages.
+ */
+template<typename T, typename S = T>
 class FixedAverage2D
 {
 public:
@@ -42,7 +46,7 @@ public:
             if (m_sum) {
                 delete[] m_sum;
             }
-            m_sum = new T[m_maxSize];
+            m_sum = new S[m_maxSize];
         }
 
         m_width = width;
@@ -94,6 +98,35 @@ public:
         }
     }
 
+    /** Accumulate a row of values. When the average is complete replace them in place by the average and return true */
+    bool storeAndGetAvg(T *values, unsigned int width)
+    {
+        if (m_size <= 1) {
+            return true;
+        }
+
+        width = std::min(width, m_width);
+
+        for (unsigned int i = 0; i < width; i++) {
+            m_sum[i] += values[i];
+        }
+
+        if (m_maxIndex == m_size - 1)
+        {
+            S size = m_size;
+
+            for (unsigned int i = 0; i < width; i++) {
+                values[i] = m_sum[i] / size;
+            }
+
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
     bool nextAverage()
     {
         if (m_size <= 1) {
@@ -114,7 +147,7 @@ public:
     }
 
 private:
-    T *m_sum;
+    S *m_sum;
     unsigned int m_maxSize;
     unsigned int m_width;
     unsigned int m_size;
@@ -78,6 +78,36 @@ public:
         }
     }
 
+    /** Store a row of values. When the maximum is complete replace them in place by the maximum and return true */
+    bool storeAndGetMax(T *values, unsigned int width)
+    {
+        if (m_size <= 1) {
+            return true;
+        }
+
+        width = std::min(width, m_width);
+
+        if (m_maxIndex == 0)
+        {
+            std::copy(values, values + width, m_max);
+            return false;
+        }
+
+        for (unsigned int i = 0; i < width; i++) {
+            m_max[i] = std::max(m_max[i], values[i]);
+        }
+
+        if (m_maxIndex == m_size - 1)
+        {
+            std::copy(m_max, m_max + width, values);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
     bool nextMax()
     {
         if (m_size <= 1) {
@@ -24,7 +24,8 @@
 const char* Message::m_identifier = 0;
 
 Message::Message() :
-	m_destination(0)
+	m_destination(0),
+	m_queueNext(nullptr)
 {
 }
 
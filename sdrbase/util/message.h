@@ -20,6 +20,7 @@
 #define INCLUDE_MESSAGE_H
 
 #include <stdlib.h>
+#include <QAtomicPointer>
 #include "export.h"
 
 class SDRBASE_API Message {
@@ -38,6 +39,10 @@ protected:
 	// addressing
 	static const char* m_identifier;
 	void* m_destination;
+
+private:
+	friend class MessageQueue;
+	QAtomicPointer<Message> m_queueNext; //!< next message in the MessageQueue holding this one
 };
 
 #define MESSAGE_CLASS_DECLARATION \
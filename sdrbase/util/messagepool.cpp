@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <new>
+
+#include "messagepool.h"
+
+const int MessagePool::m_nbSlots;
+
+MessagePool::MessagePool(std::size_t blockSize) :
+    m_blockSize(blockSize)
+{
+    for (int i = 0; i < m_nbSlots; i++) {
+        m_slots[i].storeRelease(nullptr);
+    }
+}
+
+MessagePool::~MessagePool()
+{
+    for (int i = 0; i < m_nbSlots; i++) {
+        ::operator delete(m_slots[i].fetchAndStoreAcquire(nullptr));
+    }
+}
+
+void *MessagePool::allocate(std::size_t size)
+{
+    if (size == m_blockSize)
+    {
+        for (int i = 0; i < m_nbSlots; i++)
+        {
+            // a slot pointer is exchanged as a whole so a block is taken by one thread only
+            if (m_slots[i].loadAcquire())
+            {
+                void *block = m_slots[i].fetchAndStoreAcquire(nullptr);
+
+                if (block) {
+                    return block;
+                }
+            }
+        }
+    }
+
+    return ::operator new(size);
+}
+
+void MessagePool::release(void *block, std::size_t size)
+{
+    if (!block) {
+        return;
+    }
+
+    if (size == m_blockSize)
+    {
+        for (int i = 0; i < m_nbSlots; i++)
+        {
+            if (!m_slots[i].loadAcquire() && m_slots[i].testAndSetRelease(nullptr, block)) {
+                return;
+            }
+        }
+    }
+
+    ::operator delete(block);
+}
@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_MESSAGEPOOL_H
+#define INCLUDE_MESSAGEPOOL_H
+
+#include <cstddef>
+
+#include <QAtomicPointer>
+
+#include "export.h"
+
+/**
+ * Memory of the messages of one class created at a high rate (reports from DSP loops) reused instead of
+ * going through the heap. Messages are usually created in one thread and deleted in another one so free
+ * blocks are kept in a few slots exchanged atomically: allocation and release are lock-free. When no block
+ * is free or all slots are taken the heap is used. Blocks of another size (derived classes) always go
+ * through the heap.
+ *
+ * A message class is pooled with MESSAGE_CLASS_POOL_DECLARATION in its declaration next to
+ * MESSAGE_CLASS_DECLARATION and MESSAGE_CLASS_POOL_DEFINITION(Name) next to MESSAGE_CLASS_DEFINITION.
+ * It is still created by new and deleted by the consumer.
+ */
+class SDRBASE_API MessagePool
+{
+public:
+    MessagePool(std::size_t blockSize);
+    ~MessagePool();
+
+    void *allocate(std::size_t size);
+    void release(void *block, std::size_t size);
+
+    static const int m_nbSlots = 16; //!< maximum number of free blocks kept
+
+private:
+    std::size_t m_blockSize;
+    QAtomicPointer<void> m_slots[m_nbSlots];
+};
+
+#define MESSAGE_CLASS_POOL_DECLARATION \
+	public: \
+		static void* operator new(std::size_t size); \
+		static void operator delete(void* block, std::size_t size); \
+	private: \
+		static MessagePool& getMessagePool();
+
+// the pool is never destroyed as messages may still be deleted at exit
+#define MESSAGE_CLASS_POOL_DEFINITION(Name) \
+	MessagePool& Name::getMessagePool() { \
+		static MessagePool *pool = new MessagePool(sizeof(Name)); \
+		return *pool; \
+	} \
+	void* Name::operator new(std::size_t size) { return getMessagePool().allocate(size); } \
+	void Name::operator delete(void* block, std::size_t size) { getMessagePool().release(block, size); }
+
+#endif // INCLUDE_MESSAGEPOOL_H
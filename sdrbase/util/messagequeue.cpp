@@ -23,8 +23,9 @@
 
 MessageQueue::MessageQueue(QObject* parent) :
 	QObject(parent),
-	m_lock(QMutex::Recursive),
-	m_queue()
+	m_head(&m_stub),
+	m_tail(&m_stub),
+	m_size(0)
 {
 }
 
@@ -43,9 +44,8 @@ void MessageQueue::push(Message* message, bool emitSignal)
 {
 	if (message)
 	{
-		m_lock.lock();
-		m_queue.append(message);
-		m_lock.unlock();
+		m_size.fetchAndAddOrdered(1); // counted first so that size() never goes negative
+		link(message);
 	}
 
 	if (emitSignal)
@@ -54,32 +54,54 @@ void MessageQueue::push(Message* message, bool emitSignal)
 	}
 }
 
+void MessageQueue::link(Message* message)
+{
+	message->m_queueNext.storeRelease(nullptr);
+	Message* previous = m_head.fetchAndStoreOrdered(message);
+	previous->m_queueNext.storeRelease(message); // until then the message is not reachable by pop()
+}
+
 Message* MessageQueue::pop()
 {
-	QMutexLocker locker(&m_lock);
+	QMutexLocker locker(&m_popLock);
+	Message* tail = m_tail;
+	Message* next = tail->m_queueNext.loadAcquire();
 
-	if (m_queue.isEmpty())
+	if (tail == &m_stub) // skip the stub
 	{
-		return 0;
+		if (!next) {
+			return 0;
+		}
+
+		m_tail = next;
+		tail = next;
+		next = next->m_queueNext.loadAcquire();
 	}
-	else
+
+	if (!next) // tail is the last message linked
 	{
-		return m_queue.takeFirst();
-	}
-}
+		if (tail != m_head.loadAcquire()) { // a producer is linking a message after tail
+			return 0;
+		}
 
-int MessageQueue::size()
-{
-	QMutexLocker locker(&m_lock);
+		link(&m_stub); // gives tail a successor so that it can be removed
+		next = tail->m_queueNext.loadAcquire();
+
+		if (!next) { // another message was pushed before the stub and is not linked yet
+			return 0;
+		}
+	}
 
-	return m_queue.size();
+	m_tail = next;
+	m_size.fetchAndAddOrdered(-1);
+	return tail;
 }
 
 void MessageQueue::clear()
 {
-	QMutexLocker locker(&m_lock);
+	Message* message;
 
-    while (!m_queue.isEmpty()) {
-        delete m_queue.takeFirst();
-    }
+	while ((message = pop()) != 0) {
+		delete message;
+	}
 }
@@ -20,12 +20,18 @@
 #define INCLUDE_MESSAGEQUEUE_H
 
 #include <QObject>
-#include <QQueue>
+#include <QAtomicInt>
+#include <QAtomicPointer>
 #include <QMutex>
+#include "util/message.h"
 #include "export.h"
 
-class Message;
-
+/**
+ * Multiple producers single consumer queue of messages. push() is lock-free and does not allocate:
+ * messages are linked through their own next pointer (intrusive list after D. Vyukov). size() and
+ * isEmpty() read an atomic counter so that they can be polled in DSP loops. pop() is serialized by a
+ * consumer lock that is not contended when the queue has a single consumer as intended.
+ */
 class SDRBASE_API MessageQueue : public QObject {
 	Q_OBJECT
 
@@ -36,15 +42,21 @@ public:
 	void push(Message* message, bool emitSignal = true);  //!< Push message onto queue
 	Message* pop(); //!< Pop message from queue
 
-	int size(); //!< Returns queue size
+	int size() const { return m_size.loadAcquire(); } //!< Returns queue size
+	bool isEmpty() const { return m_size.loadAcquire() == 0; }
 	void clear(); //!< Empty queue
 
 signals:
 	void messageEnqueued();
 
 private:
-	QMutex m_lock;
-	QQueue<Message*> m_queue;
+	Message m_stub;                 //!< stays in the list so that the last message can be popped
+	QAtomicPointer<Message> m_head; //!< last message pushed
+	Message* m_tail;                //!< next message to pop (consumer side)
+	QAtomicInt m_size;
+	QMutex m_popLock;
+
+	void link(Message* message);
 };
 
 #endif // INCLUDE_MESSAGEQUEUE_H
@@ -21,7 +21,11 @@
 
 #include <algorithm>
 
-template<typename T>
+/**
+ * Moving average over depth rows of width values. S is the type of the running sums that
+ * can be wider than the stored values type T to avoid drift.
+ */
+template<typename T, typename S = T>
 class MovingAverage2D
 {
 public:
@@ -55,7 +59,7 @@ public:
             if (m_sum) {
                 delete[] m_sum;
             }
-            m_sum = new T[m_sumSize];
+            m_sum = new S[m_sumSize];
         }
 
         m_width = width;
@@ -105,13 +109,32 @@ public:
         }
     }
 
+    /** Store a row of values and replace them in place by their moving average */
+    void storeAndGetAvg(T *values, unsigned int width)
+    {
+        if (m_depth <= 1) {
+            return;
+        }
+
+        width = std::min(width, m_width);
+        T *data = &m_data[m_avgIndex*m_width];
+        S depth = m_depth;
+
+        for (unsigned int i = 0; i < width; i++)
+        {
+            m_sum[i] += (S) values[i] - (S) data[i];
+            data[i] = values[i];
+            values[i] = m_sum[i] / depth;
+        }
+    }
+
     void nextAverage() {
         m_avgIndex = m_avgIndex == m_depth-1 ? 0 : m_avgIndex+1;
     }
 
 private:
     T *m_data;
-    T *m_sum;
+    S *m_sum;
     unsigned int m_dataSize;
     unsigned int m_sumSize;
     unsigned int m_width;
@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QMutexLocker>
+
+#include "orderedworkerpool.h"
+
+const int OrderedWorkerPool::m_maxWorkers;
+
+OrderedWorkerPool::OrderedWorkerPool(int nbWorkers) :
+    m_nextSequence(0),
+    m_stop(false)
+{
+    if (nbWorkers <= 0) {
+        nbWorkers = std::max(1, std::min(QThread::idealThreadCount() - 1, m_maxWorkers));
+    }
+
+    for (int i = 0; i < nbWorkers; i++)
+    {
+        m_workers.push_back(new Worker(this, i));
+        m_workers.back()->start();
+    }
+}
+
+OrderedWorkerPool::~OrderedWorkerPool()
+{
+    m_mutex.lock();
+    m_stop = true;
+    m_jobQueued.wakeAll();
+    m_mutex.unlock();
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+}
+
+quint64 OrderedWorkerPool::push(const Job& job)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    QueuedJob queuedJob;
+    queuedJob.m_sequence = m_nextSequence++;
+    queuedJob.m_job = job;
+    m_jobs.push_back(queuedJob);
+    m_pending.insert(queuedJob.m_sequence);
+    m_jobQueued.wakeOne();
+
+    return queuedJob.m_sequence;
+}
+
+bool OrderedWorkerPool::isDone(quint64 sequence)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return !m_pending.contains(sequence);
+}
+
+void OrderedWorkerPool::wait(quint64 sequence)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    while (m_pending.contains(sequence)) {
+        m_jobDone.wait(&m_mutex);
+    }
+}
+
+void OrderedWorkerPool::waitAll()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    while (!m_pending.isEmpty()) {
+        m_jobDone.wait(&m_mutex);
+    }
+}
+
+void OrderedWorkerPool::runWorker(int index)
+{
+    m_mutex.lock();
+
+    while (true)
+    {
+        while (m_jobs.empty() && !m_stop) {
+            m_jobQueued.wait(&m_mutex);
+        }
+
+        if (m_jobs.empty()) { // stopped and nothing left
+            break;
+        }
+
+        QueuedJob queuedJob = m_jobs.front();
+        m_jobs.pop_front();
+        m_mutex.unlock();
+
+        queuedJob.m_job(index);
+
+        m_mutex.lock();
+        m_pending.remove(queuedJob.m_sequence);
+        m_jobDone.wakeAll();
+    }
+
+    m_mutex.unlock();
+}
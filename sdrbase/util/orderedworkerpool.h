@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_ORDEREDWORKERPOOL_H_
+#define SDRBASE_UTIL_ORDEREDWORKERPOOL_H_
+
+#include <deque>
+#include <vector>
+#include <functional>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSet>
+
+#include "export.h"
+
+/**
+ * Small pool of threads running independent jobs such as the FEC coding of frames. Each job gets a
+ * sequence number in the order it is pushed. Jobs run in parallel and may end in any order: the producer
+ * keeps its results in push order and waits for the oldest one before using it so that the output order
+ * is preserved. Each job is given the index of the worker running it so that it can use per worker
+ * resources (coder instances, scratch buffers) without locking.
+ */
+class SDRBASE_API OrderedWorkerPool
+{
+public:
+    typedef std::function<void(int workerIndex)> Job;
+
+    OrderedWorkerPool(int nbWorkers = 0); //!< 0: one less than the number of cores up to m_maxWorkers
+    ~OrderedWorkerPool(); //!< Runs the jobs still queued then stops the workers
+
+    int getNbWorkers() const { return m_workers.size(); }
+    quint64 push(const Job& job); //!< Returns the sequence number of the job
+    bool isDone(quint64 sequence);
+    void wait(quint64 sequence); //!< Waits for the end of a job
+    void waitAll();
+
+    static const int m_maxWorkers = 4;
+
+private:
+    class Worker : public QThread
+    {
+    public:
+        Worker(OrderedWorkerPool *pool, int index) : m_pool(pool), m_index(index) {}
+    protected:
+        virtual void run() { m_pool->runWorker(m_index); }
+    private:
+        OrderedWorkerPool *m_pool;
+        int m_index;
+    };
+
+    struct QueuedJob
+    {
+        quint64 m_sequence;
+        Job m_job;
+    };
+
+    std::vector<Worker*> m_workers;
+    std::deque<QueuedJob> m_jobs;
+    QSet<quint64> m_pending;   //!< sequences of the jobs queued or running
+    quint64 m_nextSequence;
+    bool m_stop;
+    QMutex m_mutex;
+    QWaitCondition m_jobQueued;
+    QWaitCondition m_jobDone;
+
+    void runWorker(int index);
+};
+
+#endif // SDRBASE_UTIL_ORDEREDWORKERPOOL_H_
@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "SWGPerfCounter.h"
+
+#include "perfcounter.h"
+
+PerfCounter::PerfCounter() :
+    m_calls(0),
+    m_samples(0),
+    m_totalTime(0),
+    m_maxTime(0)
+{
+}
+
+void PerfCounter::add(qint64 nsecs, quint64 samples)
+{
+    // only one thread adds so stores need not be read-modify-write operations
+    m_calls.storeRelease(m_calls.load() + 1);
+    m_samples.storeRelease(m_samples.load() + samples);
+    m_totalTime.storeRelease(m_totalTime.load() + nsecs);
+
+    if (nsecs > m_maxTime.load()) {
+        m_maxTime.storeRelease(nsecs);
+    }
+}
+
+void PerfCounter::webapiFormatPerfCounter(
+    SWGSDRangel::SWGPerfCounter *apiPerfCounter,
+    const PerfCounter& perfCounter
+)
+{
+    apiPerfCounter->setCalls(perfCounter.getCalls());
+    apiPerfCounter->setSamples(perfCounter.getSamples());
+    apiPerfCounter->setTotalTime(perfCounter.getTotalTime());
+    apiPerfCounter->setMaxTime(perfCounter.getMaxTime());
+}
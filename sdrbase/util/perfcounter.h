@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_PERFCOUNTER_H_
+#define SDRBASE_UTIL_PERFCOUNTER_H_
+
+#include <QAtomicInteger>
+
+#include "export.h"
+
+namespace SWGSDRangel
+{
+    class SWGPerfCounter;
+}
+
+/**
+ * Processing time statistics of a DSP stage. The stage measures each call itself (QElapsedTimer) and adds it
+ * from the thread running it. Counters are atomic so that they can be read from another thread (web API)
+ * without locking the DSP. A single thread is expected to add to a given counter.
+ */
+class SDRBASE_API PerfCounter
+{
+public:
+    PerfCounter();
+
+    void add(qint64 nsecs, quint64 samples);
+
+    quint64 getCalls() const { return m_calls.loadAcquire(); }
+    quint64 getSamples() const { return m_samples.loadAcquire(); }
+    qint64 getTotalTime() const { return m_totalTime.loadAcquire(); } //!< nanoseconds
+    qint64 getMaxTime() const { return m_maxTime.loadAcquire(); }     //!< nanoseconds
+
+    static void webapiFormatPerfCounter(
+        SWGSDRangel::SWGPerfCounter *apiPerfCounter,
+        const PerfCounter& perfCounter
+    );
+
+private:
+    QAtomicInteger<quint64> m_calls;
+    QAtomicInteger<quint64> m_samples;
+    QAtomicInteger<qint64> m_totalTime;
+    QAtomicInteger<qint64> m_maxTime;
+};
+
+#endif // SDRBASE_UTIL_PERFCOUNTER_H_
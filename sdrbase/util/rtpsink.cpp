@@ -72,6 +72,11 @@ RTPSink::~RTPSink()
     }
 }
 
+void RTPSink::moveToThread(QThread *thread)
+{
+    m_rtpTransmitter.moveToThread(thread);
+}
+
 void RTPSink::setPayloadInformation(PayloadType payloadType, int sampleRate)
 {
     uint32_t timestampinc;
@@ -35,6 +35,7 @@
 #include "export.h"
 
 class QUdpSocket;
+class QThread;
 
 class RTPSink
 {
@@ -54,6 +55,7 @@ public:
     ~RTPSink();
 
     bool isValid() const { return m_valid; }
+    void moveToThread(QThread *thread); //!< transmitter and its sockets to the thread that sends packets
     void setPayloadInformation(PayloadType payloadType, int sampleRate);
 
     void setDestination(const QString& address, uint16_t port);
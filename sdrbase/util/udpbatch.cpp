@@ -0,0 +1,245 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
+
+#include <QUdpSocket>
+#include <QHostAddress>
+
+#include "udpbatch.h"
+
+#if defined(__linux__)
+namespace {
+
+// destination in the family of the socket. IPv4 addresses are mapped for dual stack IPv6 sockets.
+socklen_t toSockAddr(int fd, const QHostAddress& address, quint16 port, sockaddr_storage& sockAddr)
+{
+    sockaddr_storage local;
+    socklen_t localLength = sizeof(local);
+    memset(&sockAddr, 0, sizeof(sockAddr));
+
+    if (getsockname(fd, (sockaddr *) &local, &localLength) < 0) {
+        return 0;
+    }
+
+    if (local.ss_family == AF_INET)
+    {
+        bool ok;
+        quint32 ipv4 = address.toIPv4Address(&ok);
+
+        if (!ok) {
+            return 0;
+        }
+
+        sockaddr_in *sin = (sockaddr_in *) &sockAddr;
+        sin->sin_family = AF_INET;
+        sin->sin_port = htons(port);
+        sin->sin_addr.s_addr = htonl(ipv4);
+        return sizeof(sockaddr_in);
+    }
+    else if (local.ss_family == AF_INET6)
+    {
+        sockaddr_in6 *sin6 = (sockaddr_in6 *) &sockAddr;
+        sin6->sin6_family = AF_INET6;
+        sin6->sin6_port = htons(port);
+
+        if (address.protocol() == QAbstractSocket::IPv4Protocol)
+        {
+            quint32 ipv4 = address.toIPv4Address();
+            sin6->sin6_addr.s6_addr[10] = 0xff;
+            sin6->sin6_addr.s6_addr[11] = 0xff;
+            sin6->sin6_addr.s6_addr[12] = (ipv4 >> 24) & 0xff;
+            sin6->sin6_addr.s6_addr[13] = (ipv4 >> 16) & 0xff;
+            sin6->sin6_addr.s6_addr[14] = (ipv4 >> 8) & 0xff;
+            sin6->sin6_addr.s6_addr[15] = ipv4 & 0xff;
+        }
+        else
+        {
+            Q_IPV6ADDR ipv6 = address.toIPv6Address();
+            memcpy(sin6->sin6_addr.s6_addr, &ipv6, 16);
+        }
+
+        return sizeof(sockaddr_in6);
+    }
+
+    return 0;
+}
+
+} // namespace
+#endif
+
+const int UDPBatch::m_maxBatchSize;
+
+bool UDPBatch::isBatchSupported()
+{
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+int UDPBatch::writeDatagrams(QUdpSocket *socket, const char *data, int datagramSize, int nbDatagrams,
+    const QHostAddress& address, quint16 port, bool batch)
+{
+    int sent = 0;
+    batch = batch && isBatchSupported();
+
+    // the socket is created by its first write
+    if (!batch || (socket->socketDescriptor() < 0))
+    {
+        for (int n = batch ? std::min(1, nbDatagrams) : nbDatagrams; sent < n; sent++)
+        {
+            if (socket->writeDatagram(&data[sent * datagramSize], datagramSize, address, port) != datagramSize) {
+                return sent;
+            }
+        }
+
+        if (!batch) {
+            return sent;
+        }
+    }
+
+#if defined(__linux__)
+    int fd = (int) socket->socketDescriptor();
+    sockaddr_storage sockAddr;
+    socklen_t sockAddrLength = toSockAddr(fd, address, port, sockAddr);
+
+    if (sockAddrLength == 0) {
+        return sent;
+    }
+
+    mmsghdr msgs[m_maxBatchSize];
+    iovec iovecs[m_maxBatchSize];
+
+    while (sent < nbDatagrams)
+    {
+        int count = std::min(nbDatagrams - sent, m_maxBatchSize);
+
+        for (int i = 0; i < count; i++)
+        {
+            iovecs[i].iov_base = (void *) &data[(sent + i) * datagramSize];
+            iovecs[i].iov_len = datagramSize;
+            memset(&msgs[i].msg_hdr, 0, sizeof(msghdr));
+            msgs[i].msg_hdr.msg_name = &sockAddr;
+            msgs[i].msg_hdr.msg_namelen = sockAddrLength;
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int res = sendmmsg(fd, msgs, count, 0);
+
+        if (res > 0)
+        {
+            sent += res;
+        }
+        else if ((res < 0) && (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS))
+        {
+            // socket is non blocking: wait for room in the send buffer
+            pollfd pfd;
+            pfd.fd = fd;
+            pfd.events = POLLOUT;
+
+            if (poll(&pfd, 1, 100) <= 0) {
+                break;
+            }
+        }
+        else if ((res < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            qWarning("UDPBatch::writeDatagrams: sendmmsg: %s", strerror(errno));
+            break;
+        }
+    }
+#endif
+
+    return sent;
+}
+
+int UDPBatch::readDatagrams(QUdpSocket *socket, char *data, int datagramSize, int maxDatagrams, int *sizes,
+    QHostAddress *sender, bool batch)
+{
+    int read = 0;
+    batch = batch && isBatchSupported();
+
+    // Qt re-enables its read notification when a datagram is read through it
+    while ((read < (batch ? 1 : maxDatagrams)) && socket->hasPendingDatagrams())
+    {
+        qint64 size = socket->readDatagram(&data[read * datagramSize], datagramSize, read == 0 ? sender : nullptr, nullptr);
+
+        if (size < 0) {
+            return read;
+        }
+
+        sizes[read++] = (int) size;
+    }
+
+    if ((read == 0) || !batch) {
+        return read;
+    }
+
+#if defined(__linux__)
+    int fd = (int) socket->socketDescriptor();
+    mmsghdr msgs[m_maxBatchSize];
+    iovec iovecs[m_maxBatchSize];
+
+    while (read < maxDatagrams)
+    {
+        int count = std::min(maxDatagrams - read, m_maxBatchSize);
+
+        for (int i = 0; i < count; i++)
+        {
+            iovecs[i].iov_base = (void *) &data[(read + i) * datagramSize];
+            iovecs[i].iov_len = datagramSize;
+            memset(&msgs[i].msg_hdr, 0, sizeof(msghdr));
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int res = recvmmsg(fd, msgs, count, MSG_DONTWAIT, nullptr);
+
+        if (res <= 0) { // nothing left or error
+            break;
+        }
+
+        for (int i = 0; i < res; i++) {
+            sizes[read + i] = (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) ? -1 : (int) msgs[i].msg_len;
+        }
+
+        read += res;
+
+        if (res < count) {
+            break;
+        }
+    }
+#endif
+
+    return read;
+}
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_UDPBATCH_H_
+#define SDRBASE_UTIL_UDPBATCH_H_
+
+#include <QtGlobal>
+
+#include "export.h"
+
+class QUdpSocket;
+class QHostAddress;
+
+/**
+ * Sends or receives many datagrams of a QUdpSocket in one system call with sendmmsg and recvmmsg
+ * on Linux. Elsewhere or when batch is false each datagram goes through QUdpSocket. Datagrams are
+ * stored contiguously with a stride of datagramSize bytes.
+ */
+class SDRBASE_API UDPBatch
+{
+public:
+    static bool isBatchSupported();
+
+    /** Returns the number of datagrams sent. Waits for room in the socket send buffer when it is full. */
+    static int writeDatagrams(QUdpSocket *socket, const char *data, int datagramSize, int nbDatagrams,
+        const QHostAddress& address, quint16 port, bool batch = true);
+
+    /**
+     * Reads at most maxDatagrams datagrams when readyRead has been signalled and returns the number read.
+     * The size of each is returned in sizes and the sender of the first in sender if not null. Never blocks.
+     * The first datagram is read by QUdpSocket so that it keeps notifying new datagrams.
+     */
+    static int readDatagrams(QUdpSocket *socket, char *data, int datagramSize, int maxDatagrams, int *sizes,
+        QHostAddress *sender, bool batch = true);
+
+    static const int m_maxBatchSize = 256; //!< datagrams per system call
+};
+
+#endif // SDRBASE_UTIL_UDPBATCH_H_
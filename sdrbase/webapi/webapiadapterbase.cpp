@@ -130,6 +130,8 @@ void WebAPIAdapterBase::webapiFormatPreset(
         swgSpectrumConfig->setAveragingMode((int) m_spectrumSettings.m_averagingMode);
         swgSpectrumConfig->setAveragingValue(GLSpectrumSettings::getAveragingValue(m_spectrumSettings.m_averagingIndex, m_spectrumSettings.m_averagingMode));
         swgSpectrumConfig->setLinear(m_spectrumSettings.m_linear ? 1 : 0);
+        swgSpectrumConfig->setReductionBins(m_spectrumSettings.m_reductionBins);
+        swgSpectrumConfig->setReductionMode((int) m_spectrumSettings.m_reductionMode);
     }
 
     int nbChannels = preset.getChannelCount();
@@ -276,6 +278,12 @@ void WebAPIAdapterBase::webapiUpdatePreset(
         if (spectrumIt->contains("powerRange")) {
             spectrumSettings.m_powerRange = apiPreset->getSpectrumConfig()->getPowerRange();
         }
+        if (spectrumIt->contains("reductionBins")) {
+            spectrumSettings.m_reductionBins = apiPreset->getSpectrumConfig()->getReductionBins();
+        }
+        if (spectrumIt->contains("reductionMode")) {
+            spectrumSettings.m_reductionMode = (GLSpectrumSettings::ReductionMode) apiPreset->getSpectrumConfig()->getReductionMode();
+        }
         if (spectrumIt->contains("refLevel")) {
             spectrumSettings.m_refLevel = apiPreset->getSpectrumConfig()->getRefLevel();
         }
@@ -56,11 +56,14 @@ namespace SWGSDRangel
     class SWGDeviceSettings;
     class SWGDeviceState;
     class SWGDeviceReport;
+    class SWGDeviceRecord;
     class SWGDeviceActions;
     class SWGChannelsDetail;
     class SWGChannelSettings;
     class SWGChannelReport;
     class SWGChannelActions;
+    class SWGDeviceSetPerf;
+    class SWGChannelPerf;
     class SWGSuccessResponse;
 }
 
@@ -862,6 +865,40 @@ public:
         return 501;
     }
 
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/device/record (GET)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetDeviceRecordGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/device/record (PATCH)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetDeviceRecordPatch(
+            int deviceSetIndex,
+            const QStringList& deviceRecordKeys,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) deviceRecordKeys;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     /**
      * Handler of /sdrangel/deviceset/{devicesetIndex}/channels/report (GET) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
      * returns the Http status code (default 501: not implemented)
@@ -1017,6 +1054,40 @@ public:
         return 501;
     }
 
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/perf (GET)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetPerfGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceSetPerf& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/channel/{channelIndex}/perf (GET)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetChannelPerfGet(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGChannelPerf& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) channelIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     static QString instanceSummaryURL;
     static QString instanceConfigURL;
     static QString instanceDevicesURL;
@@ -1046,6 +1117,7 @@ public:
     static std::regex devicesetDeviceRunURLRe;
     static std::regex devicesetDeviceSubsystemRunURLRe;
     static std::regex devicesetDeviceReportURLRe;
+    static std::regex devicesetDeviceRecordURLRe;
     static std::regex devicesetDeviceActionsURLRe;
     static std::regex devicesetChannelURLRe;
     static std::regex devicesetChannelIndexURLRe;
@@ -1053,6 +1125,8 @@ public:
     static std::regex devicesetChannelReportURLRe;
     static std::regex devicesetChannelActionsURLRe;
     static std::regex devicesetChannelsReportURLRe;
+    static std::regex devicesetPerfURLRe;
+    static std::regex devicesetChannelPerfURLRe;
 };
 
 
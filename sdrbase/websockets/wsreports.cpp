@@ -0,0 +1,368 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+
+#include <QtWebSockets>
+#include <QUrlQuery>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDateTime>
+#include <QSet>
+#include <QDebug>
+
+#include "SWGDeviceSetList.h"
+#include "SWGDeviceSet.h"
+#include "SWGChannelReport.h"
+#include "SWGDeviceReport.h"
+#include "SWGErrorResponse.h"
+
+#include "webapi/webapiadapterinterface.h"
+#include "wsreports.h"
+
+const int WSReports::m_tickMs;
+
+WSReports::WSReports(WebAPIAdapterInterface *adapter, QObject *parent) :
+    QObject(parent),
+    m_adapter(adapter),
+    m_webSocketServer(nullptr)
+{
+    m_elapsed.start();
+    m_timer.setInterval(m_tickMs);
+    connect(&m_timer, &QTimer::timeout, this, &WSReports::tick);
+}
+
+WSReports::~WSReports()
+{
+    closeSocket();
+}
+
+void WSReports::openSocket(const QString& address, quint16 port)
+{
+    m_webSocketServer = new QWebSocketServer(
+        QStringLiteral("Reports Server"),
+        QWebSocketServer::NonSecureMode,
+        this);
+
+    if (m_webSocketServer->listen(QHostAddress(address), port))
+    {
+        qDebug() << "WSReports::openSocket: reports server listening at " << address << " on port " << port;
+        connect(m_webSocketServer, &QWebSocketServer::newConnection, this, &WSReports::onNewConnection);
+    }
+    else
+    {
+        qInfo("WSReports::openSocket: cannot start reports server at %s on port %u", qPrintable(address), port);
+    }
+}
+
+void WSReports::closeSocket()
+{
+    m_timer.stop();
+    QList<Client*> clients = m_clients;
+    m_clients.clear();
+
+    for (Client *client : qAsConst(clients))
+    {
+        disconnect(client->m_socket, nullptr, this, nullptr);
+        client->m_socket->close();
+        client->m_socket->deleteLater();
+        delete client;
+    }
+
+    if (m_webSocketServer)
+    {
+        delete m_webSocketServer;
+        m_webSocketServer = nullptr;
+    }
+}
+
+bool WSReports::socketOpened()
+{
+    return m_webSocketServer && m_webSocketServer->isListening();
+}
+
+void WSReports::Client::setValue(const QString& key, const QStringList& values)
+{
+    if (key == "interval")
+    {
+        if (values.size() > 0) {
+            m_intervalMs = std::max(100, std::min(60000, values.first().toInt()));
+        }
+    }
+    else if (key == "subscribe")
+    {
+        m_subscriptions.clear();
+        m_sent.clear(); // full snapshot at next push
+
+        for (const QString& value : values)
+        {
+            for (const QString& path : value.split(',', QString::SkipEmptyParts)) {
+                m_subscriptions.append(path.trimmed().split('/', QString::SkipEmptyParts));
+            }
+        }
+    }
+}
+
+bool WSReports::Client::subscribed(const QString& path) const
+{
+    QStringList segments = path.split('/');
+
+    for (const QStringList& subscription : m_subscriptions)
+    {
+        if (subscription.size() != segments.size()) {
+            continue;
+        }
+
+        int i = 0;
+
+        for (; i < segments.size(); i++)
+        {
+            if ((subscription[i] != "*") && (subscription[i] != segments[i])) {
+                break;
+            }
+        }
+
+        if (i == segments.size()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+WSReports::Client *WSReports::findClient(QWebSocket *socket)
+{
+    for (Client *client : qAsConst(m_clients))
+    {
+        if (client->m_socket == socket) {
+            return client;
+        }
+    }
+
+    return nullptr;
+}
+
+void WSReports::onNewConnection()
+{
+    QWebSocket *pSocket = m_webSocketServer->nextPendingConnection();
+    qDebug() << "WSReports::onNewConnection: " << pSocket->peerAddress().toString() << ":" << pSocket->peerPort() << " connected";
+    pSocket->setParent(this);
+
+    connect(pSocket, &QWebSocket::textMessageReceived, this, &WSReports::processClientMessage);
+    connect(pSocket, &QWebSocket::disconnected, this, &WSReports::socketDisconnected);
+
+    Client *client = new Client(pSocket);
+    QUrlQuery query(pSocket->requestUrl());
+    client->setValue("interval", query.allQueryItemValues("interval"));
+    client->setValue("subscribe", query.allQueryItemValues("subscribe", QUrl::FullyDecoded));
+    m_clients.append(client);
+
+    if (!m_timer.isActive()) {
+        m_timer.start();
+    }
+}
+
+void WSReports::processClientMessage(const QString &message)
+{
+    Client *client = findClient(qobject_cast<QWebSocket *>(sender()));
+    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
+
+    if (!client || !doc.isObject())
+    {
+        qDebug() << "WSReports::processClientMessage: invalid message: " << message;
+        return;
+    }
+
+    QJsonObject jsonObject = doc.object();
+
+    for (QJsonObject::const_iterator it = jsonObject.begin(); it != jsonObject.end(); ++it)
+    {
+        QStringList values;
+
+        if (it.value().isArray())
+        {
+            for (const QJsonValue& value : it.value().toArray()) {
+                values.append(value.toString());
+            }
+        }
+        else
+        {
+            values.append(it.value().toVariant().toString());
+        }
+
+        client->setValue(it.key(), values);
+    }
+}
+
+void WSReports::socketDisconnected()
+{
+    QWebSocket *pSocket = qobject_cast<QWebSocket *>(sender());
+    Client *client = findClient(pSocket);
+
+    if (client)
+    {
+        qDebug() << "WSReports::socketDisconnected: " << pSocket->peerAddress().toString() << ":" << pSocket->peerPort() << " disconnected";
+        m_clients.removeAll(client);
+        delete client;
+        pSocket->deleteLater();
+    }
+
+    if (m_clients.isEmpty()) {
+        m_timer.stop();
+    }
+}
+
+void WSReports::tick()
+{
+    qint64 now = m_elapsed.elapsed();
+    QList<Client*> dueClients;
+
+    for (Client *client : qAsConst(m_clients))
+    {
+        if ((now - client->m_lastPushMs >= client->m_intervalMs) && !client->m_subscriptions.isEmpty()) {
+            dueClients.append(client);
+        }
+    }
+
+    if (dueClients.isEmpty()) {
+        return;
+    }
+
+    QStringList paths;
+    listPaths(paths);
+    m_reports.clear();
+    QByteArray header = "{\"timestamp\":" + QByteArray::number(QDateTime::currentMSecsSinceEpoch()) + ",\"reports\":{";
+
+    for (Client *client : qAsConst(dueClients))
+    {
+        QByteArray message = header;
+        QSet<QString> present;
+        bool changed = false;
+        client->m_lastPushMs = now;
+
+        for (const QString& path : qAsConst(paths))
+        {
+            if (!client->subscribed(path)) {
+                continue;
+            }
+
+            const QByteArray& report = getReport(path);
+
+            if (report.isEmpty()) {
+                continue;
+            }
+
+            present.insert(path);
+            QHash<QString, QByteArray>::iterator it = client->m_sent.find(path);
+
+            if ((it != client->m_sent.end()) && (*it == report)) {
+                continue;
+            }
+
+            message += "\"" + path.toUtf8() + "\":" + report + ",";
+            client->m_sent.insert(path, report);
+            changed = true;
+        }
+
+        for (QHash<QString, QByteArray>::iterator it = client->m_sent.begin(); it != client->m_sent.end();)
+        {
+            if (present.contains(it.key()))
+            {
+                ++it;
+            }
+            else
+            {
+                message += "\"" + it.key().toUtf8() + "\":null,";
+                it = client->m_sent.erase(it);
+                changed = true;
+            }
+        }
+
+        if (changed)
+        {
+            message.chop(1); // trailing comma
+            message += "}}";
+            client->m_socket->sendTextMessage(QString::fromUtf8(message));
+        }
+    }
+}
+
+void WSReports::listPaths(QStringList& paths)
+{
+    SWGSDRangel::SWGDeviceSetList deviceSetList;
+    SWGSDRangel::SWGErrorResponse error;
+
+    if (m_adapter->instanceDeviceSetsGet(deviceSetList, error) / 100 != 2) {
+        return;
+    }
+
+    QList<SWGSDRangel::SWGDeviceSet*> *deviceSets = deviceSetList.getDeviceSets();
+    int nbDeviceSets = deviceSets ? deviceSets->size() : 0;
+
+    for (int i = 0; i < nbDeviceSets; i++)
+    {
+        paths.append(QString("deviceset/%1/device").arg(i));
+        int nbChannels = deviceSets->at(i)->getChannelcount();
+
+        for (int j = 0; j < nbChannels; j++) {
+            paths.append(QString("deviceset/%1/channel/%2").arg(i).arg(j));
+        }
+    }
+}
+
+const QByteArray& WSReports::getReport(const QString& path)
+{
+    QHash<QString, QByteArray>::iterator it = m_reports.find(path);
+
+    if (it != m_reports.end()) {
+        return *it;
+    }
+
+    QStringList segments = path.split('/');
+    int deviceSetIndex = segments[1].toInt();
+    SWGSDRangel::SWGErrorResponse error;
+    QJsonObject *jsonObject = nullptr;
+
+    if (segments[2] == "device")
+    {
+        SWGSDRangel::SWGDeviceReport response;
+
+        if (m_adapter->devicesetDeviceReportGet(deviceSetIndex, response, error) / 100 == 2) {
+            jsonObject = response.asJsonObject();
+        }
+    }
+    else
+    {
+        SWGSDRangel::SWGChannelReport response;
+
+        if (m_adapter->devicesetChannelReportGet(deviceSetIndex, segments[3].toInt(), response, error) / 100 == 2) {
+            jsonObject = response.asJsonObject();
+        }
+    }
+
+    QByteArray report;
+
+    if (jsonObject)
+    {
+        report = QJsonDocument(*jsonObject).toJson(QJsonDocument::Compact);
+        delete jsonObject;
+    }
+
+    return *m_reports.insert(path, report);
+}
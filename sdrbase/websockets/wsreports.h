@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_WEBSOCKETS_WSREPORTS_H_
+#define SDRBASE_WEBSOCKETS_WSREPORTS_H_
+
+#include <QObject>
+#include <QList>
+#include <QHash>
+#include <QStringList>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHostAddress>
+
+#include "export.h"
+
+class QWebSocketServer;
+class QWebSocket;
+class WebAPIAdapterInterface;
+
+/**
+ * Web socket server pushing the channel and device reports of the Web API. Clients subscribe
+ * with the query of the request URL (ws://host:port/?interval=500&subscribe=deviceset/0/channel/*)
+ * or later with a JSON text message ({"interval": 500, "subscribe": ["deviceset/0/channel/*", "deviceset/0/device"]}):
+ * - subscribe: paths of the reports as in the REST API without the /sdrangel prefix and the /report
+ *   suffix: deviceset/{i}/channel/{j} and deviceset/{i}/device. Any segment can be a * wildcard
+ * - interval: minimum time between pushes in milliseconds (100 to 60000, default 1000)
+ *
+ * At each interval a client receives a JSON text message {"timestamp": ms since epoch, "reports": {path: report, ...}}
+ * with only the reports that changed since the previous push. A report that disappeared is null.
+ * Nothing is sent when nothing changed. Reports are obtained once per tick for all clients.
+ */
+class SDRBASE_API WSReports : public QObject
+{
+    Q_OBJECT
+public:
+    explicit WSReports(WebAPIAdapterInterface *adapter, QObject *parent = nullptr);
+    ~WSReports() override;
+
+    void openSocket(const QString& address, quint16 port);
+    void closeSocket();
+    bool socketOpened();
+
+    static const int m_tickMs = 100;
+
+private slots:
+    void onNewConnection();
+    void processClientMessage(const QString &message);
+    void socketDisconnected();
+    void tick();
+
+private:
+    struct Client
+    {
+        QWebSocket *m_socket;
+        QList<QStringList> m_subscriptions; //!< path segments
+        int m_intervalMs;
+        qint64 m_lastPushMs;
+        QHash<QString, QByteArray> m_sent; //!< last report sent for each path
+
+        Client(QWebSocket *socket) : m_socket(socket), m_intervalMs(1000), m_lastPushMs(0) {}
+        void setValue(const QString& key, const QStringList& values);
+        bool subscribed(const QString& path) const;
+    };
+
+    WebAPIAdapterInterface *m_adapter;
+    QWebSocketServer* m_webSocketServer;
+    QList<Client*> m_clients;
+    QTimer m_timer;
+    QElapsedTimer m_elapsed;
+    QHash<QString, QByteArray> m_reports; //!< reports of the current tick, empty when not available
+
+    Client *findClient(QWebSocket *socket);
+    void listPaths(QStringList& paths);
+    const QByteArray& getReport(const QString& path);
+};
+
+#endif // SDRBASE_WEBSOCKETS_WSREPORTS_H_
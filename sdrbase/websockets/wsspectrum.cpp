@@ -15,8 +15,14 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cmath>
+
 #include <QtWebSockets>
 #include <QHostAddress>
+#include <QUrlQuery>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QDebug>
 
 #include "wsspectrum.h"
@@ -33,6 +39,7 @@ WSSpectrum::WSSpectrum(QObject *parent) :
 WSSpectrum::~WSSpectrum()
 {
     closeSocket();
+    qDeleteAll(m_groups);
 }
 
 void WSSpectrum::openSocket()
@@ -72,6 +79,21 @@ QString WSSpectrum::getWebSocketIdentifier(QWebSocket *peer)
     return QStringLiteral("%1:%2").arg(peer->peerAddress().toString(), QString::number(peer->peerPort()));
 }
 
+void WSSpectrum::ClientSettings::setValue(const QString& key, const QString& value)
+{
+    if (key == "version") {
+        m_version = value.toInt() == 2 ? 2 : 1;
+    } else if (key == "fps") {
+        m_fps = std::max(1, std::min(25, value.toInt()));
+    } else if (key == "bins") {
+        m_nbBins = std::max(0, value.toInt());
+    } else if (key == "reduction") {
+        m_mean = value == "mean";
+    } else if (key == "delta") {
+        m_delta = (value == "1") || (value == "true");
+    }
+}
+
 void WSSpectrum::onNewConnection()
 {
     auto pSocket = m_webSocketServer->nextPendingConnection();
@@ -81,26 +103,101 @@ void WSSpectrum::onNewConnection()
     connect(pSocket, &QWebSocket::textMessageReceived, this, &WSSpectrum::processClientMessage);
     connect(pSocket, &QWebSocket::disconnected, this, &WSSpectrum::socketDisconnected);
 
-    m_clients << pSocket;
+    ClientSettings settings;
+    QUrlQuery query(pSocket->requestUrl());
+    QList<QPair<QString, QString>> items = query.queryItems();
+
+    for (const QPair<QString, QString>& item : items) {
+        settings.setValue(item.first, item.second);
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    addClient(pSocket, settings);
 }
 
 void WSSpectrum::processClientMessage(const QString &message)
 {
-     qDebug() << "WSSpectrum::processClientMessage: " << message;
+    qDebug() << "WSSpectrum::processClientMessage: " << message;
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
+
+    if (!pClient || !doc.isObject()) {
+        return;
+    }
+
+    QJsonObject jsonObject = doc.object();
+    QMutexLocker mutexLocker(&m_mutex);
+    ClientSettings settings = removeClient(pClient);
+
+    for (QJsonObject::const_iterator it = jsonObject.begin(); it != jsonObject.end(); ++it) {
+        settings.setValue(it.key(), it.value().toVariant().toString());
+    }
+
+    addClient(pClient, settings);
 }
 
 void WSSpectrum::socketDisconnected()
 {
     QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
-    qDebug() << getWebSocketIdentifier(pClient) << " disconnected";
 
     if (pClient)
     {
-        m_clients.removeAll(pClient);
+        qDebug() << getWebSocketIdentifier(pClient) << " disconnected";
+        QMutexLocker mutexLocker(&m_mutex);
+        removeClient(pClient);
         pClient->deleteLater();
     }
 }
 
+void WSSpectrum::addClient(QWebSocket *client, const ClientSettings& settings)
+{
+    ClientGroup *group = nullptr;
+
+    for (ClientGroup *g : qAsConst(m_groups))
+    {
+        if (g->m_settings == settings)
+        {
+            group = g;
+            break;
+        }
+    }
+
+    if (!group)
+    {
+        group = new ClientGroup(settings);
+        m_groups.append(group);
+    }
+
+    group->m_clients.append(client);
+    group->m_keyFrame = true; // the new client has no previous frame
+
+    qDebug("WSSpectrum::addClient: version: %d fps: %d bins: %d delta: %s groups: %d",
+        settings.m_version, settings.m_fps, settings.m_nbBins, settings.m_delta ? "yes" : "no", m_groups.size());
+}
+
+WSSpectrum::ClientSettings WSSpectrum::removeClient(QWebSocket *client)
+{
+    for (int i = 0; i < m_groups.size(); i++)
+    {
+        ClientGroup *group = m_groups[i];
+
+        if (group->m_clients.removeAll(client) > 0)
+        {
+            ClientSettings settings = group->m_settings;
+
+            if (group->m_clients.isEmpty())
+            {
+                m_groups.removeAt(i);
+                delete group;
+            }
+
+            return settings;
+        }
+    }
+
+    return ClientSettings();
+}
+
 void WSSpectrum::newSpectrum(
     const std::vector<Real>& spectrum,
     int fftSize,
@@ -111,29 +208,175 @@ void WSSpectrum::newSpectrum(
     bool linear
 )
 {
-    if (m_timer.elapsed() < 200) { // Max 5 frames per second
-        return;
+    QMutexLocker mutexLocker(&m_mutex);
+    qint64 now = m_timer.elapsed();
+    bool quantized = false;
+    // linear bins are quantized over the linear range the GUI displays: 0 to the reference level
+    float quantRefLevel = linear ? pow(10.0, refLevel/10.0) : refLevel;
+    float quantPowerRange = linear ? quantRefLevel : powerRange;
+
+    for (ClientGroup *group : qAsConst(m_groups))
+    {
+        qint64 elapsed = now - group->m_lastFrameMs;
+
+        if (elapsed < 1000 / group->m_settings.m_fps) {
+            continue;
+        }
+
+        group->m_lastFrameMs = now;
+        QByteArray payload;
+
+        if (group->m_settings.m_version == 2)
+        {
+            if (!quantized)
+            {
+                quantize(spectrum, fftSize, quantRefLevel, quantPowerRange);
+                quantized = true;
+            }
+
+            buildPayloadV2(
+                payload,
+                *group,
+                fftSize,
+                elapsed,
+                quantRefLevel,
+                quantPowerRange,
+                centerFrequency,
+                bandwidth,
+                linear
+            );
+        }
+        else
+        {
+            buildPayload(
+                payload,
+                spectrum,
+                fftSize,
+                elapsed,
+                refLevel,
+                powerRange,
+                centerFrequency,
+                bandwidth,
+                linear
+            );
+        }
+
+        //qDebug() << "WSSpectrum::newSpectrum: " << payload.size() << " bytes in " << elapsed << " ms";
+
+        for (QWebSocket *pClient : qAsConst(group->m_clients)) {
+            pClient->sendBinaryMessage(payload);
+        }
+    }
+}
+
+void WSSpectrum::quantize(const std::vector<Real>& spectrum, int fftSize, float refLevel, float powerRange)
+{
+    float bottom = refLevel - powerRange;
+    float scale = powerRange > 0.0f ? 255.0f / powerRange : 255.0f;
+    m_quantized.resize(fftSize);
+
+    for (int i = 0; i < fftSize; i++)
+    {
+        float v = (spectrum[i] - bottom) * scale + 0.5f;
+        m_quantized[i] = v < 0.0f ? 0 : v > 255.0f ? 255 : (quint8) v;
     }
+}
 
-    qint64 elapsed = m_timer.restart();
-    QWebSocket *pSender = qobject_cast<QWebSocket *>(sender());
-    QByteArray payload;
+void WSSpectrum::buildPayloadV2(
+    QByteArray& bytes,
+    ClientGroup& group,
+    int fftSize,
+    int64_t fftTimeMs,
+    float refLevel,
+    float powerRange,
+    uint64_t centerFrequency,
+    int bandwidth,
+    bool linear
+)
+{
+    const quint8 *bins = m_quantized.data();
+    quint32 nbBins = fftSize;
+    int maxBins = group.m_settings.m_nbBins;
+
+    if ((maxBins > 0) && (maxBins < fftSize))
+    {
+        // merge adjacent bins keeping the peak as the display would or the average
+        int factor = (fftSize + maxBins - 1) / maxBins;
+        nbBins = (fftSize + factor - 1) / factor;
+        m_bins.resize(nbBins);
+
+        for (quint32 b = 0; b < nbBins; b++)
+        {
+            int start = b * factor;
+            int end = std::min(start + factor, fftSize);
+
+            if (group.m_settings.m_mean)
+            {
+                int sum = 0;
+
+                for (int i = start; i < end; i++) {
+                    sum += m_quantized[i];
+                }
+
+                m_bins[b] = (sum + (end - start) / 2) / (end - start);
+            }
+            else
+            {
+                m_bins[b] = *std::max_element(&m_quantized[start], &m_quantized[0] + end);
+            }
+        }
+
+        bins = m_bins.data();
+    }
+
+    quint8 version = 2;
+    quint8 flags = linear ? 1 : 0;
+    quint16 reserved = 0;
+    quint32 fftSize32 = fftSize;
+    qint32 bandwidth32 = bandwidth;
+    QByteArray compressed;
+    const char *data = (const char*) bins;
+
+    if (group.m_settings.m_delta)
+    {
+        if (group.m_previous.size() != nbBins) {
+            group.m_keyFrame = true;
+        }
+
+        if (!group.m_keyFrame)
+        {
+            m_delta.resize(nbBins);
+
+            for (quint32 i = 0; i < nbBins; i++) {
+                m_delta[i] = bins[i] - group.m_previous[i]; // modulo 256
+            }
+
+            data = (const char*) m_delta.data();
+            flags |= 2;
+        }
+
+        compressed = qCompress((const uchar*) data, nbBins);
+        flags |= 4;
+        group.m_previous.assign(bins, bins + nbBins);
+        group.m_keyFrame = false;
+    }
 
-    buildPayload(
-        payload,
-        spectrum,
-        fftSize,
-        elapsed,
-        refLevel,
-        powerRange,
-        centerFrequency,
-        bandwidth,
-        linear
-    );
-    //qDebug() << "WSSpectrum::newSpectrum: " << payload.size() << " bytes in " << elapsed << " ms";
+    bytes.reserve(40 + (compressed.isEmpty() ? nbBins : compressed.size()));
+    bytes.append((const char*) &version, sizeof(quint8));
+    bytes.append((const char*) &flags, sizeof(quint8));
+    bytes.append((const char*) &reserved, sizeof(quint16));
+    bytes.append((const char*) &nbBins, sizeof(quint32));
+    bytes.append((const char*) &fftSize32, sizeof(quint32));
+    bytes.append((const char*) &fftTimeMs, sizeof(int64_t));
+    bytes.append((const char*) &refLevel, sizeof(float));
+    bytes.append((const char*) &powerRange, sizeof(float));
+    bytes.append((const char*) &centerFrequency, sizeof(uint64_t));
+    bytes.append((const char*) &bandwidth32, sizeof(qint32));
 
-    for (QWebSocket *pClient : qAsConst(m_clients)) {
-        pClient->sendBinaryMessage(payload);
+    if (compressed.isEmpty()) {
+        bytes.append(data, nbBins);
+    } else {
+        bytes.append(compressed);
     }
 }
 
@@ -149,16 +392,14 @@ void WSSpectrum::buildPayload(
     bool linear
 )
 {
-    QBuffer buffer(&bytes);
-    buffer.open(QIODevice::WriteOnly);
-    buffer.write((char*) &fftSize, sizeof(int));
-    buffer.write((char*) &fftTimeMs, sizeof(int64_t));
-    buffer.write((char*) &refLevel, sizeof(float));
-    buffer.write((char*) &powerRange, sizeof(float));
-    buffer.write((char*) &centerFrequency, sizeof(uint64_t));
-    buffer.write((char*) &bandwidth, sizeof(int));
     int linearInt = linear ? 1 : 0;
-    buffer.write((char*) &linearInt, sizeof(int));
-    buffer.write((char*) spectrum.data(), fftSize*sizeof(Real));
-    buffer.close();
+    bytes.reserve(2*sizeof(int64_t) + 3*sizeof(int) + 2*sizeof(float) + fftSize*sizeof(Real));
+    bytes.append((const char*) &fftSize, sizeof(int));
+    bytes.append((const char*) &fftTimeMs, sizeof(int64_t));
+    bytes.append((const char*) &refLevel, sizeof(float));
+    bytes.append((const char*) &powerRange, sizeof(float));
+    bytes.append((const char*) &centerFrequency, sizeof(uint64_t));
+    bytes.append((const char*) &bandwidth, sizeof(int));
+    bytes.append((const char*) &linearInt, sizeof(int));
+    bytes.append((const char*) spectrum.data(), fftSize*sizeof(Real));
 }
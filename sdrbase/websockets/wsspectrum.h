@@ -22,6 +22,7 @@
 
 #include <QObject>
 #include <QList>
+#include <QMutex>
 #include <QElapsedTimer>
 #include <QHostAddress>
 
@@ -32,6 +33,26 @@
 class QWebSocketServer;
 class QWebSocket;
 
+/**
+ * Spectrum web socket server. Each client chooses its payload at connection with the query of the
+ * request URL (ws://host:port/?version=2&fps=10&bins=1024&reduction=mean&delta=1) or later with a JSON text
+ * message with the same keys:
+ * - version: 1 (default) full resolution float bins. 2 bins quantized on 8 bits over the display range
+ * - fps: maximum frame rate (1 to 25, default 5)
+ * - bins: version 2 only: maximum number of bins. Adjacent bins are merged. 0 (default) for all bins
+ * - reduction: version 2 only: how adjacent bins are merged: max (default) for the peak or mean for the average
+ * - delta: version 2 only: 1 for zlib compressed differences to the previous frame sent
+ * Clients with the same parameters form a group that is sent the same payload encoded once.
+ *
+ * Version 2 payload (little endian):
+ * - uint8 version (2), uint8 flags (bit 0: linear, bit 1: delta frame, bit 2: qCompress'ed bins), uint16 reserved
+ * - uint32 number of bins, uint32 FFT size, int64 time since previous frame (ms)
+ * - float reference level, float power range, uint64 center frequency, int32 bandwidth
+ * - bins: value 0 is refLevel - powerRange and 255 is refLevel. Delta frames carry the difference
+ *   modulo 256 with the previous frame of the client.
+ * In linear mode the reference level and power range of the header are both the linear reference power:
+ * bins go from 0 (null power) to the reference level as in the GUI.
+ */
 class SDRBASE_API WSSpectrum : public QObject
 {
     Q_OBJECT
@@ -60,13 +81,57 @@ private slots:
     void socketDisconnected();
 
 private:
+    struct ClientSettings
+    {
+        int m_version;
+        int m_fps;
+        int m_nbBins; //!< 0 for all bins
+        bool m_mean;  //!< merge bins by average instead of peak
+        bool m_delta;
+
+        ClientSettings() : m_version(1), m_fps(5), m_nbBins(0), m_mean(false), m_delta(false) {}
+        bool operator==(const ClientSettings& other) const {
+            return (m_version == other.m_version) && (m_fps == other.m_fps) && (m_nbBins == other.m_nbBins) && (m_mean == other.m_mean) && (m_delta == other.m_delta);
+        }
+        void setValue(const QString& key, const QString& value);
+    };
+
+    struct ClientGroup
+    {
+        ClientSettings m_settings;
+        QList<QWebSocket*> m_clients;
+        qint64 m_lastFrameMs;
+        bool m_keyFrame;                 //!< next frame is not a delta (new client or FFT size change)
+        std::vector<quint8> m_previous;  //!< last frame sent for delta coding
+
+        ClientGroup(const ClientSettings& settings) : m_settings(settings), m_lastFrameMs(0), m_keyFrame(true) {}
+    };
+
     QHostAddress m_listeningAddress;
     quint16 m_port;
     QWebSocketServer* m_webSocketServer;
-    QList<QWebSocket*> m_clients;
+    QList<ClientGroup*> m_groups;
+    QMutex m_mutex;                      //!< groups between the socket thread and the spectrum thread
     QElapsedTimer m_timer;
+    std::vector<quint8> m_quantized;     //!< full resolution 8 bit bins shared by version 2 groups
+    std::vector<quint8> m_bins;
+    std::vector<quint8> m_delta;
 
     static QString getWebSocketIdentifier(QWebSocket *peer);
+    void addClient(QWebSocket *client, const ClientSettings& settings);
+    ClientSettings removeClient(QWebSocket *client);
+    void quantize(const std::vector<Real>& spectrum, int fftSize, float refLevel, float powerRange);
+    void buildPayloadV2(
+        QByteArray& bytes,
+        ClientGroup& group,
+        int fftSize,
+        int64_t fftTimeMs,
+        float refLevel,
+        float powerRange,
+        uint64_t centerFrequency,
+        int bandwidth,
+        bool linear
+    );
     void buildPayload(
         QByteArray& bytes,
         const std::vector<Real>& spectrum,
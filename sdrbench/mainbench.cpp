@@ -19,19 +19,70 @@
 
 #include <QDebug>
 #include <QElapsedTimer>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QFile>
+#include <QUdpSocket>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <ctime>
+#include <stdio.h>
 
 #include "ambe/ambeengine.h"
+#include "dsp/downchannelizer.h"
+#include "dsp/polyphasefilterbank.h"
+#include "dsp/dspengine.h"
+#include "dsp/samplesinkfifo.h"
+#include "dsp/filerecord.h"
+#include "dsp/samplecodec.h"
+#include "dsp/inthalfbandfilteravx2.h"
+#include "audio/audioresampler.h"
+#include "channel/remotedatablock.h"
+#include "util/udpbatch.h"
+#include "util/message.h"
+#include "util/messagepool.h"
+#include "util/messagequeue.h"
 
 #include "mainbench.h"
 
 MainBench *MainBench::m_instance = 0;
 
+// report sized messages for the message queue test
+class MsgBenchReport : public Message {
+    MESSAGE_CLASS_DECLARATION
+
+public:
+    MsgBenchReport(quint64 count) : Message(), m_count(count), m_value(0.0f) {}
+
+private:
+    quint64 m_count;
+    float m_value;
+};
+
+class MsgBenchPooledReport : public Message {
+    MESSAGE_CLASS_DECLARATION
+    MESSAGE_CLASS_POOL_DECLARATION
+
+public:
+    MsgBenchPooledReport(quint64 count) : Message(), m_count(count), m_value(0.0f) {}
+
+private:
+    quint64 m_count;
+    float m_value;
+};
+
+MESSAGE_CLASS_DEFINITION(MsgBenchReport, Message)
+MESSAGE_CLASS_DEFINITION(MsgBenchPooledReport, Message)
+MESSAGE_CLASS_POOL_DEFINITION(MsgBenchPooledReport)
+
 MainBench::MainBench(qtwebapp::LoggerWithFile *logger, const ParserBench& parser, QObject *parent) :
     QObject(parent),
     m_logger(logger),
     m_parser(parser),
     m_uniform_distribution_f(-1.0, 1.0),
-    m_uniform_distribution_s16(-2048, 2047)
+    m_uniform_distribution_s16(-2048, 2047),
+    m_csvHeaderPrinted(false)
 {
     qDebug() << "MainBench::MainBench: start";
     m_instance = this;
@@ -64,6 +115,36 @@ void MainBench::run()
         testDecimateFF();
     } else if (m_parser.getTestType() == ParserBench::TestAMBE) {
         testAMBE();
+    } else if (m_parser.getTestType() == ParserBench::TestDownChannelizer) {
+        testDownChannelizer();
+    } else if (m_parser.getTestType() == ParserBench::TestFilterBank) {
+        testFilterBank();
+    } else if (m_parser.getTestType() == ParserBench::TestSampleSinkFifo) {
+        testSampleSinkFifo();
+    } else if (m_parser.getTestType() == ParserBench::TestInterpolator) {
+        testInterpolator();
+    } else if (m_parser.getTestType() == ParserBench::TestFFTFilt) {
+        testFFTFilt(false);
+    } else if (m_parser.getTestType() == ParserBench::TestFFTFiltSSB) {
+        testFFTFilt(true);
+    } else if (m_parser.getTestType() == ParserBench::TestNCO) {
+        testNCO();
+    } else if ((m_parser.getTestType() == ParserBench::TestNFMDemod)
+            || (m_parser.getTestType() == ParserBench::TestSSBDemod)
+            || (m_parser.getTestType() == ParserBench::TestBFMDemod)) {
+        testDemodSink(m_parser.getTestType());
+    } else if (m_parser.getTestType() == ParserBench::TestSpectrumVis) {
+        testSpectrumVis();
+    } else if (m_parser.getTestType() == ParserBench::TestLoRaDemod) {
+        testLoRaDemod();
+    } else if (m_parser.getTestType() == ParserBench::TestSampleCodec) {
+        testSampleCodec();
+    } else if (m_parser.getTestType() == ParserBench::TestUDPBatch) {
+        testUDPBatch();
+    } else if (m_parser.getTestType() == ParserBench::TestMessageQueue) {
+        testMessageQueue();
+    } else if (m_parser.getTestType() == ParserBench::TestAudioResampler) {
+        testAudioResampler();
     } else {
         qDebug() << "MainBench::run: unknown test type: " << m_parser.getTestType();
     }
@@ -73,9 +154,6 @@ void MainBench::run()
 
 void MainBench::testDecimateII(ParserBench::TestType testType)
 {
-    QElapsedTimer timer;
-    qint64 nsecs = 0;
-
     qDebug() << "MainBench::testDecimateII: create test data";
 
     qint16 *buf = new qint16[m_parser.getNbSamples()*2];
@@ -85,6 +163,28 @@ void MainBench::testDecimateII(ParserBench::TestType testType)
 
     qDebug() << "MainBench::testDecimateII: run test";
 
+    IntHalfbandFilterAVX2::setEnabled(false);
+    printResults("MainBench::testDecimateII: scalar", runDecimateII(testType, buf));
+
+    if (IntHalfbandFilterAVX2::isSupported())
+    {
+        IntHalfbandFilterAVX2::setEnabled(true);
+        printResults("MainBench::testDecimateII: AVX2", runDecimateII(testType, buf));
+    }
+    else
+    {
+        qInfo("MainBench::testDecimateII: AVX2 not supported by this CPU");
+    }
+
+    qDebug() << "MainBench::testDecimateII: cleanup test data";
+    delete[] buf;
+}
+
+qint64 MainBench::runDecimateII(ParserBench::TestType testType, const qint16 *buf)
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+
     for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
     {
         switch (testType)
@@ -108,10 +208,7 @@ void MainBench::testDecimateII(ParserBench::TestType testType)
         }
     }
 
-    printResults("MainBench::testDecimateII", nsecs);
-
-    qDebug() << "MainBench::testDecimateII: cleanup test data";
-    delete[] buf;
+    return nsecs;
 }
 
 void MainBench::testDecimateIF()
@@ -207,6 +304,581 @@ void MainBench::testAMBE()
     }
 }
 
+class BenchChannelSink : public ChannelSampleSink
+{
+public:
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end) {
+        m_samples.insert(m_samples.end(), begin, end);
+    }
+    SampleVector m_samples;
+};
+
+void MainBench::testDownChannelizer()
+{
+    QElapsedTimer timer;
+    qint64 nsecsSample = 0;
+    qint64 nsecsBlock = 0;
+    const int chunkSize = 4096; // typical device engine block
+    // filter chain hash all centers: base 3 number with all digits set to 1
+    unsigned int chainHash = 0;
+
+    for (unsigned int i = 0; i < m_parser.getLog2Factor(); i++) {
+        chainHash = 3*chainHash + 1;
+    }
+
+    qDebug() << "MainBench::testDownChannelizer: create test data";
+
+    SampleVector buf(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (SampleVector::iterator it = buf.begin(); it != buf.end(); ++it)
+    {
+        it->setReal(my_rand() << (SDR_RX_SAMP_SZ - 12));
+        it->setImag(my_rand() << (SDR_RX_SAMP_SZ - 12));
+    }
+
+    BenchChannelSink sinkSample, sinkBlock;
+    DownChannelizer channelizerSample(&sinkSample);
+    DownChannelizer channelizerBlock(&sinkBlock);
+    channelizerSample.setBlockMode(false);
+    channelizerBlock.setBlockMode(true);
+    channelizerSample.setDecimation(m_parser.getLog2Factor(), chainHash);
+    channelizerBlock.setDecimation(m_parser.getLog2Factor(), chainHash);
+    bool identical = true;
+
+    qDebug() << "MainBench::testDownChannelizer: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        sinkSample.m_samples.clear();
+        sinkBlock.m_samples.clear();
+
+        for (int j = 0; j < (int) buf.size(); j += chunkSize)
+        {
+            SampleVector::const_iterator begin = buf.begin() + j;
+            SampleVector::const_iterator end = buf.begin() + std::min(j + chunkSize, (int) buf.size());
+            timer.start();
+            channelizerSample.feed(begin, end);
+            nsecsSample += timer.nsecsElapsed();
+            timer.start();
+            channelizerBlock.feed(begin, end);
+            nsecsBlock += timer.nsecsElapsed();
+        }
+
+        identical = identical
+            && (sinkSample.m_samples.size() == sinkBlock.m_samples.size())
+            && std::equal(sinkSample.m_samples.begin(), sinkSample.m_samples.end(), sinkBlock.m_samples.begin(),
+                [](const Sample& a, const Sample& b) { return (a.m_real == b.m_real) && (a.m_imag == b.m_imag); });
+    }
+
+    printResults("MainBench::testDownChannelizer: sample", nsecsSample);
+    printResults("MainBench::testDownChannelizer: block", nsecsBlock);
+    qInfo("MainBench::testDownChannelizer: block output %s sample output", identical ? "identical to" : "DIFFERS from");
+}
+
+void MainBench::testFilterBank()
+{
+    QElapsedTimer timer;
+    qint64 nsecsDirect = 0;
+    qint64 nsecsFilterBank = 0;
+    const int chunkSize = 4096;
+    const int basebandSampleRate = 6400000;
+    const unsigned int nbSubbands = 64;  // 100 kHz spacing
+    const int nbChannels = 8;
+    const int channelSampleRate = 48000;
+    const int subbandSampleRate = (2 * basebandSampleRate) / nbSubbands;
+
+    if (!DSPEngine::instance()->getFFTFactory()) {
+        DSPEngine::instance()->createFFTFactory(QString());
+    }
+
+    qDebug() << "MainBench::testFilterBank: create test data";
+
+    SampleVector buf(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (SampleVector::iterator it = buf.begin(); it != buf.end(); ++it)
+    {
+        it->setReal(my_rand() << (SDR_RX_SAMP_SZ - 12));
+        it->setImag(my_rand() << (SDR_RX_SAMP_SZ - 12));
+    }
+
+    // channels spread over the baseband each one with a small residual offset from its sub-band center
+    std::vector<BenchChannelSink> sinksDirect(nbChannels), sinksSubband(nbChannels);
+    std::vector<DownChannelizer*> channelizersDirect, channelizersSubband;
+    PolyphaseFilterBank filterBank;
+    filterBank.create(nbSubbands);
+    std::vector<SampleVector> outputs(nbSubbands);
+    std::vector<SampleVector*> outputPointers(nbSubbands, nullptr);
+
+    for (int c = 0; c < nbChannels; c++)
+    {
+        int subband = 1 + c * 7;
+        qint64 residualOffset = 12500 * (c - nbChannels/2);
+        qint64 offset = (subband < (int) nbSubbands/2 ? subband : subband - (int) nbSubbands) * (qint64) (basebandSampleRate / nbSubbands) + residualOffset;
+        channelizersDirect.push_back(new DownChannelizer(&sinksDirect[c]));
+        channelizersDirect.back()->setBasebandSampleRate(basebandSampleRate);
+        channelizersDirect.back()->setChannelization(channelSampleRate, offset);
+        channelizersSubband.push_back(new DownChannelizer(&sinksSubband[c]));
+        channelizersSubband.back()->setBasebandSampleRate(subbandSampleRate);
+        channelizersSubband.back()->setChannelization(channelSampleRate, residualOffset);
+        outputPointers[subband] = &outputs[subband];
+    }
+
+    qDebug() << "MainBench::testFilterBank: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        for (int j = 0; j < (int) buf.size(); j += chunkSize)
+        {
+            SampleVector::const_iterator begin = buf.begin() + j;
+            SampleVector::const_iterator end = buf.begin() + std::min(j + chunkSize, (int) buf.size());
+
+            timer.start();
+
+            for (int c = 0; c < nbChannels; c++) {
+                channelizersDirect[c]->feed(begin, end);
+            }
+
+            nsecsDirect += timer.nsecsElapsed();
+            timer.start();
+            filterBank.feed(begin, end, outputPointers.data());
+
+            for (int c = 0; c < nbChannels; c++)
+            {
+                SampleVector& subbandSamples = outputs[1 + c * 7];
+                channelizersSubband[c]->feed(subbandSamples.begin(), subbandSamples.end());
+                subbandSamples.clear();
+            }
+
+            nsecsFilterBank += timer.nsecsElapsed();
+        }
+
+        for (int c = 0; c < nbChannels; c++)
+        {
+            sinksDirect[c].m_samples.clear();
+            sinksSubband[c].m_samples.clear();
+        }
+    }
+
+    for (int c = 0; c < nbChannels; c++)
+    {
+        delete channelizersDirect[c];
+        delete channelizersSubband[c];
+    }
+
+    printResults(QString("MainBench::testFilterBank: %1 channels direct").arg(nbChannels), nsecsDirect);
+    printResults(QString("MainBench::testFilterBank: %1 channels filter bank").arg(nbChannels), nsecsFilterBank);
+}
+
+void MainBench::testSampleSinkFifo()
+{
+    qDebug() << "MainBench::testSampleSinkFifo: run test";
+
+    printResults("MainBench::testSampleSinkFifo: locked", runSampleSinkFifo(false));
+    printResults("MainBench::testSampleSinkFifo: lock-free", runSampleSinkFifo(true));
+}
+
+qint64 MainBench::runSampleSinkFifo(bool lockFree)
+{
+    // A writer thread pushes device sized blocks while this thread reads them as a baseband does.
+    // Both sides poll fill() continuously so that they contend on the FIFO.
+    const unsigned int blockSize = 4096;
+    const quint64 total = (quint64) m_parser.getNbSamples() * m_parser.getRepetition();
+    SampleSinkFifo fifo(SampleSinkFifo::getSizePolicy(4800000));
+    fifo.setLockFree(lockFree);
+    SampleVector block(blockSize);
+    QElapsedTimer timer;
+    timer.start();
+
+    std::thread writer([&]() {
+        quint64 written = 0;
+
+        while (written < total)
+        {
+            unsigned int count = std::min((quint64) blockSize, total - written);
+
+            if (fifo.size() - fifo.fill() >= count) {
+                written += fifo.write(block.begin(), block.begin() + count);
+            }
+        }
+    });
+
+    quint64 read = 0;
+
+    while (read < total)
+    {
+        SampleVector::iterator part1begin;
+        SampleVector::iterator part1end;
+        SampleVector::iterator part2begin;
+        SampleVector::iterator part2end;
+
+        if (fifo.fill() == 0) {
+            continue;
+        }
+
+        unsigned int count = fifo.readBegin(fifo.fill(), &part1begin, &part1end, &part2begin, &part2end);
+        read += fifo.readCommit(count);
+    }
+
+    writer.join();
+
+    return timer.nsecsElapsed();
+}
+
+void MainBench::testSampleCodec()
+{
+    QElapsedTimer timer;
+    SampleVector samples(m_parser.getNbSamples());
+
+    if (m_parser.getFileName().isEmpty() || !readRecordFile(samples))
+    {
+        qDebug() << "MainBench::testSampleCodec: create test data";
+        generateFM(samples, 1000000, 5000);
+    }
+
+    unsigned int nbSamples = samples.size();
+    unsigned int blockSamples = SampleCodec::m_losslessBlockSamples;
+    unsigned int nbBlocks = (nbSamples + blockSamples - 1) / blockSamples;
+    std::vector<quint8> packed(nbSamples * SampleCodec::m_packed12Bytes);
+    std::vector<quint8> lossless(nbBlocks * SampleCodec::getLosslessMaxBlockBytes(blockSamples));
+    std::vector<quint64> blockOffsets;
+    SampleVector decoded(nbSamples);
+    quint64 losslessBytes = 0;
+    qint64 nsecsPackedEncode = 0, nsecsPackedDecode = 0, nsecsLosslessEncode = 0, nsecsLosslessDecode = 0;
+
+    qDebug() << "MainBench::testSampleCodec: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+        SampleCodec::encodePacked12(samples.data(), nbSamples, packed.data());
+        nsecsPackedEncode += timer.nsecsElapsed();
+
+        timer.start();
+        SampleCodec::decodePacked12(packed.data(), nbSamples, decoded.data());
+        nsecsPackedDecode += timer.nsecsElapsed();
+
+        timer.start();
+        losslessBytes = 0;
+
+        for (unsigned int j = 0; j < nbSamples; j += blockSamples) {
+            losslessBytes += SampleCodec::encodeLosslessBlock(&samples[j], std::min(blockSamples, nbSamples - j), &lossless[losslessBytes]);
+        }
+
+        nsecsLosslessEncode += timer.nsecsElapsed();
+
+        timer.start();
+        SampleCodec::indexLosslessBlocks(lossless.data(), losslessBytes, blockOffsets);
+
+        for (unsigned int j = 0; j < blockOffsets.size(); j++) {
+            SampleCodec::decodeLosslessBlock(&lossless[blockOffsets[j]], losslessBytes - blockOffsets[j], &decoded[j * blockSamples], blockSamples, 0);
+        }
+
+        nsecsLosslessDecode += timer.nsecsElapsed();
+    }
+
+    quint64 total = (quint64) nbSamples * m_parser.getRepetition();
+    bool losslessOK = std::equal(samples.begin(), samples.end(), decoded.begin(), [](const Sample& a, const Sample& b) {
+        return (a.m_real == b.m_real) && (a.m_imag == b.m_imag);
+    });
+
+    printResults("MainBench::testSampleCodec: packed12 encode", nsecsPackedEncode, total);
+    printResults("MainBench::testSampleCodec: packed12 decode", nsecsPackedDecode, total);
+    printResults("MainBench::testSampleCodec: lossless encode", nsecsLosslessEncode, total);
+    printResults("MainBench::testSampleCodec: lossless decode", nsecsLosslessDecode, total);
+    qInfo("MainBench::testSampleCodec: %u bits samples: packed12 ratio: %.3f lossless ratio: %.3f lossless check: %s",
+        SDR_RX_SAMP_SZ,
+        (double) sizeof(Sample) / SampleCodec::m_packed12Bytes,
+        losslessBytes == 0 ? 0.0 : (double) nbSamples * sizeof(Sample) / losslessBytes,
+        losslessOK ? "OK" : "KO");
+}
+
+bool MainBench::readRecordFile(SampleVector& samples)
+{
+    QFile file(m_parser.getFileName());
+    FileRecord::Header header;
+    quint8 headerBytes[sizeof(FileRecord::Header)];
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "MainBench::readRecordFile: cannot open" << m_parser.getFileName();
+        return false;
+    }
+
+    if ((file.read((char *) headerBytes, sizeof(FileRecord::Header)) != sizeof(FileRecord::Header))
+     || !FileRecord::readHeader(headerBytes, header)
+     || ((header.sampleSize != 16) && (header.sampleSize != 24)))
+    {
+        qWarning() << "MainBench::readRecordFile: not a 16 or 24 bits record file" << m_parser.getFileName();
+        return false;
+    }
+
+    unsigned int sampleBytes = header.sampleSize == 24 ? 8 : 4;
+    QByteArray data = file.read((qint64) samples.size() * sampleBytes);
+    samples.resize(data.size() / sampleBytes);
+
+    for (unsigned int i = 0; i < samples.size(); i++)
+    {
+        qint32 re, im;
+
+        if (header.sampleSize == 24)
+        {
+            re = ((const qint32 *) data.constData())[2*i];
+            im = ((const qint32 *) data.constData())[2*i+1];
+        }
+        else
+        {
+            re = ((const qint16 *) data.constData())[2*i];
+            im = ((const qint16 *) data.constData())[2*i+1];
+        }
+
+        // to the sample size of this build
+        int shift = SDR_RX_SAMP_SZ - (int) header.sampleSize;
+        samples[i].m_real = (FixReal) (shift >= 0 ? re * (1 << shift) : re >> -shift);
+        samples[i].m_imag = (FixReal) (shift >= 0 ? im * (1 << shift) : im >> -shift);
+    }
+
+    qDebug() << "MainBench::readRecordFile:" << samples.size() << "samples of" << header.sampleSize << "bits at" << header.sampleRate << "S/s";
+
+    return samples.size() != 0;
+}
+
+void MainBench::testUDPBatch()
+{
+    // samples carried by the data blocks of a remote sink stream
+    unsigned int samplesPerBlock = RemoteNbBytesPerBlock / sizeof(Sample);
+    unsigned int nbBlocks = (m_parser.getNbSamples() + samplesPerBlock - 1) / samplesPerBlock;
+
+    qDebug() << "MainBench::testUDPBatch: run test:" << nbBlocks << "blocks of" << RemoteUdpSize << "bytes"
+        << "batch supported:" << UDPBatch::isBatchSupported();
+
+    for (int batch = 0; batch < 2; batch++)
+    {
+        quint64 received = 0, sent = 0;
+        qint64 nsecs = 0, cpuNsecs = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++) {
+            nsecs += runUDPBatch(batch != 0, nbBlocks, sent, received, cpuNsecs);
+        }
+
+        QString prefix = QString("MainBench::testUDPBatch: %1").arg(batch ? "sendmmsg/recvmmsg" : "QUdpSocket");
+        printResults(prefix, nsecs, received * samplesPerBlock);
+        qInfo("%s: CPU: %.1f%% received: %llu/%llu blocks",
+            qPrintable(prefix),
+            nsecs == 0 ? 0.0 : (100.0 * cpuNsecs) / nsecs,
+            received, sent);
+    }
+}
+
+qint64 MainBench::runUDPBatch(bool batch, unsigned int nbBlocks, quint64& sent, quint64& received, qint64& cpuNsecs)
+{
+    // A sender thread sends frames of blocks as fast as it can on the loopback while this thread reads them
+    // as the remote input does. Time runs until the last block is received.
+    QUdpSocket rxSocket;
+
+    if (!rxSocket.bind(QHostAddress::LocalHost, 0))
+    {
+        qWarning() << "MainBench::runUDPBatch: cannot bind:" << rxSocket.errorString();
+        return 0;
+    }
+
+    rxSocket.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 8*1024*1024);
+    quint16 port = rxSocket.localPort();
+    std::vector<RemoteSuperBlock> txBlocks(RemoteNbOrginalBlocks);
+    std::vector<char> rxBuffer(RemoteUdpSize * UDPBatch::m_maxBatchSize);
+    std::vector<int> rxSizes(UDPBatch::m_maxBatchSize);
+    std::atomic<bool> done(false);
+    std::atomic<quint64> txCount(0);
+    qint64 nsecs = 0;
+
+    for (auto& block : txBlocks) {
+        block.init();
+    }
+
+    QElapsedTimer timer;
+    std::clock_t cpuStart = std::clock();
+    timer.start();
+
+    std::thread sender([&]() {
+        QUdpSocket txSocket;
+
+        for (unsigned int i = 0; i < nbBlocks; i += RemoteNbOrginalBlocks)
+        {
+            int count = std::min((unsigned int) RemoteNbOrginalBlocks, nbBlocks - i);
+            txCount += UDPBatch::writeDatagrams(&txSocket, (const char*) txBlocks.data(), RemoteUdpSize, count,
+                QHostAddress::LocalHost, port, batch);
+        }
+
+        done = true;
+    });
+
+    while (true)
+    {
+        if (!rxSocket.waitForReadyRead(100))
+        {
+            if (done) {
+                break;
+            } else {
+                continue;
+            }
+        }
+
+        int nbDatagrams;
+
+        while ((nbDatagrams = UDPBatch::readDatagrams(&rxSocket, rxBuffer.data(), RemoteUdpSize, UDPBatch::m_maxBatchSize,
+            rxSizes.data(), nullptr, batch)) > 0)
+        {
+            received += nbDatagrams;
+        }
+
+        nsecs = timer.nsecsElapsed();
+    }
+
+    sender.join();
+    sent += txCount;
+    cpuNsecs += (qint64) ((std::clock() - cpuStart) * (1e9 / CLOCKS_PER_SEC));
+
+    return nsecs;
+}
+
+void MainBench::testMessageQueue()
+{
+    quint64 nbMessages = m_parser.getNbSamples();
+    qDebug() << "MainBench::testMessageQueue: run test:" << nbMessages << "messages";
+
+    for (int nbProducers = 1; nbProducers <= 4; nbProducers *= 2)
+    {
+        for (int pooled = 0; pooled < 2; pooled++)
+        {
+            qint64 nsecs = 0;
+
+            for (uint32_t i = 0; i < m_parser.getRepetition(); i++) {
+                nsecs += runMessageQueue(nbProducers, pooled != 0, nbMessages);
+            }
+
+            printResults(QString("MainBench::testMessageQueue: %1 producers %2")
+                    .arg(nbProducers).arg(pooled ? "pooled" : "heap"),
+                nsecs, nbMessages * m_parser.getRepetition());
+        }
+    }
+}
+
+qint64 MainBench::runMessageQueue(int nbProducers, bool pooled, quint64 nbMessages)
+{
+    // Producer threads push report messages while this thread polls isEmpty() and pops and deletes
+    // them as a DSP loop handling its input messages does.
+    MessageQueue queue;
+    std::vector<std::thread> producers;
+    quint64 perProducer = nbMessages / nbProducers;
+    quint64 total = perProducer * nbProducers;
+    quint64 popped = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int p = 0; p < nbProducers; p++)
+    {
+        producers.push_back(std::thread([&queue, pooled, perProducer]() {
+            for (quint64 i = 0; i < perProducer; i++)
+            {
+                if (pooled) {
+                    queue.push(new MsgBenchPooledReport(i), false);
+                } else {
+                    queue.push(new MsgBenchReport(i), false);
+                }
+            }
+        }));
+    }
+
+    while (popped < total)
+    {
+        if (queue.isEmpty()) {
+            continue;
+        }
+
+        Message *message;
+
+        while ((message = queue.pop()) != nullptr)
+        {
+            delete message;
+            popped++;
+        }
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    return nsecs;
+}
+
+void MainBench::testAudioResampler()
+{
+    QElapsedTimer timer;
+    const unsigned int blockFrames = 960; // 20ms at 48 kS/s
+    const int rates[][2] = {{48000, 8000}, {48000, 16000}, {44100, 48000}, {8000, 48000}};
+
+    qDebug() << "MainBench::testAudioResampler: create test data";
+
+    std::vector<qint16> buf(2 * m_parser.getNbSamples());
+    std::vector<qint16> out;
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+
+    for (std::vector<qint16>::iterator it = buf.begin(); it != buf.end(); ++it) {
+        *it = (qint16) (my_rand() * 16384.0f);
+    }
+
+    qDebug() << "MainBench::testAudioResampler: run test";
+
+    for (int r = 0; r < 4; r++)
+    {
+        for (int stereo = 0; stereo < 2; stereo++)
+        {
+            AudioResampler resampler;
+            resampler.setRates(rates[r][0], rates[r][1], stereo != 0);
+            unsigned int nbFrames = stereo ? m_parser.getNbSamples() : 2 * m_parser.getNbSamples();
+            qint64 nsecs = 0;
+
+            for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+            {
+                timer.start();
+
+                for (unsigned int f = 0; f + blockFrames <= nbFrames; f += blockFrames) {
+                    resampler.resample(&buf[f * (stereo ? 2 : 1)], blockFrames, out);
+                }
+
+                nsecs += timer.nsecsElapsed();
+            }
+
+            printResults(QString("MainBench::testAudioResampler: %1 -> %2 %3")
+                .arg(rates[r][0]).arg(rates[r][1]).arg(stereo ? "stereo" : "mono"),
+                nsecs, (quint64) nbFrames * m_parser.getRepetition());
+        }
+    }
+
+    // former per sample decimation through the biquad filter
+    AudioResampler resampler;
+    resampler.setDecimation(6);
+    resampler.setAudioFilters(48000, 8000, 300, 3300);
+    qint64 nsecs = 0;
+    qint16 sampleOut;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (unsigned int f = 0; f < 2 * m_parser.getNbSamples(); f++) {
+            resampler.downSample(buf[f], sampleOut);
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testAudioResampler: 48000 -> 8000 mono per sample", nsecs, (quint64) 2 * m_parser.getNbSamples() * m_parser.getRepetition());
+}
+
 void MainBench::decimateII(const qint16* buf, int len)
 {
     SampleVector::iterator it = m_convertBuffer.begin();
@@ -401,8 +1073,53 @@ void MainBench::decimateFF(const float *buf, int len)
 
 void MainBench::printResults(const QString& prefix, qint64 nsecs)
 {
-    double ratekSs = (m_parser.getNbSamples()*m_parser.getRepetition() / (double) nsecs) * 1e6;
-    QDebug info = qInfo();
-    info.noquote();
-    info << tr("%1: ran test in %L2 ns - sample rate: %3 kS/s").arg(prefix).arg(nsecs).arg(ratekSs);
+    printResults(prefix, nsecs, (quint64) m_parser.getNbSamples() * m_parser.getRepetition());
+}
+
+void MainBench::printResults(const QString& prefix, qint64 nsecs, quint64 nbSamples)
+{
+    double nsPerSample = nbSamples == 0 ? 0.0 : nsecs / (double) nbSamples;
+    double rateMSs = nsecs == 0 ? 0.0 : (nbSamples / (double) nsecs) * 1e3;
+
+    if (m_parser.getOutputFormat() == ParserBench::OutputCSV)
+    {
+        if (!m_csvHeaderPrinted)
+        {
+            fprintf(stdout, "test,case,samples,repetition,log2,nsecs,ns_per_sample,msps\n");
+            m_csvHeaderPrinted = true;
+        }
+
+        QString line = QString("%1,\"%2\",%3,%4,%5,%6,%7,%8")
+            .arg(m_parser.getTestStr())
+            .arg(prefix)
+            .arg(nbSamples)
+            .arg(m_parser.getRepetition())
+            .arg(m_parser.getLog2Factor())
+            .arg(nsecs)
+            .arg(nsPerSample, 0, 'f', 3)
+            .arg(rateMSs, 0, 'f', 3);
+        fprintf(stdout, "%s\n", qPrintable(line));
+        fflush(stdout);
+    }
+    else if (m_parser.getOutputFormat() == ParserBench::OutputJSON)
+    {
+        QJsonObject result;
+        result.insert("test", m_parser.getTestStr());
+        result.insert("case", prefix);
+        result.insert("samples", (qint64) nbSamples);
+        result.insert("repetition", (int) m_parser.getRepetition());
+        result.insert("log2", (int) m_parser.getLog2Factor());
+        result.insert("nsecs", nsecs);
+        result.insert("nsPerSample", nsPerSample);
+        result.insert("msps", rateMSs);
+        fprintf(stdout, "%s\n", QJsonDocument(result).toJson(QJsonDocument::Compact).constData());
+        fflush(stdout);
+    }
+    else
+    {
+        QDebug info = qInfo();
+        info.noquote();
+        info << tr("%1: ran test in %L2 ns - %3 samples - %4 ns/S - %5 MS/s")
+            .arg(prefix).arg(nsecs).arg(nbSamples).arg(nsPerSample, 0, 'f', 3).arg(rateMSs, 0, 'f', 3);
+    }
 }
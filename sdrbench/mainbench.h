@@ -49,10 +49,31 @@ signals:
 
 private:
     void testDecimateII(ParserBench::TestType testType = ParserBench::TestDecimatorsII);
+    qint64 runDecimateII(ParserBench::TestType testType, const qint16 *buf);
     void testDecimateIF();
     void testDecimateFI();
     void testDecimateFF();
     void testAMBE();
+    void testDownChannelizer();
+    void testFilterBank();
+    void testSampleSinkFifo();
+    qint64 runSampleSinkFifo(bool lockFree);
+    void testInterpolator();
+    void testFFTFilt(bool ssb);
+    qint64 runFFTFilt(bool ssb, int fftLength, const std::vector<std::complex<float>>& buf);
+    void testNCO();
+    void testDemodSink(ParserBench::TestType testType);
+    void generateFM(SampleVector& samples, int sampleRate, int deviation);
+    void testSpectrumVis();
+    void testLoRaDemod();
+    void generateLoRaSymbol(Sample *samples, unsigned int symbol, unsigned int nbSymbolBins);
+    void testSampleCodec();
+    bool readRecordFile(SampleVector& samples);
+    void testUDPBatch();
+    qint64 runUDPBatch(bool batch, unsigned int nbBlocks, quint64& sent, quint64& received, qint64& cpuNsecs);
+    void testMessageQueue();
+    qint64 runMessageQueue(int nbProducers, bool pooled, quint64 nbMessages);
+    void testAudioResampler();
     void decimateII(const qint16 *buf, int len);
     void decimateInfII(const qint16 *buf, int len);
     void decimateSupII(const qint16 *buf, int len);
@@ -60,6 +81,7 @@ private:
     void decimateFI(const float *buf, int len);
     void decimateFF(const float *buf, int len);
     void printResults(const QString& prefix, qint64 nsecs);
+    void printResults(const QString& prefix, qint64 nsecs, quint64 nbSamples);
 
     static MainBench *m_instance;
     qtwebapp::LoggerWithFile *m_logger;
@@ -75,6 +97,7 @@ private:
 
     SampleVector m_convertBuffer;
     FSampleVector m_convertBufferF;
+    bool m_csvHeaderPrinted;
 };
 
 #endif // SDRBENCH_MAINBENCH_H_
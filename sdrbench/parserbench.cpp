@@ -24,7 +24,7 @@
 
 ParserBench::ParserBench() :
     m_testOption(QStringList() << "t" << "test",
-        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe",
+        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe, downchannelizer, samplesinkfifo, interpolator, fftfilt, fftfiltssb, nco, nfmdemod, ssbdemod, bfmdemod, spectrumvis, filterbank, lorademod, samplecodec, udpbatch, messagequeue, audioresampler",
         "test",
         "decimateii"),
     m_nbSamplesOption(QStringList() << "n" << "nb-samples",
@@ -38,12 +38,21 @@ ParserBench::ParserBench() :
     m_log2FactorOption(QStringList() << "l" << "log2-factor",
         "Log2 factor for rate conversion.",
         "log2",
-        "2")
+        "2"),
+    m_outputFormatOption(QStringList() << "f" << "format",
+        "Results output format: text, csv, json.",
+        "format",
+        "text"),
+    m_fileOption(QStringList() << "i" << "input",
+        "Input record file (.sdriq) for tests on real samples.",
+        "file",
+        "")
 {
     m_testStr = "decimateii";
     m_nbSamples = 1048576;
     m_repetition = 1;
     m_log2Factor = 4;
+    m_outputFormat = OutputText;
 
     m_parser.setApplicationDescription("Software Defined Radio application benchmarks");
     m_parser.addHelpOption();
@@ -53,6 +62,8 @@ ParserBench::ParserBench() :
     m_parser.addOption(m_nbSamplesOption);
     m_parser.addOption(m_repetitionOption);
     m_parser.addOption(m_log2FactorOption);
+    m_parser.addOption(m_outputFormatOption);
+    m_parser.addOption(m_fileOption);
 }
 
 ParserBench::~ParserBench()
@@ -111,6 +122,24 @@ void ParserBench::parse(const QCoreApplication& app)
     } else {
         qWarning() << "ParserBench::parse: repetilog2 factortion invalid. Defaulting to " << m_log2Factor;
     }
+
+    // output format
+
+    QString outputFormatStr = m_parser.value(m_outputFormatOption);
+
+    if (outputFormatStr == "text") {
+        m_outputFormat = OutputText;
+    } else if (outputFormatStr == "csv") {
+        m_outputFormat = OutputCSV;
+    } else if (outputFormatStr == "json") {
+        m_outputFormat = OutputJSON;
+    } else {
+        qWarning() << "ParserBench::parse: output format invalid. Defaulting to text";
+    }
+
+    // input file
+
+    m_fileName = m_parser.value(m_fileOption);
 }
 
 ParserBench::TestType ParserBench::getTestType() const
@@ -127,6 +156,38 @@ ParserBench::TestType ParserBench::getTestType() const
         return TestDecimatorsSupII;
     } else if (m_testStr == "ambe") {
         return TestAMBE;
+    } else if (m_testStr == "downchannelizer") {
+        return TestDownChannelizer;
+    } else if (m_testStr == "samplesinkfifo") {
+        return TestSampleSinkFifo;
+    } else if (m_testStr == "interpolator") {
+        return TestInterpolator;
+    } else if (m_testStr == "fftfilt") {
+        return TestFFTFilt;
+    } else if (m_testStr == "fftfiltssb") {
+        return TestFFTFiltSSB;
+    } else if (m_testStr == "nco") {
+        return TestNCO;
+    } else if (m_testStr == "nfmdemod") {
+        return TestNFMDemod;
+    } else if (m_testStr == "ssbdemod") {
+        return TestSSBDemod;
+    } else if (m_testStr == "bfmdemod") {
+        return TestBFMDemod;
+    } else if (m_testStr == "spectrumvis") {
+        return TestSpectrumVis;
+    } else if (m_testStr == "filterbank") {
+        return TestFilterBank;
+    } else if (m_testStr == "lorademod") {
+        return TestLoRaDemod;
+    } else if (m_testStr == "samplecodec") {
+        return TestSampleCodec;
+    } else if (m_testStr == "udpbatch") {
+        return TestUDPBatch;
+    } else if (m_testStr == "messagequeue") {
+        return TestMessageQueue;
+    } else if (m_testStr == "audioresampler") {
+        return TestAudioResampler;
     } else {
         return TestDecimatorsII;
     }
@@ -33,9 +33,32 @@ public:
         TestDecimatorsFF,
         TestDecimatorsInfII,
         TestDecimatorsSupII,
-        TestAMBE
+        TestAMBE,
+        TestDownChannelizer,
+        TestSampleSinkFifo,
+        TestInterpolator,
+        TestFFTFilt,
+        TestFFTFiltSSB,
+        TestNCO,
+        TestNFMDemod,
+        TestSSBDemod,
+        TestBFMDemod,
+        TestSpectrumVis,
+        TestFilterBank,
+        TestLoRaDemod,
+        TestSampleCodec,
+        TestUDPBatch,
+        TestMessageQueue,
+        TestAudioResampler
     } TestType;
 
+    typedef enum
+    {
+        OutputText, //!< human readable log lines
+        OutputCSV,  //!< one header line then one line per result on stdout
+        OutputJSON  //!< one JSON object per result line on stdout
+    } OutputFormat;
+
     ParserBench();
     ~ParserBench();
 
@@ -46,18 +69,24 @@ public:
     uint32_t getNbSamples() const { return m_nbSamples; }
     uint32_t getRepetition() const { return m_repetition; }
     uint32_t getLog2Factor() const { return m_log2Factor; }
+    OutputFormat getOutputFormat() const { return m_outputFormat; }
+    const QString& getFileName() const { return m_fileName; }
 
 private:
     QString  m_testStr;
     uint32_t m_nbSamples;
     uint32_t m_repetition;
     uint32_t m_log2Factor;
+    OutputFormat m_outputFormat;
+    QString  m_fileName;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_testOption;
     QCommandLineOption m_nbSamplesOption;
     QCommandLineOption m_repetitionOption;
     QCommandLineOption m_log2FactorOption;
+    QCommandLineOption m_outputFormatOption;
+    QCommandLineOption m_fileOption;
 };
 
 
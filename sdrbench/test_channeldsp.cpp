@@ -0,0 +1,523 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Channel level DSP benchmarks: interpolator, fftfilt, NCO, demodulator sinks   //
+// LoRa symbol demodulation and spectrum visualisation fed with synthetic IQ     //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "dsp/interpolator.h"
+#include "dsp/fftfilt.h"
+#include "dsp/nco.h"
+#include "dsp/dspengine.h"
+#include "dsp/spectrumvis.h"
+#include "dsp/glspectruminterface.h"
+#ifdef BENCH_DEMODNFM
+#include "nfmdemodsink.h"
+#endif
+#ifdef BENCH_DEMODSSB
+#include "ssbdemodsink.h"
+#endif
+#ifdef BENCH_DEMODBFM
+#include "bfmdemodsink.h"
+#endif
+#ifdef BENCH_DEMODLORA
+#include "lorademodsink.h"
+#endif
+
+#include "mainbench.h"
+
+void MainBench::testInterpolator()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    const int inputRate = 75000;  // typical channelizer output for a 48 kS/s audio channel
+    const int outputRate = 48000;
+
+    qDebug() << "MainBench::testInterpolator: create test data";
+
+    std::vector<Complex> buf(m_parser.getNbSamples());
+    std::vector<Complex> out(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+
+    for (std::vector<Complex>::iterator it = buf.begin(); it != buf.end(); ++it) {
+        *it = Complex(my_rand(), my_rand());
+    }
+
+    Interpolator interpolator;
+    interpolator.create(16, inputRate, outputRate / 2.2f);
+    Real interpolatorDistance = (Real) inputRate / (Real) outputRate;
+    Real interpolatorDistanceRemain = interpolatorDistance;
+    int nbOut = 0;
+
+    qDebug() << "MainBench::testInterpolator: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        nbOut = 0;
+        timer.start();
+
+        for (std::vector<Complex>::const_iterator it = buf.begin(); it != buf.end(); ++it)
+        {
+            if (interpolator.decimate(&interpolatorDistanceRemain, *it, &out[nbOut]))
+            {
+                nbOut++;
+                interpolatorDistanceRemain += interpolatorDistance;
+            }
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testInterpolator", nsecs);
+    qDebug() << "MainBench::testInterpolator: output samples per repetition: " << nbOut;
+
+    // block version on the same data compared with the per sample version on a single pass
+
+    Interpolator blockInterpolator;
+    blockInterpolator.create(16, inputRate, outputRate / 2.2f);
+    Interpolator refInterpolator;
+    refInterpolator.create(16, inputRate, outputRate / 2.2f);
+    Real blockDistanceRemain = interpolatorDistance;
+    Real refDistanceRemain = interpolatorDistance;
+    std::vector<Complex> blockOut;
+    int nbRef = 0;
+
+    for (std::vector<Complex>::const_iterator it = buf.begin(); it != buf.end(); ++it)
+    {
+        if (refInterpolator.decimate(&refDistanceRemain, *it, &out[nbRef]))
+        {
+            nbRef++;
+            refDistanceRemain += interpolatorDistance;
+        }
+    }
+
+    blockInterpolator.decimate(&blockDistanceRemain, interpolatorDistance, buf.data(), buf.size(), blockOut);
+    float maxError = 0.0f;
+
+    for (int i = 0; i < std::min(nbRef, (int) blockOut.size()); i++) {
+        maxError = std::max(maxError, std::abs(blockOut[i] - out[i]));
+    }
+
+    qDebug() << "MainBench::testInterpolator: block output samples: " << blockOut.size()
+        << " per sample output samples: " << nbRef
+        << " max error: " << maxError;
+
+    nsecs = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+        blockInterpolator.decimate(&blockDistanceRemain, interpolatorDistance, buf.data(), buf.size(), blockOut);
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testInterpolator (block)", nsecs);
+}
+
+void MainBench::testFFTFilt(bool ssb)
+{
+    qDebug() << "MainBench::testFFTFilt: create test data";
+
+    std::vector<fftfilt::cmplx> buf(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+
+    for (std::vector<fftfilt::cmplx>::iterator it = buf.begin(); it != buf.end(); ++it) {
+        *it = fftfilt::cmplx(my_rand(), my_rand());
+    }
+
+    // lengths used by the demodulators: 1024 for SSB and 2048 for DSB/AM/ATV
+    const int fftLengths[2] = {1024, 2048};
+    QString method = ssb ? "runSSB" : "runFilt";
+
+    qDebug() << "MainBench::testFFTFilt: run test" << method << "with built-in g_fft";
+
+    for (int i = 0; i < 2; i++) {
+        printResults(QString("MainBench::testFFTFilt: %1 g_fft %2").arg(method).arg(fftLengths[i]), runFFTFilt(ssb, fftLengths[i], buf));
+    }
+
+    if (!DSPEngine::instance()->getFFTFactory()) {
+        DSPEngine::instance()->createFFTFactory(QString());
+    }
+
+    qDebug() << "MainBench::testFFTFilt: run test" << method << "with FFT factory engines";
+
+    for (int i = 0; i < 2; i++) {
+        printResults(QString("MainBench::testFFTFilt: %1 FFTFactory %2").arg(method).arg(fftLengths[i]), runFFTFilt(ssb, fftLengths[i], buf));
+    }
+}
+
+qint64 MainBench::runFFTFilt(bool ssb, int fftLength, const std::vector<std::complex<float>>& buf)
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    const int sampleRate = 48000;
+
+    // 300 Hz to 3 kHz voice channel
+    fftfilt filter(300.0f / sampleRate, 3000.0f / sampleRate, fftLength);
+    fftfilt::cmplx *out;
+    int nbOut = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (std::vector<fftfilt::cmplx>::const_iterator it = buf.begin(); it != buf.end(); ++it)
+        {
+            if (ssb) {
+                nbOut += filter.runSSB(*it, &out, true);
+            } else {
+                nbOut += filter.runFilt(*it, &out);
+            }
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    qDebug() << "MainBench::runFFTFilt: FFT factory:" << filter.usesFFTFactory() << "output samples:" << nbOut;
+    return nsecs;
+}
+
+void MainBench::testNCO()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+
+    qDebug() << "MainBench::testNCO: create test data";
+
+    std::vector<Complex> buf(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+
+    for (std::vector<Complex>::iterator it = buf.begin(); it != buf.end(); ++it) {
+        *it = Complex(my_rand(), my_rand());
+    }
+
+    NCO nco;
+    nco.setFreq(-12345.0f, 96000.0f);
+
+    qDebug() << "MainBench::testNCO: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        // frequency shift in place as channel sinks do
+        for (std::vector<Complex>::iterator it = buf.begin(); it != buf.end(); ++it) {
+            *it *= nco.nextIQ();
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testNCO", nsecs);
+
+    nsecs = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+        nco.mix(buf.data(), buf.size());
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testNCO (block)", nsecs);
+}
+
+void MainBench::generateFM(SampleVector& samples, int sampleRate, int deviation)
+{
+    // 1 kHz tone frequency modulated at half full scale plus some noise
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+    const float amplitude = SDR_RX_SCALEF / 2.0f;
+    const float noise = SDR_RX_SCALEF / 64.0f;
+    double phase = 0.0;
+
+    for (unsigned int i = 0; i < samples.size(); i++)
+    {
+        double modulation = sin((2.0 * M_PI * 1000.0 * i) / sampleRate);
+        phase += (2.0 * M_PI * deviation * modulation) / sampleRate;
+        samples[i].setReal((FixReal) (amplitude * cos(phase) + noise * my_rand()));
+        samples[i].setImag((FixReal) (amplitude * sin(phase) + noise * my_rand()));
+    }
+}
+
+void MainBench::testDemodSink(ParserBench::TestType testType)
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    const int chunkSize = 1024; // typical channelizer output block
+    const int audioSampleRate = 48000;
+    int channelSampleRate;
+    QString prefix;
+    ChannelSampleSink *sink;
+    AudioFifo *audioFifo;
+#ifdef BENCH_DEMODNFM
+    NFMDemodSink nfmDemodSink;
+#endif
+#ifdef BENCH_DEMODSSB
+    SSBDemodSink ssbDemodSink;
+#endif
+#ifdef BENCH_DEMODBFM
+    BFMDemodSink bfmDemodSink;
+#endif
+
+    qDebug() << "MainBench::testDemodSink: setup sink";
+
+#ifdef BENCH_DEMODNFM
+    if (testType == ParserBench::TestNFMDemod)
+    {
+        NFMDemodSettings settings;
+        channelSampleRate = 75000;
+        nfmDemodSink.applySettings(settings, true);
+        nfmDemodSink.applyAudioSampleRate(audioSampleRate);
+        nfmDemodSink.applyChannelSettings(channelSampleRate, 0, true);
+        sink = &nfmDemodSink;
+        audioFifo = nfmDemodSink.getAudioFifo();
+        prefix = "MainBench::testDemodSink: NFM";
+    }
+    else
+#endif
+#ifdef BENCH_DEMODSSB
+    if (testType == ParserBench::TestSSBDemod)
+    {
+        SSBDemodSettings settings;
+        channelSampleRate = 75000;
+        ssbDemodSink.applySettings(settings, true);
+        ssbDemodSink.applyAudioSampleRate(audioSampleRate);
+        ssbDemodSink.applyChannelSettings(channelSampleRate, 0, true);
+        sink = &ssbDemodSink;
+        audioFifo = ssbDemodSink.getAudioFifo();
+        prefix = "MainBench::testDemodSink: SSB";
+    }
+    else
+#endif
+#ifdef BENCH_DEMODBFM
+    if (testType == ParserBench::TestBFMDemod)
+    {
+        BFMDemodSettings settings;
+        channelSampleRate = BFMDemodSettings::requiredBW(settings.m_rfBandwidth);
+        bfmDemodSink.applySettings(settings, true);
+        bfmDemodSink.applyAudioSampleRate(audioSampleRate);
+        bfmDemodSink.applyChannelSettings(channelSampleRate, 0, true);
+        sink = &bfmDemodSink;
+        audioFifo = bfmDemodSink.getAudioFifo();
+        prefix = "MainBench::testDemodSink: BFM";
+    }
+    else
+#endif
+    {
+        qWarning() << "MainBench::testDemodSink: demodulator plugin not built";
+        return;
+    }
+
+    qDebug() << "MainBench::testDemodSink: create test data at" << channelSampleRate << "S/s";
+
+    SampleVector buf(m_parser.getNbSamples());
+    generateFM(buf, channelSampleRate, testType == ParserBench::TestBFMDemod ? 75000 : 5000);
+
+    qDebug() << "MainBench::testDemodSink: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        for (int j = 0; j < (int) buf.size(); j += chunkSize)
+        {
+            SampleVector::const_iterator begin = buf.begin() + j;
+            SampleVector::const_iterator end = buf.begin() + std::min(j + chunkSize, (int) buf.size());
+            timer.start();
+            sink->feed(begin, end);
+            nsecs += timer.nsecsElapsed();
+            audioFifo->flush(); // no audio device: drop audio out of the timed section
+        }
+    }
+
+    printResults(prefix, nsecs);
+}
+
+void MainBench::testSpectrumVis()
+{
+    QElapsedTimer timer;
+    GLSpectrumInterface glSpectrum; // no display: data is dropped
+
+    if (!DSPEngine::instance()->getFFTFactory()) {
+        DSPEngine::instance()->createFFTFactory(QString());
+    }
+
+    qDebug() << "MainBench::testSpectrumVis: create test data";
+
+    SampleVector buf(m_parser.getNbSamples());
+    generateFM(buf, 48000, 5000);
+
+    SpectrumVis spectrumVis(SDR_RX_SCALEF);
+    spectrumVis.setGLSpectrum(&glSpectrum);
+
+    const GLSpectrumSettings::AveragingMode modes[4] = {
+        GLSpectrumSettings::AvgModeNone,
+        GLSpectrumSettings::AvgModeMoving,
+        GLSpectrumSettings::AvgModeFixed,
+        GLSpectrumSettings::AvgModeMax
+    };
+    const char *modeNames[4] = {"none", "moving", "fixed", "max"};
+    const int reductionBins[2] = {0, 512};
+
+    qDebug() << "MainBench::testSpectrumVis: run test";
+
+    for (int m = 0; m < 4; m++)
+    {
+        for (int r = 0; r < 2; r++)
+        {
+            GLSpectrumSettings settings;
+            settings.m_fftSize = 4096;
+            settings.m_averagingMode = modes[m];
+            settings.m_averagingIndex = m == 0 ? 0 : GLSpectrumSettings::getAveragingIndex(10, modes[m]);
+            settings.m_reductionBins = reductionBins[r];
+            SpectrumVis::MsgConfigureSpectrumVis *msg = SpectrumVis::MsgConfigureSpectrumVis::create(settings, true);
+            spectrumVis.handleMessage(*msg);
+            delete msg;
+            qint64 nsecs = 0;
+
+            for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+            {
+                timer.start();
+                spectrumVis.feed(buf.begin(), buf.end(), false);
+                nsecs += timer.nsecsElapsed();
+            }
+
+            printResults(QString("MainBench::testSpectrumVis: averaging %1 bins %2")
+                .arg(modeNames[m]).arg(reductionBins[r] == 0 ? settings.m_fftSize : reductionBins[r]), nsecs);
+        }
+    }
+}
+
+void MainBench::generateLoRaSymbol(Sample *samples, unsigned int symbol, unsigned int nbSymbolBins)
+{
+    for (unsigned int n = 0; n < nbSymbolBins; n++)
+    {
+        quint64 k = n + symbol;
+        double phase = (2.0 * M_PI * (((k * (k - 1)) / 2) & (nbSymbolBins - 1))) / nbSymbolBins;
+        samples[n] = Sample(0.5 * SDR_RX_SCALEF * cos(phase), 0.5 * SDR_RX_SCALEF * sin(phase));
+    }
+}
+
+void MainBench::testLoRaDemod()
+{
+#ifdef BENCH_DEMODLORA
+    QElapsedTimer timer;
+    const int bandwidth = LoRaDemodSettings::bandwidths[LoRaDemodSettings::nb_bandwidths - 1];
+    const int chunkSize = 1024;
+
+    if (!DSPEngine::instance()->getFFTFactory()) {
+        DSPEngine::instance()->createFFTFactory(QString());
+    }
+
+    LoRaDemodSink sink;
+    sink.applyChannelSettings(bandwidth, bandwidth, 0, true); // one sample per chip
+
+    for (int spread = 0; spread < LoRaDemodSettings::nbSpreadFactors; spread++)
+    {
+        LoRaDemodSettings settings;
+        settings.m_spread = spread;
+        sink.applySettings(settings, true);
+        unsigned int nbSymbolBins = 1 << settings.getSpreadFactor();
+
+        qDebug() << "MainBench::testLoRaDemod: create test data SF" << settings.getSpreadFactor();
+
+        // random symbols: base chirp with phase 2*pi*a(n)/N with a(n) = n(n-1)/2 started at chip s
+        unsigned int nbSymbols = std::max(1u, (unsigned int) m_parser.getNbSamples() / nbSymbolBins);
+        SampleVector buf(nbSymbols * nbSymbolBins);
+        std::vector<unsigned int> symbols(nbSymbols);
+        auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+        for (unsigned int i = 0; i < nbSymbols; i++)
+        {
+            symbols[i] = my_rand() & (nbSymbolBins - 1);
+            generateLoRaSymbol(&buf[i*nbSymbolBins], symbols[i], nbSymbolBins);
+        }
+
+        // check: preamble of up chirps then the symbols then one more up chirp to flush the last window
+        const unsigned int nbPreamble = 8;
+        unsigned int nbCheck = std::min(nbSymbols, 256u);
+        SampleVector checkBuf((nbPreamble + nbCheck + 1) * nbSymbolBins);
+        std::vector<short> decoded;
+
+        for (unsigned int i = 0; i < nbPreamble; i++) {
+            generateLoRaSymbol(&checkBuf[i*nbSymbolBins], 0, nbSymbolBins);
+        }
+
+        std::copy(buf.begin(), buf.begin() + nbCheck * nbSymbolBins, checkBuf.begin() + nbPreamble * nbSymbolBins);
+        generateLoRaSymbol(&checkBuf[(nbPreamble + nbCheck) * nbSymbolBins], 0, nbSymbolBins);
+        sink.applySettings(settings, true); // restart synchronization
+
+        for (SampleVector::const_iterator it = checkBuf.begin(); it != checkBuf.end(); ++it)
+        {
+            unsigned int nbDecoded = sink.getNbSymbols();
+            sink.feed(it, it + 1);
+
+            if (sink.getNbSymbols() != nbDecoded) {
+                decoded.push_back(sink.getLastSymbol());
+            }
+        }
+
+        // the synchronization may shift the symbol windows by one symbol
+        unsigned int nbMatches = 0;
+
+        for (unsigned int lag = nbPreamble - 1; lag <= nbPreamble + 1; lag++)
+        {
+            unsigned int matches = 0;
+
+            for (unsigned int i = 0; (i < nbCheck) && (lag + i < decoded.size()); i++) {
+                matches += decoded[lag + i] == (short) symbols[i] ? 1 : 0;
+            }
+
+            nbMatches = std::max(nbMatches, matches);
+        }
+
+        qInfo("MainBench::testLoRaDemod: SF%u symbol errors: %u/%u check: %s",
+            settings.getSpreadFactor(),
+            nbCheck - nbMatches,
+            nbCheck,
+            nbMatches == nbCheck ? "OK" : "KO");
+
+        qDebug() << "MainBench::testLoRaDemod: run test";
+        unsigned int nbSymbolsStart = sink.getNbSymbols();
+        qint64 nsecs = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            for (int j = 0; j < (int) buf.size(); j += chunkSize)
+            {
+                SampleVector::const_iterator begin = buf.begin() + j;
+                SampleVector::const_iterator end = buf.begin() + std::min(j + chunkSize, (int) buf.size());
+                timer.start();
+                sink.feed(begin, end);
+                nsecs += timer.nsecsElapsed();
+            }
+        }
+
+        unsigned int nbDemodSymbols = sink.getNbSymbols() - nbSymbolsStart;
+        printResults(QString("MainBench::testLoRaDemod: SF%1 symbols").arg(settings.getSpreadFactor()), nsecs, nbDemodSymbols);
+        qInfo("MainBench::testLoRaDemod: SF%u %.1f symbols/s at %d Hz bandwidth: %.1f",
+            settings.getSpreadFactor(),
+            nsecs == 0 ? 0.0 : (nbDemodSymbols * 1e9) / nsecs,
+            bandwidth,
+            (double) bandwidth / nbSymbolBins);
+    }
+#else
+    qWarning() << "MainBench::testLoRaDemod: LoRa demodulator plugin not built";
+#endif
+}
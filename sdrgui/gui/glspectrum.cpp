@@ -45,6 +45,7 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
 	m_sampleRate(500000),
 	m_timingRate(1),
 	m_fftSize(512),
+	m_fftLength(512),
 	m_displayGrid(true),
 	m_displayGridIntensity(5),
 	m_displayTraceIntensity(50),
@@ -375,6 +376,11 @@ void GLSpectrum::removeChannelMarker(ChannelMarker* channelMarker)
 }
 
 void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int fftSize)
+{
+	newSpectrum(spectrum, fftSize, fftSize);
+}
+
+void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int nbBins, int fftSize)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
@@ -382,13 +388,15 @@ void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int fftSize)
 
 	if (m_changesPending)
     {
-		m_fftSize = fftSize;
+		m_fftSize = nbBins;
+		m_fftLength = fftSize;
 		return;
 	}
 
-	if (fftSize != m_fftSize)
+	if ((nbBins != m_fftSize) || (fftSize != m_fftLength))
     {
-		m_fftSize = fftSize;
+		m_fftSize = nbBins;
+		m_fftLength = fftSize;
 		m_changesPending = true;
 		return;
 	}
@@ -1132,11 +1140,11 @@ void GLSpectrum::applyChanges()
 
 			if(!m_invertedWaterfall)
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (waterfallHeight * m_fftSize) / scaleDiv, 0);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (waterfallHeight * m_fftLength) / scaleDiv, 0);
 			}
 			else
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, (waterfallHeight * m_fftSize) / scaleDiv);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, (waterfallHeight * m_fftLength) / scaleDiv);
 			}
 		}
 		else
@@ -1236,11 +1244,11 @@ void GLSpectrum::applyChanges()
 
 			if(!m_invertedWaterfall)
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (waterfallHeight * m_fftSize) / scaleDiv, 0);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (waterfallHeight * m_fftLength) / scaleDiv, 0);
 			}
 			else
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, (waterfallHeight * m_fftSize) / scaleDiv);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, (waterfallHeight * m_fftLength) / scaleDiv);
 			}
 		}
 		else
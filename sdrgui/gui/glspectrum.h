@@ -90,6 +90,7 @@ public:
 	void setMessageQueueToGUI(MessageQueue* messageQueue) { m_messageQueueToGUI = messageQueue; }
 
 	virtual void newSpectrum(const std::vector<Real>& spectrum, int fftSize);
+	virtual void newSpectrum(const std::vector<Real>& spectrum, int nbBins, int fftSize);
 	void clearSpectrumHistogram();
 
 	Real getWaterfallShare() const { return m_waterfallShare; }
@@ -143,7 +144,8 @@ private:
 	quint32 m_sampleRate;
 	quint32 m_timingRate;
 
-	int m_fftSize;
+	int m_fftSize;   //!< number of bins displayed
+	int m_fftLength; //!< samples per FFT for the waterfall time scale. Can be more than m_fftSize if bins are reduced.
 
 	bool m_displayGrid;
 	int m_displayGridIntensity;
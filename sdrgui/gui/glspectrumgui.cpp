@@ -115,6 +115,8 @@ void GLSpectrumGUI::displaySettings()
 	ui->traceIntensity->setToolTip(QString("Trace intensity: %1").arg(m_settings.m_displayTraceIntensity));
 
 	ui->fftWindow->blockSignals(true);
+	ui->reductionBins->blockSignals(true);
+	ui->reductionMode->blockSignals(true);
 	ui->averaging->blockSignals(true);
 	ui->averagingMode->blockSignals(true);
 	ui->linscale->blockSignals(true);
@@ -130,12 +132,26 @@ void GLSpectrumGUI::displaySettings()
 		}
 	}
 
+	ui->reductionBins->setCurrentIndex(0);
+
+	for (int i = 1; i < 5; i++)
+	{
+		if (m_settings.m_reductionBins == (1 << (i + 7)))
+		{
+			ui->reductionBins->setCurrentIndex(i);
+			break;
+		}
+	}
+
+	ui->reductionMode->setCurrentIndex((int) m_settings.m_reductionMode);
 	ui->averaging->setCurrentIndex(m_settings.m_averagingIndex);
 	ui->averagingMode->setCurrentIndex((int) m_settings.m_averagingMode);
 	ui->linscale->setChecked(m_settings.m_linear);
 	setAveragingToolitp();
 
 	ui->fftWindow->blockSignals(false);
+	ui->reductionBins->blockSignals(false);
+	ui->reductionMode->blockSignals(false);
 	ui->averaging->blockSignals(false);
 	ui->averagingMode->blockSignals(false);
 	ui->linscale->blockSignals(false);
@@ -194,7 +210,9 @@ void GLSpectrumGUI::applySettings()
             getAveragingValue(m_settings.m_averagingIndex, m_settings.m_averagingMode),
             (SpectrumVis::AvgMode) m_settings.m_averagingMode,
             (FFTWindow::Function) m_settings.m_fftWindow,
-            m_settings.m_linear
+            m_settings.m_linear,
+            m_settings.m_reductionBins,
+            m_settings.m_reductionMode
 		);
     }
 }
@@ -214,6 +232,20 @@ void GLSpectrumGUI::on_fftSize_currentIndexChanged(int index)
 	setAveragingToolitp();
 }
 
+void GLSpectrumGUI::on_reductionBins_currentIndexChanged(int index)
+{
+	qDebug("GLSpectrumGUI::on_reductionBins_currentIndexChanged: %d", index);
+	m_settings.m_reductionBins = index <= 0 ? 0 : 1 << (7 + index);
+	applySettings();
+}
+
+void GLSpectrumGUI::on_reductionMode_currentIndexChanged(int index)
+{
+	qDebug("GLSpectrumGUI::on_reductionMode_currentIndexChanged: %d", index);
+	m_settings.m_reductionMode = index == 1 ? GLSpectrumSettings::ReductionMean : GLSpectrumSettings::ReductionMax;
+	applySettings();
+}
+
 void GLSpectrumGUI::on_averagingMode_currentIndexChanged(int index)
 {
 	qDebug("GLSpectrumGUI::on_averagingMode_currentIndexChanged: %d", index);
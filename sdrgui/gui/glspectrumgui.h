@@ -83,6 +83,8 @@ private:
 private slots:
 	void on_fftWindow_currentIndexChanged(int index);
 	void on_fftSize_currentIndexChanged(int index);
+	void on_reductionBins_currentIndexChanged(int index);
+	void on_reductionMode_currentIndexChanged(int index);
 	void on_refLevel_currentIndexChanged(int index);
 	void on_levelRange_currentIndexChanged(int index);
 	void on_decay_valueChanged(int index);
@@ -68,6 +68,7 @@
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
 #include "webapi/webapiadaptergui.h"
+#include "websockets/wsreports.h"
 #include "commands/command.h"
 
 #include "mainwindow.h"
@@ -192,6 +193,12 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
     m_dspEngine->createFFTFactory(parser.getFFTWFWisdomFileName());
     m_dspEngine->preAllocateFFTs();
 
+    if (parser.getSchedulerWorkers() >= 0)
+    {
+        splash->showStatusMessage("create baseband scheduler...", Qt::white);
+        m_dspEngine->createBasebandScheduler(parser.getSchedulerWorkers(), parser.getSchedulerNUMA());
+    }
+
     splash->showStatusMessage("load settings...", Qt::white);
     qDebug() << "MainWindow::MainWindow: load settings...";
 
@@ -241,6 +248,11 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 	m_apiPort = parser.getServerPort();
 	m_apiServer = new WebAPIServer(m_apiHost, m_apiPort, m_requestMapper);
 	m_apiServer->start();
+	m_wsReports = new WSReports(m_apiAdapter);
+
+	if (parser.getReportsPort() != 0) {
+		m_wsReports->openSocket(m_apiHost, parser.getReportsPort());
+	}
 
 	m_commandKeyReceiver = new CommandKeyReceiver();
 	m_commandKeyReceiver->setRelease(true);
@@ -267,6 +279,7 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 MainWindow::~MainWindow()
 {
     m_apiServer->stop();
+    delete m_wsReports;
     delete m_apiServer;
     delete m_requestMapper;
     delete m_apiAdapter;
@@ -50,6 +50,7 @@ class QWidget;
 class WebAPIRequestMapper;
 class WebAPIServer;
 class WebAPIAdapterGUI;
+class WSReports;
 class Preset;
 class Command;
 class CommandKeyReceiver;
@@ -341,6 +342,7 @@ private:
 	WebAPIRequestMapper *m_requestMapper;
 	WebAPIServer *m_apiServer;
 	WebAPIAdapterGUI *m_apiAdapter;
+	WSReports *m_wsReports;
 	QString m_apiHost;
 	int m_apiPort;
 
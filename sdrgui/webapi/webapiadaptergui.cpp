@@ -31,6 +31,8 @@
 #include "dsp/devicesamplesink.h"
 #include "dsp/devicesamplemimo.h"
 #include "dsp/dspdevicesourceengine.h"
+#include "dsp/samplesinkfifo.h"
+#include "dsp/filerecord.h"
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
 #include "dsp/dspengine.h"
@@ -39,6 +41,7 @@
 #include "channel/channelapi.h"
 #include "webapi/webapiadapterbase.h"
 #include "util/serialutil.h"
+#include "util/perfcounter.h"
 
 #include "SWGInstanceSummaryResponse.h"
 #include "SWGInstanceConfigResponse.h"
@@ -63,6 +66,9 @@
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelActions.h"
+#include "SWGDeviceRecord.h"
+#include "SWGDeviceSetPerf.h"
+#include "SWGChannelPerf.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
 #include "SWGDeviceState.h"
@@ -2387,6 +2393,139 @@ int WebAPIAdapterGUI::devicesetChannelReportGet(
     }
 }
 
+int WebAPIAdapterGUI::devicesetDeviceRecordGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        const DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        FileRecord *fileRecord = deviceSet->m_deviceAPI->getFileRecord();
+
+        if (fileRecord)
+        {
+            FileRecord::webapiFormatDeviceRecord(&response, *fileRecord);
+            return 200;
+        }
+        else
+        {
+            *error.getMessage() = QString("Device set %1 has no baseband recording").arg(deviceSetIndex);
+            return 404;
+        }
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetDeviceRecordPatch(
+            int deviceSetIndex,
+            const QStringList& deviceRecordKeys,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        const DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        FileRecord *fileRecord = deviceSet->m_deviceAPI->getFileRecord();
+
+        if (fileRecord)
+        {
+            FileRecord::webapiUpdateDeviceRecord(deviceRecordKeys, &response, *fileRecord);
+            FileRecord::webapiFormatDeviceRecord(&response, *fileRecord);
+            return 200;
+        }
+        else
+        {
+            *error.getMessage() = QString("Device set %1 has no baseband recording").arg(deviceSetIndex);
+            return 404;
+        }
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetPerfGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceSetPerf& response,
+            SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        const DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (deviceSet->m_deviceSourceEngine) // Single Rx
+        {
+            getDeviceSetPerf(&response, deviceSet);
+            return 200;
+        }
+        else
+        {
+            *error.getMessage() = QString("Performance counters are only available for single Rx device sets");
+            return 501;
+        }
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetChannelPerfGet(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGChannelPerf& response,
+            SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (deviceSet->m_deviceSourceEngine) // Single Rx
+        {
+            ChannelAPI *channelAPI = deviceSet->m_deviceAPI->getChanelSinkAPIAt(channelIndex);
+
+            if (channelAPI == 0)
+            {
+                *error.getMessage() = QString("There is no channel with index %1").arg(channelIndex);
+                return 404;
+            }
+            else
+            {
+                response.init();
+                response.setIndex(channelAPI->getIndexInDeviceSet());
+                channelAPI->getIdentifier(*response.getId());
+                return channelAPI->webapiPerfGet(response, *error.getMessage());
+            }
+        }
+        else
+        {
+            *error.getMessage() = QString("Performance counters are only available for single Rx device sets");
+            return 501;
+        }
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
 int WebAPIAdapterGUI::devicesetChannelActionsPost(
         int deviceSetIndex,
         int channelIndex,
@@ -2969,6 +3108,34 @@ void WebAPIAdapterGUI::getChannelsDetail(SWGSDRangel::SWGChannelsDetail *channel
     }
 }
 
+void WebAPIAdapterGUI::getDeviceSetPerf(SWGSDRangel::SWGDeviceSetPerf *deviceSetPerf, const DeviceUISet* deviceUISet)
+{
+    deviceSetPerf->init();
+    DeviceSampleSource *source = deviceUISet->m_deviceAPI->getSampleSource();
+
+    if (source)
+    {
+        SampleSinkFifo *sampleFifo = source->getSampleFifo();
+        PerfCounter::webapiFormatPerfCounter(deviceSetPerf->getWork(), sampleFifo->getReadPerf());
+        SampleSinkFifo::webapiFormatFifoPerf(deviceSetPerf->getFifo(), *sampleFifo);
+    }
+
+    deviceSetPerf->setInputQueueDepth(deviceUISet->m_deviceSourceEngine->getInputMessageQueue()->size());
+    deviceSetPerf->setChannelcount(deviceUISet->m_deviceAPI->getNbSinkChannels());
+    QList<SWGSDRangel::SWGChannelPerf*> *channels = deviceSetPerf->getChannels();
+    QString channelPerfError;
+
+    for (int i = 0; i < deviceSetPerf->getChannelcount(); i++)
+    {
+        ChannelAPI *channel = deviceUISet->m_deviceAPI->getChanelSinkAPIAt(i);
+        channels->append(new SWGSDRangel::SWGChannelPerf);
+        channels->back()->init();
+        channels->back()->setIndex(channel->getIndexInDeviceSet());
+        channel->getIdentifier(*channels->back()->getId());
+        channel->webapiPerfGet(*channels->back(), channelPerfError);
+    }
+}
+
 QtMsgType WebAPIAdapterGUI::getMsgTypeFromString(const QString& msgTypeString)
 {
     if (msgTypeString == "debug") {
@@ -320,12 +320,35 @@ public:
             SWGSDRangel::SWGChannelReport& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int devicesetDeviceRecordGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetDeviceRecordPatch(
+            int deviceSetIndex,
+            const QStringList& deviceRecordKeys,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetPerfGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceSetPerf& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetChannelPerfGet(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGChannelPerf& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
 private:
     MainWindow& m_mainWindow;
 
     void getDeviceSetList(SWGSDRangel::SWGDeviceSetList* deviceSetList);
     void getDeviceSet(SWGSDRangel::SWGDeviceSet *deviceSet, const DeviceUISet* deviceUISet, int deviceUISetIndex);
     void getChannelsDetail(SWGSDRangel::SWGChannelsDetail *channelsDetail, const DeviceUISet* deviceUISet);
+    void getDeviceSetPerf(SWGSDRangel::SWGDeviceSetPerf *deviceSetPerf, const DeviceUISet* deviceUISet);
     static QtMsgType getMsgTypeFromString(const QString& msgTypeString);
     static void getMsgTypeString(const QtMsgType& msgType, QString& level);
 };
@@ -33,6 +33,7 @@
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
 #include "webapi/webapiadaptersrv.h"
+#include "websockets/wsreports.h"
 
 #include "maincore.h"
 
@@ -66,6 +67,12 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     qDebug() << "MainCore::MainCore: create FFT factory...";
     m_dspEngine->createFFTFactory(parser.getFFTWFWisdomFileName());
 
+    if (parser.getSchedulerWorkers() >= 0)
+    {
+        qDebug() << "MainCore::MainCore: create baseband scheduler...";
+        m_dspEngine->createBasebandScheduler(parser.getSchedulerWorkers(), parser.getSchedulerNUMA());
+    }
+
     qDebug() << "MainCore::MainCore: load plugins...";
     m_pluginManager = new PluginManager(this);
     m_pluginManager->loadPlugins(QString("pluginssrv"));
@@ -84,6 +91,11 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_requestMapper->setAdapter(m_apiAdapter);
     m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper);
     m_apiServer->start();
+    m_wsReports = new WSReports(m_apiAdapter);
+
+    if (parser.getReportsPort() != 0) {
+        m_wsReports->openSocket(parser.getServerAddress(), parser.getReportsPort());
+    }
 
     m_dspEngine->setMIMOSupport(parser.getMIMOSupport());
 
@@ -98,6 +110,7 @@ MainCore::~MainCore()
 
 	m_apiServer->stop();
 	m_settings.save();
+    delete m_wsReports;
     delete m_apiServer;
     delete m_requestMapper;
     delete m_apiAdapter;
@@ -40,6 +40,7 @@ class DeviceSet;
 class WebAPIRequestMapper;
 class WebAPIServer;
 class WebAPIAdapterSrv;
+class WSReports;
 
 namespace qtwebapp {
     class LoggerWithFile;
@@ -297,6 +298,7 @@ private:
     WebAPIRequestMapper *m_requestMapper;
     WebAPIServer *m_apiServer;
     WebAPIAdapterSrv *m_apiAdapter;
+    WSReports *m_wsReports;
 
 	void loadSettings();
     void applySettings();
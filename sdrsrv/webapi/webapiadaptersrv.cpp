@@ -41,6 +41,9 @@
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelActions.h"
+#include "SWGDeviceRecord.h"
+#include "SWGDeviceSetPerf.h"
+#include "SWGChannelPerf.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
 #include "SWGDeviceState.h"
@@ -58,6 +61,8 @@
 #include "dsp/devicesamplesource.h"
 #include "dsp/devicesamplemimo.h"
 #include "dsp/dspdevicesourceengine.h"
+#include "dsp/samplesinkfifo.h"
+#include "dsp/filerecord.h"
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
 #include "dsp/dspengine.h"
@@ -65,6 +70,7 @@
 #include "plugin/pluginapi.h"
 #include "plugin/pluginmanager.h"
 #include "util/serialutil.h"
+#include "util/perfcounter.h"
 #include "webapi/webapiadapterbase.h"
 #include "webapiadaptersrv.h"
 
@@ -2489,6 +2495,139 @@ int WebAPIAdapterSrv::devicesetChannelReportGet(
     }
 }
 
+int WebAPIAdapterSrv::devicesetDeviceRecordGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        const DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        FileRecord *fileRecord = deviceSet->m_deviceAPI->getFileRecord();
+
+        if (fileRecord)
+        {
+            FileRecord::webapiFormatDeviceRecord(&response, *fileRecord);
+            return 200;
+        }
+        else
+        {
+            *error.getMessage() = QString("Device set %1 has no baseband recording").arg(deviceSetIndex);
+            return 404;
+        }
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetDeviceRecordPatch(
+            int deviceSetIndex,
+            const QStringList& deviceRecordKeys,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        const DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        FileRecord *fileRecord = deviceSet->m_deviceAPI->getFileRecord();
+
+        if (fileRecord)
+        {
+            FileRecord::webapiUpdateDeviceRecord(deviceRecordKeys, &response, *fileRecord);
+            FileRecord::webapiFormatDeviceRecord(&response, *fileRecord);
+            return 200;
+        }
+        else
+        {
+            *error.getMessage() = QString("Device set %1 has no baseband recording").arg(deviceSetIndex);
+            return 404;
+        }
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetPerfGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceSetPerf& response,
+            SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        const DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+
+        if (deviceSet->m_deviceSourceEngine) // Single Rx
+        {
+            getDeviceSetPerf(&response, deviceSet);
+            return 200;
+        }
+        else
+        {
+            *error.getMessage() = QString("Performance counters are only available for single Rx device sets");
+            return 501;
+        }
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetChannelPerfGet(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGChannelPerf& response,
+            SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+
+        if (deviceSet->m_deviceSourceEngine) // Single Rx
+        {
+            ChannelAPI *channelAPI = deviceSet->m_deviceAPI->getChanelSinkAPIAt(channelIndex);
+
+            if (channelAPI == 0)
+            {
+                *error.getMessage() = QString("There is no channel with index %1").arg(channelIndex);
+                return 404;
+            }
+            else
+            {
+                response.init();
+                response.setIndex(channelAPI->getIndexInDeviceSet());
+                channelAPI->getIdentifier(*response.getId());
+                return channelAPI->webapiPerfGet(response, *error.getMessage());
+            }
+        }
+        else
+        {
+            *error.getMessage() = QString("Performance counters are only available for single Rx device sets");
+            return 501;
+        }
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
 int WebAPIAdapterSrv::devicesetChannelActionsPost(
         int deviceSetIndex,
         int channelIndex,
@@ -3067,6 +3206,34 @@ void WebAPIAdapterSrv::getChannelsDetail(SWGSDRangel::SWGChannelsDetail *channel
     }
 }
 
+void WebAPIAdapterSrv::getDeviceSetPerf(SWGSDRangel::SWGDeviceSetPerf *deviceSetPerf, const DeviceSet* deviceSet)
+{
+    deviceSetPerf->init();
+    DeviceSampleSource *source = deviceSet->m_deviceAPI->getSampleSource();
+
+    if (source)
+    {
+        SampleSinkFifo *sampleFifo = source->getSampleFifo();
+        PerfCounter::webapiFormatPerfCounter(deviceSetPerf->getWork(), sampleFifo->getReadPerf());
+        SampleSinkFifo::webapiFormatFifoPerf(deviceSetPerf->getFifo(), *sampleFifo);
+    }
+
+    deviceSetPerf->setInputQueueDepth(deviceSet->m_deviceSourceEngine->getInputMessageQueue()->size());
+    deviceSetPerf->setChannelcount(deviceSet->m_deviceAPI->getNbSinkChannels());
+    QList<SWGSDRangel::SWGChannelPerf*> *channels = deviceSetPerf->getChannels();
+    QString channelPerfError;
+
+    for (int i = 0; i < deviceSetPerf->getChannelcount(); i++)
+    {
+        ChannelAPI *channel = deviceSet->m_deviceAPI->getChanelSinkAPIAt(i);
+        channels->append(new SWGSDRangel::SWGChannelPerf);
+        channels->back()->init();
+        channels->back()->setIndex(channel->getIndexInDeviceSet());
+        channel->getIdentifier(*channels->back()->getId());
+        channel->webapiPerfGet(*channels->back(), channelPerfError);
+    }
+}
+
 QtMsgType WebAPIAdapterSrv::getMsgTypeFromString(const QString& msgTypeString)
 {
     if (msgTypeString == "debug") {
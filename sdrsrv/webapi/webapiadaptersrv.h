@@ -330,12 +330,35 @@ public:
             SWGSDRangel::SWGChannelReport& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int devicesetDeviceRecordGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetDeviceRecordPatch(
+            int deviceSetIndex,
+            const QStringList& deviceRecordKeys,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetPerfGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceSetPerf& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetChannelPerfGet(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGChannelPerf& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
 private:
     MainCore& m_mainCore;
 
     void getDeviceSetList(SWGSDRangel::SWGDeviceSetList* deviceSetList);
     void getDeviceSet(SWGSDRangel::SWGDeviceSet *swgDeviceSet, const DeviceSet* deviceSet, int deviceUISetIndex);
     void getChannelsDetail(SWGSDRangel::SWGChannelsDetail *channelsDetail, const DeviceSet* deviceSet);
+    void getDeviceSetPerf(SWGSDRangel::SWGDeviceSetPerf *deviceSetPerf, const DeviceSet* deviceSet);
     static QtMsgType getMsgTypeFromString(const QString& msgTypeString);
     static void getMsgTypeString(const QtMsgType& msgType, QString& level);
 };
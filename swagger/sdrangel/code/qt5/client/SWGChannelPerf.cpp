@@ -0,0 +1,231 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGChannelPerf.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGChannelPerf::SWGChannelPerf(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGChannelPerf::SWGChannelPerf() {
+    index = 0;
+    m_index_isSet = false;
+    id = nullptr;
+    m_id_isSet = false;
+    feed = nullptr;
+    m_feed_isSet = false;
+    handle_data = nullptr;
+    m_handle_data_isSet = false;
+    fifo = nullptr;
+    m_fifo_isSet = false;
+    input_queue_depth = 0;
+    m_input_queue_depth_isSet = false;
+}
+
+SWGChannelPerf::~SWGChannelPerf() {
+    this->cleanup();
+}
+
+void
+SWGChannelPerf::init() {
+    index = 0;
+    m_index_isSet = false;
+    id = new QString("");
+    m_id_isSet = false;
+    feed = new SWGPerfCounter();
+    m_feed_isSet = false;
+    handle_data = new SWGPerfCounter();
+    m_handle_data_isSet = false;
+    fifo = new SWGFifoPerf();
+    m_fifo_isSet = false;
+    input_queue_depth = 0;
+    m_input_queue_depth_isSet = false;
+}
+
+void
+SWGChannelPerf::cleanup() {
+
+    if(id != nullptr) { 
+        delete id;
+    }
+    if(feed != nullptr) { 
+        delete feed;
+    }
+    if(handle_data != nullptr) { 
+        delete handle_data;
+    }
+    if(fifo != nullptr) { 
+        delete fifo;
+    }
+
+}
+
+SWGChannelPerf*
+SWGChannelPerf::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGChannelPerf::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&index, pJson["index"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&id, pJson["id"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&feed, pJson["feed"], "SWGPerfCounter", "SWGPerfCounter");
+    
+    ::SWGSDRangel::setValue(&handle_data, pJson["handleData"], "SWGPerfCounter", "SWGPerfCounter");
+    
+    ::SWGSDRangel::setValue(&fifo, pJson["fifo"], "SWGFifoPerf", "SWGFifoPerf");
+    
+    ::SWGSDRangel::setValue(&input_queue_depth, pJson["inputQueueDepth"], "qint32", "");
+    
+}
+
+QString
+SWGChannelPerf::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGChannelPerf::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_index_isSet){
+        obj->insert("index", QJsonValue(index));
+    }
+    if(id != nullptr && *id != QString("")){
+        toJsonValue(QString("id"), id, obj, QString("QString"));
+    }
+    if((feed != nullptr) && (feed->isSet())){
+        toJsonValue(QString("feed"), feed, obj, QString("SWGPerfCounter"));
+    }
+    if((handle_data != nullptr) && (handle_data->isSet())){
+        toJsonValue(QString("handleData"), handle_data, obj, QString("SWGPerfCounter"));
+    }
+    if((fifo != nullptr) && (fifo->isSet())){
+        toJsonValue(QString("fifo"), fifo, obj, QString("SWGFifoPerf"));
+    }
+    if(m_input_queue_depth_isSet){
+        obj->insert("inputQueueDepth", QJsonValue(input_queue_depth));
+    }
+
+    return obj;
+}
+
+qint32
+SWGChannelPerf::getIndex() {
+    return index;
+}
+void
+SWGChannelPerf::setIndex(qint32 index) {
+    this->index = index;
+    this->m_index_isSet = true;
+}
+
+QString*
+SWGChannelPerf::getId() {
+    return id;
+}
+void
+SWGChannelPerf::setId(QString* id) {
+    this->id = id;
+    this->m_id_isSet = true;
+}
+
+SWGPerfCounter*
+SWGChannelPerf::getFeed() {
+    return feed;
+}
+void
+SWGChannelPerf::setFeed(SWGPerfCounter* feed) {
+    this->feed = feed;
+    this->m_feed_isSet = true;
+}
+
+SWGPerfCounter*
+SWGChannelPerf::getHandleData() {
+    return handle_data;
+}
+void
+SWGChannelPerf::setHandleData(SWGPerfCounter* handle_data) {
+    this->handle_data = handle_data;
+    this->m_handle_data_isSet = true;
+}
+
+SWGFifoPerf*
+SWGChannelPerf::getFifo() {
+    return fifo;
+}
+void
+SWGChannelPerf::setFifo(SWGFifoPerf* fifo) {
+    this->fifo = fifo;
+    this->m_fifo_isSet = true;
+}
+
+qint32
+SWGChannelPerf::getInputQueueDepth() {
+    return input_queue_depth;
+}
+void
+SWGChannelPerf::setInputQueueDepth(qint32 input_queue_depth) {
+    this->input_queue_depth = input_queue_depth;
+    this->m_input_queue_depth_isSet = true;
+}
+
+
+bool
+SWGChannelPerf::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_index_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(id && *id != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(feed && feed->isSet()){
+            isObjectUpdated = true; break;
+        }
+        if(handle_data && handle_data->isSet()){
+            isObjectUpdated = true; break;
+        }
+        if(fifo && fifo->isSet()){
+            isObjectUpdated = true; break;
+        }
+        if(m_input_queue_depth_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,269 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGDeviceRecord.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGDeviceRecord::SWGDeviceRecord(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDeviceRecord::SWGDeviceRecord() {
+    direct_io = 0;
+    m_direct_io_isSet = false;
+    preallocate = 0L;
+    m_preallocate_isSet = false;
+    sample_format = 0;
+    m_sample_format_isSet = false;
+    recording = 0;
+    m_recording_isSet = false;
+    sample_count = 0L;
+    m_sample_count_isSet = false;
+    nb_blocks = 0;
+    m_nb_blocks_isSet = false;
+    queue_high_water = 0;
+    m_queue_high_water_isSet = false;
+    dropped_buffers = 0;
+    m_dropped_buffers_isSet = false;
+}
+
+SWGDeviceRecord::~SWGDeviceRecord() {
+    this->cleanup();
+}
+
+void
+SWGDeviceRecord::init() {
+    direct_io = 0;
+    m_direct_io_isSet = false;
+    preallocate = 0L;
+    m_preallocate_isSet = false;
+    sample_format = 0;
+    m_sample_format_isSet = false;
+    recording = 0;
+    m_recording_isSet = false;
+    sample_count = 0L;
+    m_sample_count_isSet = false;
+    nb_blocks = 0;
+    m_nb_blocks_isSet = false;
+    queue_high_water = 0;
+    m_queue_high_water_isSet = false;
+    dropped_buffers = 0;
+    m_dropped_buffers_isSet = false;
+}
+
+void
+SWGDeviceRecord::cleanup() {
+
+
+
+
+
+
+
+
+}
+
+SWGDeviceRecord*
+SWGDeviceRecord::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDeviceRecord::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&direct_io, pJson["directIO"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&preallocate, pJson["preallocate"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&sample_format, pJson["sampleFormat"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&recording, pJson["recording"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&sample_count, pJson["sampleCount"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&nb_blocks, pJson["nbBlocks"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&queue_high_water, pJson["queueHighWater"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&dropped_buffers, pJson["droppedBuffers"], "qint32", "");
+    
+}
+
+QString
+SWGDeviceRecord::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDeviceRecord::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_direct_io_isSet){
+        obj->insert("directIO", QJsonValue(direct_io));
+    }
+    if(m_preallocate_isSet){
+        obj->insert("preallocate", QJsonValue(preallocate));
+    }
+    if(m_sample_format_isSet){
+        obj->insert("sampleFormat", QJsonValue(sample_format));
+    }
+    if(m_recording_isSet){
+        obj->insert("recording", QJsonValue(recording));
+    }
+    if(m_sample_count_isSet){
+        obj->insert("sampleCount", QJsonValue(sample_count));
+    }
+    if(m_nb_blocks_isSet){
+        obj->insert("nbBlocks", QJsonValue(nb_blocks));
+    }
+    if(m_queue_high_water_isSet){
+        obj->insert("queueHighWater", QJsonValue(queue_high_water));
+    }
+    if(m_dropped_buffers_isSet){
+        obj->insert("droppedBuffers", QJsonValue(dropped_buffers));
+    }
+
+    return obj;
+}
+
+qint32
+SWGDeviceRecord::getDirectIo() {
+    return direct_io;
+}
+void
+SWGDeviceRecord::setDirectIo(qint32 direct_io) {
+    this->direct_io = direct_io;
+    this->m_direct_io_isSet = true;
+}
+
+qint64
+SWGDeviceRecord::getPreallocate() {
+    return preallocate;
+}
+void
+SWGDeviceRecord::setPreallocate(qint64 preallocate) {
+    this->preallocate = preallocate;
+    this->m_preallocate_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getSampleFormat() {
+    return sample_format;
+}
+void
+SWGDeviceRecord::setSampleFormat(qint32 sample_format) {
+    this->sample_format = sample_format;
+    this->m_sample_format_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getRecording() {
+    return recording;
+}
+void
+SWGDeviceRecord::setRecording(qint32 recording) {
+    this->recording = recording;
+    this->m_recording_isSet = true;
+}
+
+qint64
+SWGDeviceRecord::getSampleCount() {
+    return sample_count;
+}
+void
+SWGDeviceRecord::setSampleCount(qint64 sample_count) {
+    this->sample_count = sample_count;
+    this->m_sample_count_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getNbBlocks() {
+    return nb_blocks;
+}
+void
+SWGDeviceRecord::setNbBlocks(qint32 nb_blocks) {
+    this->nb_blocks = nb_blocks;
+    this->m_nb_blocks_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getQueueHighWater() {
+    return queue_high_water;
+}
+void
+SWGDeviceRecord::setQueueHighWater(qint32 queue_high_water) {
+    this->queue_high_water = queue_high_water;
+    this->m_queue_high_water_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getDroppedBuffers() {
+    return dropped_buffers;
+}
+void
+SWGDeviceRecord::setDroppedBuffers(qint32 dropped_buffers) {
+    this->dropped_buffers = dropped_buffers;
+    this->m_dropped_buffers_isSet = true;
+}
+
+
+bool
+SWGDeviceRecord::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_direct_io_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_preallocate_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_sample_format_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_recording_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_sample_count_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_blocks_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_queue_high_water_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_dropped_buffers_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,100 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGDeviceRecord.h
+ *
+ * Device baseband file recording options and statistics
+ */
+
+#ifndef SWGDeviceRecord_H_
+#define SWGDeviceRecord_H_
+
+#include <QJsonObject>
+
+
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGDeviceRecord: public SWGObject {
+public:
+    SWGDeviceRecord();
+    SWGDeviceRecord(QString* json);
+    virtual ~SWGDeviceRecord();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGDeviceRecord* fromJson(QString &jsonString) override;
+
+    qint32 getDirectIo();
+    void setDirectIo(qint32 direct_io);
+
+    qint64 getPreallocate();
+    void setPreallocate(qint64 preallocate);
+
+    qint32 getSampleFormat();
+    void setSampleFormat(qint32 sample_format);
+
+    qint32 getRecording();
+    void setRecording(qint32 recording);
+
+    qint64 getSampleCount();
+    void setSampleCount(qint64 sample_count);
+
+    qint32 getNbBlocks();
+    void setNbBlocks(qint32 nb_blocks);
+
+    qint32 getQueueHighWater();
+    void setQueueHighWater(qint32 queue_high_water);
+
+    qint32 getDroppedBuffers();
+    void setDroppedBuffers(qint32 dropped_buffers);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 direct_io;
+    bool m_direct_io_isSet;
+
+    qint64 preallocate;
+    bool m_preallocate_isSet;
+
+    qint32 sample_format;
+    bool m_sample_format_isSet;
+
+    qint32 recording;
+    bool m_recording_isSet;
+
+    qint64 sample_count;
+    bool m_sample_count_isSet;
+
+    qint32 nb_blocks;
+    bool m_nb_blocks_isSet;
+
+    qint32 queue_high_water;
+    bool m_queue_high_water_isSet;
+
+    qint32 dropped_buffers;
+    bool m_dropped_buffers_isSet;
+
+};
+
+}
+
+#endif /* SWGDeviceRecord_H_ */
@@ -16,6 +16,7 @@
 #include "SWGHttpRequest.h"
 
 #include "SWGChannelActions.h"
+#include "SWGChannelPerf.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelsDetail.h"
@@ -23,6 +24,7 @@
 #include "SWGDeviceListItem.h"
 #include "SWGDeviceReport.h"
 #include "SWGDeviceSet.h"
+#include "SWGDeviceSetPerf.h"
 #include "SWGDeviceSettings.h"
 #include "SWGDeviceState.h"
 #include "SWGErrorResponse.h"
@@ -46,6 +48,7 @@ public:
 
     void devicesetChannelActionsPost(qint32 device_set_index, qint32 channel_index, SWGChannelActions& body);
     void devicesetChannelDelete(qint32 device_set_index, qint32 channel_index);
+    void devicesetChannelPerfGet(qint32 device_set_index, qint32 channel_index);
     void devicesetChannelPost(qint32 device_set_index, SWGChannelSettings& body);
     void devicesetChannelReportGet(qint32 device_set_index, qint32 channel_index);
     void devicesetChannelSettingsGet(qint32 device_set_index, qint32 channel_index);
@@ -66,12 +69,14 @@ public:
     void devicesetDeviceSubsystemRunPost(qint32 device_set_index, qint32 subsystem_index, SWGDeviceSettings& body);
     void devicesetFocusPatch(qint32 device_set_index);
     void devicesetGet(qint32 device_set_index);
+    void devicesetPerfGet(qint32 device_set_index);
     void instanceDeviceSetDelete();
     void instanceDeviceSetPost(qint32 direction);
     
 private:
     void devicesetChannelActionsPostCallback (SWGHttpRequestWorker * worker);
     void devicesetChannelDeleteCallback (SWGHttpRequestWorker * worker);
+    void devicesetChannelPerfGetCallback (SWGHttpRequestWorker * worker);
     void devicesetChannelPostCallback (SWGHttpRequestWorker * worker);
     void devicesetChannelReportGetCallback (SWGHttpRequestWorker * worker);
     void devicesetChannelSettingsGetCallback (SWGHttpRequestWorker * worker);
@@ -92,12 +97,14 @@ private:
     void devicesetDeviceSubsystemRunPostCallback (SWGHttpRequestWorker * worker);
     void devicesetFocusPatchCallback (SWGHttpRequestWorker * worker);
     void devicesetGetCallback (SWGHttpRequestWorker * worker);
+    void devicesetPerfGetCallback (SWGHttpRequestWorker * worker);
     void instanceDeviceSetDeleteCallback (SWGHttpRequestWorker * worker);
     void instanceDeviceSetPostCallback (SWGHttpRequestWorker * worker);
     
 signals:
     void devicesetChannelActionsPostSignal(SWGSuccessResponse* summary);
     void devicesetChannelDeleteSignal(SWGChannelSettings* summary);
+    void devicesetChannelPerfGetSignal(SWGChannelPerf* summary);
     void devicesetChannelPostSignal(SWGSuccessResponse* summary);
     void devicesetChannelReportGetSignal(SWGChannelReport* summary);
     void devicesetChannelSettingsGetSignal(SWGChannelSettings* summary);
@@ -118,11 +125,13 @@ signals:
     void devicesetDeviceSubsystemRunPostSignal(SWGDeviceState* summary);
     void devicesetFocusPatchSignal(SWGSuccessResponse* summary);
     void devicesetGetSignal(SWGDeviceSet* summary);
+    void devicesetPerfGetSignal(SWGDeviceSetPerf* summary);
     void instanceDeviceSetDeleteSignal(SWGSuccessResponse* summary);
     void instanceDeviceSetPostSignal(SWGSuccessResponse* summary);
     
     void devicesetChannelActionsPostSignalE(SWGSuccessResponse* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetChannelDeleteSignalE(SWGChannelSettings* summary, QNetworkReply::NetworkError error_type, QString& error_str);
+    void devicesetChannelPerfGetSignalE(SWGChannelPerf* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetChannelPostSignalE(SWGSuccessResponse* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetChannelReportGetSignalE(SWGChannelReport* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetChannelSettingsGetSignalE(SWGChannelSettings* summary, QNetworkReply::NetworkError error_type, QString& error_str);
@@ -143,11 +152,13 @@ signals:
     void devicesetDeviceSubsystemRunPostSignalE(SWGDeviceState* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetFocusPatchSignalE(SWGSuccessResponse* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetGetSignalE(SWGDeviceSet* summary, QNetworkReply::NetworkError error_type, QString& error_str);
+    void devicesetPerfGetSignalE(SWGDeviceSetPerf* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceDeviceSetDeleteSignalE(SWGSuccessResponse* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceDeviceSetPostSignalE(SWGSuccessResponse* summary, QNetworkReply::NetworkError error_type, QString& error_str);
     
     void devicesetChannelActionsPostSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetChannelDeleteSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
+    void devicesetChannelPerfGetSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetChannelPostSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetChannelReportGetSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetChannelSettingsGetSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
@@ -168,6 +179,7 @@ signals:
     void devicesetDeviceSubsystemRunPostSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetFocusPatchSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void devicesetGetSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
+    void devicesetPerfGetSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceDeviceSetDeleteSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     void instanceDeviceSetPostSignalEFull(SWGHttpRequestWorker* worker, QNetworkReply::NetworkError error_type, QString& error_str);
     
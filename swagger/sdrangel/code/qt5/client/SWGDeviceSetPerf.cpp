@@ -0,0 +1,210 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGDeviceSetPerf.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGDeviceSetPerf::SWGDeviceSetPerf(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDeviceSetPerf::SWGDeviceSetPerf() {
+    work = nullptr;
+    m_work_isSet = false;
+    fifo = nullptr;
+    m_fifo_isSet = false;
+    input_queue_depth = 0;
+    m_input_queue_depth_isSet = false;
+    channelcount = 0;
+    m_channelcount_isSet = false;
+    channels = nullptr;
+    m_channels_isSet = false;
+}
+
+SWGDeviceSetPerf::~SWGDeviceSetPerf() {
+    this->cleanup();
+}
+
+void
+SWGDeviceSetPerf::init() {
+    work = new SWGPerfCounter();
+    m_work_isSet = false;
+    fifo = new SWGFifoPerf();
+    m_fifo_isSet = false;
+    input_queue_depth = 0;
+    m_input_queue_depth_isSet = false;
+    channelcount = 0;
+    m_channelcount_isSet = false;
+    channels = new QList<SWGChannelPerf*>();
+    m_channels_isSet = false;
+}
+
+void
+SWGDeviceSetPerf::cleanup() {
+    if(work != nullptr) { 
+        delete work;
+    }
+    if(fifo != nullptr) { 
+        delete fifo;
+    }
+
+
+    if(channels != nullptr) { 
+        auto arr = channels;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete channels;
+    }
+}
+
+SWGDeviceSetPerf*
+SWGDeviceSetPerf::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDeviceSetPerf::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&work, pJson["work"], "SWGPerfCounter", "SWGPerfCounter");
+    
+    ::SWGSDRangel::setValue(&fifo, pJson["fifo"], "SWGFifoPerf", "SWGFifoPerf");
+    
+    ::SWGSDRangel::setValue(&input_queue_depth, pJson["inputQueueDepth"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&channelcount, pJson["channelcount"], "qint32", "");
+    
+    
+    ::SWGSDRangel::setValue(&channels, pJson["channels"], "QList", "SWGChannelPerf");
+}
+
+QString
+SWGDeviceSetPerf::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDeviceSetPerf::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if((work != nullptr) && (work->isSet())){
+        toJsonValue(QString("work"), work, obj, QString("SWGPerfCounter"));
+    }
+    if((fifo != nullptr) && (fifo->isSet())){
+        toJsonValue(QString("fifo"), fifo, obj, QString("SWGFifoPerf"));
+    }
+    if(m_input_queue_depth_isSet){
+        obj->insert("inputQueueDepth", QJsonValue(input_queue_depth));
+    }
+    if(m_channelcount_isSet){
+        obj->insert("channelcount", QJsonValue(channelcount));
+    }
+    if(channels && channels->size() > 0){
+        toJsonArray((QList<void*>*)channels, obj, "channels", "SWGChannelPerf");
+    }
+
+    return obj;
+}
+
+SWGPerfCounter*
+SWGDeviceSetPerf::getWork() {
+    return work;
+}
+void
+SWGDeviceSetPerf::setWork(SWGPerfCounter* work) {
+    this->work = work;
+    this->m_work_isSet = true;
+}
+
+SWGFifoPerf*
+SWGDeviceSetPerf::getFifo() {
+    return fifo;
+}
+void
+SWGDeviceSetPerf::setFifo(SWGFifoPerf* fifo) {
+    this->fifo = fifo;
+    this->m_fifo_isSet = true;
+}
+
+qint32
+SWGDeviceSetPerf::getInputQueueDepth() {
+    return input_queue_depth;
+}
+void
+SWGDeviceSetPerf::setInputQueueDepth(qint32 input_queue_depth) {
+    this->input_queue_depth = input_queue_depth;
+    this->m_input_queue_depth_isSet = true;
+}
+
+qint32
+SWGDeviceSetPerf::getChannelcount() {
+    return channelcount;
+}
+void
+SWGDeviceSetPerf::setChannelcount(qint32 channelcount) {
+    this->channelcount = channelcount;
+    this->m_channelcount_isSet = true;
+}
+
+QList<SWGChannelPerf*>*
+SWGDeviceSetPerf::getChannels() {
+    return channels;
+}
+void
+SWGDeviceSetPerf::setChannels(QList<SWGChannelPerf*>* channels) {
+    this->channels = channels;
+    this->m_channels_isSet = true;
+}
+
+
+bool
+SWGDeviceSetPerf::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(work && work->isSet()){
+            isObjectUpdated = true; break;
+        }
+        if(fifo && fifo->isSet()){
+            isObjectUpdated = true; break;
+        }
+        if(m_input_queue_depth_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_channelcount_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(channels && (channels->size() > 0)){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
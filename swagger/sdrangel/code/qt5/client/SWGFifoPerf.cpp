@@ -0,0 +1,200 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGFifoPerf.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGFifoPerf::SWGFifoPerf(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGFifoPerf::SWGFifoPerf() {
+    size = 0;
+    m_size_isSet = false;
+    fill = 0;
+    m_fill_isSet = false;
+    high_water_mark = 0;
+    m_high_water_mark_isSet = false;
+    overflows = 0L;
+    m_overflows_isSet = false;
+    dropped_samples = 0L;
+    m_dropped_samples_isSet = false;
+}
+
+SWGFifoPerf::~SWGFifoPerf() {
+    this->cleanup();
+}
+
+void
+SWGFifoPerf::init() {
+    size = 0;
+    m_size_isSet = false;
+    fill = 0;
+    m_fill_isSet = false;
+    high_water_mark = 0;
+    m_high_water_mark_isSet = false;
+    overflows = 0L;
+    m_overflows_isSet = false;
+    dropped_samples = 0L;
+    m_dropped_samples_isSet = false;
+}
+
+void
+SWGFifoPerf::cleanup() {
+
+
+
+
+
+}
+
+SWGFifoPerf*
+SWGFifoPerf::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGFifoPerf::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&size, pJson["size"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&fill, pJson["fill"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&high_water_mark, pJson["highWaterMark"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&overflows, pJson["overflows"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&dropped_samples, pJson["droppedSamples"], "qint64", "");
+    
+}
+
+QString
+SWGFifoPerf::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGFifoPerf::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_size_isSet){
+        obj->insert("size", QJsonValue(size));
+    }
+    if(m_fill_isSet){
+        obj->insert("fill", QJsonValue(fill));
+    }
+    if(m_high_water_mark_isSet){
+        obj->insert("highWaterMark", QJsonValue(high_water_mark));
+    }
+    if(m_overflows_isSet){
+        obj->insert("overflows", QJsonValue(overflows));
+    }
+    if(m_dropped_samples_isSet){
+        obj->insert("droppedSamples", QJsonValue(dropped_samples));
+    }
+
+    return obj;
+}
+
+qint32
+SWGFifoPerf::getSize() {
+    return size;
+}
+void
+SWGFifoPerf::setSize(qint32 size) {
+    this->size = size;
+    this->m_size_isSet = true;
+}
+
+qint32
+SWGFifoPerf::getFill() {
+    return fill;
+}
+void
+SWGFifoPerf::setFill(qint32 fill) {
+    this->fill = fill;
+    this->m_fill_isSet = true;
+}
+
+qint32
+SWGFifoPerf::getHighWaterMark() {
+    return high_water_mark;
+}
+void
+SWGFifoPerf::setHighWaterMark(qint32 high_water_mark) {
+    this->high_water_mark = high_water_mark;
+    this->m_high_water_mark_isSet = true;
+}
+
+qint64
+SWGFifoPerf::getOverflows() {
+    return overflows;
+}
+void
+SWGFifoPerf::setOverflows(qint64 overflows) {
+    this->overflows = overflows;
+    this->m_overflows_isSet = true;
+}
+
+qint64
+SWGFifoPerf::getDroppedSamples() {
+    return dropped_samples;
+}
+void
+SWGFifoPerf::setDroppedSamples(qint64 dropped_samples) {
+    this->dropped_samples = dropped_samples;
+    this->m_dropped_samples_isSet = true;
+}
+
+
+bool
+SWGFifoPerf::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_size_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_fill_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_high_water_mark_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_overflows_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_dropped_samples_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
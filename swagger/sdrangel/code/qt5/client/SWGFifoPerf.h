@@ -0,0 +1,82 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGFifoPerf.h
+ *
+ * Sample FIFO statistics
+ */
+
+#ifndef SWGFifoPerf_H_
+#define SWGFifoPerf_H_
+
+#include <QJsonObject>
+
+
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGFifoPerf: public SWGObject {
+public:
+    SWGFifoPerf();
+    SWGFifoPerf(QString* json);
+    virtual ~SWGFifoPerf();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGFifoPerf* fromJson(QString &jsonString) override;
+
+    qint32 getSize();
+    void setSize(qint32 size);
+
+    qint32 getFill();
+    void setFill(qint32 fill);
+
+    qint32 getHighWaterMark();
+    void setHighWaterMark(qint32 high_water_mark);
+
+    qint64 getOverflows();
+    void setOverflows(qint64 overflows);
+
+    qint64 getDroppedSamples();
+    void setDroppedSamples(qint64 dropped_samples);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 size;
+    bool m_size_isSet;
+
+    qint32 fill;
+    bool m_fill_isSet;
+
+    qint32 high_water_mark;
+    bool m_high_water_mark_isSet;
+
+    qint64 overflows;
+    bool m_overflows_isSet;
+
+    qint64 dropped_samples;
+    bool m_dropped_samples_isSet;
+
+};
+
+}
+
+#endif /* SWGFifoPerf_H_ */
@@ -34,6 +34,8 @@ SWGFileInputSettings::SWGFileInputSettings() {
     m_acceleration_factor_isSet = false;
     loop = 0;
     m_loop_isSet = false;
+    free_run = 0;
+    m_free_run_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = nullptr;
@@ -56,6 +58,8 @@ SWGFileInputSettings::init() {
     m_acceleration_factor_isSet = false;
     loop = 0;
     m_loop_isSet = false;
+    free_run = 0;
+    m_free_run_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = new QString("");
@@ -74,6 +78,7 @@ SWGFileInputSettings::cleanup() {
 
 
 
+
     if(reverse_api_address != nullptr) { 
         delete reverse_api_address;
     }
@@ -98,6 +103,8 @@ SWGFileInputSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&loop, pJson["loop"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&free_run, pJson["freeRun"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&use_reverse_api, pJson["useReverseAPI"], "qint32", "");
     
     ::SWGSDRangel::setValue(&reverse_api_address, pJson["reverseAPIAddress"], "QString", "QString");
@@ -131,6 +138,9 @@ SWGFileInputSettings::asJsonObject() {
     if(m_loop_isSet){
         obj->insert("loop", QJsonValue(loop));
     }
+    if(m_free_run_isSet){
+        obj->insert("freeRun", QJsonValue(free_run));
+    }
     if(m_use_reverse_api_isSet){
         obj->insert("useReverseAPI", QJsonValue(use_reverse_api));
     }
@@ -177,6 +187,16 @@ SWGFileInputSettings::setLoop(qint32 loop) {
     this->m_loop_isSet = true;
 }
 
+qint32
+SWGFileInputSettings::getFreeRun() {
+    return free_run;
+}
+void
+SWGFileInputSettings::setFreeRun(qint32 free_run) {
+    this->free_run = free_run;
+    this->m_free_run_isSet = true;
+}
+
 qint32
 SWGFileInputSettings::getUseReverseApi() {
     return use_reverse_api;
@@ -231,6 +251,9 @@ SWGFileInputSettings::isSet(){
         if(m_loop_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_free_run_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_use_reverse_api_isSet){
             isObjectUpdated = true; break;
         }
@@ -51,6 +51,9 @@ public:
     qint32 getLoop();
     void setLoop(qint32 loop);
 
+    qint32 getFreeRun();
+    void setFreeRun(qint32 free_run);
+
     qint32 getUseReverseApi();
     void setUseReverseApi(qint32 use_reverse_api);
 
@@ -76,6 +79,9 @@ private:
     qint32 loop;
     bool m_loop_isSet;
 
+    qint32 free_run;
+    bool m_free_run_isSet;
+
     qint32 use_reverse_api;
     bool m_use_reverse_api_isSet;
 
@@ -70,6 +70,10 @@ SWGGLSpectrum::SWGGLSpectrum() {
     m_averaging_value_isSet = false;
     linear = 0;
     m_linear_isSet = false;
+    reduction_bins = 0;
+    m_reduction_bins_isSet = false;
+    reduction_mode = 0;
+    m_reduction_mode_isSet = false;
 }
 
 SWGGLSpectrum::~SWGGLSpectrum() {
@@ -120,6 +124,10 @@ SWGGLSpectrum::init() {
     m_averaging_value_isSet = false;
     linear = 0;
     m_linear_isSet = false;
+    reduction_bins = 0;
+    m_reduction_bins_isSet = false;
+    reduction_mode = 0;
+    m_reduction_mode_isSet = false;
 }
 
 void
@@ -200,6 +208,10 @@ SWGGLSpectrum::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&linear, pJson["linear"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&reduction_bins, pJson["reductionBins"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&reduction_mode, pJson["reductionMode"], "qint32", "");
+    
 }
 
 QString
@@ -279,6 +291,12 @@ SWGGLSpectrum::asJsonObject() {
     if(m_linear_isSet){
         obj->insert("linear", QJsonValue(linear));
     }
+    if(m_reduction_bins_isSet){
+        obj->insert("reductionBins", QJsonValue(reduction_bins));
+    }
+    if(m_reduction_mode_isSet){
+        obj->insert("reductionMode", QJsonValue(reduction_mode));
+    }
 
     return obj;
 }
@@ -493,6 +511,26 @@ SWGGLSpectrum::setLinear(qint32 linear) {
     this->m_linear_isSet = true;
 }
 
+qint32
+SWGGLSpectrum::getReductionBins() {
+    return reduction_bins;
+}
+void
+SWGGLSpectrum::setReductionBins(qint32 reduction_bins) {
+    this->reduction_bins = reduction_bins;
+    this->m_reduction_bins_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getReductionMode() {
+    return reduction_mode;
+}
+void
+SWGGLSpectrum::setReductionMode(qint32 reduction_mode) {
+    this->reduction_mode = reduction_mode;
+    this->m_reduction_mode_isSet = true;
+}
+
 
 bool
 SWGGLSpectrum::isSet(){
@@ -561,6 +599,12 @@ SWGGLSpectrum::isSet(){
         if(m_linear_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_reduction_bins_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_reduction_mode_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
@@ -104,6 +104,12 @@ public:
     qint32 getLinear();
     void setLinear(qint32 linear);
 
+    qint32 getReductionBins();
+    void setReductionBins(qint32 reduction_bins);
+
+    qint32 getReductionMode();
+    void setReductionMode(qint32 reduction_mode);
+
 
     virtual bool isSet() override;
 
@@ -171,6 +177,12 @@ private:
     qint32 linear;
     bool m_linear_isSet;
 
+    qint32 reduction_bins;
+    bool m_reduction_bins_isSet;
+
+    qint32 reduction_mode;
+    bool m_reduction_mode_isSet;
+
 };
 
 }
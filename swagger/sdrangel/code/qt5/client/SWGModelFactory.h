@@ -52,6 +52,7 @@
 #include "SWGChannelAnalyzerSettings.h"
 #include "SWGChannelConfig.h"
 #include "SWGChannelListItem.h"
+#include "SWGChannelPerf.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelsDetail.h"
@@ -65,9 +66,11 @@
 #include "SWGDeviceActions.h"
 #include "SWGDeviceConfig.h"
 #include "SWGDeviceListItem.h"
+#include "SWGDeviceRecord.h"
 #include "SWGDeviceReport.h"
 #include "SWGDeviceSet.h"
 #include "SWGDeviceSetList.h"
+#include "SWGDeviceSetPerf.h"
 #include "SWGDeviceSettings.h"
 #include "SWGDeviceState.h"
 #include "SWGErrorResponse.h"
@@ -75,6 +78,7 @@
 #include "SWGFCDProPlusActions.h"
 #include "SWGFCDProPlusSettings.h"
 #include "SWGFCDProSettings.h"
+#include "SWGFifoPerf.h"
 #include "SWGFileInputReport.h"
 #include "SWGFileInputSettings.h"
 #include "SWGFileSourceActions.h"
@@ -125,6 +129,7 @@
 #include "SWGNFMModReport.h"
 #include "SWGNFMModSettings.h"
 #include "SWGNamedEnum.h"
+#include "SWGPerfCounter.h"
 #include "SWGPerseusActions.h"
 #include "SWGPerseusReport.h"
 #include "SWGPerseusSettings.h"
@@ -308,6 +313,9 @@ namespace SWGSDRangel {
     if(QString("SWGChannelListItem").compare(type) == 0) {
       return new SWGChannelListItem();
     }
+    if(QString("SWGChannelPerf").compare(type) == 0) {
+      return new SWGChannelPerf();
+    }
     if(QString("SWGChannelReport").compare(type) == 0) {
       return new SWGChannelReport();
     }
@@ -347,6 +355,9 @@ namespace SWGSDRangel {
     if(QString("SWGDeviceListItem").compare(type) == 0) {
       return new SWGDeviceListItem();
     }
+    if(QString("SWGDeviceRecord").compare(type) == 0) {
+      return new SWGDeviceRecord();
+    }
     if(QString("SWGDeviceReport").compare(type) == 0) {
       return new SWGDeviceReport();
     }
@@ -356,6 +367,9 @@ namespace SWGSDRangel {
     if(QString("SWGDeviceSetList").compare(type) == 0) {
       return new SWGDeviceSetList();
     }
+    if(QString("SWGDeviceSetPerf").compare(type) == 0) {
+      return new SWGDeviceSetPerf();
+    }
     if(QString("SWGDeviceSettings").compare(type) == 0) {
       return new SWGDeviceSettings();
     }
@@ -377,6 +391,9 @@ namespace SWGSDRangel {
     if(QString("SWGFCDProSettings").compare(type) == 0) {
       return new SWGFCDProSettings();
     }
+    if(QString("SWGFifoPerf").compare(type) == 0) {
+      return new SWGFifoPerf();
+    }
     if(QString("SWGFileInputReport").compare(type) == 0) {
       return new SWGFileInputReport();
     }
@@ -527,6 +544,9 @@ namespace SWGSDRangel {
     if(QString("SWGNamedEnum").compare(type) == 0) {
       return new SWGNamedEnum();
     }
+    if(QString("SWGPerfCounter").compare(type) == 0) {
+      return new SWGPerfCounter();
+    }
     if(QString("SWGPerseusActions").compare(type) == 0) {
       return new SWGPerseusActions();
     }
@@ -0,0 +1,177 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGPerfCounter.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGPerfCounter::SWGPerfCounter(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGPerfCounter::SWGPerfCounter() {
+    calls = 0L;
+    m_calls_isSet = false;
+    samples = 0L;
+    m_samples_isSet = false;
+    total_time = 0L;
+    m_total_time_isSet = false;
+    max_time = 0L;
+    m_max_time_isSet = false;
+}
+
+SWGPerfCounter::~SWGPerfCounter() {
+    this->cleanup();
+}
+
+void
+SWGPerfCounter::init() {
+    calls = 0L;
+    m_calls_isSet = false;
+    samples = 0L;
+    m_samples_isSet = false;
+    total_time = 0L;
+    m_total_time_isSet = false;
+    max_time = 0L;
+    m_max_time_isSet = false;
+}
+
+void
+SWGPerfCounter::cleanup() {
+
+
+
+
+}
+
+SWGPerfCounter*
+SWGPerfCounter::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGPerfCounter::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&calls, pJson["calls"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&samples, pJson["samples"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&total_time, pJson["totalTime"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&max_time, pJson["maxTime"], "qint64", "");
+    
+}
+
+QString
+SWGPerfCounter::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGPerfCounter::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_calls_isSet){
+        obj->insert("calls", QJsonValue(calls));
+    }
+    if(m_samples_isSet){
+        obj->insert("samples", QJsonValue(samples));
+    }
+    if(m_total_time_isSet){
+        obj->insert("totalTime", QJsonValue(total_time));
+    }
+    if(m_max_time_isSet){
+        obj->insert("maxTime", QJsonValue(max_time));
+    }
+
+    return obj;
+}
+
+qint64
+SWGPerfCounter::getCalls() {
+    return calls;
+}
+void
+SWGPerfCounter::setCalls(qint64 calls) {
+    this->calls = calls;
+    this->m_calls_isSet = true;
+}
+
+qint64
+SWGPerfCounter::getSamples() {
+    return samples;
+}
+void
+SWGPerfCounter::setSamples(qint64 samples) {
+    this->samples = samples;
+    this->m_samples_isSet = true;
+}
+
+qint64
+SWGPerfCounter::getTotalTime() {
+    return total_time;
+}
+void
+SWGPerfCounter::setTotalTime(qint64 total_time) {
+    this->total_time = total_time;
+    this->m_total_time_isSet = true;
+}
+
+qint64
+SWGPerfCounter::getMaxTime() {
+    return max_time;
+}
+void
+SWGPerfCounter::setMaxTime(qint64 max_time) {
+    this->max_time = max_time;
+    this->m_max_time_isSet = true;
+}
+
+
+bool
+SWGPerfCounter::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_calls_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_samples_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_total_time_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_max_time_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
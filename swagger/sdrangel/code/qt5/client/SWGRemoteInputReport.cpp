@@ -40,6 +40,10 @@ SWGRemoteInputReport::SWGRemoteInputReport() {
     m_min_nb_blocks_isSet = false;
     max_nb_recovery = 0;
     m_max_nb_recovery_isSet = false;
+    frames_per_sec = 0.0f;
+    m_frames_per_sec_isSet = false;
+    fec_latency = 0;
+    m_fec_latency_isSet = false;
 }
 
 SWGRemoteInputReport::~SWGRemoteInputReport() {
@@ -60,6 +64,10 @@ SWGRemoteInputReport::init() {
     m_min_nb_blocks_isSet = false;
     max_nb_recovery = 0;
     m_max_nb_recovery_isSet = false;
+    frames_per_sec = 0.0f;
+    m_frames_per_sec_isSet = false;
+    fec_latency = 0;
+    m_fec_latency_isSet = false;
 }
 
 void
@@ -97,6 +105,10 @@ SWGRemoteInputReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&max_nb_recovery, pJson["maxNbRecovery"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&frames_per_sec, pJson["framesPerSec"], "float", "");
+    
+    ::SWGSDRangel::setValue(&fec_latency, pJson["fecLatency"], "qint32", "");
+    
 }
 
 QString
@@ -131,6 +143,12 @@ SWGRemoteInputReport::asJsonObject() {
     if(m_max_nb_recovery_isSet){
         obj->insert("maxNbRecovery", QJsonValue(max_nb_recovery));
     }
+    if(m_frames_per_sec_isSet){
+        obj->insert("framesPerSec", QJsonValue(frames_per_sec));
+    }
+    if(m_fec_latency_isSet){
+        obj->insert("fecLatency", QJsonValue(fec_latency));
+    }
 
     return obj;
 }
@@ -195,6 +213,26 @@ SWGRemoteInputReport::setMaxNbRecovery(qint32 max_nb_recovery) {
     this->m_max_nb_recovery_isSet = true;
 }
 
+float
+SWGRemoteInputReport::getFramesPerSec() {
+    return frames_per_sec;
+}
+void
+SWGRemoteInputReport::setFramesPerSec(float frames_per_sec) {
+    this->frames_per_sec = frames_per_sec;
+    this->m_frames_per_sec_isSet = true;
+}
+
+qint32
+SWGRemoteInputReport::getFecLatency() {
+    return fec_latency;
+}
+void
+SWGRemoteInputReport::setFecLatency(qint32 fec_latency) {
+    this->fec_latency = fec_latency;
+    this->m_fec_latency_isSet = true;
+}
+
 
 bool
 SWGRemoteInputReport::isSet(){
@@ -218,6 +256,12 @@ SWGRemoteInputReport::isSet(){
         if(m_max_nb_recovery_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_frames_per_sec_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_fec_latency_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
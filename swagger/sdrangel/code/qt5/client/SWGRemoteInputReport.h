@@ -60,6 +60,12 @@ public:
     qint32 getMaxNbRecovery();
     void setMaxNbRecovery(qint32 max_nb_recovery);
 
+    float getFramesPerSec();
+    void setFramesPerSec(float frames_per_sec);
+
+    qint32 getFecLatency();
+    void setFecLatency(qint32 fec_latency);
+
 
     virtual bool isSet() override;
 
@@ -82,6 +88,12 @@ private:
     qint32 max_nb_recovery;
     bool m_max_nb_recovery_isSet;
 
+    float frames_per_sec;
+    bool m_frames_per_sec_isSet;
+
+    qint32 fec_latency;
+    bool m_fec_latency_isSet;
+
 };
 
 }
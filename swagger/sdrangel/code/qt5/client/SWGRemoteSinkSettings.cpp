@@ -36,6 +36,8 @@ SWGRemoteSinkSettings::SWGRemoteSinkSettings() {
     m_data_port_isSet = false;
     tx_delay = 0;
     m_tx_delay_isSet = false;
+    block_size = 0;
+    m_block_size_isSet = false;
     rgb_color = 0;
     m_rgb_color_isSet = false;
     title = nullptr;
@@ -72,6 +74,8 @@ SWGRemoteSinkSettings::init() {
     m_data_port_isSet = false;
     tx_delay = 0;
     m_tx_delay_isSet = false;
+    block_size = 0;
+    m_block_size_isSet = false;
     rgb_color = 0;
     m_rgb_color_isSet = false;
     title = new QString("");
@@ -137,6 +141,8 @@ SWGRemoteSinkSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&tx_delay, pJson["txDelay"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&block_size, pJson["blockSize"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&rgb_color, pJson["rgbColor"], "qint32", "");
     
     ::SWGSDRangel::setValue(&title, pJson["title"], "QString", "QString");
@@ -185,6 +191,9 @@ SWGRemoteSinkSettings::asJsonObject() {
     if(m_tx_delay_isSet){
         obj->insert("txDelay", QJsonValue(tx_delay));
     }
+    if(m_block_size_isSet){
+        obj->insert("blockSize", QJsonValue(block_size));
+    }
     if(m_rgb_color_isSet){
         obj->insert("rgbColor", QJsonValue(rgb_color));
     }
@@ -259,6 +268,16 @@ SWGRemoteSinkSettings::setTxDelay(qint32 tx_delay) {
     this->m_tx_delay_isSet = true;
 }
 
+qint32
+SWGRemoteSinkSettings::getBlockSize() {
+    return block_size;
+}
+void
+SWGRemoteSinkSettings::setBlockSize(qint32 block_size) {
+    this->block_size = block_size;
+    this->m_block_size_isSet = true;
+}
+
 qint32
 SWGRemoteSinkSettings::getRgbColor() {
     return rgb_color;
@@ -376,6 +395,9 @@ SWGRemoteSinkSettings::isSet(){
         if(m_tx_delay_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_block_size_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_rgb_color_isSet){
             isObjectUpdated = true; break;
         }
@@ -54,6 +54,9 @@ public:
     qint32 getTxDelay();
     void setTxDelay(qint32 tx_delay);
 
+    qint32 getBlockSize();
+    void setBlockSize(qint32 block_size);
+
     qint32 getRgbColor();
     void setRgbColor(qint32 rgb_color);
 
@@ -100,6 +103,9 @@ private:
     qint32 tx_delay;
     bool m_tx_delay_isSet;
 
+    qint32 block_size;
+    bool m_block_size_isSet;
+
     qint32 rgb_color;
     bool m_rgb_color_isSet;
 